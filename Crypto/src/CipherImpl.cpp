@@ -97,7 +97,7 @@ namespace
 
 	private:
 		const EVP_CIPHER* _pCipher;
-		EVP_CIPHER_CTX    _ctx;
+		EVP_CIPHER_CTX*   _pCtx;
 		ByteVec           _key;
 		ByteVec           _iv;
 	};
@@ -109,11 +109,13 @@ namespace
 		const ByteVec&    iv,
 		Direction         dir):
 		_pCipher(pCipher),
+		_pCtx(EVP_CIPHER_CTX_new()),
 		_key(key),
 		_iv(iv)
 	{
+		if (!_pCtx) throwError();
 		EVP_CipherInit(
-			&_ctx,
+			_pCtx,
 			_pCipher,
 			&_key[0],
 			_iv.empty() ? 0 : &_iv[0],
@@ -123,19 +125,19 @@ namespace
 
 	CryptoTransformImpl::~CryptoTransformImpl()
 	{
-		EVP_CIPHER_CTX_cleanup(&_ctx);
+		EVP_CIPHER_CTX_free(_pCtx);
 	}
 
 
 	std::size_t CryptoTransformImpl::blockSize() const
 	{
-		return EVP_CIPHER_CTX_block_size(&_ctx);
+		return EVP_CIPHER_CTX_block_size(_pCtx);
 	}
 
 	
 	int CryptoTransformImpl::setPadding(int padding)
 	{
-		return EVP_CIPHER_CTX_set_padding(&_ctx, padding);
+		return EVP_CIPHER_CTX_set_padding(_pCtx, padding);
 	}
 	
 
@@ -149,7 +151,7 @@ namespace
 
 		int outLen = static_cast<int>(outputLength);
 		int rc = EVP_CipherUpdate(
-			&_ctx,
+			_pCtx,
 			output,
 			&outLen,
 			input,
@@ -171,9 +173,9 @@ namespace
 		int len = static_cast<int>(length);
 
 		// Use the '_ex' version that does not perform implicit cleanup since we
-		// will call EVP_CIPHER_CTX_cleanup() from the dtor as there is no
+		// will call EVP_CIPHER_CTX_free() from the dtor as there is no
 		// guarantee that finalize() will be called if an error occurred.
-		int rc = EVP_CipherFinal_ex(&_ctx, output, &len);
+		int rc = EVP_CipherFinal_ex(_pCtx, output, &len);
 
 		if (rc == 0)
 			throwError();
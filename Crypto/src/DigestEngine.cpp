@@ -66,7 +66,11 @@ std::size_t DigestEngine::digestLength() const
 
 void DigestEngine::reset()
 {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	EVP_MD_CTX_reset(_ctx);
+#else
 	EVP_MD_CTX_cleanup(_ctx);
+#endif
 	const EVP_MD* md = EVP_get_digestbyname(_name.c_str());
 	if (!md) throw Poco::NotFoundException(_name);
 	EVP_DigestInit_ex(_ctx, md, NULL);
@@ -73,7 +73,12 @@ namespace
 		case RSA_PADDING_PKCS1_OAEP:
 			return RSA_PKCS1_OAEP_PADDING;
 		case RSA_PADDING_SSLV23:
+#if defined(RSA_SSLV23_PADDING)
 			return RSA_SSLV23_PADDING;
+#else
+			// removed in OpenSSL 3.0
+			throw Poco::NotImplementedException("RSA_PADDING_SSLV23");
+#endif
 		case RSA_PADDING_NONE:
 			return RSA_NO_PADDING;
 		default:
@@ -45,7 +45,11 @@
 #include "Poco/Data/LOB.h"
 #include "Poco/Any.h"
 #include "Poco/DynamicAny.h"
+#include "Poco/SharedPtr.h"
 #include "sqlite3.h"
+#include <vector>
+#include <deque>
+#include <list>
 
 
 namespace Poco {
@@ -55,6 +59,10 @@ namespace SQLite {
 
 class SQLite_API Binder: public Poco::Data::AbstractBinder
 	/// Binds placeholders in the sql query to the provided values. Performs data types mapping.
+	///
+	/// Containers are only bound in bulk mode. The binder remembers them,
+	/// and SQLiteStatementImpl executes the statement once per row,
+	/// calling bindBulkRow() before each execution.
 {
 public:
 	Binder(sqlite3_stmt* pStmt);
@@ -131,7 +139,268 @@ public:
 	void bind(std::size_t pos, const NullData& val, Direction dir);
 		/// Binds a null.
 
+	void bind(std::size_t pos, const std::vector<Poco::Int8>& val, Direction dir);
+		/// Binds an Int8 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int8>& val, Direction dir);
+		/// Binds an Int8 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::Int8>& val, Direction dir);
+		/// Binds an Int8 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt8>& val, Direction dir);
+		/// Binds an UInt8 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt8>& val, Direction dir);
+		/// Binds an UInt8 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::UInt8>& val, Direction dir);
+		/// Binds an UInt8 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::Int16>& val, Direction dir);
+		/// Binds an Int16 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int16>& val, Direction dir);
+		/// Binds an Int16 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::Int16>& val, Direction dir);
+		/// Binds an Int16 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt16>& val, Direction dir);
+		/// Binds an UInt16 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt16>& val, Direction dir);
+		/// Binds an UInt16 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::UInt16>& val, Direction dir);
+		/// Binds an UInt16 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::Int32>& val, Direction dir);
+		/// Binds an Int32 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int32>& val, Direction dir);
+		/// Binds an Int32 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::Int32>& val, Direction dir);
+		/// Binds an Int32 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt32>& val, Direction dir);
+		/// Binds an UInt32 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt32>& val, Direction dir);
+		/// Binds an UInt32 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::UInt32>& val, Direction dir);
+		/// Binds an UInt32 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::Int64>& val, Direction dir);
+		/// Binds an Int64 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::Int64>& val, Direction dir);
+		/// Binds an Int64 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::Int64>& val, Direction dir);
+		/// Binds an Int64 list.
+
+	void bind(std::size_t pos, const std::vector<Poco::UInt64>& val, Direction dir);
+		/// Binds an UInt64 vector.
+
+	void bind(std::size_t pos, const std::deque<Poco::UInt64>& val, Direction dir);
+		/// Binds an UInt64 deque.
+
+	void bind(std::size_t pos, const std::list<Poco::UInt64>& val, Direction dir);
+		/// Binds an UInt64 list.
+
+#ifndef POCO_LONG_IS_64_BIT
+	void bind(std::size_t pos, const std::vector<long>& val, Direction dir);
+		/// Binds a long vector.
+
+	void bind(std::size_t pos, const std::deque<long>& val, Direction dir);
+		/// Binds a long deque.
+
+	void bind(std::size_t pos, const std::list<long>& val, Direction dir);
+		/// Binds a long list.
+#endif
+
+	void bind(std::size_t pos, const std::vector<bool>& val, Direction dir);
+		/// Binds a boolean vector.
+
+	void bind(std::size_t pos, const std::deque<bool>& val, Direction dir);
+		/// Binds a boolean deque.
+
+	void bind(std::size_t pos, const std::list<bool>& val, Direction dir);
+		/// Binds a boolean list.
+
+	void bind(std::size_t pos, const std::vector<float>& val, Direction dir);
+		/// Binds a float vector.
+
+	void bind(std::size_t pos, const std::deque<float>& val, Direction dir);
+		/// Binds a float deque.
+
+	void bind(std::size_t pos, const std::list<float>& val, Direction dir);
+		/// Binds a float list.
+
+	void bind(std::size_t pos, const std::vector<double>& val, Direction dir);
+		/// Binds a double vector.
+
+	void bind(std::size_t pos, const std::deque<double>& val, Direction dir);
+		/// Binds a double deque.
+
+	void bind(std::size_t pos, const std::list<double>& val, Direction dir);
+		/// Binds a double list.
+
+	void bind(std::size_t pos, const std::vector<char>& val, Direction dir);
+		/// Binds a character vector.
+
+	void bind(std::size_t pos, const std::deque<char>& val, Direction dir);
+		/// Binds a character deque.
+
+	void bind(std::size_t pos, const std::list<char>& val, Direction dir);
+		/// Binds a character list.
+
+	void bind(std::size_t pos, const std::vector<std::string>& val, Direction dir);
+		/// Binds a string vector.
+
+	void bind(std::size_t pos, const std::deque<std::string>& val, Direction dir);
+		/// Binds a string deque.
+
+	void bind(std::size_t pos, const std::list<std::string>& val, Direction dir);
+		/// Binds a string list.
+
+	void bind(std::size_t pos, const std::vector<BLOB>& val, Direction dir);
+		/// Binds a BLOB vector.
+
+	void bind(std::size_t pos, const std::deque<BLOB>& val, Direction dir);
+		/// Binds a BLOB deque.
+
+	void bind(std::size_t pos, const std::list<BLOB>& val, Direction dir);
+		/// Binds a BLOB list.
+
+	void bind(std::size_t pos, const std::vector<CLOB>& val, Direction dir);
+		/// Binds a CLOB vector.
+
+	void bind(std::size_t pos, const std::deque<CLOB>& val, Direction dir);
+		/// Binds a CLOB deque.
+
+	void bind(std::size_t pos, const std::list<CLOB>& val, Direction dir);
+		/// Binds a CLOB list.
+
+	void bind(std::size_t pos, const std::vector<DateTime>& val, Direction dir);
+		/// Binds a DateTime vector.
+
+	void bind(std::size_t pos, const std::deque<DateTime>& val, Direction dir);
+		/// Binds a DateTime deque.
+
+	void bind(std::size_t pos, const std::list<DateTime>& val, Direction dir);
+		/// Binds a DateTime list.
+
+	void bind(std::size_t pos, const std::vector<Date>& val, Direction dir);
+		/// Binds a Date vector.
+
+	void bind(std::size_t pos, const std::deque<Date>& val, Direction dir);
+		/// Binds a Date deque.
+
+	void bind(std::size_t pos, const std::list<Date>& val, Direction dir);
+		/// Binds a Date list.
+
+	void bind(std::size_t pos, const std::vector<Time>& val, Direction dir);
+		/// Binds a Time vector.
+
+	void bind(std::size_t pos, const std::deque<Time>& val, Direction dir);
+		/// Binds a Time deque.
+
+	void bind(std::size_t pos, const std::list<Time>& val, Direction dir);
+		/// Binds a Time list.
+
+	void bind(std::size_t pos, const std::vector<NullData>& val, Direction dir);
+		/// Binds a null vector.
+
+	void bind(std::size_t pos, const std::deque<NullData>& val, Direction dir);
+		/// Binds a null deque.
+
+	void bind(std::size_t pos, const std::list<NullData>& val, Direction dir);
+		/// Binds a null list.
+
+	void reset();
+		/// Clears the containers bound in bulk.
+
+	std::size_t bulkSize() const;
+		/// Returns the number of rows of the containers bound
+		/// in bulk, or zero if no container has been bound.
+		///
+		/// Throws a BindingException if the containers
+		/// differ in size.
+
+	void bindBulkRow(std::size_t row);
+		/// Binds the values at the given row of all containers
+		/// bound in bulk. Rows must be bound in ascending order,
+		/// starting at zero.
+
 private:
+	class AbstractBulkParameter
+		/// A container bound in bulk.
+	{
+	public:
+		virtual ~AbstractBulkParameter()
+		{
+		}
+
+		virtual std::size_t size() const = 0;
+			/// Returns the number of rows in the container.
+
+		virtual void bind(Binder& binder, std::size_t row) = 0;
+			/// Binds the value at the given row.
+	};
+
+	template <class C>
+	class BulkParameter: public AbstractBulkParameter
+	{
+	public:
+		BulkParameter(std::size_t pos, const C& container):
+			_pos(pos),
+			_rContainer(container),
+			_it(container.begin())
+		{
+		}
+
+		std::size_t size() const
+		{
+			return _rContainer.size();
+		}
+
+		void bind(Binder& binder, std::size_t row)
+		{
+			if (row == 0) _it = _rContainer.begin();
+			poco_assert_dbg (_it != _rContainer.end());
+			binder.bindBulkValue(_pos, *_it);
+			++_it;
+		}
+
+	private:
+		std::size_t                _pos;
+		const C&                   _rContainer;
+		typename C::const_iterator _it;
+	};
+
+	typedef std::vector<Poco::SharedPtr<AbstractBulkParameter> > BulkParameterVec;
+
+	template <class C>
+	void bindBulk(std::size_t pos, const C& val)
+		/// Remembers the container, whose values are bound
+		/// row by row by bindBulkRow().
+	{
+		if (pos >= _bulkParameters.size()) _bulkParameters.resize(pos + 1);
+		_bulkParameters[pos] = new BulkParameter<C>(pos, val);
+	}
+
+	template <typename T>
+	void bindBulkValue(std::size_t pos, const T& val)
+	{
+		bind(pos, val, PD_IN);
+	}
+
+	void bindBulkValue(std::size_t pos, const std::string& val);
+
 	void checkReturn(int rc);
 		/// Checks the SQLite return code and throws an appropriate exception
 		/// if error has occurred.
@@ -147,7 +416,8 @@ private:
 		checkReturn(rc);
 	}
 
-	sqlite3_stmt* _pStmt;
+	sqlite3_stmt*    _pStmt;
+	BulkParameterVec _bulkParameters;
 };
 
 
@@ -52,8 +52,11 @@
 #include "Poco/Data/Time.h"
 #include "Poco/Any.h"
 #include "Poco/DynamicAny.h"
+#include "Poco/SharedPtr.h"
 #include "sqlite3.h"
 #include <vector>
+#include <deque>
+#include <list>
 #include <utility>
 
 
@@ -65,6 +68,13 @@ namespace SQLite {
 class SQLite_API Extractor: public Poco::Data::AbstractExtractor
 	/// Extracts and converts data values form the result row returned by SQLite.
 	/// If NULL is received, the incoming val value is not changed and false is returned
+	///
+	/// For bulk extraction, SQLiteStatementImpl first passes the containers
+	/// of all columns to the container extract() overloads, which only
+	/// register them. It then steps through the result and calls
+	/// extractBulkRow() for every row, which writes the values straight
+	/// into the registered containers. Finally, finishBulk() removes
+	/// unused elements from the containers.
 {
 public:
 	typedef std::vector<std::pair<bool, bool> > NullIndVec;
@@ -144,6 +154,201 @@ public:
 	bool extract(std::size_t pos, Poco::DynamicAny& val);
 		/// Extracts a DynamicAny.
 
+	bool extract(std::size_t pos, std::vector<Poco::Int8>& val);
+		/// Extracts an Int8 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int8>& val);
+		/// Extracts an Int8 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::Int8>& val);
+		/// Extracts an Int8 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt8>& val);
+		/// Extracts an UInt8 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt8>& val);
+		/// Extracts an UInt8 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt8>& val);
+		/// Extracts an UInt8 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::Int16>& val);
+		/// Extracts an Int16 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int16>& val);
+		/// Extracts an Int16 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::Int16>& val);
+		/// Extracts an Int16 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt16>& val);
+		/// Extracts an UInt16 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt16>& val);
+		/// Extracts an UInt16 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt16>& val);
+		/// Extracts an UInt16 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::Int32>& val);
+		/// Extracts an Int32 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int32>& val);
+		/// Extracts an Int32 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::Int32>& val);
+		/// Extracts an Int32 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt32>& val);
+		/// Extracts an UInt32 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt32>& val);
+		/// Extracts an UInt32 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt32>& val);
+		/// Extracts an UInt32 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::Int64>& val);
+		/// Extracts an Int64 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::Int64>& val);
+		/// Extracts an Int64 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::Int64>& val);
+		/// Extracts an Int64 list.
+
+	bool extract(std::size_t pos, std::vector<Poco::UInt64>& val);
+		/// Extracts an UInt64 vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::UInt64>& val);
+		/// Extracts an UInt64 deque.
+
+	bool extract(std::size_t pos, std::list<Poco::UInt64>& val);
+		/// Extracts an UInt64 list.
+
+#ifndef POCO_LONG_IS_64_BIT
+	bool extract(std::size_t pos, std::vector<long>& val);
+		/// Extracts a long vector.
+
+	bool extract(std::size_t pos, std::deque<long>& val);
+		/// Extracts a long deque.
+
+	bool extract(std::size_t pos, std::list<long>& val);
+		/// Extracts a long list.
+#endif
+
+	bool extract(std::size_t pos, std::vector<bool>& val);
+		/// Extracts a boolean vector.
+
+	bool extract(std::size_t pos, std::deque<bool>& val);
+		/// Extracts a boolean deque.
+
+	bool extract(std::size_t pos, std::list<bool>& val);
+		/// Extracts a boolean list.
+
+	bool extract(std::size_t pos, std::vector<float>& val);
+		/// Extracts a float vector.
+
+	bool extract(std::size_t pos, std::deque<float>& val);
+		/// Extracts a float deque.
+
+	bool extract(std::size_t pos, std::list<float>& val);
+		/// Extracts a float list.
+
+	bool extract(std::size_t pos, std::vector<double>& val);
+		/// Extracts a double vector.
+
+	bool extract(std::size_t pos, std::deque<double>& val);
+		/// Extracts a double deque.
+
+	bool extract(std::size_t pos, std::list<double>& val);
+		/// Extracts a double list.
+
+	bool extract(std::size_t pos, std::vector<char>& val);
+		/// Extracts a character vector.
+
+	bool extract(std::size_t pos, std::deque<char>& val);
+		/// Extracts a character deque.
+
+	bool extract(std::size_t pos, std::list<char>& val);
+		/// Extracts a character list.
+
+	bool extract(std::size_t pos, std::vector<std::string>& val);
+		/// Extracts a string vector.
+
+	bool extract(std::size_t pos, std::deque<std::string>& val);
+		/// Extracts a string deque.
+
+	bool extract(std::size_t pos, std::list<std::string>& val);
+		/// Extracts a string list.
+
+	bool extract(std::size_t pos, std::vector<BLOB>& val);
+		/// Extracts a BLOB vector.
+
+	bool extract(std::size_t pos, std::deque<BLOB>& val);
+		/// Extracts a BLOB deque.
+
+	bool extract(std::size_t pos, std::list<BLOB>& val);
+		/// Extracts a BLOB list.
+
+	bool extract(std::size_t pos, std::vector<CLOB>& val);
+		/// Extracts a CLOB vector.
+
+	bool extract(std::size_t pos, std::deque<CLOB>& val);
+		/// Extracts a CLOB deque.
+
+	bool extract(std::size_t pos, std::list<CLOB>& val);
+		/// Extracts a CLOB list.
+
+	bool extract(std::size_t pos, std::vector<DateTime>& val);
+		/// Extracts a DateTime vector.
+
+	bool extract(std::size_t pos, std::deque<DateTime>& val);
+		/// Extracts a DateTime deque.
+
+	bool extract(std::size_t pos, std::list<DateTime>& val);
+		/// Extracts a DateTime list.
+
+	bool extract(std::size_t pos, std::vector<Date>& val);
+		/// Extracts a Date vector.
+
+	bool extract(std::size_t pos, std::deque<Date>& val);
+		/// Extracts a Date deque.
+
+	bool extract(std::size_t pos, std::list<Date>& val);
+		/// Extracts a Date list.
+
+	bool extract(std::size_t pos, std::vector<Time>& val);
+		/// Extracts a Time vector.
+
+	bool extract(std::size_t pos, std::deque<Time>& val);
+		/// Extracts a Time deque.
+
+	bool extract(std::size_t pos, std::list<Time>& val);
+		/// Extracts a Time list.
+
+	bool extract(std::size_t pos, std::vector<Any>& val);
+		/// Extracts an Any vector.
+
+	bool extract(std::size_t pos, std::deque<Any>& val);
+		/// Extracts an Any deque.
+
+	bool extract(std::size_t pos, std::list<Any>& val);
+		/// Extracts an Any list.
+
+	bool extract(std::size_t pos, std::vector<Poco::Dynamic::Var>& val);
+		/// Extracts a Var vector.
+
+	bool extract(std::size_t pos, std::deque<Poco::Dynamic::Var>& val);
+		/// Extracts a Var deque.
+
+	bool extract(std::size_t pos, std::list<Poco::Dynamic::Var>& val);
+		/// Extracts a Var list.
+
+	const char* stringData(std::size_t pos, std::size_t& length);
+		/// Returns a pointer to the text of the value at pos,
+		/// as held by SQLite for the current row.
+
 	bool isNull(std::size_t pos, std::size_t row = POCO_DATA_INVALID_ROW);
 		/// Returns true if the current row value at pos column is null.
 		/// Because of the loss of information about null-ness of the 
@@ -157,13 +362,99 @@ public:
 		/// bool value in the pair is true if the null indicator has 
 		/// been set and the second bool value in the pair is true if
 		/// the column is actually null.
-		/// The row argument, needed for connectors with bulk capabilities,
-		/// is ignored in this implementation.
+		/// If the row argument is given and a bulk extraction has been
+		/// made, the null indicator of the given row of the last bulk
+		/// is returned.
 
 	void reset();
 		/// Clears the cached nulls indicator vector.
 
+	bool hasBulkColumns() const;
+		/// Returns true if containers have been registered
+		/// for bulk extraction.
+
+	void extractBulkRow(std::size_t row);
+		/// Extracts the current result row into the registered
+		/// containers, at the given row index. Rows must be extracted
+		/// in ascending order, starting at zero for every bulk.
+
+	void finishBulk();
+		/// Removes the elements following the last extracted row
+		/// from all registered containers.
+
 private:
+	class AbstractBulkColumn
+		/// A container registered for bulk extraction.
+	{
+	public:
+		virtual ~AbstractBulkColumn()
+		{
+		}
+
+		virtual bool refersTo(const void* pContainer) const = 0;
+			/// Returns true if the column writes into the given container.
+
+		virtual bool extract(Extractor& extractor, std::size_t pos, std::size_t row) = 0;
+			/// Extracts the value at pos from the current result row
+			/// into the given row of the container. Returns false
+			/// if the value is null.
+
+		virtual void finish() = 0;
+			/// Removes the elements following the last extracted row.
+	};
+
+	template <class C>
+	class BulkColumn: public AbstractBulkColumn
+	{
+	public:
+		BulkColumn(C& container):
+			_rContainer(container),
+			_it(container.begin())
+		{
+		}
+
+		bool refersTo(const void* pContainer) const
+		{
+			return &_rContainer == pContainer;
+		}
+
+		bool extract(Extractor& extractor, std::size_t pos, std::size_t row)
+		{
+			if (row == 0) _it = _rContainer.begin();
+			if (_it == _rContainer.end())
+			{
+				_rContainer.push_back(typename C::value_type());
+				_it = _rContainer.end();
+				--_it;
+			}
+			bool ret = extractor.Extractor::extract(pos, *_it);
+			if (!ret) *_it = typename C::value_type();
+			++_it;
+			return ret;
+		}
+
+		void finish()
+		{
+			_rContainer.erase(_it, _rContainer.end());
+		}
+
+	private:
+		C&                     _rContainer;
+		typename C::iterator   _it;
+	};
+
+	template <class C>
+	bool extractBulk(std::size_t pos, C& val)
+		/// Registers the container for bulk extraction. The values
+		/// have already been written by extractBulkRow() if the container
+		/// is already registered.
+	{
+		if (pos >= _bulkColumns.size()) _bulkColumns.resize(pos + 1);
+		if (_bulkColumns[pos].isNull() || !_bulkColumns[pos]->refersTo(&val))
+			_bulkColumns[pos] = new BulkColumn<C>(val);
+		return true;
+	}
+
 	template <typename T>
 	bool extractImpl(std::size_t pos, T& val)
 		/// Utility function for extraction of Any and DynamicAny.
@@ -303,11 +594,36 @@ private:
 		return true;
 	}
 
+	typedef std::vector<Poco::SharedPtr<AbstractBulkColumn> > BulkColumnVec;
+	typedef std::vector<std::vector<bool> > BulkNullVec;
+
 	sqlite3_stmt* _pStmt;
 	NullIndVec    _nulls;
+	BulkColumnVec _bulkColumns;
+	BulkNullVec   _bulkNulls;
 };
 
 
+template <>
+inline bool Extractor::BulkColumn<std::vector<bool> >::extract(Extractor& extractor, std::size_t pos, std::size_t row)
+	/// std::vector<bool> does not hand out references
+	/// to its elements, so extract into a temporary.
+{
+	if (row == 0) _it = _rContainer.begin();
+	if (_it == _rContainer.end())
+	{
+		_rContainer.push_back(false);
+		_it = _rContainer.end();
+		--_it;
+	}
+	bool val = false;
+	bool ret = extractor.Extractor::extract(pos, val);
+	*_it = val;
+	++_it;
+	return ret;
+}
+
+
 ///
 /// inlines
 ///
@@ -317,6 +633,12 @@ inline void Extractor::reset()
 }
 
 
+inline bool Extractor::hasBulkColumns() const
+{
+	return !_bulkColumns.empty();
+}
+
+
 inline bool Extractor::extract(std::size_t pos, Poco::Data::BLOB& val)
 {
 	return extractLOB<Poco::Data::BLOB::ValueType>(pos, val);
@@ -43,6 +43,7 @@
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/SQLite/Binder.h"
 #include "Poco/Data/SQLite/Extractor.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Data/StatementImpl.h"
 #include "Poco/Data/MetaColumn.h"
 #include "Poco/SharedPtr.h"
@@ -61,8 +62,12 @@ class SQLite_API SQLiteStatementImpl: public Poco::Data::StatementImpl
 	/// Implements statement functionality needed for SQLite
 {
 public:
-	SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB);
+	SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB, StatementCache::Ptr pCache = 0);
 		/// Creates the SQLiteStatementImpl.
+		///
+		/// If a StatementCache is given, prepared statements are
+		/// taken from the cache when compiling and returned to it 
+		/// instead of being finalized.
 
 	~SQLiteStatementImpl();
 		/// Destroys the SQLiteStatementImpl.
@@ -85,6 +90,8 @@ protected:
 
 	std::size_t next();
 		/// Retrieves the next row from the resultset and returns 1.
+		/// In bulk extraction mode, retrieves up to the extraction
+		/// limit rows and returns their number.
 		/// Will throw, if the resultset is empty.
 
 	bool canBind() const;
@@ -112,7 +119,20 @@ protected:
 
 private:
 	void clear();
-		/// Removes the _pStmt
+		/// Removes the _pStmt, returning it to the statement
+		/// cache, if there is one.
+
+	int stepBulk();
+		/// Executes the statement once for every row of the
+		/// containers bound in bulk. Returns SQLITE_DONE, or
+		/// the error code of the failed execution.
+
+	std::size_t nextBulk();
+		/// Extracts up to the extraction limit rows straight
+		/// into the containers of the bulk extractions.
+
+	void extractAll();
+		/// Calls extract() for all extractions.
 
 	typedef Poco::SharedPtr<Binder>             BinderPtr;
 	typedef Poco::SharedPtr<Extractor>          ExtractorPtr;
@@ -125,6 +145,9 @@ private:
 
 	sqlite3*         _pDB;
 	sqlite3_stmt*    _pStmt;
+	StatementCache::Ptr _pCache;
+	std::string      _sql;
+	std::string      _stmtLeftover;
 	bool             _stepCalled;
 	int              _nextResponse;
 	BinderPtr        _pBinder;
@@ -43,6 +43,7 @@
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/SQLite/Connector.h"
 #include "Poco/Data/SQLite/Binder.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Data/AbstractSessionImpl.h"
 #include "Poco/SharedPtr.h"
 
@@ -61,8 +62,17 @@ namespace SQLite {
 
 class SQLite_API SessionImpl: public Poco::Data::AbstractSessionImpl<SessionImpl>
 	/// Implements SessionImpl interface.
+	///
+	/// Prepared statements are kept in a StatementCache and reused
+	/// by statements with the same SQL text. The maximum number of
+	/// cached statements can be set with the "maxStatementCacheSize"
+	/// property (of type std::size_t); setting it to zero disables
+	/// the cache.
 {
 public:
+	static const std::size_t STATEMENT_CACHE_SIZE_DEFAULT = 32;
+		/// Default maximum number of cached prepared statements.
+
 	SessionImpl(const std::string& fileName,
 		std::size_t loginTimeout = LOGIN_TIMEOUT_DEFAULT);
 		/// Creates the SessionImpl. Opens a connection to the database.
@@ -137,8 +147,19 @@ public:
 	const std::string& connectorName() const;
 		/// Returns the name of the connector.
 
+	void setMaxStatementCacheSize(const std::string&, const Poco::Any& value);
+		/// Sets the maximum number of cached prepared statements.
+		/// Value must be of type std::size_t.
+
+	Poco::Any getMaxStatementCacheSize(const std::string& name = "");
+		/// Returns the maximum number of cached prepared statements.
+
+	StatementCache& statementCache();
+		/// Returns the statement cache.
+
 private:
 	std::string _connector;
+	StatementCache::Ptr _pCache;
 	sqlite3*    _pDB;
 	bool        _connected;
 	bool        _isTransaction;
@@ -171,6 +192,12 @@ inline const std::string& SessionImpl::connectorName() const
 }
 
 
+inline StatementCache& SessionImpl::statementCache()
+{
+	return *_pCache;
+}
+
+
 inline std::size_t SessionImpl::getConnectionTimeout()
 {
 	return static_cast<std::size_t>(_timeout);
@@ -0,0 +1,146 @@
+//
+// StatementCache.h
+//
+// $Id: //poco/Main/Data/SQLite/include/Poco/Data/SQLite/StatementCache.h#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  StatementCache
+//
+// Definition of the StatementCache class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_SQLite_StatementCache_INCLUDED
+#define Data_SQLite_StatementCache_INCLUDED
+
+
+#include "Poco/Data/SQLite/SQLite.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include <list>
+#include <map>
+#include <string>
+
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+class SQLite_API StatementCache
+	/// StatementCache is a bounded LRU cache of prepared statements,
+	/// keyed by SQL text. 
+	///
+	/// Every SessionImpl owns one StatementCache, so the cache lives as
+	/// long as the physical database connection and is kept when a
+	/// pooled session is returned to, and checked out again from, 
+	/// a SessionPool.
+	///
+	/// A statement is removed from the cache while it is in use by an
+	/// SQLiteStatementImpl, so a prepared statement is never shared.
+	/// If the cache is full, the least recently used statement is
+	/// finalized.
+	///
+	/// Statements that change the database schema (CREATE, DROP and
+	/// ALTER) are never cached, and returning one clears the cache,
+	/// since cached statements could report stale column metadata.
+{
+public:
+	typedef Poco::SharedPtr<StatementCache> Ptr;
+
+	explicit StatementCache(std::size_t capacity);
+		/// Creates the StatementCache, holding at most
+		/// capacity statements. A capacity of zero disables
+		/// the cache.
+
+	~StatementCache();
+		/// Finalizes all cached statements and destroys the StatementCache.
+
+	sqlite3_stmt* take(sqlite3* pDB, const std::string& sql, std::string& leftover);
+		/// Removes the statement prepared from the given SQL text
+		/// from the cache and returns it, together with the 
+		/// unprepared remainder of the SQL text.
+		///
+		/// Returns a null pointer if no such statement is cached.
+
+	void put(const std::string& sql, sqlite3_stmt* pStmt, const std::string& leftover);
+		/// Resets the statement and returns it to the cache.
+		/// Finalizes the statement if it can not be cached.
+
+	void setDB(sqlite3* pDB);
+		/// Clears the cache and sets the database connection.
+		/// Statements prepared on any other connection are
+		/// finalized, rather than cached, when returned.
+
+	void clear();
+		/// Finalizes all cached statements.
+
+	void setCapacity(std::size_t capacity);
+		/// Sets the maximum number of cached statements,
+		/// finalizing the least recently used ones, if necessary.
+
+	std::size_t getCapacity() const;
+		/// Returns the maximum number of cached statements.
+
+	std::size_t size() const;
+		/// Returns the number of cached statements.
+
+private:
+	struct Entry
+	{
+		std::string   sql;
+		sqlite3_stmt* pStmt;
+		std::string   leftover;
+	};
+	typedef std::list<Entry>                           EntryList;
+	typedef std::map<std::string, EntryList::iterator> EntryMap;
+
+	StatementCache();
+	StatementCache(const StatementCache&);
+	StatementCache& operator = (const StatementCache&);
+
+	void evict(std::size_t capacity);
+	static bool changesSchema(const std::string& sql);
+
+	sqlite3*                _pDB;
+	std::size_t             _capacity;
+	EntryList               _entries;
+	EntryMap                _index;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+} } } // namespace Poco::Data::SQLite
+
+
+#endif // Data_SQLite_StatementCache_INCLUDED
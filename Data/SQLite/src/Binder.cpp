@@ -38,6 +38,7 @@
 #include "Poco/Data/SQLite/Utility.h"
 #include "Poco/Data/Date.h"
 #include "Poco/Data/Time.h"
+#include "Poco/Data/DataException.h"
 #include "Poco/Exception.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
@@ -139,6 +140,411 @@ void Binder::bind(std::size_t pos, const NullData&, Direction)
 }
 
 
+void Binder::bind(std::size_t pos, const std::vector<Poco::Int8>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::Int8>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::Int8>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::UInt8>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::UInt8>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::UInt8>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::Int16>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::Int16>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::Int16>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::UInt16>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::UInt16>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::UInt16>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::Int32>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::Int32>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::Int32>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::UInt32>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::UInt32>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::UInt32>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::Int64>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::Int64>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::Int64>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Poco::UInt64>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Poco::UInt64>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Poco::UInt64>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+#ifndef POCO_LONG_IS_64_BIT
+void Binder::bind(std::size_t pos, const std::vector<long>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<long>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<long>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+#endif
+
+
+void Binder::bind(std::size_t pos, const std::vector<bool>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<bool>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<bool>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<float>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<float>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<float>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<double>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<double>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<double>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<char>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<char>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<char>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<std::string>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<std::string>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<std::string>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<BLOB>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<BLOB>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<BLOB>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<CLOB>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<CLOB>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<CLOB>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<DateTime>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<DateTime>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<DateTime>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Date>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Date>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Date>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<Time>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<Time>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<Time>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::vector<NullData>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::deque<NullData>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::bind(std::size_t pos, const std::list<NullData>& val, Direction)
+{
+	bindBulk(pos, val);
+}
+
+
+void Binder::reset()
+{
+	_bulkParameters.clear();
+}
+
+
+std::size_t Binder::bulkSize() const
+{
+	std::size_t size = 0;
+	bool found = false;
+	for (BulkParameterVec::const_iterator it = _bulkParameters.begin(); it != _bulkParameters.end(); ++it)
+	{
+		if (it->isNull()) continue;
+		if (!found)
+		{
+			size = (*it)->size();
+			found = true;
+		}
+		else if ((*it)->size() != size)
+			throw BindingException("Size mismatch in bulk bindings. All containers MUST have the same size");
+	}
+	return size;
+}
+
+
+void Binder::bindBulkRow(std::size_t row)
+{
+	for (BulkParameterVec::iterator it = _bulkParameters.begin(); it != _bulkParameters.end(); ++it)
+	{
+		if (!it->isNull()) (*it)->bind(*this, row);
+	}
+}
+
+
+void Binder::bindBulkValue(std::size_t pos, const std::string& val)
+{
+	// The container outlives the execution of the statement,
+	// so SQLite does not need to copy the string.
+	int rc = sqlite3_bind_text(_pStmt, (int) pos, val.data(), (int) val.size(), SQLITE_STATIC);
+	checkReturn(rc);
+}
+
+
 void Binder::checkReturn(int rc)
 {
 	if (rc != SQLITE_OK)
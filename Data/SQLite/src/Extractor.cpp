@@ -118,11 +118,24 @@ bool Extractor::extract(std::size_t pos, std::string& val)
 	if (!pBuf)
 		val.clear();
 	else
-		val = std::string(pBuf);
+		val.assign(pBuf, sqlite3_column_bytes(_pStmt, (int) pos));
 	return true;
 }
 
 
+const char* Extractor::stringData(std::size_t pos, std::size_t& length)
+{
+	const char *pBuf = reinterpret_cast<const char*>(sqlite3_column_text(_pStmt, (int) pos));
+	if (!pBuf)
+	{
+		length = 0;
+		return "";
+	}
+	length = sqlite3_column_bytes(_pStmt, (int) pos);
+	return pBuf;
+}
+
+
 bool Extractor::extract(std::size_t pos, Poco::Int8& val)
 {
 	if (isNull(pos)) return false;
@@ -242,8 +255,11 @@ bool Extractor::extract(std::size_t pos, Poco::DynamicAny& val)
 }
 
 
-bool Extractor::isNull(std::size_t pos, std::size_t)
+bool Extractor::isNull(std::size_t pos, std::size_t row)
 {
+	if (row != POCO_DATA_INVALID_ROW && pos < _bulkNulls.size() && row < _bulkNulls[pos].size())
+		return _bulkNulls[pos][row];
+
 	if (pos >= _nulls.size())
 		_nulls.resize(pos + 1);
 
@@ -257,4 +273,408 @@ bool Extractor::isNull(std::size_t pos, std::size_t)
 }
 
 
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int8>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int8>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int8>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt8>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt8>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt8>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int16>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int16>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int16>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt16>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt16>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt16>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int32>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int32>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int32>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt32>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt32>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt32>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Int64>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Int64>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Int64>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::UInt64>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::UInt64>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::UInt64>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+#ifndef POCO_LONG_IS_64_BIT
+bool Extractor::extract(std::size_t pos, std::vector<long>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<long>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<long>& val)
+{
+	return extractBulk(pos, val);
+}
+#endif
+
+
+bool Extractor::extract(std::size_t pos, std::vector<bool>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<bool>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<bool>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<float>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<float>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<float>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<double>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<double>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<double>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<char>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<char>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<char>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<std::string>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<std::string>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<std::string>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<BLOB>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<BLOB>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<BLOB>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<CLOB>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<CLOB>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<CLOB>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<DateTime>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<DateTime>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<DateTime>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Date>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Date>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Date>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Time>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Time>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Time>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Any>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Any>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Any>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::vector<Poco::Dynamic::Var>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::deque<Poco::Dynamic::Var>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+bool Extractor::extract(std::size_t pos, std::list<Poco::Dynamic::Var>& val)
+{
+	return extractBulk(pos, val);
+}
+
+
+void Extractor::extractBulkRow(std::size_t row)
+{
+	_nulls.clear();
+	if (_bulkNulls.size() < _bulkColumns.size())
+		_bulkNulls.resize(_bulkColumns.size());
+	for (std::size_t pos = 0; pos < _bulkColumns.size(); ++pos)
+	{
+		if (_bulkColumns[pos].isNull()) continue;
+		if (row == 0) _bulkNulls[pos].clear();
+		bool isNull = !_bulkColumns[pos]->extract(*this, pos, row);
+		_bulkNulls[pos].push_back(isNull);
+	}
+}
+
+
+void Extractor::finishBulk()
+{
+	for (BulkColumnVec::iterator it = _bulkColumns.begin(); it != _bulkColumns.end(); ++it)
+	{
+		if (!it->isNull()) (*it)->finish();
+	}
+}
+
+
 } } } // namespace Poco::Data::SQLite
@@ -55,10 +55,11 @@ namespace SQLite {
 const std::size_t SQLiteStatementImpl::POCO_SQLITE_INV_ROW_CNT = std::numeric_limits<std::size_t>::max();
 
 
-SQLiteStatementImpl::SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB):
+SQLiteStatementImpl::SQLiteStatementImpl(Poco::Data::SessionImpl& rSession, sqlite3* pDB, StatementCache::Ptr pCache):
 	StatementImpl(rSession),
 	_pDB(pDB),
 	_pStmt(0),
+	_pCache(pCache),
 	_stepCalled(false),
 	_nextResponse(0),
 	_affectedRowCount(POCO_SQLITE_INV_ROW_CNT),
@@ -91,11 +92,15 @@ void SQLiteStatementImpl::compileImpl()
 	if (0 == std::strlen(pSql))
 		throw InvalidSQLStatementException("Empty statements are illegal");
 
+	std::string sql(pSql);
+	std::string leftOver;
+	if (_pCache) pStmt = _pCache->take(_pDB, sql, leftOver);
+
 	int rc = SQLITE_OK;
 	const char* pLeftover = 0;
-	bool queryFound = false;
+	bool queryFound = pStmt != 0;
 
-	do
+	while (!queryFound)
 	{
 		rc = sqlite3_prepare_v2(_pDB, pSql, -1, &pStmt, &pLeftover);
 		if (rc != SQLITE_OK)
@@ -119,15 +124,20 @@ void SQLiteStatementImpl::compileImpl()
 				queryFound = true;
 			}
 		}
-	} while (rc == SQLITE_OK && !pStmt && !queryFound);
+	}
 
 	//Finalization call in clear() invalidates the pointer, so the value is remembered here.
 	//For last statement in a batch (or a single statement), pLeftover == "", so the next call
 	// to compileImpl() shall return false immediately when there are no more statements left.
-	std::string leftOver(pLeftover);
-	trimInPlace(leftOver);
+	if (pLeftover)
+	{
+		leftOver = pLeftover;
+		trimInPlace(leftOver);
+	}
 	clear();
 	_pStmt = pStmt;
+	_sql = sql;
+	_stmtLeftover = leftOver;
 	if (!leftOver.empty())
 	{
 		_pLeftover = new std::string(leftOver);
@@ -232,7 +242,10 @@ void SQLiteStatementImpl::clear()
 
 	if (_pStmt)
 	{
-		sqlite3_finalize(_pStmt);
+		if (_pCache)
+			_pCache->put(_sql, _pStmt, _stmtLeftover);
+		else
+			sqlite3_finalize(_pStmt);
 		_pStmt=0;
 	}
 	_pLeftover = 0;
@@ -253,11 +266,17 @@ bool SQLiteStatementImpl::hasNext()
 	}
 
 	_stepCalled = true;
-	_nextResponse = sqlite3_step(_pStmt);
-
 	if (_affectedRowCount == POCO_SQLITE_INV_ROW_CNT) _affectedRowCount = 0;
-	if (!sqlite3_stmt_readonly(_pStmt))
-		_affectedRowCount += sqlite3_changes(_pDB);
+	if (_pBinder->bulkSize() > 0)
+	{
+		_nextResponse = stepBulk();
+	}
+	else
+	{
+		_nextResponse = sqlite3_step(_pStmt);
+		if (!sqlite3_stmt_readonly(_pStmt))
+			_affectedRowCount += sqlite3_changes(_pDB);
+	}
 
 	if (_nextResponse != SQLITE_ROW && _nextResponse != SQLITE_OK && _nextResponse != SQLITE_DONE)
 		Utility::throwException(_nextResponse);
@@ -275,15 +294,9 @@ std::size_t SQLiteStatementImpl::next()
 		poco_assert (columnsReturned() == sqlite3_column_count(_pStmt));
 
 		Extractions& extracts = extractions();
-		Extractions::iterator it    = extracts.begin();
-		Extractions::iterator itEnd = extracts.end();
-		std::size_t pos = 0; // sqlite starts with pos 0 for results!
-		for (; it != itEnd; ++it)
-		{
-			(*it)->extract(pos);
-			pos += (*it)->numOfColumnsHandled();
-			_isExtracted = true;
-		}
+		if (!extracts.empty() && extracts.front()->isBulk()) return nextBulk();
+
+		extractAll();
 		_stepCalled = false;
 		if (_affectedRowCount == POCO_SQLITE_INV_ROW_CNT) _affectedRowCount = 0;
 		_affectedRowCount += (*extracts.begin())->numOfRowsHandled();
@@ -301,6 +314,72 @@ std::size_t SQLiteStatementImpl::next()
 }
 
 
+int SQLiteStatementImpl::stepBulk()
+{
+	if (sqlite3_column_count(_pStmt) > 0)
+		throw InvalidAccessException("Bulk binding is only supported for statements that do not return data.");
+
+	bool readOnly = sqlite3_stmt_readonly(_pStmt) != 0;
+	std::size_t rows = _pBinder->bulkSize();
+	for (std::size_t row = 0; row < rows; ++row)
+	{
+		if (row > 0) sqlite3_reset(_pStmt);
+		_pBinder->bindBulkRow(row);
+		int rc = sqlite3_step(_pStmt);
+		if (rc != SQLITE_DONE) return rc;
+		if (!readOnly) _affectedRowCount += sqlite3_changes(_pDB);
+	}
+	return SQLITE_DONE;
+}
+
+
+std::size_t SQLiteStatementImpl::nextBulk()
+{
+	// The first call only registers the containers
+	// of the extractions with the extractor.
+	if (!_pExtractor->hasBulkColumns()) extractAll();
+
+	std::size_t limit = getExtractionLimit();
+	std::size_t rows = 0;
+	do
+	{
+		_pExtractor->extractBulkRow(rows++);
+		_nextResponse = sqlite3_step(_pStmt);
+	}
+	while (rows < limit && SQLITE_ROW == _nextResponse);
+	_pExtractor->finishBulk();
+	_pExtractor->reset();
+
+	// The statement has already been stepped to the
+	// first row of the next bulk, if there is one.
+	_stepCalled = true;
+	if (_nextResponse != SQLITE_ROW && _nextResponse != SQLITE_DONE)
+		Utility::throwException(_nextResponse);
+
+	// Let the extractions pick up the null indicators.
+	extractAll();
+
+	if (_affectedRowCount == POCO_SQLITE_INV_ROW_CNT) _affectedRowCount = 0;
+	_affectedRowCount += rows;
+	return rows;
+}
+
+
+void SQLiteStatementImpl::extractAll()
+{
+	Extractions& extracts = extractions();
+	Extractions::iterator it    = extracts.begin();
+	Extractions::iterator itEnd = extracts.end();
+	std::size_t pos = 0; // sqlite starts with pos 0 for results!
+	for (; it != itEnd; ++it)
+	{
+		(*it)->extract(pos);
+		pos += (*it)->numOfColumnsHandled();
+		_isExtracted = true;
+	}
+}
+
+
 std::size_t SQLiteStatementImpl::columnsReturned() const
 {
 	return (std::size_t) _columns[currentDataSet()].size();
@@ -56,21 +56,27 @@ namespace SQLite {
 const std::string SessionImpl::DEFERRED_BEGIN_TRANSACTION("BEGIN DEFERRED");
 const std::string SessionImpl::COMMIT_TRANSACTION("COMMIT");
 const std::string SessionImpl::ABORT_TRANSACTION("ROLLBACK");
+const std::size_t SessionImpl::STATEMENT_CACHE_SIZE_DEFAULT;
 
 
 SessionImpl::SessionImpl(const std::string& fileName, std::size_t loginTimeout):
 	Poco::Data::AbstractSessionImpl<SessionImpl>(fileName, loginTimeout),
 	_connector(Connector::KEY),
+	_pCache(new StatementCache(STATEMENT_CACHE_SIZE_DEFAULT)),
 	_pDB(0),
 	_connected(false),
 	_isTransaction(false)
 {
+	setFeature("bulk", true);
 	open();
 	setConnectionTimeout(CONNECTION_TIMEOUT_DEFAULT);
 	setProperty("handle", _pDB);
 	addFeature("autoCommit", 
 		&SessionImpl::autoCommit, 
 		&SessionImpl::isAutoCommit);
+	addProperty("maxStatementCacheSize",
+		&SessionImpl::setMaxStatementCacheSize,
+		&SessionImpl::getMaxStatementCacheSize);
 }
 
 
@@ -83,14 +89,14 @@ SessionImpl::~SessionImpl()
 Poco::Data::StatementImpl* SessionImpl::createStatementImpl()
 {
 	poco_check_ptr (_pDB);
-	return new SQLiteStatementImpl(*this, _pDB);
+	return new SQLiteStatementImpl(*this, _pDB, _pCache);
 }
 
 
 void SessionImpl::begin()
 {
 	Poco::Mutex::ScopedLock l(_mutex);
-	SQLiteStatementImpl tmp(*this, _pDB);
+	SQLiteStatementImpl tmp(*this, _pDB, _pCache);
 	tmp.add(DEFERRED_BEGIN_TRANSACTION);
 	tmp.execute();
 	_isTransaction = true;
@@ -100,7 +106,7 @@ void SessionImpl::begin()
 void SessionImpl::commit()
 {
 	Poco::Mutex::ScopedLock l(_mutex);
-	SQLiteStatementImpl tmp(*this, _pDB);
+	SQLiteStatementImpl tmp(*this, _pDB, _pCache);
 	tmp.add(COMMIT_TRANSACTION);
 	tmp.execute();
 	_isTransaction = false;
@@ -110,7 +116,7 @@ void SessionImpl::commit()
 void SessionImpl::rollback()
 {
 	Poco::Mutex::ScopedLock l(_mutex);
-	SQLiteStatementImpl tmp(*this, _pDB);
+	SQLiteStatementImpl tmp(*this, _pDB, _pCache);
 	tmp.add(ABORT_TRANSACTION);
 	tmp.execute();
 	_isTransaction = false;
@@ -201,12 +207,14 @@ void SessionImpl::open(const std::string& connect)
 		throw ConnectionFailedException(ex.displayText());
 	}
 
+	_pCache->setDB(_pDB);
 	_connected = true;
 }
 
 
 void SessionImpl::close()
 {
+	_pCache->setDB(0);
 	if (_pDB)
 	{
 		sqlite3_close(_pDB);
@@ -242,6 +250,18 @@ void SessionImpl::autoCommit(const std::string&, bool)
 }
 
 
+void SessionImpl::setMaxStatementCacheSize(const std::string&, const Poco::Any& value)
+{
+	_pCache->setCapacity(Poco::AnyCast<std::size_t>(value));
+}
+
+
+Poco::Any SessionImpl::getMaxStatementCacheSize(const std::string&)
+{
+	return _pCache->getCapacity();
+}
+
+
 bool SessionImpl::isAutoCommit(const std::string&)
 {
 	Poco::Mutex::ScopedLock l(_mutex);
@@ -0,0 +1,190 @@
+//
+// StatementCache.cpp
+//
+// $Id: //poco/Main/Data/SQLite/src/StatementCache.cpp#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  StatementCache
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/SQLite/StatementCache.h"
+#include "Poco/String.h"
+#include "Poco/Ascii.h"
+#if defined(POCO_UNBUNDLED)
+#include <sqlite3.h>
+#else
+#include "sqlite3.h"
+#endif
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+StatementCache::StatementCache(std::size_t capacity):
+	_pDB(0),
+	_capacity(capacity)
+{
+}
+
+
+StatementCache::~StatementCache()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+sqlite3_stmt* StatementCache::take(sqlite3* pDB, const std::string& sql, std::string& leftover)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (pDB != _pDB) return 0;
+
+	EntryMap::iterator it = _index.find(sql);
+	if (it == _index.end()) return 0;
+
+	sqlite3_stmt* pStmt = it->second->pStmt;
+	leftover = it->second->leftover;
+	_entries.erase(it->second);
+	_index.erase(it);
+	return pStmt;
+}
+
+
+void StatementCache::put(const std::string& sql, sqlite3_stmt* pStmt, const std::string& leftover)
+{
+	if (!pStmt) return;
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (changesSchema(sql))
+	{
+		sqlite3_finalize(pStmt);
+		evict(0);
+		return;
+	}
+
+	if (0 == _capacity || 
+		sqlite3_db_handle(pStmt) != _pDB ||
+		_index.find(sql) != _index.end())
+	{
+		sqlite3_finalize(pStmt);
+		return;
+	}
+
+	sqlite3_reset(pStmt);
+	sqlite3_clear_bindings(pStmt);
+
+	Entry entry;
+	entry.sql = sql;
+	entry.pStmt = pStmt;
+	entry.leftover = leftover;
+	_entries.push_front(entry);
+	_index[sql] = _entries.begin();
+	evict(_capacity);
+}
+
+
+void StatementCache::setDB(sqlite3* pDB)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	evict(0);
+	_pDB = pDB;
+}
+
+
+void StatementCache::clear()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	evict(0);
+}
+
+
+void StatementCache::setCapacity(std::size_t capacity)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_capacity = capacity;
+	evict(_capacity);
+}
+
+
+std::size_t StatementCache::getCapacity() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _capacity;
+}
+
+
+std::size_t StatementCache::size() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _entries.size();
+}
+
+
+void StatementCache::evict(std::size_t capacity)
+{
+	while (_entries.size() > capacity)
+	{
+		sqlite3_finalize(_entries.back().pStmt);
+		_index.erase(_entries.back().sql);
+		_entries.pop_back();
+	}
+}
+
+
+bool StatementCache::changesSchema(const std::string& sql)
+{
+	std::string::const_iterator it  = sql.begin();
+	std::string::const_iterator end = sql.end();
+	while (it != end && Poco::Ascii::isSpace(*it)) ++it;
+	std::string::const_iterator begin = it;
+	while (it != end && Poco::Ascii::isAlpha(*it)) ++it;
+	std::string keyword(begin, it);
+
+	return 0 == icompare(keyword, "CREATE") ||
+		0 == icompare(keyword, "DROP") ||
+		0 == icompare(keyword, "ALTER");
+}
+
+
+} } } // namespace Poco::Data::SQLite
@@ -37,12 +37,17 @@
 #include "Poco/Data/Time.h"
 #include "Poco/Data/LOB.h"
 #include "Poco/Data/Statement.h"
+#include "Poco/Data/BulkBinding.h"
 #include "Poco/Data/RecordSet.h"
+#include "Poco/Data/ColumnarRecordSet.h"
+#include "Poco/Data/PipelinedExecution.h"
 #include "Poco/Data/SQLChannel.h"
 #include "Poco/Data/SessionFactory.h"
 #include "Poco/Data/SQLite/Connector.h"
 #include "Poco/Data/SQLite/Utility.h"
 #include "Poco/Data/SQLite/Notifier.h"
+#include "Poco/Data/SQLite/SessionImpl.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Dynamic/Var.h"
 #include "Poco/Data/TypeHandler.h"
 #include "Poco/Nullable.h"
@@ -69,6 +74,9 @@ using namespace Poco::Data::Keywords;
 using Poco::Data::Session;
 using Poco::Data::Statement;
 using Poco::Data::RecordSet;
+using Poco::Data::ColumnarRecordSet;
+using Poco::Data::ColumnarColumn;
+using Poco::Data::PipelinedExecution;
 using Poco::Data::Column;
 using Poco::Data::Row;
 using Poco::Data::SQLChannel;
@@ -81,7 +89,9 @@ using Poco::Data::AbstractExtractionVec;
 using Poco::Data::AbstractExtractionVecVec;
 using Poco::Data::AbstractBindingVec;
 using Poco::Data::NotConnectedException;
+using Poco::Data::BindingException;
 using Poco::Data::SQLite::Notifier;
+using Poco::Data::SQLite::StatementCache;
 using Poco::Nullable;
 using Poco::Tuple;
 using Poco::Any;
@@ -767,6 +777,123 @@ void SQLiteTest::testInsertSingleBulkVec()
 }
 
 
+void SQLiteTest::testBulkInsert()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Bulk", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Bulk (str VARCHAR(30), i INTEGER, f REAL)", now;
+
+	const int size = 1000;
+	std::vector<std::string> strings;
+	std::deque<int> ints;
+	std::list<double> doubles;
+	for (int x = 0; x < size; ++x)
+	{
+		strings.push_back(format("str%d", x));
+		ints.push_back(x);
+		doubles.push_back(x + 0.5);
+	}
+
+	Statement stmt((tmp << "INSERT INTO Bulk VALUES(?, ?, ?)", use(strings, bulk), use(ints, bulk), use(doubles, bulk)));
+	assert (size == stmt.execute());
+
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM Bulk", into(count), now;
+	assert (count == size);
+	tmp << "SELECT SUM(i) FROM Bulk", into(count), now;
+	assert (count == ((0 + size - 1) * size / 2));
+	std::string str;
+	double f = 0;
+	tmp << "SELECT str, f FROM Bulk WHERE i = 123", into(str), into(f), now;
+	assert (str == "str123");
+	assert (f == 123.5);
+
+	// the statement can be executed again with new values
+	for (int x = 0; x < size; ++x) ints[x] = x + size;
+	assert (size == stmt.execute());
+	tmp << "SELECT COUNT(*) FROM Bulk", into(count), now;
+	assert (count == 2 * size);
+
+	std::vector<int> keys(2, 1);
+	try
+	{
+		tmp << "SELECT i FROM Bulk WHERE i = ?", use(keys, bulk), now;
+		fail ("bulk binding of a query must fail");
+	}
+	catch (InvalidAccessException&)
+	{
+	}
+
+	ints.pop_back();
+	try
+	{
+		stmt.execute();
+		fail ("bulk binding of containers of different size must fail");
+	}
+	catch (BindingException&)
+	{
+	}
+	tmp << "SELECT COUNT(*) FROM Bulk", into(count), now;
+	assert (count == 2 * size);
+}
+
+
+void SQLiteTest::testBulkExtraction()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Bulk", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Bulk (str VARCHAR(30), i INTEGER, f REAL)", now;
+
+	const int size = 1000;
+	std::vector<std::string> strings;
+	std::vector<int> ints;
+	std::vector<double> doubles;
+	for (int x = 0; x < size; ++x)
+	{
+		strings.push_back(format("str%d", x));
+		ints.push_back(x);
+		doubles.push_back(x + 0.5);
+	}
+	tmp << "INSERT INTO Bulk VALUES(?, ?, ?)", use(strings, bulk), use(ints, bulk), use(doubles, bulk), now;
+	tmp << "UPDATE Bulk SET str = NULL WHERE i % 10 = 0", now;
+
+	std::deque<std::string> rStrings;
+	std::vector<int> rInts;
+	std::list<double> rDoubles;
+	Statement stmt((tmp << "SELECT str, i, f FROM Bulk ORDER BY i", 
+		into(rStrings, bulk(300)), 
+		into(rInts, bulk(300)), 
+		into(rDoubles, bulk(300))));
+
+	std::size_t total = 0;
+	int batches = 0;
+	while (!stmt.done())
+	{
+		std::size_t n = stmt.execute();
+		assert (n == (total + 300 <= size ? 300 : size - total));
+		assert (rStrings.size() == n);
+		assert (rInts.size() == n);
+		assert (rDoubles.size() == n);
+
+		std::list<double>::const_iterator dIt = rDoubles.begin();
+		for (std::size_t row = 0; row < n; ++row, ++dIt)
+		{
+			int x = static_cast<int>(total + row);
+			assert (rInts[row] == x);
+			assert (*dIt == x + 0.5);
+			if (x % 10 == 0)
+				assert (rStrings[row].empty());
+			else
+				assert (rStrings[row] == format("str%d", x));
+		}
+		total += n;
+		++batches;
+	}
+	assert (total == size);
+	assert (batches == 4);
+}
+
+
 void SQLiteTest::testLimit()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -2148,6 +2275,254 @@ void SQLiteTest::testRowIterator()
 }
 
 
+void SQLiteTest::testColumnarRecordSet()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Columnar", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Columnar (str VARCHAR(30), i INTEGER, f REAL, b BOOLEAN)", now;
+
+	const int size = 100;
+	std::vector<std::string> strings;
+	std::vector<int> ints;
+	std::vector<double> doubles;
+	for (int x = 0; x < size; ++x)
+	{
+		strings.push_back(format("str%d", x));
+		ints.push_back(x);
+		doubles.push_back(x + 0.5);
+	}
+	tmp << "INSERT INTO Columnar VALUES(?, ?, ?, 0)", use(strings, bulk), use(ints, bulk), use(doubles, bulk), now;
+	tmp << "UPDATE Columnar SET str = NULL WHERE i % 10 = 0", now;
+	tmp << "UPDATE Columnar SET b = 1 WHERE i % 2 = 1", now;
+
+	ColumnarRecordSet rs(tmp, "SELECT str, i, f, b FROM Columnar ORDER BY i");
+	assert (rs.rowCount() == size);
+	assert (rs.columnCount() == 4);
+	assert (rs.column(1).name() == "i");
+
+	const ColumnarColumn<std::string>& str = rs.column<std::string>(0);
+	const ColumnarColumn<Poco::Int32>& i = rs.column<Poco::Int32>("i");
+	const ColumnarColumn<double>& f = rs.column<double>(2);
+	const ColumnarColumn<bool>& b = rs.column<bool>(3);
+	assert (str.nullCount() == size / 10);
+	assert (i.nullCount() == 0);
+
+	const Poco::Int32* pInts = i.data();
+	const double* pDoubles = f.data();
+	for (int x = 0; x < size; ++x)
+	{
+		assert (pInts[x] == x);
+		assert (pDoubles[x] == x + 0.5);
+		assert (b[x] == (x % 2 == 1));
+		if (x % 10 == 0)
+		{
+			assert (str.isNull(x));
+			assert (str.length(x) == 0);
+		}
+		else
+		{
+			assert (!str.isNull(x));
+			assert (std::string(str.data(x), str.length(x)) == format("str%d", x));
+		}
+	}
+	assert (str.arena() == str.data(1));
+	assert (str.offsets()[size] == str.arenaSize());
+
+	ColumnarRecordSet::Cursor cursor = rs.cursor();
+	int count = 0;
+	if (cursor.moveFirst())
+	{
+		do
+		{
+			assert (cursor.get<Poco::Int32>(1) == count);
+			assert (cursor.isNull(0) == (count % 10 == 0));
+			if (!cursor.isNull(0))
+				assert (cursor.get<std::string>("str") == format("str%d", count));
+			++count;
+		}
+		while (cursor.moveNext());
+	}
+	assert (count == size);
+	assert (cursor.row() == size - 1);
+
+	try
+	{
+		rs.column<std::string>(1);
+		fail ("must fail");
+	}
+	catch (Poco::BadCastException&) { }
+
+	try
+	{
+		rs.column(4);
+		fail ("must fail");
+	}
+	catch (Poco::RangeException&) { }
+
+	Statement stmt = (tmp << "SELECT i FROM Columnar ORDER BY i", columnar, limit(30));
+	stmt.execute();
+	ColumnarRecordSet batch(stmt);
+	std::size_t total = 0;
+	while (true)
+	{
+		const ColumnarColumn<Poco::Int32>& col = batch.column<Poco::Int32>(0);
+		assert (batch.rowCount() == (total + 30 <= size ? 30 : size - total));
+		for (std::size_t row = 0; row < col.rowCount(); ++row)
+			assert (col[row] == static_cast<Poco::Int32>(total + row));
+		total += batch.rowCount();
+		if (stmt.done()) break;
+		stmt.execute();
+	}
+	assert (total == size);
+}
+
+
+void SQLiteTest::testStatementCache()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	assert (AnyCast<std::size_t>(tmp.getProperty("maxStatementCacheSize")) == 
+		Poco::Data::SQLite::SessionImpl::STATEMENT_CACHE_SIZE_DEFAULT);
+	StatementCache& cache = dynamic_cast<Poco::Data::SQLite::SessionImpl*>(tmp.impl())->statementCache();
+
+	tmp << "DROP TABLE IF EXISTS Cached", now;
+	tmp << "CREATE TABLE Cached (i INTEGER)", now;
+	assert (cache.size() == 0);
+
+	for (int x = 0; x < 10; ++x)
+		tmp << "INSERT INTO Cached VALUES(?)", use(x), now;
+	assert (cache.size() == 1);
+
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM Cached", into(count), now;
+	assert (count == 10);
+	assert (cache.size() == 2);
+
+	{
+		int count1 = 0;
+		int count2 = 0;
+		Statement stmt1 = (tmp << "SELECT COUNT(*) FROM Cached", into(count1));
+		Statement stmt2 = (tmp << "SELECT COUNT(*) FROM Cached", into(count2));
+		stmt1.execute();
+		assert (cache.size() == 1);
+		stmt2.execute();
+		assert (count1 == 10);
+		assert (count2 == 10);
+	}
+	assert (cache.size() == 2);
+
+	{
+		RecordSet rs(tmp, "SELECT * FROM Cached");
+		assert (rs.columnCount() == 1);
+	}
+	assert (cache.size() == 3);
+
+	tmp << "DROP TABLE Cached", now;
+	assert (cache.size() == 0);
+	tmp << "CREATE TABLE Cached (i INTEGER, str VARCHAR)", now;
+	tmp << "INSERT INTO Cached VALUES(1, 'a')", now;
+	{
+		RecordSet rs(tmp, "SELECT * FROM Cached");
+		assert (rs.columnCount() == 2);
+		assert (rs.value(1, 0) == "a");
+	}
+
+	tmp.setProperty("maxStatementCacheSize", std::size_t(1));
+	assert (cache.size() == 1);
+	tmp << "SELECT COUNT(*) FROM Cached", into(count), now;
+	assert (count == 1);
+	assert (cache.size() == 1);
+
+	tmp.setProperty("maxStatementCacheSize", std::size_t(0));
+	assert (cache.size() == 0);
+	tmp << "SELECT COUNT(*) FROM Cached", into(count), now;
+	assert (count == 1);
+	assert (cache.size() == 0);
+}
+
+
+class BatchSum
+{
+public:
+	BatchSum(int& sum): _sum(sum)
+	{
+	}
+
+	void operator () (const std::vector<int>& batch)
+	{
+		for (std::vector<int>::const_iterator it = batch.begin(); it != batch.end(); ++it)
+			_sum += *it;
+	}
+
+private:
+	int& _sum;
+};
+
+
+void SQLiteTest::testPipelinedExecution()
+{
+	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Pipelined", now;
+	tmp << "CREATE TABLE IF NOT EXISTS Pipelined (i INTEGER)", now;
+
+	const int size = 1000;
+	std::vector<int> ints;
+	for (int x = 0; x < size; ++x) ints.push_back(x);
+	tmp << "INSERT INTO Pipelined VALUES(?)", use(ints), now;
+
+	std::vector<int> result;
+	{
+		Statement stmt = (tmp << "SELECT i FROM Pipelined ORDER BY i", into(result), limit(100));
+		PipelinedExecution<std::vector<int> > exec(stmt, result, 2);
+		std::vector<int> batch;
+		int expected = 0;
+		int batches = 0;
+		while (exec.next(batch))
+		{
+			assert (batch.size() == 100);
+			for (std::vector<int>::const_iterator it = batch.begin(); it != batch.end(); ++it)
+				assert (*it == expected++);
+			++batches;
+		}
+		assert (expected == size);
+		assert (batches == 10);
+		assert (exec.rowsFetched() == size);
+		assert (exec.batchesFetched() == 10);
+		assert (!exec.next(batch));
+	}
+
+	{
+		Statement stmt = (tmp << "SELECT i FROM Pipelined", into(result), limit(300));
+		PipelinedExecution<std::vector<int> > exec(stmt, result);
+		int sum = 0;
+		assert (exec.forEach(BatchSum(sum)) == size);
+		assert (sum == size * (size - 1) / 2);
+	}
+
+	{
+		Statement stmt = (tmp << "SELECT i FROM Pipelined", into(result), limit(10));
+		PipelinedExecution<std::vector<int> > exec(stmt, result, 1);
+		std::vector<int> batch;
+		assert (exec.next(batch));
+		assert (batch.size() == 10);
+		exec.cancel();
+		while (exec.next(batch));
+		assert (exec.rowsFetched() < size);
+	}
+
+	{
+		Statement stmt = (tmp << "SELECT i FROM NoSuchTable", into(result), limit(10));
+		PipelinedExecution<std::vector<int> > exec(stmt, result);
+		std::vector<int> batch;
+		try
+		{
+			exec.next(batch);
+			fail ("must fail");
+		}
+		catch (Poco::Exception&) { }
+	}
+}
+
+
 void SQLiteTest::testAsync()
 {
 	Session tmp (Poco::Data::SQLite::Connector::KEY, "dummy.db");
@@ -3316,6 +3691,8 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testAffectedRows);
 	CppUnit_addTest(pSuite, SQLiteTest, testInsertSingleBulk);
 	CppUnit_addTest(pSuite, SQLiteTest, testInsertSingleBulkVec);
+	CppUnit_addTest(pSuite, SQLiteTest, testBulkInsert);
+	CppUnit_addTest(pSuite, SQLiteTest, testBulkExtraction);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimit);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimitOnce);
 	CppUnit_addTest(pSuite, SQLiteTest, testLimitPrepare);
@@ -3367,6 +3744,9 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testNullable);
 	CppUnit_addTest(pSuite, SQLiteTest, testNull);
 	CppUnit_addTest(pSuite, SQLiteTest, testRowIterator);
+	CppUnit_addTest(pSuite, SQLiteTest, testColumnarRecordSet);
+	CppUnit_addTest(pSuite, SQLiteTest, testStatementCache);
+	CppUnit_addTest(pSuite, SQLiteTest, testPipelinedExecution);
 	CppUnit_addTest(pSuite, SQLiteTest, testAsync);
 	CppUnit_addTest(pSuite, SQLiteTest, testAny);
 	CppUnit_addTest(pSuite, SQLiteTest, testDynamicAny);
@@ -69,6 +69,8 @@ public:
 	void testAffectedRows();
 	void testInsertSingleBulk();
 	void testInsertSingleBulkVec();
+	void testBulkInsert();
+	void testBulkExtraction();
 
 	void testLimit();
 	void testLimitOnce();
@@ -126,6 +128,9 @@ public:
 	void testNullable();
 	void testNull();
 	void testRowIterator();
+	void testColumnarRecordSet();
+	void testStatementCache();
+	void testPipelinedExecution();
 	void testAsync();
 
 	void testAny();
@@ -340,6 +340,17 @@ public:
 	virtual bool isNull(std::size_t col, std::size_t row = POCO_DATA_INVALID_ROW) = 0;
 		/// Returns true if the value at [col,row] position is null.
 
+	virtual const char* stringData(std::size_t pos, std::size_t& length);
+		/// Gives direct access to the characters of the non-null
+		/// string value at the given position, without copying them
+		/// into a std::string. Returns a pointer to the characters,
+		/// which is valid until the next row is fetched, and stores
+		/// their number in length.
+		///
+		/// Returns a null pointer if the extractor does not support
+		/// direct access, in which case extract() must be used.
+		/// The default implementation always returns a null pointer.
+
 	virtual void reset();
 		/// Resets any information internally cached by the extractor.
 };
@@ -348,6 +359,12 @@ public:
 ///
 /// inlines
 ///
+inline const char* AbstractExtractor::stringData(std::size_t pos, std::size_t& length)
+{
+	return 0;
+}
+
+
 inline void AbstractExtractor::reset()
 {
 	//default no-op
@@ -118,6 +118,7 @@ public:
 	{
 		AbstractExtractor::Ptr pExt = getExtractor();
 		TypeHandler<C>::extract(col, _rResult, _default, pExt);
+		_nulls.clear();
 		typename C::iterator it = _rResult.begin();
 		typename C::iterator end = _rResult.end();
 		for (int row = 0; it !=end; ++it, ++row)
@@ -0,0 +1,585 @@
+//
+// ColumnarColumn.h
+//
+// $Id: //poco/Main/Data/include/Poco/Data/ColumnarColumn.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  ColumnarColumn
+//
+// Definition of the ColumnarColumn class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_ColumnarColumn_INCLUDED
+#define Data_ColumnarColumn_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/Data/MetaColumn.h"
+#include "Poco/Data/AbstractExtraction.h"
+#include "Poco/Data/Preparation.h"
+#include "Poco/Data/TypeHandler.h"
+#include "Poco/Data/Position.h"
+#include "Poco/Data/DataException.h"
+#include "Poco/Exception.h"
+#include "Poco/Types.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+namespace Data {
+
+
+class Data_API AbstractColumnarColumn
+	/// AbstractColumnarColumn is the type independent part of a
+	/// column of a ColumnarRecordSet. It holds the column metadata
+	/// and the null indicators of the column, packed into a bitmap
+	/// with one bit per row.
+{
+public:
+	AbstractColumnarColumn(const MetaColumn& metaColumn);
+		/// Creates the AbstractColumnarColumn.
+
+	virtual ~AbstractColumnarColumn();
+		/// Destroys the AbstractColumnarColumn.
+
+	const MetaColumn& metaColumn() const;
+		/// Returns the column metadata.
+
+	const std::string& name() const;
+		/// Returns the column name.
+
+	MetaColumn::ColumnDataType type() const;
+		/// Returns the column type.
+
+	std::size_t position() const;
+		/// Returns the column position.
+
+	std::size_t rowCount() const;
+		/// Returns the number of rows in the column.
+
+	bool isNull(std::size_t row) const;
+		/// Returns true if the value in the given row is null.
+		/// Throws RangeException if the row does not exist.
+
+	std::size_t nullCount() const;
+		/// Returns the number of null values in the column.
+		/// Scans over columns without nulls can skip
+		/// the null checks altogether.
+
+	const Poco::UInt8* nullBitmap() const;
+		/// Returns the null bitmap, or a null pointer for an empty
+		/// column. Bit (row % 8) of byte (row / 8) is set if the value
+		/// in the row is null.
+
+	virtual void reserve(std::size_t rows);
+		/// Reserves storage for the given number of rows.
+
+	virtual void reset();
+		/// Removes all rows from the column.
+
+protected:
+	void appendRow(bool isNull);
+		/// Must be called by subclasses for every appended value.
+
+	void checkRow(std::size_t row) const;
+		/// Throws RangeException if the row does not exist.
+
+private:
+	AbstractColumnarColumn();
+	AbstractColumnarColumn(const AbstractColumnarColumn&);
+	AbstractColumnarColumn& operator = (const AbstractColumnarColumn&);
+
+	MetaColumn               _metaColumn;
+	std::vector<Poco::UInt8> _nulls;
+	std::size_t              _rowCount;
+	std::size_t              _nullCount;
+};
+
+
+template <class T>
+class ColumnarColumn: public AbstractColumnarColumn
+	/// ColumnarColumn stores the values of a result column
+	/// in a single contiguous array.
+	///
+	/// Null values are stored as default-constructed values;
+	/// use isNull() to distinguish them.
+{
+public:
+	typedef T              Type;
+	typedef const T&       ValueType;
+	typedef std::vector<T> Container;
+
+	explicit ColumnarColumn(const MetaColumn& metaColumn):
+		AbstractColumnarColumn(metaColumn)
+		/// Creates the ColumnarColumn.
+	{
+	}
+
+	~ColumnarColumn()
+		/// Destroys the ColumnarColumn.
+	{
+	}
+
+	void append(const T& value, bool isNull)
+		/// Appends a value to the column.
+	{
+		_values.push_back(value);
+		appendRow(isNull);
+	}
+
+	ValueType value(std::size_t row) const
+		/// Returns the value in the given row.
+		/// Throws RangeException if the row does not exist.
+	{
+		checkRow(row);
+		return _values[row];
+	}
+
+	ValueType operator [] (std::size_t row) const
+		/// Returns the value in the given row.
+	{
+		return value(row);
+	}
+
+	const T* data() const
+		/// Returns a pointer to the first of rowCount() consecutive
+		/// values, or a null pointer for an empty column.
+	{
+		return _values.empty() ? 0 : &_values[0];
+	}
+
+	void reserve(std::size_t rows)
+	{
+		AbstractColumnarColumn::reserve(rows);
+		_values.reserve(rows);
+	}
+
+	void reset()
+	{
+		AbstractColumnarColumn::reset();
+		_values.clear();
+	}
+
+private:
+	Container _values;
+};
+
+
+template <>
+class ColumnarColumn<bool>: public AbstractColumnarColumn
+	/// ColumnarColumn specialization for bool.
+	///
+	/// Values are stored as one byte per row,
+	/// since std::vector<bool> is not contiguous.
+{
+public:
+	typedef bool                     Type;
+	typedef bool                     ValueType;
+	typedef std::vector<Poco::UInt8> Container;
+
+	explicit ColumnarColumn(const MetaColumn& metaColumn):
+		AbstractColumnarColumn(metaColumn)
+		/// Creates the ColumnarColumn.
+	{
+	}
+
+	~ColumnarColumn()
+		/// Destroys the ColumnarColumn.
+	{
+	}
+
+	void append(bool value, bool isNull)
+		/// Appends a value to the column.
+	{
+		_values.push_back(value ? 1 : 0);
+		appendRow(isNull);
+	}
+
+	ValueType value(std::size_t row) const
+		/// Returns the value in the given row.
+		/// Throws RangeException if the row does not exist.
+	{
+		checkRow(row);
+		return _values[row] != 0;
+	}
+
+	ValueType operator [] (std::size_t row) const
+		/// Returns the value in the given row.
+	{
+		return value(row);
+	}
+
+	const Poco::UInt8* data() const
+		/// Returns a pointer to the first of rowCount() consecutive
+		/// values (0 or 1), or a null pointer for an empty column.
+	{
+		return _values.empty() ? 0 : &_values[0];
+	}
+
+	void reserve(std::size_t rows)
+	{
+		AbstractColumnarColumn::reserve(rows);
+		_values.reserve(rows);
+	}
+
+	void reset()
+	{
+		AbstractColumnarColumn::reset();
+		_values.clear();
+	}
+
+private:
+	Container _values;
+};
+
+
+template <>
+class ColumnarColumn<std::string>: public AbstractColumnarColumn
+	/// ColumnarColumn specialization for std::string.
+	///
+	/// The characters of all values are stored back to back in a
+	/// single arena. The value in row n occupies the range
+	/// [offsets()[n], offsets()[n + 1]) of the arena, so
+	/// data() and length() give access to the value without
+	/// creating a std::string.
+{
+public:
+	typedef std::string              Type;
+	typedef std::string              ValueType;
+	typedef std::vector<char>        Container;
+	typedef std::vector<std::size_t> OffsetContainer;
+
+	explicit ColumnarColumn(const MetaColumn& metaColumn):
+		AbstractColumnarColumn(metaColumn),
+		_offsets(1, 0)
+		/// Creates the ColumnarColumn.
+	{
+	}
+
+	~ColumnarColumn()
+		/// Destroys the ColumnarColumn.
+	{
+	}
+
+	void append(const char* pData, std::size_t length, bool isNull)
+		/// Appends a value to the column.
+	{
+		if (length > 0) _arena.insert(_arena.end(), pData, pData + length);
+		_offsets.push_back(_arena.size());
+		appendRow(isNull);
+	}
+
+	void append(const std::string& value, bool isNull)
+		/// Appends a value to the column.
+	{
+		append(value.data(), value.size(), isNull);
+	}
+
+	ValueType value(std::size_t row) const
+		/// Returns a copy of the value in the given row.
+		/// Throws RangeException if the row does not exist.
+	{
+		checkRow(row);
+		return std::string(arena() + _offsets[row], _offsets[row + 1] - _offsets[row]);
+	}
+
+	ValueType operator [] (std::size_t row) const
+		/// Returns a copy of the value in the given row.
+	{
+		return value(row);
+	}
+
+	const char* data(std::size_t row) const
+		/// Returns a pointer to the characters of the value in the
+		/// given row. The value is not zero-terminated.
+		/// Throws RangeException if the row does not exist.
+	{
+		checkRow(row);
+		return arena() + _offsets[row];
+	}
+
+	std::size_t length(std::size_t row) const
+		/// Returns the length of the value in the given row.
+		/// Throws RangeException if the row does not exist.
+	{
+		checkRow(row);
+		return _offsets[row + 1] - _offsets[row];
+	}
+
+	const char* arena() const
+		/// Returns a pointer to the arena holding the characters
+		/// of all values, or a null pointer if the arena is empty.
+	{
+		return _arena.empty() ? 0 : &_arena[0];
+	}
+
+	std::size_t arenaSize() const
+		/// Returns the total number of characters in the arena.
+	{
+		return _arena.size();
+	}
+
+	const std::size_t* offsets() const
+		/// Returns the rowCount() + 1 offsets of the values
+		/// in the arena.
+	{
+		return &_offsets[0];
+	}
+
+	void reserve(std::size_t rows)
+	{
+		AbstractColumnarColumn::reserve(rows);
+		_offsets.reserve(rows + 1);
+	}
+
+	void reset()
+	{
+		AbstractColumnarColumn::reset();
+		_arena.clear();
+		_offsets.assign(1, 0);
+	}
+
+private:
+	Container       _arena;
+	OffsetContainer _offsets;
+};
+
+
+class Data_API AbstractColumnarExtraction: public AbstractExtraction
+	/// AbstractColumnarExtraction is the type independent interface
+	/// of ColumnarExtraction.
+{
+public:
+	AbstractColumnarExtraction(const Position& pos);
+		/// Creates the AbstractColumnarExtraction.
+
+	~AbstractColumnarExtraction();
+		/// Destroys the AbstractColumnarExtraction.
+
+	virtual const AbstractColumnarColumn& columnarColumn() const = 0;
+		/// Returns the column the values are extracted to.
+};
+
+
+template <class T>
+class ColumnarExtraction: public AbstractColumnarExtraction
+	/// ColumnarExtraction appends the values of one result column
+	/// to a ColumnarColumn.
+	///
+	/// This class is intended for PocoData internal use - it is used by
+	/// StatementImpl to create the internal extractions for statements
+	/// with columnar storage. It takes ownership of the column.
+	///
+	/// ColumnarExtraction objects can not be copied or assigned.
+{
+public:
+	typedef ColumnarColumn<T> ColumnType;
+
+	ColumnarExtraction(ColumnType* pColumn, const Position& pos = Position(0)):
+		AbstractColumnarExtraction(pos),
+		_pColumn(pColumn),
+		_value(),
+		_default()
+		/// Creates the ColumnarExtraction.
+	{
+		if (!_pColumn)
+			throw NullPointerException("Column pointer must point to valid storage.");
+	}
+
+	~ColumnarExtraction()
+		/// Destroys the ColumnarExtraction.
+	{
+		delete _pColumn;
+	}
+
+	std::size_t numOfColumnsHandled() const
+	{
+		return 1u;
+	}
+
+	std::size_t numOfRowsHandled() const
+	{
+		return _pColumn->rowCount();
+	}
+
+	std::size_t numOfRowsAllowed() const
+	{
+		return getLimit();
+	}
+
+	bool isNull(std::size_t row) const
+	{
+		return _pColumn->isNull(row);
+	}
+
+	std::size_t extract(std::size_t pos)
+	{
+		AbstractExtractor::Ptr pExt = getExtractor();
+		TypeHandler<T>::extract(pos, _value, _default, pExt);
+		_pColumn->append(_value, isValueNull(_value, pExt->isNull(pos)));
+		return 1u;
+	}
+
+	void reset()
+	{
+		_pColumn->reset();
+	}
+
+	AbstractPreparation::Ptr createPreparation(AbstractPreparator::Ptr& pPrep, std::size_t pos)
+	{
+		return new Preparation<T>(pPrep, pos, _default);
+	}
+
+	const ColumnType& column() const
+		/// Returns the column.
+	{
+		return *_pColumn;
+	}
+
+	const AbstractColumnarColumn& columnarColumn() const
+	{
+		return *_pColumn;
+	}
+
+private:
+	ColumnarExtraction();
+	ColumnarExtraction(const ColumnarExtraction&);
+	ColumnarExtraction& operator = (const ColumnarExtraction&);
+
+	ColumnType* _pColumn;
+	T           _value;
+	T           _default;
+};
+
+
+template <>
+inline std::size_t ColumnarExtraction<std::string>::extract(std::size_t pos)
+	/// Copies the characters straight into the column's arena
+	/// if the extractor gives direct access to them.
+{
+	AbstractExtractor::Ptr pExt = getExtractor();
+	bool isNull = pExt->isNull(pos);
+	const char* pData = 0;
+	std::size_t length = 0;
+	if (!isNull) pData = pExt->stringData(pos, length);
+	if (isNull || pData)
+	{
+		if (getForceEmptyString())
+			isNull = false;
+		else if (getEmptyStringIsNull() && length == 0)
+			isNull = true;
+		_pColumn->append(pData, length, isNull);
+	}
+	else
+	{
+		TypeHandler<std::string>::extract(pos, _value, _default, pExt);
+		_pColumn->append(_value, isValueNull(_value, pExt->isNull(pos)));
+	}
+	return 1u;
+}
+
+
+//
+// inlines
+//
+inline const MetaColumn& AbstractColumnarColumn::metaColumn() const
+{
+	return _metaColumn;
+}
+
+
+inline const std::string& AbstractColumnarColumn::name() const
+{
+	return _metaColumn.name();
+}
+
+
+inline MetaColumn::ColumnDataType AbstractColumnarColumn::type() const
+{
+	return _metaColumn.type();
+}
+
+
+inline std::size_t AbstractColumnarColumn::position() const
+{
+	return _metaColumn.position();
+}
+
+
+inline std::size_t AbstractColumnarColumn::rowCount() const
+{
+	return _rowCount;
+}
+
+
+inline std::size_t AbstractColumnarColumn::nullCount() const
+{
+	return _nullCount;
+}
+
+
+inline const Poco::UInt8* AbstractColumnarColumn::nullBitmap() const
+{
+	return _nulls.empty() ? 0 : &_nulls[0];
+}
+
+
+inline void AbstractColumnarColumn::checkRow(std::size_t row) const
+{
+	if (row >= _rowCount)
+		throw RangeException("Invalid row index.");
+}
+
+
+inline bool AbstractColumnarColumn::isNull(std::size_t row) const
+{
+	checkRow(row);
+	return (_nulls[row >> 3] & (1 << (row & 7))) != 0;
+}
+
+
+inline void AbstractColumnarColumn::appendRow(bool isNull)
+{
+	if ((_rowCount & 7) == 0) _nulls.push_back(0);
+	if (isNull)
+	{
+		_nulls.back() |= static_cast<Poco::UInt8>(1 << (_rowCount & 7));
+		++_nullCount;
+	}
+	++_rowCount;
+}
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_ColumnarColumn_INCLUDED
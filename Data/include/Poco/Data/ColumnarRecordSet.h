@@ -0,0 +1,264 @@
+//
+// ColumnarRecordSet.h
+//
+// $Id: //poco/Main/Data/include/Poco/Data/ColumnarRecordSet.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  ColumnarRecordSet
+//
+// Definition of the ColumnarRecordSet class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_ColumnarRecordSet_INCLUDED
+#define Data_ColumnarRecordSet_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/Data/Session.h"
+#include "Poco/Data/Statement.h"
+#include "Poco/Data/ColumnarColumn.h"
+#include "Poco/Format.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <typeinfo>
+
+
+namespace Poco {
+namespace Data {
+
+
+class Data_API ColumnarRecordSet: private Statement
+	/// ColumnarRecordSet provides typed access to data returned from
+	/// a query executed with columnar storage.
+	///
+	/// Unlike RecordSet, which stores every column in a container of
+	/// values and returns Poco::Dynamic::Var for untyped access, 
+	/// ColumnarRecordSet stores each column in a ColumnarColumn:
+	/// values in one contiguous array, null indicators in a bitmap
+	/// and strings in a single character arena. Values are accessed
+	/// through typed columns or through a Cursor, without any Var
+	/// and Row objects being created.
+	///
+	/// The statement must use columnar storage, as follows:
+	///
+	///     Statement select(session);
+	///     select << "SELECT Name, Age FROM Person", columnar;
+	///     select.execute();
+	///     ColumnarRecordSet rs(select);
+	///
+	/// The shorter way to do the above is following:
+	///
+	///     ColumnarRecordSet rs(session, "SELECT Name, Age FROM Person");
+	///
+	/// For scans over large result sets, obtain the typed columns once
+	/// and iterate over their values or data() arrays directly:
+	///
+	///     const ColumnarColumn<int>& age = rs.column<int>(1);
+	///     for (std::size_t row = 0; row < age.rowCount(); ++row)
+	///         if (!age.isNull(row)) sum += age[row];
+	///
+	/// The ColumnarRecordSet shares the underlying statement. With a
+	/// limit set, every execution of the statement replaces the
+	/// content of the columns with the next batch of rows.
+{
+public:
+	class Data_API Cursor
+		/// Cursor provides typed, row by row access to
+		/// a ColumnarRecordSet.
+	{
+	public:
+		explicit Cursor(const ColumnarRecordSet& recordSet);
+			/// Creates the Cursor, positioned at the first row.
+
+		~Cursor();
+			/// Destroys the Cursor.
+
+		std::size_t row() const;
+			/// Returns the current row.
+
+		bool moveFirst();
+			/// Moves the cursor to the first row.
+			///
+			/// Returns true if there is at least one row in the
+			/// ColumnarRecordSet, false otherwise.
+
+		bool moveNext();
+			/// Moves the cursor to the next row.
+			///
+			/// Returns true if the row is available, or false
+			/// if the end of the record set has been reached.
+
+		bool movePrevious();
+			/// Moves the cursor to the previous row.
+			///
+			/// Returns true if the row is available, or false
+			/// if there are no more rows available.
+
+		bool moveLast();
+			/// Moves the cursor to the last row.
+			///
+			/// Returns true if there is at least one row in the
+			/// ColumnarRecordSet, false otherwise.
+
+		bool isNull(std::size_t col) const;
+			/// Returns true if the value in the given column
+			/// of the current row is null.
+
+		template <class T>
+		typename ColumnarColumn<T>::ValueType get(std::size_t col) const
+			/// Returns the value in the given column of the current row.
+			/// Throws BadCastException if T is not the column type.
+		{
+			return _pRecordSet->column<T>(col).value(_row);
+		}
+
+		template <class T>
+		typename ColumnarColumn<T>::ValueType get(const std::string& name) const
+			/// Returns the value in the named column of the current row.
+			/// Throws BadCastException if T is not the column type.
+		{
+			return _pRecordSet->column<T>(name).value(_row);
+		}
+
+	private:
+		Cursor();
+
+		const ColumnarRecordSet* _pRecordSet;
+		std::size_t              _row;
+	};
+
+	explicit ColumnarRecordSet(const Statement& rStatement);
+		/// Creates the ColumnarRecordSet.
+		///
+		/// The statement must have columnar storage and must
+		/// already be executed.
+
+	ColumnarRecordSet(Session& rSession, const std::string& query);
+		/// Creates the ColumnarRecordSet and executes the query
+		/// with columnar storage.
+
+	ColumnarRecordSet(const ColumnarRecordSet& other);
+		/// Copy-creates the ColumnarRecordSet.
+
+	~ColumnarRecordSet();
+		/// Destroys the ColumnarRecordSet.
+
+	std::size_t rowCount() const;
+		/// Returns the number of rows in the ColumnarRecordSet.
+
+	std::size_t columnCount() const;
+		/// Returns the number of columns in the ColumnarRecordSet.
+
+	const AbstractColumnarColumn& column(std::size_t pos) const;
+		/// Returns the column at the specified position.
+		/// Throws RangeException if the column does not exist.
+
+	const AbstractColumnarColumn& column(const std::string& name) const;
+		/// Returns the first column with the specified name.
+		/// Throws NotFoundException if the column does not exist.
+
+	template <class T>
+	const ColumnarColumn<T>& column(std::size_t pos) const
+		/// Returns the typed column at the specified position.
+		/// Throws BadCastException if T is not the column type.
+	{
+		return columnImpl<T>(column(pos));
+	}
+
+	template <class T>
+	const ColumnarColumn<T>& column(const std::string& name) const
+		/// Returns the first typed column with the specified name.
+		/// Throws BadCastException if T is not the column type.
+	{
+		return columnImpl<T>(column(name));
+	}
+
+	bool isNull(std::size_t col, std::size_t row) const;
+		/// Returns true if the value at [col, row] is null.
+
+	Cursor cursor() const;
+		/// Returns a Cursor positioned at the first row.
+
+private:
+	ColumnarRecordSet();
+	ColumnarRecordSet& operator = (const ColumnarRecordSet&);
+
+	template <class T>
+	const ColumnarColumn<T>& columnImpl(const AbstractColumnarColumn& col) const
+	{
+		const ColumnarColumn<T>* pColumn = dynamic_cast<const ColumnarColumn<T>*>(&col);
+		if (!pColumn)
+		{
+			throw BadCastException(Poco::format("Type cast failed!\nColumn: %z\nTarget type:\t%s",
+				col.position(),
+				std::string(typeid(T).name())));
+		}
+		return *pColumn;
+	}
+};
+
+
+//
+// inlines
+//
+inline std::size_t ColumnarRecordSet::Cursor::row() const
+{
+	return _row;
+}
+
+
+inline bool ColumnarRecordSet::Cursor::isNull(std::size_t col) const
+{
+	return _pRecordSet->isNull(col, _row);
+}
+
+
+inline std::size_t ColumnarRecordSet::columnCount() const
+{
+	return extractions().size();
+}
+
+
+inline bool ColumnarRecordSet::isNull(std::size_t col, std::size_t row) const
+{
+	return column(col).isNull(row);
+}
+
+
+inline ColumnarRecordSet::Cursor ColumnarRecordSet::cursor() const
+{
+	return Cursor(*this);
+}
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_ColumnarRecordSet_INCLUDED
@@ -0,0 +1,284 @@
+//
+// PipelinedExecution.h
+//
+// $Id: //poco/Main/Data/include/Poco/Data/PipelinedExecution.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  PipelinedExecution
+//
+// Definition of the PipelinedExecution class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_PipelinedExecution_INCLUDED
+#define Data_PipelinedExecution_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/Data/Statement.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Exception.h"
+#include <deque>
+
+
+namespace Poco {
+namespace Data {
+
+
+template <class C>
+class PipelinedExecution
+	/// PipelinedExecution executes a statement in batches on a
+	/// background thread and hands every batch over to the consumer
+	/// as soon as it has been fetched. While the consumer works on a
+	/// batch, the following batches are already being fetched.
+	///
+	/// The statement must extract into a single container of type C
+	/// (std::vector, std::deque or std::list) and should have a limit
+	/// set, which determines the batch size. Without a limit, the
+	/// whole result arrives as one batch.
+	///
+	///     std::vector<std::string> names;
+	///     Statement stmt = (session << "SELECT Name FROM Person", into(names), limit(1000));
+	///     PipelinedExecution<std::vector<std::string> > exec(stmt, names);
+	///     std::vector<std::string> batch;
+	///     while (exec.next(batch))
+	///     {
+	///         ...
+	///     }
+	///
+	/// At most queueCapacity fetched batches are held back; if the
+	/// consumer falls behind, fetching pauses until a batch has been
+	/// taken, so memory use is bounded regardless of the result size.
+	///
+	/// The statement, the result container and the session must not
+	/// be used otherwise until all batches have been consumed or the
+	/// PipelinedExecution has been destroyed.
+{
+public:
+	typedef C                                                   Container;
+	typedef SharedPtr<C>                                        ContainerPtr;
+	typedef ActiveResult<std::size_t>                           Result;
+	typedef SharedPtr<Result>                                   ResultPtr;
+	typedef ActiveMethod<std::size_t, void, PipelinedExecution> FetchMethod;
+
+	PipelinedExecution(const Statement& statement, C& result, std::size_t queueCapacity = 2):
+		_statement(statement),
+		_rResult(result),
+		_capacity(queueCapacity),
+		_finished(false),
+		_cancelled(false),
+		_rows(0),
+		_batches(0),
+		_fetch(this, &PipelinedExecution::fetchImpl)
+		/// Creates the PipelinedExecution for the given statement,
+		/// which extracts into result.
+		///
+		/// Throws an InvalidArgumentException if the statement is
+		/// asynchronous or if queueCapacity is zero.
+	{
+		if (_statement.isAsync())
+			throw InvalidArgumentException("Statement must be synchronous.");
+		if (0 == _capacity)
+			throw InvalidArgumentException("Queue capacity must be greater than zero.");
+	}
+
+	~PipelinedExecution()
+		/// Cancels fetching and waits for the background
+		/// thread to finish.
+	{
+		try
+		{
+			cancel();
+			if (_pResult) _pResult->wait();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	void start()
+		/// Starts fetching, if it has not been started yet.
+		/// Called by next() if necessary.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (!_pResult) _pResult = new Result(_fetch());
+	}
+
+	bool next(C& batch)
+		/// Waits for the next batch and swaps it into batch.
+		///
+		/// Returns false if all batches have been consumed or
+		/// fetching has been cancelled. If fetching has failed,
+		/// the exception is rethrown once all batches fetched
+		/// before the failure have been consumed.
+	{
+		start();
+
+		ContainerPtr pBatch;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			while (_queue.empty() && !_finished)
+				_notEmpty.wait(_mutex);
+
+			if (!_queue.empty())
+			{
+				pBatch = _queue.front();
+				_queue.pop_front();
+				_notFull.signal();
+			}
+		}
+
+		if (pBatch)
+		{
+			batch.swap(*pBatch);
+			return true;
+		}
+
+		_pResult->wait();
+		if (_pResult->failed()) _pResult->exception()->rethrow();
+		return false;
+	}
+
+	template <class Callback>
+	std::size_t forEach(Callback callback)
+		/// Calls callback(batch) with a const reference to every
+		/// batch, on the calling thread, while the following batches
+		/// are being fetched. Returns the number of rows passed to
+		/// the callback.
+	{
+		C batch;
+		std::size_t rows = 0;
+		while (next(batch))
+		{
+			rows += batch.size();
+			const C& rBatch = batch;
+			callback(rBatch);
+		}
+		return rows;
+	}
+
+	void cancel()
+		/// Stops fetching after the current batch and discards
+		/// all batches that have not been consumed yet.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_cancelled = true;
+		_queue.clear();
+		_notFull.broadcast();
+	}
+
+	std::size_t rowsFetched() const
+		/// Returns the number of rows fetched so far.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		return _rows;
+	}
+
+	std::size_t batchesFetched() const
+		/// Returns the number of batches fetched so far.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		return _batches;
+	}
+
+private:
+	PipelinedExecution();
+	PipelinedExecution(const PipelinedExecution&);
+	PipelinedExecution& operator = (const PipelinedExecution&);
+
+	std::size_t fetchImpl()
+	{
+		try
+		{
+			do
+			{
+				_statement.execute();
+				if (_rResult.empty()) continue;
+
+				ContainerPtr pBatch = new C;
+				pBatch->swap(_rResult);
+
+				FastMutex::ScopedLock lock(_mutex);
+				while (_queue.size() >= _capacity && !_cancelled)
+					_notFull.wait(_mutex);
+				if (_cancelled) break;
+
+				_rows += pBatch->size();
+				++_batches;
+				_queue.push_back(pBatch);
+				_notEmpty.signal();
+			}
+			while (!_statement.done() && !isCancelled());
+		}
+		catch (...)
+		{
+			finish();
+			throw;
+		}
+		finish();
+		return rowsFetched();
+	}
+
+	bool isCancelled() const
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		return _cancelled;
+	}
+
+	void finish()
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_finished = true;
+		_notEmpty.broadcast();
+	}
+
+	Statement                _statement;
+	C&                       _rResult;
+	std::size_t              _capacity;
+	std::deque<ContainerPtr> _queue;
+	bool                     _finished;
+	bool                     _cancelled;
+	std::size_t              _rows;
+	std::size_t              _batches;
+	mutable FastMutex        _mutex;
+	Condition                _notEmpty;
+	Condition                _notFull;
+	FetchMethod              _fetch;
+	ResultPtr                _pResult;
+};
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_PipelinedExecution_INCLUDED
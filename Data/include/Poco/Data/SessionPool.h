@@ -48,6 +48,9 @@
 #include "Poco/Any.h"
 #include "Poco/Timer.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Timespan.h"
+#include "Poco/Types.h"
 #include <list>
 
 
@@ -75,11 +78,23 @@ class Data_API SessionPool: public RefCountedObject
 	/// Sessions found not to be connected to the database are purged
 	/// from the pool whenever one of the following events occurs:
 	/// 
-	///   - JanitorTimer event
-	///   - get() request
+	///   - JanitorTimer event (all idle sessions are checked)
+	///   - get() request (the session handed out is checked)
 	///   - putBack() request
 	///
-	/// Not connected idle sessions can not exist.
+	/// The JanitorTimer and get() check sessions one at a time,
+	/// without holding the pool lock while a session is checked or
+	/// closed. A get() request that finds no other session waits for
+	/// such a check to finish, instead of failing. New sessions are
+	/// also created outside of the pool lock.
+	///
+	/// If a wait timeout has been set with setWaitTimeout(), get()
+	/// waits for a session to become available instead of throwing a
+	/// SessionPoolExhaustedException right away. Waiting callers are
+	/// served in the order in which they have called get().
+	///
+	/// warmUp() creates minSessions sessions ahead of time, and the
+	/// JanitorTimer keeps the pool at that size afterwards.
 	///
 	/// Usage example:
 	///
@@ -89,6 +104,25 @@ class Data_API SessionPool: public RefCountedObject
 	///     ...
 {
 public:
+	struct Statistics
+		/// Usage statistics of a SessionPool.
+	{
+		Statistics():
+			checkouts(0),
+			waits(0),
+			exhausted(0)
+		{
+		}
+
+		Poco::UInt64   checkouts;         /// Number of sessions handed out by get().
+		Poco::UInt64   waits;             /// Number of get() calls that had to wait.
+		Poco::UInt64   exhausted;         /// Number of get() calls that failed because the pool was exhausted.
+		Poco::Timespan totalWaitTime;     /// Total time spent waiting for sessions.
+		Poco::Timespan maxWaitTime;       /// Longest time spent waiting for a session.
+		Poco::Timespan totalCheckoutTime; /// Total time spent in successful get() calls.
+		Poco::Timespan maxCheckoutTime;   /// Longest time spent in a successful get() call.
+	};
+
 	SessionPool(const std::string& connector, 
 		const std::string& connectionString, 
 		int minSessions = 1, 
@@ -112,8 +146,10 @@ public:
 		/// is created. 
 		///
 		/// If the maximum number of sessions for this pool has
-		/// already been created, a SessionPoolExhaustedException
-		/// is thrown.
+		/// already been created, get() waits up to the wait timeout
+		/// for a session to be returned to the pool. If no session
+		/// becomes available in time, or if no wait timeout has been
+		/// set, a SessionPoolExhaustedException is thrown.
 	
 	template <typename T>
 	Session get(const std::string& name, const T& value)
@@ -173,7 +209,29 @@ public:
 	Poco::Any getProperty(const std::string& name);
 		/// Returns the requested property.
 
+	void setWaitTimeout(long milliseconds);
+		/// Sets the time get() waits for a session if the pool
+		/// is exhausted. Zero (the default) disables waiting.
+
+	long getWaitTimeout() const;
+		/// Returns the time get() waits for a session if the pool
+		/// is exhausted.
+
+	void warmUp();
+		/// Creates sessions until the pool holds at least minSessions
+		/// sessions, and makes the JanitorTimer replace sessions found
+		/// to be dead or expired, in order to keep that size.
+
+	Statistics statistics() const;
+		/// Returns the usage statistics of the pool.
+
+	void resetStatistics();
+		/// Resets the usage statistics of the pool.
+
 	void shutdown();
+		/// Shuts down the pool, closing all sessions.
+		/// Callers waiting in get() are woken up and
+		/// get an InvalidAccessException.
 
 protected:
 	typedef Poco::AutoPtr<PooledSessionHolder>    PooledSessionHolderPtr;
@@ -187,6 +245,10 @@ protected:
 	void applySettings(SessionImpl* pImpl);
 	void putBack(PooledSessionHolderPtr pHolder);
 	void onJanitorTimer(Poco::Timer&);
+	PooledSessionHolderPtr acquire();
+	PooledSessionHolderPtr waitForSession(const Poco::Timestamp& start);
+	PooledSessionHolderPtr createSession();
+	void recycle(PooledSessionHolderPtr pHolder);
 
 private:
 	typedef std::pair<std::string, Poco::Any> PropertyPair; 
@@ -194,10 +256,17 @@ private:
 	typedef std::map<SessionImpl*, PropertyPair> AddPropertyMap;
 	typedef std::map<SessionImpl*, FeaturePair> AddFeatureMap;
 
+	struct Waiter
+	{
+		PooledSessionHolderPtr pHolder;
+	};
+	typedef std::list<Waiter*> WaiterList;
+
 	SessionPool(const SessionPool&);
 	SessionPool& operator = (const SessionPool&);
 		
 	void closeAll(SessionList& sessionList);
+	void fill();
 
 	std::string    _connector;
 	std::string    _connectionString;
@@ -205,6 +274,7 @@ private:
 	int            _maxSessions;
 	int            _idleTime;
 	int            _nSessions;
+	int            _checking;
 	SessionList    _idleSessions;
 	SessionList    _activeSessions;
 	Poco::Timer    _janitorTimer;
@@ -213,8 +283,13 @@ private:
 	bool           _shutdown;
 	AddPropertyMap _addPropertyMap;
 	AddFeatureMap  _addFeatureMap;
+	WaiterList     _waiters;
+	long           _waitTimeout;
+	bool           _warm;
+	Statistics     _statistics;
+	Poco::Condition _available;
 	mutable
-	Poco::Mutex _mutex;
+	Poco::Mutex    _mutex;
 	
 	friend class PooledSessionImpl;
 };
@@ -108,7 +108,8 @@ public:
 		STORAGE_DEQUE   = StatementImpl::STORAGE_DEQUE_IMPL,
 		STORAGE_VECTOR  = StatementImpl::STORAGE_VECTOR_IMPL,
 		STORAGE_LIST    = StatementImpl::STORAGE_LIST_IMPL,
-		STORAGE_UNKNOWN = StatementImpl::STORAGE_UNKNOWN_IMPL
+		STORAGE_UNKNOWN = StatementImpl::STORAGE_UNKNOWN_IMPL,
+		STORAGE_COLUMNAR = StatementImpl::STORAGE_COLUMNAR_IMPL
 	};
 
 	Statement(StatementImpl::Ptr pImpl);
@@ -512,6 +513,19 @@ inline void Data_API list(Statement& statement)
 }
 
 
+inline void Data_API columnar(Statement& statement)
+	/// Sets the internal storage to columnar storage.
+	/// Data of statements with columnar storage can be
+	/// accessed through ColumnarRecordSet, but not
+	/// through RecordSet.
+{
+	if (!statement.canModifyStorage())
+		throw InvalidAccessException("Storage not modifiable.");
+
+	statement.setStorage("columnar");
+}
+
+
 inline void Data_API reset(Statement& statement)
 	/// Sets all internal settings to their respective default values.
 {
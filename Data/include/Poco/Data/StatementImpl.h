@@ -48,6 +48,7 @@
 #include "Poco/Data/Column.h"
 #include "Poco/Data/Extraction.h"
 #include "Poco/Data/BulkExtraction.h"
+#include "Poco/Data/ColumnarColumn.h"
 #include "Poco/Data/SessionImpl.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/String.h"
@@ -87,7 +88,8 @@ public:
 		STORAGE_DEQUE_IMPL,
 		STORAGE_VECTOR_IMPL,
 		STORAGE_LIST_IMPL,
-		STORAGE_UNKNOWN_IMPL
+		STORAGE_UNKNOWN_IMPL,
+		STORAGE_COLUMNAR_IMPL
 	};
 
 	enum BulkType
@@ -112,6 +114,7 @@ public:
 	static const std::string VECTOR;
 	static const std::string LIST;
 	static const std::string UNKNOWN;
+	static const std::string COLUMNAR;
 
 	static const int USE_CURRENT_DATA_SET = -1;
 
@@ -353,6 +356,13 @@ private:
 			Position(static_cast<Poco::UInt32>(currentDataSet())));
 	}
 
+	template <class T>
+	SharedPtr<ColumnarExtraction<T> > createColumnarExtract(const MetaColumn& mc)
+	{
+		return new ColumnarExtraction<T>(new ColumnarColumn<T>(mc),
+			Position(static_cast<Poco::UInt32>(currentDataSet())));
+	}
+
 	template <class T>
 	void addInternalExtract(const MetaColumn& mc)
 		/// Creates and adds the internal extraction.
@@ -365,6 +375,9 @@ private:
 		/// session setting is used.
 		/// If neither this statement nor the session have the storage
 		/// type set, std::deque is the default container type used.
+		///
+		/// Columnar storage always extracts row by row into a
+		/// ColumnarColumn, regardless of the bulk setting.
 	{
 		std::string storage;
 	
@@ -376,6 +389,8 @@ private:
 			storage = VECTOR; break;
 		case STORAGE_LIST_IMPL:   
 			storage = LIST; break;
+		case STORAGE_COLUMNAR_IMPL:
+			storage = COLUMNAR; break;
 		case STORAGE_UNKNOWN_IMPL:
 			storage = AnyCast<std::string>(session().getProperty("storage")); 
 			break;
@@ -404,6 +419,10 @@ private:
 			else
 				addExtract(createBulkExtract<std::list<T> >(mc));
 		}
+		else if (0 == icompare(COLUMNAR, storage))
+		{
+			addExtract(createColumnarExtract<T>(mc));
+		}
 	}
 
 	bool isNull(std::size_t col, std::size_t row) const;
@@ -0,0 +1,82 @@
+//
+// ColumnarColumn.cpp
+//
+// $Id: //poco/Main/Data/src/ColumnarColumn.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  ColumnarColumn
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/ColumnarColumn.h"
+
+
+namespace Poco {
+namespace Data {
+
+
+AbstractColumnarColumn::AbstractColumnarColumn(const MetaColumn& metaColumn):
+	_metaColumn(metaColumn),
+	_rowCount(0),
+	_nullCount(0)
+{
+}
+
+
+AbstractColumnarColumn::~AbstractColumnarColumn()
+{
+}
+
+
+void AbstractColumnarColumn::reserve(std::size_t rows)
+{
+	_nulls.reserve((rows + 7) / 8);
+}
+
+
+void AbstractColumnarColumn::reset()
+{
+	_nulls.clear();
+	_rowCount = 0;
+	_nullCount = 0;
+}
+
+
+AbstractColumnarExtraction::AbstractColumnarExtraction(const Position& pos):
+	AbstractExtraction(Limit::LIMIT_UNLIMITED, pos.value())
+{
+}
+
+
+AbstractColumnarExtraction::~AbstractColumnarExtraction()
+{
+}
+
+
+} } // namespace Poco::Data
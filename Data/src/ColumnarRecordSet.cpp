@@ -0,0 +1,152 @@
+//
+// ColumnarRecordSet.cpp
+//
+// $Id: //poco/Main/Data/src/ColumnarRecordSet.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  ColumnarRecordSet
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/ColumnarRecordSet.h"
+#include "Poco/Data/DataException.h"
+
+
+using namespace Poco::Data::Keywords;
+
+
+namespace Poco {
+namespace Data {
+
+
+//
+// ColumnarRecordSet::Cursor
+//
+
+
+ColumnarRecordSet::Cursor::Cursor(const ColumnarRecordSet& recordSet):
+	_pRecordSet(&recordSet),
+	_row(0)
+{
+}
+
+
+ColumnarRecordSet::Cursor::~Cursor()
+{
+}
+
+
+bool ColumnarRecordSet::Cursor::moveFirst()
+{
+	_row = 0;
+	return _pRecordSet->rowCount() > 0;
+}
+
+
+bool ColumnarRecordSet::Cursor::moveNext()
+{
+	if (_row + 1 >= _pRecordSet->rowCount()) return false;
+	++_row;
+	return true;
+}
+
+
+bool ColumnarRecordSet::Cursor::movePrevious()
+{
+	if (0 == _row) return false;
+	--_row;
+	return true;
+}
+
+
+bool ColumnarRecordSet::Cursor::moveLast()
+{
+	std::size_t rows = _pRecordSet->rowCount();
+	if (0 == rows) return false;
+	_row = rows - 1;
+	return true;
+}
+
+
+//
+// ColumnarRecordSet
+//
+
+
+ColumnarRecordSet::ColumnarRecordSet(const Statement& rStatement):
+	Statement(rStatement)
+{
+}
+
+
+ColumnarRecordSet::ColumnarRecordSet(Session& rSession, const std::string& query):
+	Statement((rSession << query, columnar, now))
+{
+}
+
+
+ColumnarRecordSet::ColumnarRecordSet(const ColumnarRecordSet& other):
+	Statement(other.impl())
+{
+}
+
+
+ColumnarRecordSet::~ColumnarRecordSet()
+{
+}
+
+
+std::size_t ColumnarRecordSet::rowCount() const
+{
+	if (0 == columnCount()) return 0;
+	return column(0).rowCount();
+}
+
+
+const AbstractColumnarColumn& ColumnarRecordSet::column(std::size_t pos) const
+{
+	const AbstractExtractionVec& rExtractions = extractions();
+	if (pos >= rExtractions.size())
+		throw RangeException(Poco::format("Invalid column index: %z", pos));
+
+	const AbstractColumnarExtraction* pExtraction = dynamic_cast<const AbstractColumnarExtraction*>(rExtractions[pos].get());
+	if (!pExtraction)
+		throw BadCastException(Poco::format("Column %z does not have columnar storage.", pos));
+
+	return pExtraction->columnarColumn();
+}
+
+
+const AbstractColumnarColumn& ColumnarRecordSet::column(const std::string& name) const
+{
+	return column(metaColumn(name).position());
+}
+
+
+} } // namespace Poco::Data
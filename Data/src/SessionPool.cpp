@@ -37,7 +37,10 @@
 #include "Poco/Data/SessionPool.h"
 #include "Poco/Data/SessionFactory.h"
 #include "Poco/Data/DataException.h"
+#include "Poco/ScopedUnlock.h"
+#include "Poco/Timestamp.h"
 #include <algorithm>
+#include <vector>
 
 
 namespace Poco {
@@ -51,8 +54,11 @@ SessionPool::SessionPool(const std::string& connector, const std::string& connec
 	_maxSessions(maxSessions),
 	_idleTime(idleTime),
 	_nSessions(0),
+	_checking(0),
 	_janitorTimer(1000*idleTime, 1000*idleTime/4),
-	_shutdown(false)
+	_shutdown(false),
+	_waitTimeout(0),
+	_warm(false)
 {
 	Poco::TimerCallback<SessionPool> callback(*this, &SessionPool::onJanitorTimer);
 	_janitorTimer.start(callback);
@@ -78,34 +84,191 @@ Session SessionPool::get(const std::string& name, bool value)
 
 Session SessionPool::get()
 {
+	Poco::Timestamp start;
 	Poco::Mutex::ScopedLock lock(_mutex);
-    if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
-	
-	purgeDeadSessions();
-
-	if (_idleSessions.empty())
+	PooledSessionHolderPtr pHolder;
+	while (!pHolder)
 	{
-		if (_nSessions < _maxSessions)
+		if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+
+		if (_waiters.empty()) pHolder = acquire();
+		while (!pHolder && _checking > 0 && _waiters.empty() && _waitTimeout <= 0 && !_shutdown)
+		{
+			// A session is being checked and will
+			// be available again shortly.
+			_available.wait(_mutex);
+			pHolder = acquire();
+		}
+		if (!pHolder)
 		{
-			Session newSession(SessionFactory::instance().create(_connector, _connectionString));
-			applySettings(newSession.impl());
+			if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+			if (_waitTimeout <= 0)
+			{
+				++_statistics.exhausted;
+				throw SessionPoolExhaustedException(_connector, _connectionString);
+			}
+			pHolder = waitForSession(start);
+		}
 
-			PooledSessionHolderPtr pHolder(new PooledSessionHolder(*this, newSession.impl()));
-			_idleSessions.push_front(pHolder);
-			++_nSessions;
+		// Only the session handed out is checked, and
+		// without holding the lock. If it is no longer
+		// connected, it is discarded and we try again.
+		bool connected = false;
+		++_checking;
+		{
+			Poco::ScopedUnlock<Poco::Mutex> unlock(_mutex);
+			try { connected = pHolder->session()->isConnected(); }
+			catch (...) { }
+			if (!connected)
+			{
+				try	{ pHolder->session()->close(); }
+				catch (...) { }
+			}
 		}
-		else throw SessionPoolExhaustedException(_connector, _connectionString);
+		--_checking;
+		if (_shutdown)
+		{
+			// shutdown() has not seen this session
+			try	{ pHolder->session()->close(); }
+			catch (...) { }
+			throw InvalidAccessException("Session pool has been shut down.");
+		}
+		if (!connected)
+		{
+			pHolder = 0;
+			if (_nSessions > 0) --_nSessions;
+		}
+		_available.broadcast();
 	}
 
-	PooledSessionHolderPtr pHolder(_idleSessions.front());
 	PooledSessionImplPtr pPSI(new PooledSessionImpl(pHolder));
-	
 	_activeSessions.push_front(pHolder);
-	_idleSessions.pop_front();
+
+	Poco::Timespan checkoutTime(start.elapsed());
+	++_statistics.checkouts;
+	_statistics.totalCheckoutTime += checkoutTime;
+	if (checkoutTime > _statistics.maxCheckoutTime)
+		_statistics.maxCheckoutTime = checkoutTime;
+
 	return Session(pPSI);
 }
 
 
+SessionPool::PooledSessionHolderPtr SessionPool::acquire()
+{
+	PooledSessionHolderPtr pHolder;
+	if (!_idleSessions.empty())
+	{
+		pHolder = _idleSessions.front();
+		_idleSessions.pop_front();
+	}
+	else if (_nSessions < _maxSessions)
+	{
+		pHolder = createSession();
+	}
+	return pHolder;
+}
+
+
+SessionPool::PooledSessionHolderPtr SessionPool::waitForSession(const Poco::Timestamp& start)
+{
+	Waiter waiter;
+	_waiters.push_back(&waiter);
+	++_statistics.waits;
+
+	PooledSessionHolderPtr pHolder;
+	try
+	{
+		while (!waiter.pHolder && !_shutdown)
+		{
+			if (_waiters.front() == &waiter && (!_idleSessions.empty() || _nSessions < _maxSessions))
+			{
+				_waiters.pop_front();
+				_available.broadcast();
+				pHolder = acquire();
+				break;
+			}
+
+			long remaining = _waitTimeout - static_cast<long>(start.elapsed()/1000);
+			if (remaining <= 0) break;
+			_available.tryWait(_mutex, remaining);
+		}
+	}
+	catch (...)
+	{
+		WaiterList::iterator it = std::find(_waiters.begin(), _waiters.end(), &waiter);
+		if (it != _waiters.end()) _waiters.erase(it);
+		_available.broadcast();
+		throw;
+	}
+
+	WaiterList::iterator it = std::find(_waiters.begin(), _waiters.end(), &waiter);
+	if (it != _waiters.end())
+	{
+		_waiters.erase(it);
+		_available.broadcast();
+	}
+	if (!pHolder) pHolder = waiter.pHolder;
+
+	Poco::Timespan waitTime(start.elapsed());
+	_statistics.totalWaitTime += waitTime;
+	if (waitTime > _statistics.maxWaitTime)
+		_statistics.maxWaitTime = waitTime;
+
+	if (!pHolder)
+	{
+		if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+		++_statistics.exhausted;
+		throw SessionPoolExhaustedException(_connector, _connectionString);
+	}
+	return pHolder;
+}
+
+
+SessionPool::PooledSessionHolderPtr SessionPool::createSession()
+{
+	// The new session is counted right away, but connected
+	// without holding the lock.
+	++_nSessions;
+	Poco::AutoPtr<SessionImpl> pImpl;
+	try
+	{
+		Poco::ScopedUnlock<Poco::Mutex> unlock(_mutex);
+		Session newSession(SessionFactory::instance().create(_connector, _connectionString));
+		applySettings(newSession.impl());
+		pImpl.assign(newSession.impl(), true);
+	}
+	catch (...)
+	{
+		--_nSessions;
+		_available.broadcast();
+		throw;
+	}
+
+	if (_shutdown)
+	{
+		--_nSessions;
+		try { pImpl->close(); }
+		catch (...) { }
+		throw InvalidAccessException("Session pool has been shut down.");
+	}
+
+	return new PooledSessionHolder(*this, pImpl);
+}
+
+
+void SessionPool::recycle(PooledSessionHolderPtr pHolder)
+{
+	if (!_waiters.empty())
+	{
+		_waiters.front()->pHolder = pHolder;
+		_waiters.pop_front();
+		_available.broadcast();
+	}
+	else _idleSessions.push_front(pHolder);
+}
+
+
 void SessionPool::purgeDeadSessions()
 {
 	Poco::Mutex::ScopedLock lock(_mutex);
@@ -257,11 +420,15 @@ void SessionPool::putBack(PooledSessionHolderPtr pHolder)
 			applySettings(pHolder->session());
 
 			pHolder->access();
-			_idleSessions.push_front(pHolder);
+			_activeSessions.erase(it);
+			recycle(pHolder);
+		}
+		else
+		{
+			_activeSessions.erase(it);
+			--_nSessions;
+			_available.broadcast();
 		}
-		else --_nSessions;
-
-		_activeSessions.erase(it);
 	}
 	else
 	{
@@ -272,32 +439,135 @@ void SessionPool::putBack(PooledSessionHolderPtr pHolder)
 
 void SessionPool::onJanitorTimer(Poco::Timer&)
 {
-	Poco::Mutex::ScopedLock lock(_mutex);
-	if (_shutdown) return;
+	std::vector<PooledSessionHolderPtr> sessions;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_shutdown) return;
+		sessions.assign(_idleSessions.begin(), _idleSessions.end());
+	}
 
-	SessionList::iterator it = _idleSessions.begin(); 
-	while (_nSessions > _minSessions && it != _idleSessions.end())
+	// Each idle session is taken out of the idle list and checked
+	// without holding the lock, so that get() and putBack() are
+	// not blocked by a slow connection check. A session that has
+	// been handed out in the meantime is skipped. Healthy sessions
+	// are appended to the idle list, which preserves their order.
+	for (std::vector<PooledSessionHolderPtr>::iterator it = sessions.begin(); it != sessions.end(); ++it)
 	{
-		if ((*it)->idle() > _idleTime || !(*it)->session()->isConnected())
-		{	
-			try	{ (*it)->session()->close(); }
+		PooledSessionHolderPtr pHolder = *it;
+		bool expired = false;
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+			if (_shutdown) return;
+			SessionList::iterator itIdle = std::find(_idleSessions.begin(), _idleSessions.end(), pHolder);
+			if (itIdle == _idleSessions.end()) continue;
+			_idleSessions.erase(itIdle);
+			++_checking;
+			expired = _nSessions > _minSessions && pHolder->idle() > _idleTime;
+		}
+
+		bool healthy = !expired;
+		if (healthy)
+		{
+			try { healthy = pHolder->session()->isConnected(); }
+			catch (...) { healthy = false; }
+		}
+		if (!healthy)
+		{
+			try	{ pHolder->session()->close(); }
 			catch (...) { }
-			it = _idleSessions.erase(it);
-			--_nSessions;
 		}
-		else ++it;
+
+		Poco::Mutex::ScopedLock lock(_mutex);
+		--_checking;
+		if (healthy && !_shutdown)
+		{
+			_idleSessions.push_back(pHolder);
+		}
+		else
+		{
+			if (healthy)
+			{
+				try	{ pHolder->session()->close(); }
+				catch (...) { }
+			}
+			if (_nSessions > 0) --_nSessions;
+		}
+		_available.broadcast();
+	}
+
+	try
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (_warm) fill();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void SessionPool::setWaitTimeout(long milliseconds)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	_waitTimeout = milliseconds;
+}
+
+
+long SessionPool::getWaitTimeout() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _waitTimeout;
+}
+
+
+void SessionPool::warmUp()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	if (_shutdown) throw InvalidAccessException("Session pool has been shut down.");
+
+	_warm = true;
+	fill();
+}
+
+
+void SessionPool::fill()
+{
+	while (!_shutdown && _nSessions < _minSessions)
+	{
+		PooledSessionHolderPtr pHolder = createSession();
+		pHolder->access();
+		recycle(pHolder);
 	}
 }
 
 
+SessionPool::Statistics SessionPool::statistics() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	return _statistics;
+}
+
+
+void SessionPool::resetStatistics()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	_statistics = Statistics();
+}
+
+
 void SessionPool::shutdown()
 {
+	// The janitor takes the lock while it runs, so the timer
+	// must be stopped without holding it, or stopping the
+	// timer would wait for the janitor forever.
+	_janitorTimer.stop();
+
 	Poco::Mutex::ScopedLock lock(_mutex);
 	if (_shutdown) return;
 	_shutdown = true;
-	_janitorTimer.stop();
 	closeAll(_idleSessions);
 	closeAll(_activeSessions);
+	_available.broadcast();
 }
 
 
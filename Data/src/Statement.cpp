@@ -194,6 +194,8 @@ const std::string& Statement::getStorage() const
 		return StatementImpl::DEQUE;
 	case STORAGE_UNKNOWN:
 		return StatementImpl::UNKNOWN;
+	case STORAGE_COLUMNAR:
+		return StatementImpl::COLUMNAR;
 	}
 
 	throw IllegalStateException("Invalid storage setting.");
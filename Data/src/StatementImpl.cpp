@@ -62,6 +62,7 @@ const std::string StatementImpl::VECTOR = "vector";
 const std::string StatementImpl::LIST = "list";
 const std::string StatementImpl::DEQUE = "deque";
 const std::string StatementImpl::UNKNOWN = "unknown";
+const std::string StatementImpl::COLUMNAR = "columnar";
 
 
 StatementImpl::StatementImpl(SessionImpl& rSession):
@@ -311,6 +312,8 @@ void StatementImpl::setStorage(const std::string& storage)
 		_storage = STORAGE_LIST_IMPL;
 	else if (0 == icompare(UNKNOWN, storage))
 		_storage = STORAGE_UNKNOWN_IMPL;
+	else if (0 == icompare(COLUMNAR, storage))
+		_storage = STORAGE_COLUMNAR_IMPL;
 	else
 		throw NotFoundException();
 }
@@ -36,6 +36,7 @@
 #include "Poco/Data/SessionPool.h"
 #include "Poco/Data/SessionPoolContainer.h"
 #include "Poco/Thread.h"
+#include "Poco/Runnable.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Exception.h"
 #include "Connector.h"
@@ -54,6 +55,30 @@ using Poco::Data::SessionPoolExistsException;
 using Poco::Data::SessionUnavailableException;
 
 
+namespace
+{
+	class SessionReleaser: public Poco::Runnable
+	{
+	public:
+		SessionReleaser(const Session& session, long delay):
+			_session(session),
+			_delay(delay)
+		{
+		}
+
+		void run()
+		{
+			Thread::sleep(_delay);
+			_session.close();
+		}
+
+	private:
+		Session _session;
+		long    _delay;
+	};
+}
+
+
 SessionPoolTest::SessionPoolTest(const std::string& name): CppUnit::TestCase(name)
 {
 	Poco::Data::Test::Connector::addToFactory();
@@ -231,6 +256,80 @@ void SessionPoolTest::testSessionPool()
 }
 
 
+void SessionPoolTest::testSessionPoolWait()
+{
+	SessionPool pool("test", "cs", 1, 2, 10);
+	assert (pool.getWaitTimeout() == 0);
+
+	pool.warmUp();
+	assert (pool.allocated() == 1);
+	assert (pool.idle() == 1);
+	assert (pool.used() == 0);
+
+	pool.setWaitTimeout(5000);
+	assert (pool.getWaitTimeout() == 5000);
+
+	Session s1(pool.get());
+	Session s2(pool.get());
+	assert (pool.allocated() == 2);
+	assert (pool.available() == 0);
+
+	SessionReleaser releaser(s1, 200);
+	Thread thread;
+	thread.start(releaser);
+	Session s3(pool.get());
+	thread.join();
+	assert (s3.isConnected());
+	assert (pool.allocated() == 2);
+	assert (pool.used() == 2);
+
+	SessionPool::Statistics stats = pool.statistics();
+	assert (stats.checkouts == 3);
+	assert (stats.waits == 1);
+	assert (stats.exhausted == 0);
+	assert (stats.totalWaitTime.totalMilliseconds() >= 100);
+	assert (stats.maxWaitTime == stats.totalWaitTime);
+	assert (stats.maxCheckoutTime >= stats.maxWaitTime);
+
+	pool.setWaitTimeout(100);
+	try
+	{
+		Session s4(pool.get());
+		fail("pool exhausted - must throw");
+	}
+	catch (SessionPoolExhaustedException&) { }
+
+	pool.setWaitTimeout(0);
+	try
+	{
+		Session s4(pool.get());
+		fail("pool exhausted - must throw");
+	}
+	catch (SessionPoolExhaustedException&) { }
+
+	stats = pool.statistics();
+	assert (stats.checkouts == 3);
+	assert (stats.waits == 2);
+	assert (stats.exhausted == 2);
+
+	pool.resetStatistics();
+	stats = pool.statistics();
+	assert (stats.checkouts == 0);
+	assert (stats.waits == 0);
+	assert (stats.exhausted == 0);
+	assert (stats.totalWaitTime == 0);
+
+	s2.close();
+	assert (pool.idle() == 1);
+	Session s5(pool.get());
+	assert (pool.idle() == 0);
+	assert (pool.statistics().checkouts == 1);
+
+	pool.shutdown();
+	assert (pool.allocated() == 0);
+}
+
+
 void SessionPoolTest::testSessionPoolContainer()
 {
 	SessionPoolContainer spc;
@@ -275,6 +374,7 @@ CppUnit::Test* SessionPoolTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SessionPoolTest");
 
 	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPool);
+	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPoolWait);
 	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPoolContainer);
 
 	return pSuite;
@@ -47,6 +47,7 @@ public:
 	~SessionPoolTest();
 
 	void testSessionPool();
+	void testSessionPoolWait();
 	void testSessionPoolContainer();
 
 	void setUp();
@@ -0,0 +1,83 @@
+//
+// AbstractNotificationQueue.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/AbstractNotificationQueue.h#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  NotificationQueue
+//
+// Definition of the AbstractNotificationQueue class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef Foundation_AbstractNotificationQueue_INCLUDED
+#define Foundation_AbstractNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+
+
+namespace Poco {
+
+
+class Foundation_API AbstractNotificationQueue
+	/// The interface of a notification queue used by
+	/// a single class, such as ActiveDispatcher, that can
+	/// be configured to use either a NotificationQueue or
+	/// a LockFreeNotificationQueue.
+	///
+	/// Neither queue class derives from AbstractNotificationQueue.
+	/// Use the NotificationQueueAdapter class template to
+	/// access a queue through this interface.
+	///
+	/// See NotificationQueue for a description of the methods.
+{
+public:
+	AbstractNotificationQueue();
+	virtual ~AbstractNotificationQueue();
+
+	virtual void enqueueNotification(Notification::Ptr pNotification) = 0;
+	virtual Notification* dequeueNotification() = 0;
+	virtual Notification* waitDequeueNotification() = 0;
+	virtual Notification* waitDequeueNotification(long milliseconds) = 0;
+	virtual void wakeUpAll() = 0;
+	virtual bool empty() const = 0;
+	virtual void clear() = 0;
+	virtual bool hasIdleThreads() const = 0;
+
+private:
+	AbstractNotificationQueue(const AbstractNotificationQueue&);
+	AbstractNotificationQueue& operator = (const AbstractNotificationQueue&);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AbstractNotificationQueue_INCLUDED
@@ -46,6 +46,7 @@
 #include "Poco/ActiveStarter.h"
 #include "Poco/ActiveRunnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/AbstractNotificationQueue.h"
 
 
 namespace Poco {
@@ -100,6 +101,15 @@ public:
 		/// Creates the ActiveDispatcher and sets
 		/// the priority of its thread.
 
+	ActiveDispatcher(Thread::Priority prio, std::size_t queueCapacity);
+		/// Creates the ActiveDispatcher and sets
+		/// the priority of its thread.
+		///
+		/// Methods are queued in a LockFreeNotificationQueue
+		/// with the given capacity. If the queue is full,
+		/// starting a method blocks until a queued method
+		/// has been dispatched.
+
 	virtual ~ActiveDispatcher();
 		/// Destroys the ActiveDispatcher.
 
@@ -114,8 +124,8 @@ protected:
 	void stop();
 
 private:
-	Thread            _thread;
-	NotificationQueue _queue;
+	Thread                     _thread;
+	AbstractNotificationQueue* _pQueue;
 };
 
 
@@ -46,6 +46,7 @@
 #include "Poco/Mutex.h"
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/AbstractNotificationQueue.h"
 
 
 namespace Poco {
@@ -101,18 +102,33 @@ public:
 		///    * highest
 		///
 		/// The "priority" property is set-only.
+		///
+		/// The "queueCapacity" property allows using a bounded
+		/// LockFreeNotificationQueue with the given capacity,
+		/// instead of the default NotificationQueue. This avoids
+		/// contention between threads that log concurrently.
+		/// If the queue is full, logging blocks until the
+		/// background thread has processed a message.
+		/// A capacity of 0 (default) selects the default
+		/// NotificationQueue.
+		///
+		/// The "queueCapacity" property is set-only and can
+		/// only be set before the channel is opened for the
+		/// first time (explicitly, or by logging a message).
 
 protected:
 	~AsyncChannel();
 	void run();
 	void setPriority(const std::string& value);
+	void setQueueCapacity(const std::string& value);
 		
 private:
 	Channel*  _pChannel;
 	Thread    _thread;
 	FastMutex _threadMutex;
 	FastMutex _channelMutex;
-	NotificationQueue _queue;
+	AbstractNotificationQueue* _pQueue;
+	bool      _opened;
 };
 
 
@@ -0,0 +1,181 @@
+//
+// BatchingChannel.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/BatchingChannel.h#1 $
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BatchingChannel
+//
+// Definition of the BatchingChannel class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_BatchingChannel_INCLUDED
+#define Foundation_BatchingChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/Message.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Runnable.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API BatchingChannel: public Channel, public Runnable
+	/// A channel that collects log messages in buffers and
+	/// passes them on to its target channel in batches, using
+	/// a separate thread.
+	///
+	/// Like AsyncChannel, BatchingChannel moves the cost of
+	/// writing log messages out of the logging threads. Unlike
+	/// AsyncChannel, it does not allocate a notification for
+	/// every message and does not funnel all threads through
+	/// a single queue. Instead, messages are copied into one of
+	/// several buffers of preallocated Message objects, selected
+	/// by the ID of the logging thread, so that threads that log
+	/// concurrently rarely compete for the same lock. Since the
+	/// Message objects in the buffers are reused (see Message::assign()),
+	/// buffering a message does not allocate memory once the
+	/// buffers have warmed up.
+	///
+	/// The background thread periodically (see the "flushInterval"
+	/// property), or when a buffer becomes half full, takes over
+	/// the content of all buffers and passes it to the target
+	/// channel using Channel::logBatch(). Channels such as
+	/// FileChannel write a whole batch at once.
+	///
+	/// If a buffer is full, the logging thread passes the buffer
+	/// to the target channel itself. The order of the messages
+	/// logged by a single thread is preserved, but messages
+	/// from different threads may be reordered.
+{
+public:
+	BatchingChannel(Channel* pChannel = 0, Thread::Priority prio = Thread::PRIO_NORMAL);
+		/// Creates the BatchingChannel and connects it to
+		/// the given channel.
+
+	void setChannel(Channel* pChannel);
+		/// Connects the BatchingChannel to the given target channel.
+		/// All messages will be forwarded to this channel.
+		
+	Channel* getChannel() const;
+		/// Returns the target channel.
+
+	void open();
+		/// Opens the channel and creates the 
+		/// background logging thread.
+		
+	void close();
+		/// Closes the channel, stops the background
+		/// logging thread and passes all buffered
+		/// messages to the target channel.
+
+	void log(const Message& msg);
+		/// Buffers the message for processing by the
+		/// background thread.
+
+	void flush();
+		/// Passes all buffered messages to the target channel.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets or changes a configuration property.
+		///
+		/// The "channel" property allows setting the target 
+		/// channel via the LoggingRegistry.
+		/// The "channel" property is set-only.
+		///
+		/// The "priority" property allows setting the thread
+		/// priority. The following values are supported:
+		///    * lowest
+		///    * low
+		///    * normal (default)
+		///    * high
+		///    * highest
+		///
+		/// The "priority" property is set-only.
+		///
+		/// The "batchSize" property specifies the number of
+		/// messages each buffer can hold (default 256).
+		/// It can only be set while the channel is closed.
+		///
+		/// The "flushInterval" property specifies the maximum
+		/// time in milliseconds (default 100) messages are
+		/// buffered before they are passed on. It must be
+		/// greater than zero.
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the "batchSize" or "flushInterval"
+		/// property.
+
+	enum
+	{
+		BUFFER_COUNT = 16,
+		DEFAULT_BATCH_SIZE = 256,
+		DEFAULT_FLUSH_INTERVAL = 100
+	};
+
+protected:
+	~BatchingChannel();
+	void run();
+	void setPriority(const std::string& value);
+	void setBatchSize(std::size_t batchSize);
+	void setFlushInterval(long flushInterval);
+
+private:
+	struct Buffer;
+
+	Buffer& currentBuffer();
+	void drain(Buffer& buffer);
+		/// Passes the messages in the buffer to the target channel.
+		/// Must be called with _channelMutex locked, which guards
+		/// both _pChannel and _batch.
+
+	Channel*             _pChannel;
+	Thread               _thread;
+	std::vector<Buffer*> _buffers;
+	std::vector<Message> _batch;
+	std::size_t          _batchSize;
+	long                 _flushInterval;
+	Event                _wakeUp;
+	volatile bool        _stop;
+	FastMutex            _threadMutex;
+	mutable FastMutex    _channelMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BatchingChannel_INCLUDED
@@ -78,6 +78,14 @@ public:
 		///
 		/// If the channel has not been opened yet, the log()
 		/// method will open it.
+
+	virtual void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given array of count messages to the channel.
+		///
+		/// Channels that can write several messages at once
+		/// more efficiently than one at a time (e.g., FileChannel)
+		/// override this. The default implementation calls log()
+		/// for every message.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Throws a PropertyNotSupportedException.
@@ -0,0 +1,433 @@
+//
+// ConcurrentCache.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/ConcurrentCache.h#1 $
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentCache
+//
+// Definition of the ConcurrentCache class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentCache_INCLUDED
+#define Foundation_ConcurrentCache_INCLUDED
+
+
+#include "Poco/KeyValueArgs.h"
+#include "Poco/ValidArgs.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include "Poco/FIFOEvent.h"
+#include "Poco/EventArgs.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Hash.h"
+#include <map>
+#include <set>
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class TStrategy,
+	class THash = Hash<TKey>,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class ConcurrentCache
+	/// A ConcurrentCache is a cache with the same interface as
+	/// AbstractCache, designed for being accessed by many threads
+	/// at the same time.
+	///
+	/// The key space is divided into a number of shards, selected
+	/// by the hash of the key. Every shard has its own mutex, its own
+	/// strategy and its own part of the data, so threads accessing
+	/// keys in different shards do not contend with each other.
+	/// The consequence is that replacement decisions are made per
+	/// shard. For example, with an LRUStrategy, the least recently
+	/// used entry of the shard receiving a new entry is removed,
+	/// which is only an approximation of the globally least recently
+	/// used entry. The capacity is split evenly among the shards.
+	///
+	/// Unlike AbstractCache, which connects the strategy through
+	/// events, ConcurrentCache calls the strategy directly. The public
+	/// events are only notified if at least one delegate has been
+	/// registered, so they cost nothing if nobody is interested.
+	///
+	/// Any strategy usable with AbstractCache can be used, as long
+	/// as copies of it do not share state. This excludes
+	/// StrategyCollection.
+{
+public:
+	template <class TArgs>
+	class Event: public FIFOEvent<TArgs, TEventMutex>
+		/// A FIFOEvent that keeps track of whether any delegates
+		/// are registered, without having to lock the event's mutex.
+	{
+	public:
+		typedef FIFOEvent<TArgs, TEventMutex> Base;
+
+		Event()
+		{
+		}
+
+		~Event()
+		{
+		}
+
+		void operator += (const AbstractDelegate<TArgs>& aDelegate)
+		{
+			Base::operator += (aDelegate);
+			update();
+		}
+
+		void operator -= (const AbstractDelegate<TArgs>& aDelegate)
+		{
+			Base::operator -= (aDelegate);
+			update();
+		}
+
+		void clear()
+		{
+			Base::clear();
+			update();
+		}
+
+		bool active() const
+			/// Returns true if at least one delegate is registered.
+		{
+			return _active.value() != 0;
+		}
+
+	private:
+		void update()
+		{
+			_active = Base::empty() ? 0 : 1;
+		}
+
+		AtomicCounter _active;
+	};
+
+	Event<const KeyValueArgs<TKey, TValue> > Add;
+	Event<const KeyValueArgs<TKey, TValue> > Update;
+	Event<const TKey>                        Remove;
+	Event<const TKey>                        Get;
+	Event<const EventArgs>                   Clear;
+
+	typedef std::map<TKey, SharedPtr<TValue> > DataHolder;
+	typedef typename DataHolder::iterator       Iterator;
+	typedef typename DataHolder::const_iterator ConstIterator;
+	typedef std::set<TKey>                      KeySet;
+
+	enum
+	{
+		DEFAULT_SHARD_COUNT = 16
+	};
+
+	ConcurrentCache(const TStrategy& strategy, std::size_t shardCount = DEFAULT_SHARD_COUNT)
+		/// Creates the ConcurrentCache with the given number of shards.
+		/// Every shard gets its own copy of the given strategy.
+	{
+		if (shardCount < 1) throw InvalidArgumentException("shardCount must be > 0");
+		_shards.reserve(shardCount);
+		try
+		{
+			for (std::size_t i = 0; i < shardCount; ++i)
+			{
+				_shards.push_back(new Shard(strategy));
+			}
+		}
+		catch (...)
+		{
+			destroyShards();
+			throw;
+		}
+	}
+
+	virtual ~ConcurrentCache()
+	{
+		destroyShards();
+	}
+
+	void add(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doAdd(shard, key, SharedPtr<TValue>(new TValue(val)));
+	}
+
+	void add(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten, ie. first a remove event
+		/// is thrown, then a add event
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doAdd(shard, key, val);
+	}
+
+	void update(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten,
+		/// without remove and add events being thrown.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doUpdate(shard, key, SharedPtr<TValue>(new TValue(val)));
+	}
+
+	void update(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten,
+		/// without remove and add events being thrown.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doUpdate(shard, key, val);
+	}
+
+	void remove(const TKey& key)
+		/// Removes an entry from the cache. If the entry is not found,
+		/// the remove is ignored.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		doRemove(shard, shard.data.find(key));
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true if the cache contains a value for the key.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		return doHas(shard, key);
+	}
+
+	SharedPtr<TValue> get(const TKey& key)
+		/// Returns a SharedPtr of the value. The SharedPointer will remain valid
+		/// even when cache replacement removes the element.
+		/// If for the key no value exists, an empty SharedPtr is returned.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		return doGet(shard, key);
+	}
+
+	void clear()
+		/// Removes all elements from the cache.
+		///
+		/// Shards are cleared one after the other, so entries
+		/// added concurrently may survive.
+	{
+		static EventArgs emptyArgs;
+		if (Clear.active()) Clear.notify(this, emptyArgs);
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			(*it)->strategy.onClear(this, emptyArgs);
+			(*it)->data.clear();
+		}
+	}
+
+	std::size_t size()
+		/// Returns the number of cached elements.
+	{
+		std::size_t result = 0;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			doReplace(**it);
+			result += (*it)->data.size();
+		}
+		return result;
+	}
+
+	void forceReplace()
+		/// Forces cache replacement in all shards. See AbstractCache::forceReplace()
+		/// for details.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			doReplace(**it);
+		}
+	}
+
+	std::set<TKey> getAllKeys()
+		/// Returns a copy of all keys stored in the cache.
+	{
+		std::set<TKey> result;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			doReplace(**it);
+			for (ConstIterator itData = (*it)->data.begin(); itData != (*it)->data.end(); ++itData)
+				result.insert(itData->first);
+		}
+		return result;
+	}
+
+	std::size_t shardCount() const
+		/// Returns the number of shards.
+	{
+		return _shards.size();
+	}
+
+protected:
+	struct Shard
+	{
+		Shard(const TStrategy& strat):
+			strategy(strat)
+		{
+		}
+
+		TStrategy  strategy;
+		DataHolder data;
+		TMutex     mutex;
+	};
+
+	typedef std::vector<Shard*> ShardVec;
+
+	Shard& shardFor(const TKey& key) const
+	{
+		std::size_t h = _hash(key);
+		h ^= h >> 16;
+		return *_shards[h % _shards.size()];
+	}
+
+	void doAdd(Shard& shard, const TKey& key, SharedPtr<TValue> val)
+	{
+		doRemove(shard, shard.data.find(key));
+		KeyValueArgs<TKey, TValue> args(key, *val);
+		shard.strategy.onAdd(this, args);
+		if (Add.active()) Add.notify(this, args);
+		shard.data.insert(std::make_pair(key, val));
+
+		doReplace(shard);
+	}
+
+	void doUpdate(Shard& shard, const TKey& key, SharedPtr<TValue> val)
+	{
+		KeyValueArgs<TKey, TValue> args(key, *val);
+		Iterator it = shard.data.find(key);
+		if (it == shard.data.end())
+		{
+			shard.strategy.onAdd(this, args);
+			if (Add.active()) Add.notify(this, args);
+			shard.data.insert(std::make_pair(key, val));
+		}
+		else
+		{
+			shard.strategy.onUpdate(this, args);
+			if (Update.active()) Update.notify(this, args);
+			it->second = val;
+		}
+
+		doReplace(shard);
+	}
+
+	void doRemove(Shard& shard, Iterator it)
+	{
+		if (it != shard.data.end())
+		{
+			shard.strategy.onRemove(this, it->first);
+			if (Remove.active()) Remove.notify(this, it->first);
+			shard.data.erase(it);
+		}
+	}
+
+	bool doHas(Shard& shard, const TKey& key) const
+	{
+		if (shard.data.find(key) != shard.data.end())
+		{
+			ValidArgs<TKey> args(key);
+			shard.strategy.onIsValid(this, args);
+			return args.isValid();
+		}
+		return false;
+	}
+
+	SharedPtr<TValue> doGet(Shard& shard, const TKey& key)
+	{
+		SharedPtr<TValue> result;
+		Iterator it = shard.data.find(key);
+		if (it != shard.data.end())
+		{
+			shard.strategy.onGet(this, key);
+			if (Get.active()) Get.notify(this, key);
+			ValidArgs<TKey> args(key);
+			shard.strategy.onIsValid(this, args);
+			if (args.isValid())
+				result = it->second;
+			else
+				doRemove(shard, it);
+		}
+		return result;
+	}
+
+	void doReplace(Shard& shard)
+	{
+		std::set<TKey> delMe;
+		shard.strategy.onReplace(this, delMe);
+		for (typename std::set<TKey>::const_iterator it = delMe.begin(); it != delMe.end(); ++it)
+		{
+			doRemove(shard, shard.data.find(*it));
+		}
+	}
+
+	void destroyShards()
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			delete *it;
+		}
+		_shards.clear();
+	}
+
+	ShardVec _shards;
+	THash    _hash;
+
+private:
+	ConcurrentCache(const ConcurrentCache& aCache);
+	ConcurrentCache& operator = (const ConcurrentCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentCache_INCLUDED
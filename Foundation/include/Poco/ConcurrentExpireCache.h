@@ -0,0 +1,84 @@
+//
+// ConcurrentExpireCache.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/ConcurrentExpireCache.h#1 $
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentExpireCache
+//
+// Definition of the ConcurrentExpireCache class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentExpireCache_INCLUDED
+#define Foundation_ConcurrentExpireCache_INCLUDED
+
+
+#include "Poco/ConcurrentCache.h"
+#include "Poco/ExpireStrategy.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = Hash<TKey>,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class ConcurrentExpireCache: public ConcurrentCache<TKey, TValue, ExpireStrategy<TKey, TValue>, THash, TMutex, TEventMutex>
+	/// A ConcurrentExpireCache caches entries for a fixed time period
+	/// (per default 10 minutes), like ExpireCache, but is designed
+	/// for concurrent use. See ConcurrentCache for details.
+	///
+	/// For entries that expire after they have not been accessed for
+	/// the given time, use ConcurrentCache with an AccessExpireStrategy.
+{
+public:
+	ConcurrentExpireCache(Timestamp::TimeDiff expire = 600000, std::size_t shardCount = 16):
+		ConcurrentCache<TKey, TValue, ExpireStrategy<TKey, TValue>, THash, TMutex, TEventMutex>(ExpireStrategy<TKey, TValue>(expire), shardCount)
+	{
+	}
+
+	~ConcurrentExpireCache()
+	{
+	}
+
+private:
+	ConcurrentExpireCache(const ConcurrentExpireCache& aCache);
+	ConcurrentExpireCache& operator = (const ConcurrentExpireCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentExpireCache_INCLUDED
@@ -200,6 +200,14 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the file.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given messages to the file, using a single
+		/// write (and, if the "flush" property is true, a single
+		/// flush) for the whole batch.
+		///
+		/// Rotation is checked once per batch, so a batch is never
+		/// split across two log files.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name. 
@@ -261,6 +269,7 @@ protected:
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
 	void purge();
+	void checkRotation();
 
 private:
 	std::string      _path;
@@ -276,6 +285,7 @@ private:
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
+	std::string      _batchText;
 	FastMutex        _mutex;
 };
 
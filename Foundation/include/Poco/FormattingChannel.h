@@ -42,6 +42,9 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Channel.h"
+#include "Poco/Message.h"
+#include "Poco/Mutex.h"
+#include <vector>
 
 
 namespace Poco {
@@ -88,6 +91,13 @@ public:
 		/// passes the formatted message on to the destination
 		/// Channel.
 
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Formats the given messages and passes them on to
+		/// the destination Channel as a single batch.
+		///
+		/// The formatted messages are kept in a buffer that
+		/// is reused for subsequent batches.
+
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets or changes a configuration property.
 		///
@@ -109,6 +119,9 @@ protected:
 private:
 	Formatter* _pFormatter;
 	Channel* _pChannel;
+	std::vector<Message> _batch;
+	std::string _text;
+	FastMutex _batchMutex;
 };
 
 
@@ -0,0 +1,232 @@
+//
+// LockFreeNotificationQueue.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/LockFreeNotificationQueue.h#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  LockFreeNotificationQueue
+//
+// Definition of the LockFreeNotificationQueue class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_LockFreeNotificationQueue_INCLUDED
+#define Foundation_LockFreeNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Condition.h"
+#include "Poco/Mutex.h"
+#include <deque>
+
+
+namespace Poco {
+
+
+class NotificationCenter;
+
+
+class Foundation_API LockFreeNotificationQueue
+	/// A bounded NotificationQueue that allows multiple producers
+	/// and multiple consumers to enqueue and dequeue notifications
+	/// without acquiring a mutex.
+	///
+	/// Notifications are stored in a fixed-size ring buffer, whose
+	/// slots are claimed with atomic compare-and-swap operations.
+	/// Producers and consumers only contend on the individual slots
+	/// they access, not on a common lock.
+	///
+	/// A mutex is only used for parking threads that have
+	/// to wait, similar to a futex: a consumer that finds the
+	/// queue empty in waitDequeueNotification() (or a producer
+	/// that finds it full in enqueueNotification()) registers itself
+	/// as waiting and blocks on a Condition. Threads on the other
+	/// side only acquire the mutex to wake up a waiting thread if
+	/// there actually is one.
+	///
+	/// Since the queue is bounded, enqueueNotification() blocks
+	/// while the queue is full.
+	///
+	/// Urgent notifications (enqueueUrgentNotification()) are
+	/// kept in a separate, mutex-protected queue that is checked
+	/// before the ring buffer. They should only be used for
+	/// rare out-of-band notifications.
+	///
+	/// The values returned by size() and empty() are a snapshot
+	/// that may already be outdated when the function returns.
+	///
+	/// A LockFreeNotificationQueue has the same interface as a
+	/// NotificationQueue, but does not derive from it. Use
+	/// NotificationQueueAdapter to select either queue at run time.
+	/// The same considerations regarding shutting down a queue
+	/// with waiting worker threads apply.
+{
+public:
+	enum
+	{
+		DEFAULT_CAPACITY = 1024
+	};
+
+	explicit LockFreeNotificationQueue(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the LockFreeNotificationQueue.
+		///
+		/// The capacity is rounded up to the next power of two.
+
+	~LockFreeNotificationQueue();
+		/// Destroys the LockFreeNotificationQueue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO).
+		///
+		/// If the queue is full, waits until a notification
+		/// has been dequeued.
+
+	void enqueueUrgentNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the front of the queue (LIFO). The event therefore gets processed
+		/// before all other events already in the queue.
+		///
+		/// Urgent notifications are not subject to the
+		/// capacity of the queue.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued. 
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+
+	void dispatch(NotificationCenter& notificationCenter);
+		/// Dispatches all queued notifications to the given
+		/// notification center.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting 
+		/// for a notification.
+
+	std::size_t capacity() const;
+		/// Returns the capacity of the queue.
+
+protected:
+	bool tryEnqueue(Notification* pNotification);
+		/// Stores the given notification in the ring buffer.
+		/// On success, the queue takes over the reference held
+		/// by the caller. Returns false if the queue is full.
+
+	Notification* tryDequeue();
+		/// Removes the next notification from the urgent queue
+		/// or the ring buffer, or returns 0 if both are empty.
+
+	Notification* waitDequeue(long milliseconds);
+		/// Implements waitDequeueNotification(). If milliseconds
+		/// is negative, waits without a timeout.
+
+	void wakeUpConsumer();
+	void wakeUpProducer();
+
+private:
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	struct Cell
+	{
+		volatile UInt32 sequence;
+		Notification*   pNf;
+	};
+
+	typedef std::deque<Notification::Ptr> UrgentQueue;
+
+	LockFreeNotificationQueue(const LockFreeNotificationQueue&);
+	LockFreeNotificationQueue& operator = (const LockFreeNotificationQueue&);
+
+	Cell*           _pCells;
+	UInt32          _mask;
+	char            _pad1[CACHE_LINE_SIZE];
+	volatile UInt32 _enqueuePos;
+	char            _pad2[CACHE_LINE_SIZE];
+	volatile UInt32 _dequeuePos;
+	char            _pad3[CACHE_LINE_SIZE];
+	AtomicCounter   _waitingConsumers;
+	AtomicCounter   _waitingProducers;
+	AtomicCounter   _urgentCount;
+	UrgentQueue     _urgentQueue;
+	FastMutex       _urgentMutex;
+	FastMutex       _parkMutex;
+	Condition       _nfAvailable;
+	Condition       _spaceAvailable;
+	int             _wakeUpCount;
+};
+
+
+//
+// inlines
+//
+inline std::size_t LockFreeNotificationQueue::capacity() const
+{
+	return static_cast<std::size_t>(_mask) + 1;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_LockFreeNotificationQueue_INCLUDED
@@ -111,6 +111,16 @@ public:
 		
 	void swap(Message& msg);
 		/// Swaps the message with another one.	
+
+	void assign(const Message& msg);
+		/// Assigns the content of another message, member
+		/// by member.
+		///
+		/// Unlike the assignment operator, assign() reuses
+		/// the storage already allocated by this message's
+		/// strings, so assigning messages of similar size
+		/// to a Message object over and over again does
+		/// not allocate memory.
 		
 	void setSource(const std::string& src);
 		/// Sets the source of the message.
@@ -69,6 +69,9 @@ class Foundation_API NotificationQueue
 	///   2. call the wakeUpAll() method
 	///   3. join each worker thread
 	///   4. destroy the notification queue.
+	///
+	/// See LockFreeNotificationQueue for a bounded variant that
+	/// does not serialize producers and consumers on a mutex.
 {
 public:
 	NotificationQueue();
@@ -0,0 +1,126 @@
+//
+// NotificationQueueAdapter.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/NotificationQueueAdapter.h#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  NotificationQueue
+//
+// Definition of the NotificationQueueAdapter class template.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef Foundation_NotificationQueueAdapter_INCLUDED
+#define Foundation_NotificationQueueAdapter_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AbstractNotificationQueue.h"
+
+
+namespace Poco {
+
+
+template <class Q>
+class NotificationQueueAdapter: public AbstractNotificationQueue
+	/// Makes a notification queue of class Q (NotificationQueue
+	/// or LockFreeNotificationQueue) available through the
+	/// AbstractNotificationQueue interface.
+	///
+	/// The queue is owned by the adapter.
+{
+public:
+	NotificationQueueAdapter()
+	{
+	}
+
+	template <class A>
+	explicit NotificationQueueAdapter(const A& arg):
+		_queue(arg)
+	{
+	}
+
+	~NotificationQueueAdapter()
+	{
+	}
+
+	void enqueueNotification(Notification::Ptr pNotification)
+	{
+		_queue.enqueueNotification(pNotification);
+	}
+
+	Notification* dequeueNotification()
+	{
+		return _queue.dequeueNotification();
+	}
+
+	Notification* waitDequeueNotification()
+	{
+		return _queue.waitDequeueNotification();
+	}
+
+	Notification* waitDequeueNotification(long milliseconds)
+	{
+		return _queue.waitDequeueNotification(milliseconds);
+	}
+
+	void wakeUpAll()
+	{
+		_queue.wakeUpAll();
+	}
+
+	bool empty() const
+	{
+		return _queue.empty();
+	}
+
+	void clear()
+	{
+		_queue.clear();
+	}
+
+	bool hasIdleThreads() const
+	{
+		return _queue.hasIdleThreads();
+	}
+
+	Q& queue()
+		/// Returns the adapted queue.
+	{
+		return _queue;
+	}
+
+private:
+	Q _queue;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_NotificationQueueAdapter_INCLUDED
@@ -67,6 +67,10 @@ public:
 		/// Sends the given Message to all
 		/// attaches channels. 
 
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Sends the given batch of messages to all
+		/// attached channels.
+
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets or changes a configuration property.
 		///
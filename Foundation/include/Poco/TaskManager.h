@@ -54,6 +54,7 @@ namespace Poco {
 
 class Notification;
 class ThreadPool;
+class WorkStealingExecutor;
 class Exception;
 
 
@@ -80,12 +81,21 @@ public:
 		/// Creates the TaskManager, using the
 		/// given ThreadPool.
 
+	TaskManager(WorkStealingExecutor& executor);
+		/// Creates the TaskManager, using the given
+		/// WorkStealingExecutor to run tasks.
+		///
+		/// This is suitable for a large number of short
+		/// tasks. Every task occupies a worker thread of
+		/// the executor while it runs.
+
 	~TaskManager();
 		/// Destroys the TaskManager.
 
 	void start(Task* pTask);
 		/// Starts the given task in a thread obtained
-		/// from the thread pool.
+		/// from the thread pool, or queues it for
+		/// execution by the WorkStealingExecutor.
 		///
 		/// The TaskManager takes ownership of the Task object
 		/// and deletes it when it it finished.
@@ -101,7 +111,9 @@ public:
 		/// TaskManager's ThreadPool to complete. If the
 		/// ThreadPool has threads created by other
 		/// facilities, these threads must also complete
-		/// before joinAll() can return.
+		/// before joinAll() can return. The same applies
+		/// to tasks started by other facilities in the
+		/// TaskManager's WorkStealingExecutor.
 
 	TaskList taskList() const;
 		/// Returns a copy of the internal task list.
@@ -132,11 +144,12 @@ protected:
 	void taskFailed(Task* pTask, const Exception& exc);
 
 private:
-	ThreadPool&        _threadPool;
-	TaskList           _taskList;
-	Timestamp          _lastProgressNotification;
-	NotificationCenter _nc;
-	mutable FastMutex  _mutex;
+	ThreadPool*           _pThreadPool;
+	WorkStealingExecutor* _pExecutor;
+	TaskList              _taskList;
+	Timestamp             _lastProgressNotification;
+	NotificationCenter    _nc;
+	mutable FastMutex     _mutex;
 
 	friend class Task;
 };
@@ -53,6 +53,7 @@ namespace Poco {
 
 class AbstractTimerCallback;
 class ThreadPool;
+class WorkStealingExecutor;
 
 
 class Foundation_API Timer: protected Runnable
@@ -123,6 +124,17 @@ public:
 		/// Create the TimerCallback as follows:
 		///     TimerCallback<MyClass> callback(*this, &MyClass::onTimer);
 		///     timer.start(callback);
+
+	void start(const AbstractTimerCallback& method, WorkStealingExecutor& executor);
+		/// Starts the timer in a thread of its own, and runs
+		/// the callback method in a worker thread of the given
+		/// WorkStealingExecutor.
+		///
+		/// A worker thread is only occupied while the callback
+		/// method runs. The callback method should therefore
+		/// be short, as required for all tasks run by the executor.
+		///
+		/// The timer must be stopped before the executor is destroyed.
 		
 	void stop();
 		/// Stops the timer. If the callback method is currently running
@@ -161,14 +173,19 @@ public:
 
 protected:
 	void run();
+	void invokeCallback();
+	void runCallback();
 
 private:
 	volatile long _startInterval;
 	volatile long _periodicInterval;
 	Event         _wakeUp;
 	Event         _done;
+	Event         _callbackDone;
 	long          _skipped;
 	AbstractTimerCallback* _pCallback;
+	WorkStealingExecutor*  _pExecutor;
+	Thread*                _pThread;
 	Timestamp              _nextInvocation;
 	mutable FastMutex      _mutex;
 	
@@ -0,0 +1,335 @@
+//
+// WorkStealingExecutor.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/WorkStealingExecutor.h#1 $
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingExecutor
+//
+// Definition of the WorkStealingExecutor class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_WorkStealingExecutor_INCLUDED
+#define Foundation_WorkStealingExecutor_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Runnable.h"
+#include "Poco/ActiveRunnable.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Condition.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <deque>
+
+
+namespace Poco {
+
+
+class Foundation_API WorkStealingExecutor
+	/// A WorkStealingExecutor runs a large number of small
+	/// tasks on a fixed number of worker threads.
+	///
+	/// In contrast to ThreadPool, which hands every Runnable
+	/// to a thread of its own, a WorkStealingExecutor queues
+	/// tasks. Every worker thread has its own double-ended
+	/// queue. Tasks started from within a worker thread are
+	/// pushed onto that worker's queue, and a worker takes
+	/// tasks from the back of its own queue (which is good for
+	/// cache locality). Tasks started from other threads are
+	/// put into a shared queue. A worker that runs out of
+	/// tasks steals tasks from the front of the queues of the
+	/// other workers, so load is balanced without a central
+	/// dispatcher.
+	///
+	/// Tasks that belong together can be tracked with a
+	/// TaskGroup. When a worker waits for a TaskGroup (e.g., in
+	/// a nested parallelFor()), it executes queued tasks while
+	/// waiting, so nested parallelism does not deadlock.
+	///
+	/// Tasks should not block for a significant amount of
+	/// time, as this takes a worker out of service. Use a
+	/// ThreadPool for long-running tasks.
+	///
+	/// Exceptions thrown by tasks that do not belong to a
+	/// TaskGroup are passed to the ErrorHandler.
+{
+public:
+	class Foundation_API TaskGroup
+		/// A TaskGroup keeps track of a number of tasks
+		/// started by a WorkStealingExecutor, so that the
+		/// tasks can be waited for as a whole.
+		///
+		/// The first exception thrown by a task in the group
+		/// is rethrown by WorkStealingExecutor::wait().
+	{
+	public:
+		TaskGroup();
+			/// Creates the TaskGroup.
+
+		~TaskGroup();
+			/// Destroys the TaskGroup.
+			///
+			/// The TaskGroup must not be destroyed
+			/// before all its tasks have completed.
+
+		int pending() const;
+			/// Returns the number of tasks in the group
+			/// that have not yet completed.
+
+	protected:
+		void add();
+		bool done();
+			/// Returns true if the last pending task has completed.
+
+		void setException(const Exception& exc);
+		void rethrow();
+
+	private:
+		TaskGroup(const TaskGroup&);
+		TaskGroup& operator = (const TaskGroup&);
+
+		AtomicCounter _pending;
+		Event         _done;
+		FastMutex     _mutex;
+		Exception*    _pException;
+
+		friend class WorkStealingExecutor;
+	};
+
+	WorkStealingExecutor(int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates the WorkStealingExecutor with the given
+		/// number of worker threads. If threads is 0, one
+		/// worker thread per processor is created.
+
+	~WorkStealingExecutor();
+		/// Completes all queued tasks, stops the
+		/// worker threads and destroys the WorkStealingExecutor.
+
+	void start(Runnable& target);
+		/// Queues the given target for execution by
+		/// a worker thread.
+		///
+		/// The target must stay alive until it has been run.
+
+	void start(Runnable& target, TaskGroup& group);
+		/// Queues the given target for execution by
+		/// a worker thread, as part of the given group.
+
+	void wait(TaskGroup& group);
+		/// Waits until all tasks in the group have
+		/// completed. If called from a worker thread, the
+		/// worker executes queued tasks while waiting.
+		///
+		/// If a task in the group has thrown an exception,
+		/// the exception is rethrown.
+
+	void invokeAll(const std::vector<Runnable*>& targets);
+		/// Runs all given targets and waits until they
+		/// have completed.
+		///
+		/// If one of the targets throws an exception, the
+		/// first such exception is rethrown once all
+		/// targets have completed.
+
+	template <class F>
+	void parallelFor(int begin, int end, const F& body, int grainSize = 1)
+		/// Calls body(i) for every i in the range [begin, end),
+		/// in parallel, and waits until all calls have completed.
+		///
+		/// F must be a copyable function object type with a
+		/// const call operator taking an int.
+		///
+		/// The range is recursively split in half, with one half
+		/// being queued as a new task (that may be stolen by another
+		/// worker), until a part is not larger than grainSize.
+		/// grainSize should be chosen so that a part takes
+		/// at least a few microseconds to process.
+		///
+		/// If body throws an exception, the first exception
+		/// is rethrown once all parts have completed.
+	{
+		if (begin >= end) return;
+		if (grainSize < 1) grainSize = 1;
+
+		TaskGroup group;
+		submit(new RangeTask<F>(*this, group, begin, end, grainSize, body), true, &group);
+		wait(group);
+	}
+
+	void joinAll();
+		/// Waits until all queued and running tasks
+		/// have completed.
+
+	int threads() const;
+		/// Returns the number of worker threads.
+
+	int queued() const;
+		/// Returns the number of tasks that have been queued,
+		/// but not yet taken by a worker.
+
+	static WorkStealingExecutor& defaultExecutor();
+		/// Returns a reference to the default
+		/// WorkStealingExecutor.
+
+protected:
+	class Worker;
+
+	struct Job
+	{
+		Runnable*  pTarget;
+		bool       owned;
+		TaskGroup* pGroup;
+	};
+
+	typedef std::deque<Job> JobQueue;
+	typedef std::vector<Worker*> WorkerVec;
+
+	void submit(Runnable* pTarget, bool owned, TaskGroup* pGroup);
+		/// Queues the target. If owned is true, the target is
+		/// deleted after it has been run.
+
+	bool takeJob(Worker* pWorker, Job& job);
+		/// Takes the next job from the worker's own queue, the shared
+		/// queue, or another worker's queue, in that order.
+
+	void runJob(const Job& job);
+	void runWorker(Worker& worker);
+	void waitFor(TaskGroup& group);
+	void groupDone(TaskGroup& group);
+		/// Marks a task in the group as completed, and wakes
+		/// up workers waiting for a group if it was the last one.
+	Worker* currentWorker() const;
+
+	template <class F>
+	class RangeTask: public Runnable
+	{
+	public:
+		RangeTask(WorkStealingExecutor& executor, TaskGroup& group, int begin, int end, int grainSize, const F& body):
+			_executor(executor),
+			_group(group),
+			_begin(begin),
+			_end(end),
+			_grainSize(grainSize),
+			_body(body)
+		{
+		}
+
+		void run()
+		{
+			int end = _end;
+			while (end - _begin > _grainSize)
+			{
+				int mid = _begin + (end - _begin)/2;
+				_executor.submit(new RangeTask(_executor, _group, mid, end, _grainSize, _body), true, &_group);
+				end = mid;
+			}
+			for (int i = _begin; i < end; ++i)
+			{
+				_body(i);
+			}
+		}
+
+	private:
+		WorkStealingExecutor& _executor;
+		TaskGroup&            _group;
+		int                   _begin;
+		int                   _end;
+		int                   _grainSize;
+		F                     _body;
+	};
+
+private:
+	WorkStealingExecutor(const WorkStealingExecutor&);
+	WorkStealingExecutor& operator = (const WorkStealingExecutor&);
+
+	WorkerVec     _workers;
+	JobQueue      _queue;
+	FastMutex     _queueMutex;
+	AtomicCounter _queued;
+	AtomicCounter _idle;
+	AtomicCounter _waiting;
+	FastMutex     _parkMutex;
+	Condition     _wakeUp;
+	bool          _stopped;
+	TaskGroup     _allTasks;
+};
+
+
+template <class OwnerType>
+class WorkStealingStarter
+	/// An implementation of the StarterType policy
+	/// for ActiveMethod that runs the method on the
+	/// default WorkStealingExecutor.
+{
+public:
+	static void start(OwnerType* pOwner, ActiveRunnableBase::Ptr pRunnable)
+	{
+		pRunnable->duplicate(); // The runnable will release itself.
+		try
+		{
+			WorkStealingExecutor::defaultExecutor().start(*pRunnable);
+		}
+		catch (...)
+		{
+			pRunnable->release();
+			throw;
+		}
+	}
+};
+
+
+//
+// inlines
+//
+inline int WorkStealingExecutor::TaskGroup::pending() const
+{
+	return _pending.value();
+}
+
+
+inline int WorkStealingExecutor::threads() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline int WorkStealingExecutor::queued() const
+{
+	return _queued.value();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingExecutor_INCLUDED
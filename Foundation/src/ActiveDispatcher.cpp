@@ -35,6 +35,8 @@
 
 
 #include "Poco/ActiveDispatcher.h"
+#include "Poco/NotificationQueueAdapter.h"
+#include "Poco/LockFreeNotificationQueue.h"
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
 
@@ -67,13 +69,23 @@ namespace
 }
 
 
-ActiveDispatcher::ActiveDispatcher()
+ActiveDispatcher::ActiveDispatcher():
+	_pQueue(new NotificationQueueAdapter<NotificationQueue>)
 {
 	_thread.start(*this);
 }
 
 
-ActiveDispatcher::ActiveDispatcher(Thread::Priority prio)
+ActiveDispatcher::ActiveDispatcher(Thread::Priority prio):
+	_pQueue(new NotificationQueueAdapter<NotificationQueue>)
+{
+	_thread.setPriority(prio);
+	_thread.start(*this);
+}
+
+
+ActiveDispatcher::ActiveDispatcher(Thread::Priority prio, std::size_t queueCapacity):
+	_pQueue(new NotificationQueueAdapter<LockFreeNotificationQueue>(queueCapacity))
 {
 	_thread.setPriority(prio);
 	_thread.start(*this);
@@ -89,6 +101,7 @@ ActiveDispatcher::~ActiveDispatcher()
 	catch (...)
 	{
 	}
+	delete _pQueue;
 }
 
 
@@ -96,19 +109,19 @@ void ActiveDispatcher::start(ActiveRunnableBase::Ptr pRunnable)
 {
 	poco_check_ptr (pRunnable);
 
-	_queue.enqueueNotification(new MethodNotification(pRunnable));
+	_pQueue->enqueueNotification(new MethodNotification(pRunnable));
 }
 
 
 void ActiveDispatcher::cancel()
 {
-	_queue.clear();
+	_pQueue->clear();
 }
 
 
 void ActiveDispatcher::run()
 {
-	AutoPtr<Notification> pNf = _queue.waitDequeueNotification();
+	AutoPtr<Notification> pNf = _pQueue->waitDequeueNotification();
 	while (pNf && !dynamic_cast<StopNotification*>(pNf.get()))
 	{
 		MethodNotification* pMethodNf = dynamic_cast<MethodNotification*>(pNf.get());
@@ -116,16 +129,16 @@ void ActiveDispatcher::run()
 		ActiveRunnableBase::Ptr pRunnable = pMethodNf->runnable();
 		pRunnable->duplicate(); // run will release
 		pRunnable->run();
-		pNf = _queue.waitDequeueNotification();
+		pNf = _pQueue->waitDequeueNotification();
 	}
 }
 
 
 void ActiveDispatcher::stop()
 {
-	_queue.clear();
-	_queue.wakeUpAll();
-	_queue.enqueueNotification(new StopNotification);
+	_pQueue->clear();
+	_pQueue->wakeUpAll();
+	_pQueue->enqueueNotification(new StopNotification);
 	_thread.join();
 }
 
@@ -35,11 +35,14 @@
 
 
 #include "Poco/AsyncChannel.h"
+#include "Poco/NotificationQueueAdapter.h"
+#include "Poco/LockFreeNotificationQueue.h"
 #include "Poco/Notification.h"
 #include "Poco/Message.h"
 #include "Poco/Formatter.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/LoggingRegistry.h"
+#include "Poco/NumberParser.h"
 #include "Poco/Exception.h"
 
 
@@ -70,7 +73,9 @@ private:
 
 AsyncChannel::AsyncChannel(Channel* pChannel, Thread::Priority prio): 
 	_pChannel(pChannel), 
-	_thread("AsyncChannel")
+	_thread("AsyncChannel"),
+	_pQueue(new NotificationQueueAdapter<NotificationQueue>),
+	_opened(false)
 {
 	if (_pChannel) _pChannel->duplicate();
 	_thread.setPriority(prio);
@@ -81,6 +86,7 @@ AsyncChannel::~AsyncChannel()
 {
 	close();
 	if (_pChannel) _pChannel->release();
+	delete _pQueue;
 }
 
 
@@ -104,6 +110,7 @@ void AsyncChannel::open()
 {
 	FastMutex::ScopedLock lock(_threadMutex);
 
+	_opened = true;
 	if (!_thread.isRunning())
 		_thread.start(*this);
 }
@@ -113,11 +120,11 @@ void AsyncChannel::close()
 {
 	if (_thread.isRunning())
 	{
-		while (!_queue.empty()) Thread::sleep(100);
+		while (!_pQueue->empty()) Thread::sleep(100);
 		
 		do 
 		{
-			_queue.wakeUpAll(); 
+			_pQueue->wakeUpAll(); 
 		}
 		while (!_thread.tryJoin(100));
 	}
@@ -128,7 +135,7 @@ void AsyncChannel::log(const Message& msg)
 {
 	open();
 
-	_queue.enqueueNotification(new MessageNotification(msg));
+	_pQueue->enqueueNotification(new MessageNotification(msg));
 }
 
 
@@ -138,6 +145,8 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
 	else if (name == "priority")
 		setPriority(value);
+	else if (name == "queueCapacity")
+		setQueueCapacity(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -145,7 +154,7 @@ void AsyncChannel::setProperty(const std::string& name, const std::string& value
 
 void AsyncChannel::run()
 {
-	AutoPtr<Notification> nf = _queue.waitDequeueNotification();
+	AutoPtr<Notification> nf = _pQueue->waitDequeueNotification();
 	while (nf)
 	{
 		MessageNotification* pNf = dynamic_cast<MessageNotification*>(nf.get());
@@ -154,7 +163,7 @@ void AsyncChannel::run()
 
 			if (pNf && _pChannel) _pChannel->log(pNf->message());
 		}
-		nf = _queue.waitDequeueNotification();
+		nf = _pQueue->waitDequeueNotification();
 	}
 }
 		
@@ -180,4 +189,28 @@ void AsyncChannel::setPriority(const std::string& value)
 }
 
 
+void AsyncChannel::setQueueCapacity(const std::string& value)
+{
+	int capacity = NumberParser::parse(value);
+	if (capacity < 0)
+		throw InvalidArgumentException("queue capacity", value);
+
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	// Once the channel has been opened, log() may use the
+	// queue at any time without holding the mutex, so the
+	// queue must not be replaced anymore.
+	if (_opened)
+		throw IllegalStateException("Cannot change the queue capacity of an AsyncChannel that has been opened");
+
+	AbstractNotificationQueue* pQueue;
+	if (capacity > 0)
+		pQueue = new NotificationQueueAdapter<LockFreeNotificationQueue>(static_cast<std::size_t>(capacity));
+	else
+		pQueue = new NotificationQueueAdapter<NotificationQueue>;
+	delete _pQueue;
+	_pQueue = pQueue;
+}
+
+
 } // namespace Poco
@@ -0,0 +1,304 @@
+//
+// BatchingChannel.cpp
+//
+// $Id: //poco/1.4/Foundation/src/BatchingChannel.cpp#1 $
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BatchingChannel
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/BatchingChannel.h"
+#include "Poco/LoggingRegistry.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+struct BatchingChannel::Buffer
+{
+	Buffer(std::size_t size):
+		messages(size),
+		count(0)
+	{
+	}
+
+	FastMutex            mutex;
+	std::vector<Message> messages;
+	std::size_t          count;
+};
+
+
+BatchingChannel::BatchingChannel(Channel* pChannel, Thread::Priority prio): 
+	_pChannel(pChannel), 
+	_thread("BatchingChannel"),
+	_batch(DEFAULT_BATCH_SIZE),
+	_batchSize(DEFAULT_BATCH_SIZE),
+	_flushInterval(DEFAULT_FLUSH_INTERVAL),
+	_stop(false)
+{
+	if (_pChannel) _pChannel->duplicate();
+	_thread.setPriority(prio);
+	_buffers.reserve(BUFFER_COUNT);
+	for (int i = 0; i < BUFFER_COUNT; ++i)
+	{
+		_buffers.push_back(new Buffer(_batchSize));
+	}
+}
+
+
+BatchingChannel::~BatchingChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+	if (_pChannel) _pChannel->release();
+	for (std::vector<Buffer*>::iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void BatchingChannel::setChannel(Channel* pChannel)
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+	
+	if (_pChannel) _pChannel->release();
+	_pChannel = pChannel;
+	if (_pChannel) _pChannel->duplicate();
+}
+
+
+Channel* BatchingChannel::getChannel() const
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	return _pChannel;
+}
+
+
+void BatchingChannel::open()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (!_thread.isRunning())
+	{
+		_stop = false;
+		_thread.start(*this);
+	}
+}
+
+
+void BatchingChannel::close()
+{
+	{
+		FastMutex::ScopedLock lock(_threadMutex);
+
+		if (_thread.isRunning())
+		{
+			_stop = true;
+			_wakeUp.set();
+			_thread.join();
+		}
+	}
+	flush();
+}
+
+
+void BatchingChannel::log(const Message& msg)
+{
+	if (!_thread.isRunning()) open();
+
+	Buffer& buffer = currentBuffer();
+	for (;;)
+	{
+		{
+			FastMutex::ScopedLock lock(buffer.mutex);
+
+			if (buffer.count < buffer.messages.size())
+			{
+				buffer.messages[buffer.count++].assign(msg);
+				if (buffer.count == (buffer.messages.size() + 1)/2)
+					_wakeUp.set();
+				return;
+			}
+		}
+		// The buffer is full, so the background thread
+		// cannot keep up. Pass the buffer on ourselves.
+		FastMutex::ScopedLock lock(_channelMutex);
+		drain(buffer);
+	}
+}
+
+
+void BatchingChannel::flush()
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	for (std::vector<Buffer*>::iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+	{
+		drain(**it);
+	}
+}
+
+
+void BatchingChannel::setProperty(const std::string& name, const std::string& value)
+{
+	if (name == "channel")
+		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
+	else if (name == "priority")
+		setPriority(value);
+	else if (name == "batchSize")
+		setBatchSize(NumberParser::parseUnsigned(value));
+	else if (name == "flushInterval")
+		setFlushInterval(NumberParser::parse(value));
+	else
+		Channel::setProperty(name, value);
+}
+
+
+std::string BatchingChannel::getProperty(const std::string& name) const
+{
+	if (name == "batchSize")
+		return NumberFormatter::format(static_cast<unsigned>(_batchSize));
+	else if (name == "flushInterval")
+		return NumberFormatter::format(_flushInterval);
+	else
+		return Channel::getProperty(name);
+}
+
+
+void BatchingChannel::run()
+{
+	while (!_stop)
+	{
+		_wakeUp.tryWait(_flushInterval);
+		try
+		{
+			flush();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
+
+		
+void BatchingChannel::setPriority(const std::string& value)
+{
+	Thread::Priority prio = Thread::PRIO_NORMAL;
+	
+	if (value == "lowest")
+		prio = Thread::PRIO_LOWEST;
+	else if (value == "low")
+		prio = Thread::PRIO_LOW;
+	else if (value == "normal")
+		prio = Thread::PRIO_NORMAL;
+	else if (value == "high")
+		prio = Thread::PRIO_HIGH;
+	else if (value == "highest")
+		prio = Thread::PRIO_HIGHEST;
+	else
+		throw InvalidArgumentException("thread priority", value);
+		
+	_thread.setPriority(prio);
+}
+
+
+void BatchingChannel::setFlushInterval(long flushInterval)
+{
+	if (flushInterval <= 0) throw InvalidArgumentException("flushInterval must be greater than zero");
+
+	_flushInterval = flushInterval;
+}
+
+
+void BatchingChannel::setBatchSize(std::size_t batchSize)
+{
+	if (batchSize == 0) throw InvalidArgumentException("batchSize must be greater than zero");
+	if (_thread.isRunning()) throw IllegalStateException("batchSize cannot be changed while the channel is open");
+
+	flush();
+
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	for (std::vector<Buffer*>::iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+	{
+		(*it)->messages.resize(batchSize);
+	}
+	_batch.resize(batchSize);
+	_batchSize = batchSize;
+}
+
+
+BatchingChannel::Buffer& BatchingChannel::currentBuffer()
+{
+	// Spread the bits of the thread ID, which is often an
+	// aligned address, before selecting a buffer.
+	std::size_t tid = (std::size_t) Thread::currentTid();
+	UInt32 h = static_cast<UInt32>(tid ^ (tid >> 16))*2654435761U;
+	return *_buffers[(h >> 16) % BUFFER_COUNT];
+}
+
+
+void BatchingChannel::drain(Buffer& buffer)
+{
+	std::size_t count;
+	{
+		FastMutex::ScopedLock lock(buffer.mutex);
+
+		count = buffer.count;
+		if (count == 0) return;
+		buffer.messages.swap(_batch);
+		buffer.count = 0;
+	}
+	// _channelMutex is held by the caller
+	if (_pChannel) _pChannel->logBatch(&_batch[0], count);
+}
+
+
+} // namespace Poco
@@ -35,6 +35,7 @@
 
 
 #include "Poco/Channel.h"
+#include "Poco/Message.h"
 
 
 namespace Poco {
@@ -60,6 +61,15 @@ void Channel::close()
 }
 
 
+void Channel::logBatch(const Message* pMessages, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		log(pMessages[i]);
+	}
+}
+
+
 void Channel::setProperty(const std::string& name, const std::string& value)
 {
 	throw PropertyNotSupportedException(name);
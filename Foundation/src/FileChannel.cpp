@@ -136,6 +136,41 @@ void FileChannel::log(const Message& msg)
 
 	FastMutex::ScopedLock lock(_mutex);
 
+	checkRotation();
+	_pFile->write(msg.getText(), _flush);
+}
+
+
+void FileChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	if (count == 0) return;
+
+	open();
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	checkRotation();
+	// LogFile::write() appends the line terminator
+	// of the last message.
+	_batchText.clear();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (i > 0)
+		{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+			_batchText += "\r\n";
+#else
+			_batchText += '\n';
+#endif
+		}
+		_batchText += pMessages[i].getText();
+	}
+	_pFile->write(_batchText, _flush);
+}
+
+
+void FileChannel::checkRotation()
+{
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
 		try
@@ -152,7 +187,6 @@ void FileChannel::log(const Message& msg)
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
 	}
-	_pFile->write(msg.getText(), _flush);
 }
 
 	
@@ -120,6 +120,32 @@ void FormattingChannel::log(const Message& msg)
 }
 
 
+void FormattingChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	if (_pChannel && count > 0)
+	{
+		if (_pFormatter)
+		{
+			FastMutex::ScopedLock lock(_batchMutex);
+
+			if (_batch.size() < count) _batch.resize(count);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				_text.clear();
+				_pFormatter->format(pMessages[i], _text);
+				_batch[i].assign(pMessages[i]);
+				_batch[i].setText(_text);
+			}
+			_pChannel->logBatch(&_batch[0], count);
+		}
+		else
+		{
+			_pChannel->logBatch(pMessages, count);
+		}
+	}
+}
+
+
 void FormattingChannel::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == "channel")
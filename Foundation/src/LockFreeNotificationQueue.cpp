@@ -0,0 +1,423 @@
+//
+// LockFreeNotificationQueue.cpp
+//
+// $Id: //poco/1.4/Foundation/src/LockFreeNotificationQueue.cpp#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  LockFreeNotificationQueue
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/LockFreeNotificationQueue.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/Notification.h"
+#include "Poco/Timestamp.h"
+#if POCO_OS == POCO_OS_WINDOWS_NT
+#include "Poco/UnWindows.h"
+#elif POCO_OS == POCO_OS_MAC_OS_X
+#include <libkern/OSAtomic.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	//
+	// Atomic operations on the ring buffer positions and
+	// slot sequence numbers. compareAndSwap() and fence()
+	// are full memory barriers, load() has acquire and
+	// store() has release semantics.
+	//
+#if POCO_OS == POCO_OS_WINDOWS_NT
+
+	inline bool compareAndSwap(volatile UInt32* pValue, UInt32 expected, UInt32 desired)
+	{
+		return InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(pValue), static_cast<LONG>(desired), static_cast<LONG>(expected)) == static_cast<LONG>(expected);
+	}
+
+	inline UInt32 load(const volatile UInt32* pValue)
+	{
+		UInt32 value = *pValue;
+		MemoryBarrier();
+		return value;
+	}
+
+	inline void store(volatile UInt32* pValue, UInt32 value)
+	{
+		MemoryBarrier();
+		*pValue = value;
+	}
+
+	inline void fence()
+	{
+		MemoryBarrier();
+	}
+
+#elif POCO_OS == POCO_OS_MAC_OS_X
+
+	inline bool compareAndSwap(volatile UInt32* pValue, UInt32 expected, UInt32 desired)
+	{
+		return OSAtomicCompareAndSwap32Barrier(static_cast<int32_t>(expected), static_cast<int32_t>(desired), reinterpret_cast<volatile int32_t*>(pValue));
+	}
+
+	inline UInt32 load(const volatile UInt32* pValue)
+	{
+		UInt32 value = *pValue;
+		OSMemoryBarrier();
+		return value;
+	}
+
+	inline void store(volatile UInt32* pValue, UInt32 value)
+	{
+		OSMemoryBarrier();
+		*pValue = value;
+	}
+
+	inline void fence()
+	{
+		OSMemoryBarrier();
+	}
+
+#elif defined(POCO_HAVE_GCC_ATOMICS)
+
+	inline bool compareAndSwap(volatile UInt32* pValue, UInt32 expected, UInt32 desired)
+	{
+		return __sync_bool_compare_and_swap(pValue, expected, desired);
+	}
+
+	inline UInt32 load(const volatile UInt32* pValue)
+	{
+		UInt32 value = *pValue;
+		__sync_synchronize();
+		return value;
+	}
+
+	inline void store(volatile UInt32* pValue, UInt32 value)
+	{
+		__sync_synchronize();
+		*pValue = value;
+	}
+
+	inline void fence()
+	{
+		__sync_synchronize();
+	}
+
+#else
+
+	FastMutex atomicMutex;
+
+	inline bool compareAndSwap(volatile UInt32* pValue, UInt32 expected, UInt32 desired)
+	{
+		FastMutex::ScopedLock lock(atomicMutex);
+		if (*pValue != expected) return false;
+		*pValue = desired;
+		return true;
+	}
+
+	inline UInt32 load(const volatile UInt32* pValue)
+	{
+		FastMutex::ScopedLock lock(atomicMutex);
+		return *pValue;
+	}
+
+	inline void store(volatile UInt32* pValue, UInt32 value)
+	{
+		FastMutex::ScopedLock lock(atomicMutex);
+		*pValue = value;
+	}
+
+	inline void fence()
+	{
+		FastMutex::ScopedLock lock(atomicMutex);
+	}
+
+#endif
+}
+
+
+LockFreeNotificationQueue::LockFreeNotificationQueue(std::size_t capacity):
+	_pCells(0),
+	_mask(1),
+	_enqueuePos(0),
+	_dequeuePos(0),
+	_wakeUpCount(0)
+{
+	poco_assert (capacity > 0 && capacity <= 0x40000000);
+
+	while (_mask + 1 < capacity) _mask = (_mask << 1) | 1;
+	_pCells = new Cell[_mask + 1];
+	for (UInt32 i = 0; i <= _mask; ++i)
+	{
+		_pCells[i].sequence = i;
+		_pCells[i].pNf = 0;
+	}
+}
+
+
+LockFreeNotificationQueue::~LockFreeNotificationQueue()
+{
+	clear();
+	delete [] _pCells;
+}
+
+
+void LockFreeNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	if (!tryEnqueue(pNf))
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		++_waitingProducers;
+		fence();
+		while (!tryEnqueue(pNf))
+		{
+			_spaceAvailable.wait(_parkMutex);
+		}
+		--_waitingProducers;
+	}
+	wakeUpConsumer();
+}
+
+
+void LockFreeNotificationQueue::enqueueUrgentNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	{
+		FastMutex::ScopedLock lock(_urgentMutex);
+		_urgentQueue.push_front(pNotification);
+		++_urgentCount;
+	}
+	wakeUpConsumer();
+}
+
+
+Notification* LockFreeNotificationQueue::dequeueNotification()
+{
+	Notification* pNf = tryDequeue();
+	if (pNf) wakeUpProducer();
+	return pNf;
+}
+
+
+Notification* LockFreeNotificationQueue::waitDequeueNotification()
+{
+	return waitDequeue(-1);
+}
+
+
+Notification* LockFreeNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	return waitDequeue(milliseconds < 0 ? 0 : milliseconds);
+}
+
+
+void LockFreeNotificationQueue::dispatch(NotificationCenter& notificationCenter)
+{
+	Notification::Ptr pNf = dequeueNotification();
+	while (pNf)
+	{
+		notificationCenter.postNotification(pNf);
+		pNf = dequeueNotification();
+	}
+}
+
+
+void LockFreeNotificationQueue::wakeUpAll()
+{
+	FastMutex::ScopedLock lock(_parkMutex);
+
+	++_wakeUpCount;
+	_nfAvailable.broadcast();
+}
+
+
+bool LockFreeNotificationQueue::empty() const
+{
+	return size() == 0;
+}
+
+
+int LockFreeNotificationQueue::size() const
+{
+	Int32 size = static_cast<Int32>(load(&_enqueuePos) - load(&_dequeuePos));
+	if (size < 0) size = 0;
+	return static_cast<int>(size) + _urgentCount.value();
+}
+
+
+void LockFreeNotificationQueue::clear()
+{
+	Notification* pNf = dequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		pNf = dequeueNotification();
+	}
+}
+
+
+bool LockFreeNotificationQueue::hasIdleThreads() const
+{
+	return _waitingConsumers.value() > 0;
+}
+
+
+bool LockFreeNotificationQueue::tryEnqueue(Notification* pNotification)
+{
+	Cell* pCell;
+	UInt32 pos = load(&_enqueuePos);
+	for (;;)
+	{
+		pCell = &_pCells[pos & _mask];
+		Int32 diff = static_cast<Int32>(load(&pCell->sequence) - pos);
+		if (diff == 0)
+		{
+			if (compareAndSwap(&_enqueuePos, pos, pos + 1)) break;
+		}
+		else if (diff < 0)
+		{
+			// the slot still holds the notification enqueued
+			// one round earlier, so the queue is full
+			return false;
+		}
+		pos = load(&_enqueuePos);
+	}
+	pCell->pNf = pNotification;
+	store(&pCell->sequence, pos + 1);
+	return true;
+}
+
+
+Notification* LockFreeNotificationQueue::tryDequeue()
+{
+	if (_urgentCount.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_urgentMutex);
+		if (!_urgentQueue.empty())
+		{
+			Notification::Ptr pNf = _urgentQueue.front();
+			_urgentQueue.pop_front();
+			--_urgentCount;
+			return pNf.duplicate();
+		}
+	}
+
+	Cell* pCell;
+	UInt32 pos = load(&_dequeuePos);
+	for (;;)
+	{
+		pCell = &_pCells[pos & _mask];
+		Int32 diff = static_cast<Int32>(load(&pCell->sequence) - (pos + 1));
+		if (diff == 0)
+		{
+			if (compareAndSwap(&_dequeuePos, pos, pos + 1)) break;
+		}
+		else if (diff < 0)
+		{
+			// the slot has not been filled yet, so the queue is empty
+			return 0;
+		}
+		pos = load(&_dequeuePos);
+	}
+	Notification* pNf = pCell->pNf;
+	pCell->pNf = 0;
+	store(&pCell->sequence, pos + _mask + 1);
+	return pNf;
+}
+
+
+Notification* LockFreeNotificationQueue::waitDequeue(long milliseconds)
+{
+	Notification* pNf = tryDequeue();
+	if (!pNf)
+	{
+		Timestamp start;
+		FastMutex::ScopedLock lock(_parkMutex);
+
+		int wakeUpCount = _wakeUpCount;
+		++_waitingConsumers;
+		fence();
+		for (;;)
+		{
+			// A producer only signals _nfAvailable if it sees us waiting,
+			// so we must check the queue again after registering.
+			pNf = tryDequeue();
+			if (pNf || wakeUpCount != _wakeUpCount) break;
+			if (milliseconds < 0)
+			{
+				_nfAvailable.wait(_parkMutex);
+			}
+			else
+			{
+				long remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+				if (remaining <= 0 || !_nfAvailable.tryWait(_parkMutex, remaining))
+				{
+					pNf = tryDequeue();
+					break;
+				}
+			}
+		}
+		--_waitingConsumers;
+	}
+	if (pNf) wakeUpProducer();
+	return pNf;
+}
+
+
+void LockFreeNotificationQueue::wakeUpConsumer()
+{
+	// The notification must be visible before we look for
+	// waiting consumers, see waitDequeue().
+	fence();
+	if (_waitingConsumers.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_nfAvailable.signal();
+	}
+}
+
+
+void LockFreeNotificationQueue::wakeUpProducer()
+{
+	fence();
+	if (_waitingProducers.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_spaceAvailable.signal();
+	}
+}
+
+
+} // namespace Poco
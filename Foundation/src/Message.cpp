@@ -169,6 +169,35 @@ void Message::swap(Message& msg)
 }
 
 
+void Message::assign(const Message& msg)
+{
+	if (&msg != this)
+	{
+		_source.assign(msg._source);
+		_text.assign(msg._text);
+		_prio = msg._prio;
+		_time = msg._time;
+		_tid  = msg._tid;
+		_thread.assign(msg._thread);
+		_pid  = msg._pid;
+		_file = msg._file;
+		_line = msg._line;
+		if (msg._pMap)
+		{
+			if (_pMap)
+				*_pMap = *msg._pMap;
+			else
+				_pMap = new StringMap(*msg._pMap);
+		}
+		else
+		{
+			delete _pMap;
+			_pMap = 0;
+		}
+	}
+}
+
+
 void Message::setSource(const std::string& src)
 {
 	_source = src;
@@ -105,6 +105,17 @@ void SplitterChannel::log(const Message& msg)
 }
 
 
+void SplitterChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (ChannelVec::iterator it = _channels.begin(); it != _channels.end(); ++it)
+	{
+		(*it)->logBatch(pMessages, count);
+	}
+}
+
+
 void SplitterChannel::close()
 {
 	FastMutex::ScopedLock lock(_mutex);
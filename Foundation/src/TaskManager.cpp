@@ -37,6 +37,7 @@
 #include "Poco/TaskManager.h"
 #include "Poco/TaskNotification.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingExecutor.h"
 
 
 namespace Poco {
@@ -46,13 +47,22 @@ const int TaskManager::MIN_PROGRESS_NOTIFICATION_INTERVAL = 100000; // 100 milli
 
 
 TaskManager::TaskManager():
-	_threadPool(ThreadPool::defaultPool())
+	_pThreadPool(&ThreadPool::defaultPool()),
+	_pExecutor(0)
 {
 }
 
 
 TaskManager::TaskManager(ThreadPool& pool):
-	_threadPool(pool)
+	_pThreadPool(&pool),
+	_pExecutor(0)
+{
+}
+
+
+TaskManager::TaskManager(WorkStealingExecutor& executor):
+	_pThreadPool(0),
+	_pExecutor(&executor)
 {
 }
 
@@ -72,7 +82,10 @@ void TaskManager::start(Task* pTask)
 	_taskList.push_back(pAutoTask);
 	try
 	{
-		_threadPool.start(*pAutoTask, pAutoTask->name());
+		if (_pExecutor)
+			_pExecutor->start(*pAutoTask);
+		else
+			_pThreadPool->start(*pAutoTask, pAutoTask->name());
 	}
 	catch (...)
 	{
@@ -98,7 +111,10 @@ void TaskManager::cancelAll()
 
 void TaskManager::joinAll()
 {
-	_threadPool.joinAll();
+	if (_pExecutor)
+		_pExecutor->joinAll();
+	else
+		_pThreadPool->joinAll();
 }
 
 
@@ -36,6 +36,8 @@
 
 #include "Poco/Timer.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/RunnableAdapter.h"
 #include "Poco/Exception.h"
 #include "Poco/ErrorHandler.h"
 
@@ -47,7 +49,9 @@ Timer::Timer(long startInterval, long periodicInterval):
 	_startInterval(startInterval), 
 	_periodicInterval(periodicInterval),
 	_skipped(0),
-	_pCallback(0)
+	_pCallback(0),
+	_pExecutor(0),
+	_pThread(0)
 {
 	poco_assert (startInterval >= 0 && periodicInterval >= 0);
 }
@@ -87,11 +91,29 @@ void Timer::start(const AbstractTimerCallback& method, Thread::Priority priority
 	FastMutex::ScopedLock lock(_mutex);	
 	_nextInvocation = nextInvocation;
 	_pCallback = method.clone();
+	_pExecutor = 0;
 	_wakeUp.reset();
 	threadPool.startWithPriority(priority, *this);
 }
 
 
+void Timer::start(const AbstractTimerCallback& method, WorkStealingExecutor& executor)
+{
+	Timestamp nextInvocation;
+	nextInvocation += static_cast<Timestamp::TimeVal>(_startInterval)*1000;
+
+	poco_assert (!_pCallback);
+
+	FastMutex::ScopedLock lock(_mutex);	
+	_nextInvocation = nextInvocation;
+	_pCallback = method.clone();
+	_pExecutor = &executor;
+	_wakeUp.reset();
+	_pThread = new Thread("Timer");
+	_pThread->start(*this);
+}
+
+
 void Timer::stop()
 {
 	FastMutex::ScopedLock lock(_mutex);
@@ -101,6 +123,12 @@ void Timer::stop()
 		_mutex.unlock();
 		_wakeUp.set();
 		_done.wait(); // warning: deadlock if called from timer callback
+		if (_pThread)
+		{
+			_pThread->join();
+			delete _pThread;
+			_pThread = 0;
+		}
 		_mutex.lock();
 		delete _pCallback;
 		_pCallback = 0;
@@ -192,22 +220,15 @@ void Timer::run()
 		}
 		else
 		{
-			try
-			{
-				_pCallback->invoke(*this);
-			}
-			catch (Poco::Exception& exc)
-			{
-				Poco::ErrorHandler::handle(exc);
-			}
-			catch (std::exception& exc)
+			if (_pExecutor)
 			{
-				Poco::ErrorHandler::handle(exc);
-			}
-			catch (...)
-			{
-				Poco::ErrorHandler::handle();
+				// Only the callback runs in a worker thread;
+				// this thread waits for it to complete.
+				RunnableAdapter<Timer> callback(*this, &Timer::runCallback);
+				_pExecutor->start(callback);
+				_callbackDone.wait();
 			}
+			else invokeCallback();
 			interval = _periodicInterval;
 		}
 		_nextInvocation += static_cast<Timestamp::TimeVal>(interval)*1000;
@@ -218,6 +239,34 @@ void Timer::run()
 }
 
 
+void Timer::invokeCallback()
+{
+	try
+	{
+		_pCallback->invoke(*this);
+	}
+	catch (Poco::Exception& exc)
+	{
+		Poco::ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		Poco::ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		Poco::ErrorHandler::handle();
+	}
+}
+
+
+void Timer::runCallback()
+{
+	invokeCallback();
+	_callbackDone.set();
+}
+
+
 long Timer::skipped() const
 {
 	return _skipped;
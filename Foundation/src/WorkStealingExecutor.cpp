@@ -0,0 +1,478 @@
+//
+// WorkStealingExecutor.cpp
+//
+// $Id: //poco/1.4/Foundation/src/WorkStealingExecutor.cpp#1 $
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingExecutor
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Environment.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/SingletonHolder.h"
+#include "Poco/NumberFormatter.h"
+#include <algorithm>
+#include <memory>
+
+
+namespace Poco {
+
+
+//
+// WorkStealingExecutor::TaskGroup
+//
+
+
+WorkStealingExecutor::TaskGroup::TaskGroup():
+	_done(false),
+	_pException(0)
+{
+	_done.set();
+}
+
+
+WorkStealingExecutor::TaskGroup::~TaskGroup()
+{
+	// done() may still hold the mutex after
+	// the waiting thread has been released.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+	}
+	delete _pException;
+}
+
+
+void WorkStealingExecutor::TaskGroup::add()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (++_pending == 1) _done.reset();
+}
+
+
+bool WorkStealingExecutor::TaskGroup::done()
+{
+	// The count and the event are updated together, so
+	// the event is set if and only if no task is pending.
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (--_pending == 0)
+	{
+		_done.set();
+		return true;
+	}
+	return false;
+}
+
+
+void WorkStealingExecutor::TaskGroup::setException(const Exception& exc)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (!_pException) _pException = exc.clone();
+}
+
+
+void WorkStealingExecutor::TaskGroup::rethrow()
+{
+	Exception* pException = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		
+		std::swap(pException, _pException);
+	}
+	if (pException)
+	{
+		std::auto_ptr<Exception> pGuard(pException);
+		pException->rethrow();
+	}
+}
+
+
+//
+// WorkStealingExecutor::Worker
+//
+
+
+class WorkStealingExecutor::Worker: public Runnable
+{
+public:
+	Worker(WorkStealingExecutor& executor, int index, int stackSize):
+		_executor(executor),
+		_index(index),
+		_thread("WorkStealingExecutor[#" + NumberFormatter::format(index) + "]")
+	{
+		_thread.setStackSize(stackSize);
+	}
+
+	void start()
+	{
+		_thread.start(*this);
+	}
+
+	void join()
+	{
+		_thread.join();
+	}
+
+	void run()
+	{
+		_executor.runWorker(*this);
+	}
+
+	void push(const Job& job)
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_jobs.push_back(job);
+	}
+
+	bool popBack(Job& job)
+		/// Used by the worker itself.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_jobs.empty()) return false;
+		job = _jobs.back();
+		_jobs.pop_back();
+		return true;
+	}
+
+	bool popFront(Job& job)
+		/// Used by other workers for stealing.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_jobs.empty()) return false;
+		job = _jobs.front();
+		_jobs.pop_front();
+		return true;
+	}
+
+	WorkStealingExecutor& executor() const
+	{
+		return _executor;
+	}
+
+	int index() const
+	{
+		return _index;
+	}
+
+private:
+	WorkStealingExecutor& _executor;
+	int       _index;
+	Thread    _thread;
+	JobQueue  _jobs;
+	FastMutex _mutex;
+};
+
+
+namespace
+{
+	ThreadLocal<void*> currentWorkerPtr;
+}
+
+
+//
+// WorkStealingExecutor
+//
+
+
+WorkStealingExecutor::WorkStealingExecutor(int threads, int stackSize):
+	_stopped(false)
+{
+	poco_assert (threads >= 0);
+
+	if (threads == 0) threads = static_cast<int>(Environment::processorCount());
+	if (threads == 0) threads = 1;
+	
+	for (int i = 0; i < threads; ++i)
+	{
+		_workers.push_back(new Worker(*this, i, stackSize));
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->start();
+	}
+}
+
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_stopped = true;
+		_wakeUp.broadcast();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->join();
+		delete *it;
+	}
+}
+
+
+void WorkStealingExecutor::start(Runnable& target)
+{
+	submit(&target, false, 0);
+}
+
+
+void WorkStealingExecutor::start(Runnable& target, TaskGroup& group)
+{
+	submit(&target, false, &group);
+}
+
+
+void WorkStealingExecutor::wait(TaskGroup& group)
+{
+	waitFor(group);
+	group.rethrow();
+}
+
+
+void WorkStealingExecutor::invokeAll(const std::vector<Runnable*>& targets)
+{
+	TaskGroup group;
+	try
+	{
+		for (std::vector<Runnable*>::const_iterator it = targets.begin(); it != targets.end(); ++it)
+		{
+			poco_check_ptr (*it);
+			submit(*it, false, &group);
+		}
+	}
+	catch (...)
+	{
+		waitFor(group);
+		throw;
+	}
+	wait(group);
+}
+
+
+void WorkStealingExecutor::joinAll()
+{
+	waitFor(_allTasks);
+}
+
+
+void WorkStealingExecutor::submit(Runnable* pTarget, bool owned, TaskGroup* pGroup)
+{
+	Job job;
+	job.pTarget = pTarget;
+	job.owned   = owned;
+	job.pGroup  = pGroup;
+
+	_allTasks.add();
+	if (pGroup) pGroup->add();
+
+	Worker* pWorker = currentWorker();
+	if (pWorker)
+	{
+		pWorker->push(job);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		_queue.push_back(job);
+	}
+
+	// _queued must be incremented before we look for idle
+	// workers; runWorker() checks it after becoming idle.
+	++_queued;
+	if (_idle.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_wakeUp.signal();
+	}
+}
+
+
+bool WorkStealingExecutor::takeJob(Worker* pWorker, Job& job)
+{
+	if (_queued.value() == 0) return false;
+
+	bool found = pWorker && pWorker->popBack(job);
+	if (!found)
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		if (!_queue.empty())
+		{
+			job = _queue.front();
+			_queue.pop_front();
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		std::size_t n = _workers.size();
+		std::size_t start = pWorker ? static_cast<std::size_t>(pWorker->index()) + 1 : 0;
+		for (std::size_t i = 0; i < n && !found; ++i)
+		{
+			Worker* pVictim = _workers[(start + i) % n];
+			if (pVictim != pWorker)
+				found = pVictim->popFront(job);
+		}
+	}
+	if (found) --_queued;
+	return found;
+}
+
+
+void WorkStealingExecutor::runJob(const Job& job)
+{
+	try
+	{
+		job.pTarget->run();
+	}
+	catch (Exception& exc)
+	{
+		if (job.pGroup)
+			job.pGroup->setException(exc);
+		else
+			ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		if (job.pGroup)
+			job.pGroup->setException(SystemException(exc.what()));
+		else
+			ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		if (job.pGroup)
+			job.pGroup->setException(SystemException("unknown exception"));
+		else
+			ErrorHandler::handle();
+	}
+	if (job.owned) delete job.pTarget;
+	if (job.pGroup) groupDone(*job.pGroup);
+	groupDone(_allTasks);
+}
+
+
+void WorkStealingExecutor::runWorker(Worker& worker)
+{
+	currentWorkerPtr.get() = &worker;
+	for (;;)
+	{
+		Job job;
+		if (takeJob(&worker, job))
+		{
+			runJob(job);
+		}
+		else
+		{
+			FastMutex::ScopedLock lock(_parkMutex);
+			if (_stopped) break;
+			++_idle;
+			// The timeout guards against missed wake-ups on
+			// platforms where AtomicCounter has no memory barrier.
+			if (_queued.value() == 0)
+				_wakeUp.tryWait(_parkMutex, 100);
+			--_idle;
+		}
+	}
+	currentWorkerPtr.get() = 0;
+}
+
+
+void WorkStealingExecutor::waitFor(TaskGroup& group)
+{
+	Worker* pWorker = currentWorker();
+	if (!pWorker)
+	{
+		while (group.pending() > 0) group._done.wait();
+		return;
+	}
+
+	// A worker keeps running queued tasks while it waits.
+	// If there are none, it parks like an idle worker, and is
+	// woken up by submit() or by groupDone().
+	while (group.pending() > 0)
+	{
+		Job job;
+		if (takeJob(pWorker, job))
+		{
+			runJob(job);
+		}
+		else
+		{
+			FastMutex::ScopedLock lock(_parkMutex);
+			++_idle;
+			++_waiting;
+			if (_queued.value() == 0 && group.pending() > 0)
+				_wakeUp.tryWait(_parkMutex, 100);
+			--_waiting;
+			--_idle;
+		}
+	}
+}
+
+
+void WorkStealingExecutor::groupDone(TaskGroup& group)
+{
+	if (group.done() && _waiting.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_wakeUp.broadcast();
+	}
+}
+
+
+WorkStealingExecutor::Worker* WorkStealingExecutor::currentWorker() const
+{
+	Worker* pWorker = static_cast<Worker*>(currentWorkerPtr.get());
+	if (pWorker && &pWorker->executor() == this)
+		return pWorker;
+	else
+		return 0;
+}
+
+
+namespace
+{
+	static SingletonHolder<WorkStealingExecutor> sh;
+}
+
+
+WorkStealingExecutor& WorkStealingExecutor::defaultExecutor()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
@@ -36,6 +36,7 @@
 #include "ExpireLRUCacheTest.h"
 #include "UniqueExpireCacheTest.h"
 #include "UniqueExpireLRUCacheTest.h"
+#include "ConcurrentCacheTest.h"
 
 CppUnit::Test* CacheTestSuite::suite()
 {
@@ -46,6 +47,7 @@ CppUnit::Test* CacheTestSuite::suite()
 	pSuite->addTest(UniqueExpireCacheTest::suite());
 	pSuite->addTest(ExpireLRUCacheTest::suite());
 	pSuite->addTest(UniqueExpireLRUCacheTest::suite());
+	pSuite->addTest(ConcurrentCacheTest::suite());
 
 	return pSuite;
 }
@@ -35,24 +35,34 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/SplitterChannel.h"
 #include "Poco/AsyncChannel.h"
+#include "Poco/BatchingChannel.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Message.h"
 #include "Poco/Formatter.h"
 #include "Poco/FormattingChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/StreamChannel.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
 #include "TestChannel.h"
 #include <sstream>
 
 
 using Poco::SplitterChannel;
 using Poco::AsyncChannel;
+using Poco::BatchingChannel;
 using Poco::FormattingChannel;
 using Poco::ConsoleChannel;
 using Poco::StreamChannel;
 using Poco::Formatter;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::NumberFormatter;
+using Poco::NumberParser;
 
 
 class SimpleFormatter: public Formatter
@@ -67,6 +77,31 @@ public:
 };
 
 
+class BatchLogger: public Poco::Runnable
+{
+public:
+	BatchLogger(Poco::Channel* pChannel, const std::string& source, int count):
+		_pChannel(pChannel),
+		_source(source),
+		_count(count)
+	{
+	}
+
+	void run()
+	{
+		for (int i = 0; i < _count; ++i)
+		{
+			_pChannel->log(Message(_source, NumberFormatter::format(i), Message::PRIO_INFORMATION));
+		}
+	}
+
+private:
+	Poco::Channel* _pChannel;
+	std::string _source;
+	int _count;
+};
+
+
 ChannelTest::ChannelTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -102,6 +137,127 @@ void ChannelTest::testAsync()
 }
 
 
+void ChannelTest::testAsyncLockFree()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel.get());
+	pAsync->setProperty("queueCapacity", "4");
+	pAsync->open();
+	Message msg;
+	for (int i = 0; i < 100; ++i)
+		pAsync->log(msg);
+	try
+	{
+		pAsync->setProperty("queueCapacity", "8");
+		fail("channel is open - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	pAsync->close();
+	assert (pChannel->list().size() == 100);
+	try
+	{
+		pAsync->setProperty("queueCapacity", "8");
+		fail("channel has been opened - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+}
+
+
+void ChannelTest::testBatching()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<BatchingChannel> pBatching = new BatchingChannel(pChannel.get());
+	pBatching->setProperty("batchSize", "16");
+	assert (pBatching->getProperty("batchSize") == "16");
+	pBatching->open();
+	for (int i = 0; i < 1000; ++i)
+	{
+		pBatching->log(Message("Source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+	}
+	try
+	{
+		pBatching->setProperty("batchSize", "32");
+		fail("channel is open - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	pBatching->close();
+	assert (pChannel->list().size() == 1000);
+	int i = 0;
+	for (TestChannel::MsgList::const_iterator it = pChannel->list().begin(); it != pChannel->list().end(); ++it, ++i)
+	{
+		assert (it->getText() == NumberFormatter::format(i));
+	}
+}
+
+
+void ChannelTest::testBatchingThreads()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<BatchingChannel> pBatching = new BatchingChannel(pChannel.get());
+	pBatching->setProperty("batchSize", "8");
+	pBatching->setProperty("flushInterval", "10");
+	try
+	{
+		pBatching->setProperty("flushInterval", "0");
+		fail("flushInterval must be positive - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assert (pBatching->getProperty("flushInterval") == "10");
+	pBatching->open();
+	
+	const int THREADS = 4;
+	const int COUNT = 2000;
+	std::vector<BatchLogger*> loggers;
+	std::vector<Thread*> threads;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		loggers.push_back(new BatchLogger(pBatching.get(), NumberFormatter::format(i), COUNT));
+		threads.push_back(new Thread);
+		threads.back()->start(*loggers.back());
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+		delete loggers[i];
+	}
+	pBatching->close();
+	
+	assert (pChannel->list().size() == THREADS*COUNT);
+	std::vector<int> next(THREADS, 0);
+	for (TestChannel::MsgList::const_iterator it = pChannel->list().begin(); it != pChannel->list().end(); ++it)
+	{
+		int source = NumberParser::parse(it->getSource());
+		assert (NumberParser::parse(it->getText()) == next[source]);
+		++next[source];
+	}
+}
+
+
+void ChannelTest::testBatchingFormatting()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<Formatter> pFormatter = new SimpleFormatter;
+	AutoPtr<FormattingChannel> pFormatterChannel = new FormattingChannel(pFormatter, pChannel.get());
+	AutoPtr<BatchingChannel> pBatching = new BatchingChannel(pFormatterChannel.get());
+	pBatching->log(Message("Source", "Text", Message::PRIO_INFORMATION));
+	pBatching->log(Message("Source", "More Text", Message::PRIO_INFORMATION));
+	pBatching->flush();
+	assert (pChannel->list().size() == 2);
+	assert (pChannel->list().begin()->getText() == "Source: Text");
+	assert (pChannel->list().back().getText() == "Source: More Text");
+	pBatching->close();
+}
+
+
 void ChannelTest::testFormatting()
 {
 	AutoPtr<TestChannel> pChannel = new TestChannel;
@@ -152,6 +308,10 @@ CppUnit::Test* ChannelTest::suite()
 
 	CppUnit_addTest(pSuite, ChannelTest, testSplitter);
 	CppUnit_addTest(pSuite, ChannelTest, testAsync);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncLockFree);
+	CppUnit_addTest(pSuite, ChannelTest, testBatching);
+	CppUnit_addTest(pSuite, ChannelTest, testBatchingThreads);
+	CppUnit_addTest(pSuite, ChannelTest, testBatchingFormatting);
 	CppUnit_addTest(pSuite, ChannelTest, testFormatting);
 	CppUnit_addTest(pSuite, ChannelTest, testConsole);
 	CppUnit_addTest(pSuite, ChannelTest, testStream);
@@ -48,6 +48,10 @@ public:
 
 	void testSplitter();
 	void testAsync();
+	void testAsyncLockFree();
+	void testBatching();
+	void testBatchingThreads();
+	void testBatchingFormatting();
 	void testFormatting();
 	void testConsole();
 	void testStream();
@@ -0,0 +1,307 @@
+//
+// ConcurrentCacheTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/ConcurrentCacheTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "ConcurrentCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/ConcurrentLRUCache.h"
+#include "Poco/ConcurrentExpireCache.h"
+#include "Poco/AccessExpireStrategy.h"
+#include "Poco/Exception.h"
+#include "Poco/Delegate.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+
+
+using namespace Poco;
+
+
+ConcurrentCacheTest::ConcurrentCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ConcurrentCacheTest::~ConcurrentCacheTest()
+{
+}
+
+
+void ConcurrentCacheTest::testClear()
+{
+	ConcurrentLRUCache<int, int> aCache(32, 4);
+	assert (aCache.shardCount() == 4);
+	assert (aCache.size() == 0);
+	assert (aCache.getAllKeys().size() == 0);
+	for (int i = 0; i < 8; ++i)
+		aCache.add(i, i*2);
+	assert (aCache.size() == 8);
+	// removing illegal entries should work too
+	aCache.remove(666);
+	assert (aCache.size() == 8);
+
+	aCache.clear();
+	assert (aCache.size() == 0);
+	for (int i = 0; i < 8; ++i)
+		assert (!aCache.has(i));
+}
+
+
+void ConcurrentCacheTest::testAddGetRemove()
+{
+	ConcurrentLRUCache<std::string, std::string> aCache(100);
+	aCache.add("one", "1");
+	aCache.add("two", SharedPtr<std::string>(new std::string("2")));
+	assert (aCache.has("one"));
+	assert (*aCache.get("one") == "1");
+	assert (*aCache.get("two") == "2");
+	assert (aCache.get("three").isNull());
+
+	aCache.add("one", "one");
+	assert (*aCache.get("one") == "one");
+	aCache.update("two", "two");
+	assert (*aCache.get("two") == "two");
+	aCache.update("three", "3");
+	assert (*aCache.get("three") == "3");
+	assert (aCache.size() == 3);
+
+	SharedPtr<std::string> pTwo = aCache.get("two");
+	aCache.remove("two");
+	assert (!aCache.has("two"));
+	assert (*pTwo == "two");
+
+	std::set<std::string> keys = aCache.getAllKeys();
+	assert (keys.size() == 2);
+	assert (keys.count("one") == 1);
+	assert (keys.count("three") == 1);
+
+	try
+	{
+		ConcurrentLRUCache<int, int> invalid(100, 0);
+		fail ("no shards - must throw");
+	}
+	catch (InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ConcurrentCacheTest::testLRUOneShard()
+{
+	// with a single shard, replacement is exact LRU
+	ConcurrentLRUCache<int, int> aCache(3, 1);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (aCache.has(1) && aCache.has(3) && aCache.has(5));
+	assert (*aCache.get(1) == 2); // 1 is now the most recently used
+	aCache.add(7, 8);
+	assert (aCache.has(1));
+	assert (!aCache.has(3));
+	assert (aCache.has(5));
+	assert (aCache.has(7));
+	aCache.add(9, 10);
+	assert (!aCache.has(5));
+	assert (aCache.size() == 3);
+}
+
+
+void ConcurrentCacheTest::testLRUShards()
+{
+	ConcurrentLRUCache<int, int> aCache(64, 8);
+	for (int i = 0; i < 1000; ++i)
+	{
+		aCache.add(i, i);
+		assert (aCache.has(i));
+		assert (aCache.size() <= 64);
+	}
+	// every shard is full
+	assert (aCache.size() == 64);
+
+	// the most recently added entries survive
+	std::set<int> keys = aCache.getAllKeys();
+	for (std::set<int>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		assert (*it >= 1000 - 64*4);
+		assert (*aCache.get(*it) == *it);
+	}
+}
+
+
+void ConcurrentCacheTest::testExpire()
+{
+	ConcurrentExpireCache<int, int> aCache(100, 4);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	assert (aCache.has(1));
+	assert (*aCache.get(3) == 4);
+	Thread::sleep(200);
+	assert (!aCache.has(1));
+	assert (aCache.get(3).isNull());
+	assert (aCache.size() == 0);
+}
+
+
+void ConcurrentCacheTest::testAccessExpire()
+{
+	ConcurrentCache<int, int, AccessExpireStrategy<int, int> > aCache(AccessExpireStrategy<int, int>(500), 4);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	for (int i = 0; i < 4; ++i)
+	{
+		Thread::sleep(200);
+		assert (*aCache.get(1) == 2);
+	}
+	assert (!aCache.has(3));
+	assert (aCache.size() == 1);
+}
+
+
+void ConcurrentCacheTest::testEvents()
+{
+	_addCnt = _updateCnt = _removeCnt = _getCnt = 0;
+	ConcurrentLRUCache<int, int> aCache(2, 1);
+	aCache.add(1, 1);
+
+	aCache.Add += delegate(this, &ConcurrentCacheTest::onAdd);
+	aCache.Update += delegate(this, &ConcurrentCacheTest::onUpdate);
+	aCache.Remove += delegate(this, &ConcurrentCacheTest::onRemove);
+	aCache.Get += delegate(this, &ConcurrentCacheTest::onGet);
+	aCache.add(2, 2);
+	assert (_addCnt == 1);
+	aCache.update(2, 3);
+	assert (_addCnt == 1);
+	assert (_updateCnt == 1);
+	aCache.get(2);
+	assert (_getCnt == 1);
+	aCache.add(3, 3); // replaces 1
+	assert (_addCnt == 2);
+	assert (_removeCnt == 1);
+	aCache.add(3, 4); // remove and add
+	assert (_addCnt == 3);
+	assert (_removeCnt == 2);
+
+	aCache.Add -= delegate(this, &ConcurrentCacheTest::onAdd);
+	aCache.Get.clear();
+	aCache.add(4, 4);
+	aCache.get(4);
+	assert (_addCnt == 3);
+	assert (_getCnt == 1);
+	assert (_removeCnt == 3);
+}
+
+
+void ConcurrentCacheTest::testConcurrentAccess()
+{
+	ConcurrentLRUCache<int, int> aCache(256, 16);
+	_pCache = &aCache;
+	_errors = 0;
+
+	RunnableAdapter<ConcurrentCacheTest> ra(*this, &ConcurrentCacheTest::access);
+	Thread threads[4];
+	for (int i = 0; i < 4; ++i)
+		threads[i].start(ra);
+	for (int i = 0; i < 4; ++i)
+		threads[i].join();
+
+	_pCache = 0;
+	assert (_errors.value() == 0);
+	assert (aCache.size() <= 256);
+}
+
+
+void ConcurrentCacheTest::access()
+{
+	for (int i = 0; i < 20000; ++i)
+	{
+		int key = i % 512;
+		if (i % 3 == 0)
+		{
+			_pCache->add(key, key*2);
+		}
+		else
+		{
+			SharedPtr<int> pValue = _pCache->get(key);
+			if (!pValue.isNull() && *pValue != key*2) ++_errors;
+		}
+	}
+}
+
+
+void ConcurrentCacheTest::onAdd(const void* pSender, const Poco::KeyValueArgs<int, int>& args)
+{
+	++_addCnt;
+}
+
+
+void ConcurrentCacheTest::onUpdate(const void* pSender, const Poco::KeyValueArgs<int, int>& args)
+{
+	++_updateCnt;
+}
+
+
+void ConcurrentCacheTest::onRemove(const void* pSender, const int& args)
+{
+	++_removeCnt;
+}
+
+
+void ConcurrentCacheTest::onGet(const void* pSender, const int& args)
+{
+	++_getCnt;
+}
+
+
+void ConcurrentCacheTest::setUp()
+{
+}
+
+
+void ConcurrentCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ConcurrentCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ConcurrentCacheTest");
+
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testClear);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testAddGetRemove);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testLRUOneShard);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testLRUShards);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testAccessExpire);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testEvents);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testConcurrentAccess);
+
+	return pSuite;
+}
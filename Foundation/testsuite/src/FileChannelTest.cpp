@@ -48,6 +48,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/DirectoryIterator.h"
 #include "Poco/Exception.h"
+#include "Poco/FileStream.h"
 #include <vector>
 
 
@@ -66,6 +67,7 @@ using Poco::DateTimeFormatter;
 using Poco::DateTimeFormat;
 using Poco::DirectoryIterator;
 using Poco::InvalidArgumentException;
+using Poco::FileInputStream;
 
 
 FileChannelTest::FileChannelTest(const std::string& name): CppUnit::TestCase(name)
@@ -365,6 +367,40 @@ void FileChannelTest::testCompress()
 }
 
 
+void FileChannelTest::testLogBatch()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->open();
+		std::vector<Message> batch;
+		batch.push_back(Message("source", "first entry", Message::PRIO_INFORMATION));
+		batch.push_back(Message("source", "second entry", Message::PRIO_INFORMATION));
+		batch.push_back(Message("source", "third entry", Message::PRIO_INFORMATION));
+		pChannel->logBatch(&batch[0], batch.size());
+		pChannel->log(Message("source", "fourth entry", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		FileInputStream istr(name);
+		std::vector<std::string> lines;
+		std::string line;
+		while (std::getline(istr, line)) lines.push_back(line);
+		assert (lines.size() == 4);
+		assert (lines[0] == "first entry");
+		assert (lines[1] == "second entry");
+		assert (lines[2] == "third entry");
+		assert (lines[3] == "fourth entry");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::purgeAge(const std::string& pa)
 {
 	std::string name = filename();
@@ -640,6 +676,7 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addTest(pSuite, FileChannelTest, testCompress);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
+	CppUnit_addTest(pSuite, FileChannelTest, testLogBatch);
 
 	return pSuite;
 }
@@ -65,6 +65,7 @@ public:
 	void testCompress();
 	void testPurgeAge();
 	void testPurgeCount();
+	void testLogBatch();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,321 @@
+//
+// LockFreeNotificationQueueTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/LockFreeNotificationQueueTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "LockFreeNotificationQueueTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+
+
+using Poco::LockFreeNotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::RunnableAdapter;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+	
+	const int PRODUCER_COUNT = 4;
+	const int NOTIFICATION_COUNT = 20000;
+}
+
+
+LockFreeNotificationQueueTest::LockFreeNotificationQueueTest(const std::string& name): 
+	CppUnit::TestCase(name),
+	_queue(16)
+{
+}
+
+
+LockFreeNotificationQueueTest::~LockFreeNotificationQueueTest()
+{
+}
+
+
+void LockFreeNotificationQueueTest::testQueueDequeue()
+{
+	LockFreeNotificationQueue queue;
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification);
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pNf = queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	pNf->release();
+	
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	assert (!queue.empty());
+	assert (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (queue.empty());
+	assert (queue.size() == 0);
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void LockFreeNotificationQueueTest::testQueueDequeueUrgent()
+{
+	LockFreeNotificationQueue queue;	
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	queue.enqueueUrgentNotification(new QTestNotification("third"));
+	assert (!queue.empty());
+	assert (queue.size() == 3);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (queue.size() == 2);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (queue.empty());
+	assert (queue.size() == 0);
+}
+
+
+void LockFreeNotificationQueueTest::testWaitDequeue()
+{
+	LockFreeNotificationQueue queue;
+	queue.enqueueNotification(new QTestNotification("third"));
+	queue.enqueueNotification(new QTestNotification("fourth"));
+	assert (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "fourth");
+	pTNf->release();
+	assert (queue.empty());
+
+	Stopwatch sw;
+	sw.start();
+	Notification* pNf = queue.waitDequeueNotification(100);
+	sw.stop();
+	assertNullPtr(pNf);
+	assert (sw.elapsed() >= 90000);
+}
+
+
+void LockFreeNotificationQueueTest::testCapacity()
+{
+	LockFreeNotificationQueue queue1(1);
+	assert (queue1.capacity() == 2);
+	LockFreeNotificationQueue queue2(16);
+	assert (queue2.capacity() == 16);
+	LockFreeNotificationQueue queue3(100);
+	assert (queue3.capacity() == 128);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		// wrap around the ring buffer a few times
+		for (int k = 0; k < 16; ++k)
+		{
+			queue2.enqueueNotification(new Notification);
+		}
+		assert (queue2.size() == 16);
+		queue2.clear();
+		assert (queue2.empty());
+	}
+}
+
+
+void LockFreeNotificationQueueTest::testFull()
+{
+	for (std::size_t i = 0; i < _queue.capacity(); ++i)
+	{
+		_queue.enqueueNotification(new Notification);
+	}
+	assert (_queue.size() == static_cast<int>(_queue.capacity()));
+
+	RunnableAdapter<LockFreeNotificationQueueTest> ra(*this, &LockFreeNotificationQueueTest::produceOne);
+	Thread t;
+	t.start(ra);
+	Thread::sleep(100);
+	// the producer must be blocked on the full queue
+	assert (t.isRunning());
+	assert (_queue.size() == static_cast<int>(_queue.capacity()));
+
+	Notification* pNf = _queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	pNf->release();
+	t.join();
+	assert (_queue.size() == static_cast<int>(_queue.capacity()));
+	_queue.clear();
+}
+
+
+void LockFreeNotificationQueueTest::testWakeUpAll()
+{
+	RunnableAdapter<LockFreeNotificationQueueTest> ra(*this, &LockFreeNotificationQueueTest::consume);
+	Thread t1;
+	Thread t2;
+	t1.start(ra);
+	t2.start(ra);
+	while (!_queue.hasIdleThreads()) Thread::sleep(10);
+	Thread::sleep(50);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	assert (_handled.value() == 0);
+}
+
+
+void LockFreeNotificationQueueTest::testThreads()
+{
+	RunnableAdapter<LockFreeNotificationQueueTest> producer(*this, &LockFreeNotificationQueueTest::produce);
+	RunnableAdapter<LockFreeNotificationQueueTest> consumer(*this, &LockFreeNotificationQueueTest::consume);
+	Thread producers[PRODUCER_COUNT];
+	Thread consumers[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		consumers[i].start(consumer);
+	}
+	for (int i = 0; i < PRODUCER_COUNT; ++i)
+	{
+		producers[i].start(producer);
+	}
+	for (int i = 0; i < PRODUCER_COUNT; ++i)
+	{
+		producers[i].join();
+	}
+	while (_handled.value() < PRODUCER_COUNT*NOTIFICATION_COUNT) Thread::sleep(10);
+	assert (_queue.empty());
+	_queue.wakeUpAll();
+	for (int i = 0; i < 3; ++i)
+	{
+		consumers[i].join();
+	}
+	assert (_handled.value() == PRODUCER_COUNT*NOTIFICATION_COUNT);
+}
+
+
+void LockFreeNotificationQueueTest::setUp()
+{
+	_queue.clear();
+	_handled = 0;
+}
+
+
+void LockFreeNotificationQueueTest::tearDown()
+{
+}
+
+
+void LockFreeNotificationQueueTest::produce()
+{
+	for (int i = 0; i < NOTIFICATION_COUNT; ++i)
+	{
+		_queue.enqueueNotification(new Notification);
+	}
+}
+
+
+void LockFreeNotificationQueueTest::produceOne()
+{
+	_queue.enqueueNotification(new Notification);
+}
+
+
+void LockFreeNotificationQueueTest::consume()
+{
+	Notification* pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		++_handled;
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+CppUnit::Test* LockFreeNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("LockFreeNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testQueueDequeue);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testQueueDequeueUrgent);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testCapacity);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testFull);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testWakeUpAll);
+	CppUnit_addTest(pSuite, LockFreeNotificationQueueTest, testThreads);
+
+	return pSuite;
+}
@@ -41,6 +41,7 @@
 #include "ActiveMethodTest.h"
 #include "ActiveDispatcherTest.h"
 #include "ConditionTest.h"
+#include "WorkStealingExecutorTest.h"
 
 
 CppUnit::Test* ThreadingTestSuite::suite()
@@ -57,6 +58,7 @@ CppUnit::Test* ThreadingTestSuite::suite()
 	pSuite->addTest(ActiveMethodTest::suite());
 	pSuite->addTest(ActiveDispatcherTest::suite());
 	pSuite->addTest(ConditionTest::suite());
+	pSuite->addTest(WorkStealingExecutorTest::suite());
 
 	return pSuite;
 }
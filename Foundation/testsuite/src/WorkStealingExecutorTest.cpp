@@ -0,0 +1,365 @@
+//
+// WorkStealingExecutorTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/WorkStealingExecutorTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "WorkStealingExecutorTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/TaskManager.h"
+#include "Poco/Task.h"
+#include "Poco/Timer.h"
+#include "Poco/Event.h"
+#include "Poco/Exception.h"
+#include <vector>
+
+
+using Poco::WorkStealingExecutor;
+using Poco::WorkStealingStarter;
+using Poco::RunnableAdapter;
+using Poco::Runnable;
+using Poco::ActiveMethod;
+using Poco::ActiveResult;
+using Poco::TaskManager;
+using Poco::Task;
+using Poco::Timer;
+using Poco::TimerCallback;
+using Poco::Event;
+using Poco::AtomicCounter;
+
+
+namespace
+{
+	class SquareBody
+	{
+	public:
+		SquareBody(std::vector<int>& result):
+			_result(result)
+		{
+		}
+
+		void operator () (int i) const
+		{
+			_result[i] = i*i;
+		}
+
+	private:
+		std::vector<int>& _result;
+	};
+
+	class NestedBody
+	{
+	public:
+		NestedBody(WorkStealingExecutor& executor, std::vector<int>& result, int columns):
+			_executor(executor),
+			_result(result),
+			_columns(columns)
+		{
+		}
+
+		void operator () (int row) const
+		{
+			_executor.parallelFor(row*_columns, (row + 1)*_columns, SquareBody(_result));
+		}
+
+	private:
+		WorkStealingExecutor& _executor;
+		std::vector<int>&     _result;
+		int                   _columns;
+	};
+
+	class ThrowingBody
+	{
+	public:
+		void operator () (int i) const
+		{
+			if (i == 42) throw Poco::InvalidArgumentException("42");
+		}
+	};
+
+	class ActiveObject
+	{
+	public:
+		ActiveObject():
+			square(this, &ActiveObject::squareImpl)
+		{
+		}
+
+		ActiveMethod<int, int, ActiveObject, WorkStealingStarter<ActiveObject> > square;
+
+	protected:
+		int squareImpl(const int& n)
+		{
+			return n*n;
+		}
+	};
+
+	class CountTask: public Task
+	{
+	public:
+		CountTask(AtomicCounter& counter):
+			Task("CountTask"),
+			_counter(counter)
+		{
+		}
+
+		void runTask()
+		{
+			++_counter;
+		}
+
+	private:
+		AtomicCounter& _counter;
+	};
+
+	class TimerTarget
+	{
+	public:
+		TimerTarget():
+			_worker(false)
+		{
+		}
+
+		void onTimer(Timer&)
+		{
+			Poco::Thread* pThread = Poco::Thread::current();
+			_worker = pThread && pThread->getName().find("WorkStealingExecutor") == 0;
+			_event.set();
+		}
+
+		bool  _worker;
+		Event _event;
+	};
+
+	class EventTask: public Runnable
+	{
+	public:
+		void run()
+		{
+			_event.set();
+		}
+
+		Event _event;
+	};
+}
+
+
+WorkStealingExecutorTest::WorkStealingExecutorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+WorkStealingExecutorTest::~WorkStealingExecutorTest()
+{
+}
+
+
+void WorkStealingExecutorTest::testStart()
+{
+	WorkStealingExecutor executor(4);
+	assert (executor.threads() == 4);
+
+	RunnableAdapter<WorkStealingExecutorTest> ra(*this, &WorkStealingExecutorTest::count);
+	for (int i = 0; i < 10000; ++i)
+	{
+		executor.start(ra);
+	}
+	executor.joinAll();
+	assert (_count.value() == 10000);
+	assert (executor.queued() == 0);
+}
+
+
+void WorkStealingExecutorTest::testTaskGroup()
+{
+	WorkStealingExecutor executor(2);
+	WorkStealingExecutor::TaskGroup group;
+	assert (group.pending() == 0);
+	executor.wait(group);
+
+	RunnableAdapter<WorkStealingExecutorTest> ra(*this, &WorkStealingExecutorTest::count);
+	for (int i = 0; i < 100; ++i)
+	{
+		executor.start(ra, group);
+	}
+	executor.wait(group);
+	assert (group.pending() == 0);
+	assert (_count.value() == 100);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		executor.start(ra, group);
+	}
+	executor.wait(group);
+	assert (_count.value() == 200);
+}
+
+
+void WorkStealingExecutorTest::testInvokeAll()
+{
+	WorkStealingExecutor executor(3);
+	RunnableAdapter<WorkStealingExecutorTest> ra(*this, &WorkStealingExecutorTest::count);
+	std::vector<Runnable*> targets(50, &ra);
+	executor.invokeAll(targets);
+	assert (_count.value() == 50);
+}
+
+
+void WorkStealingExecutorTest::testParallelFor()
+{
+	WorkStealingExecutor executor(4);
+	std::vector<int> result(10000, -1);
+	executor.parallelFor(0, 10000, SquareBody(result), 16);
+	for (int i = 0; i < 10000; ++i)
+	{
+		assert (result[i] == i*i);
+	}
+
+	std::vector<int> single(1, -1);
+	executor.parallelFor(0, 1, SquareBody(single));
+	assert (single[0] == 0);
+
+	executor.parallelFor(5, 5, SquareBody(single));
+}
+
+
+void WorkStealingExecutorTest::testNestedParallelFor()
+{
+	// more rows than workers, so all workers
+	// wait for nested groups at the same time
+	WorkStealingExecutor executor(2);
+	std::vector<int> result(64*100, -1);
+	executor.parallelFor(0, 64, NestedBody(executor, result, 100));
+	for (int i = 0; i < 64*100; ++i)
+	{
+		assert (result[i] == i*i);
+	}
+}
+
+
+void WorkStealingExecutorTest::testException()
+{
+	WorkStealingExecutor executor(2);
+	try
+	{
+		executor.parallelFor(0, 100, ThrowingBody());
+		fail("body throws - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	// the executor must still be usable
+	std::vector<int> result(100, -1);
+	executor.parallelFor(0, 100, SquareBody(result));
+	assert (result[99] == 99*99);
+}
+
+
+void WorkStealingExecutorTest::testActiveMethod()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.square(12);
+	result.wait();
+	assert (result.data() == 144);
+}
+
+
+void WorkStealingExecutorTest::testTaskManager()
+{
+	WorkStealingExecutor executor(2);
+	TaskManager tm(executor);
+	AtomicCounter counter;
+	for (int i = 0; i < 20; ++i)
+	{
+		tm.start(new CountTask(counter));
+	}
+	tm.joinAll();
+	assert (counter.value() == 20);
+	assert (tm.count() == 0);
+}
+
+
+void WorkStealingExecutorTest::testTimer()
+{
+	WorkStealingExecutor executor(1);
+	Timer t(100, 50);
+	TimerTarget target;
+	TimerCallback<TimerTarget> tc(target, &TimerTarget::onTimer);
+	t.start(tc, executor);
+	assert (target._event.tryWait(5000));
+	assert (target._worker);
+	assert (target._event.tryWait(5000));
+
+	// The timer must not occupy the only worker
+	// between invocations of the callback.
+	EventTask task;
+	executor.start(task);
+	assert (task._event.tryWait(5000));
+	t.stop();
+}
+
+
+void WorkStealingExecutorTest::setUp()
+{
+	_count = 0;
+}
+
+
+void WorkStealingExecutorTest::tearDown()
+{
+}
+
+
+void WorkStealingExecutorTest::count()
+{
+	++_count;
+}
+
+
+CppUnit::Test* WorkStealingExecutorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WorkStealingExecutorTest");
+
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testStart);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testTaskGroup);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testInvokeAll);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testParallelFor);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testNestedParallelFor);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testException);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testActiveMethod);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testTaskManager);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testTimer);
+
+	return pSuite;
+}
@@ -0,0 +1,460 @@
+//
+// Document.h
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  Document
+//
+// Definition of the Document class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef JSON_Document_INCLUDED
+#define JSON_Document_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/JSON/Object.h"
+#include "Poco/JSON/Array.h"
+#include "Poco/Dynamic/Var.h"
+#include "Poco/SharedPtr.h"
+#include <vector>
+#include <istream>
+
+
+namespace Poco {
+namespace JSON {
+
+
+class JSON_API Document
+	/// A compact, read-only representation of a parsed JSON document.
+	///
+	/// Parsing a JSON document into Object and Array instances creates
+	/// a heap-allocated Dynamic::Var holder for every value, a std::map
+	/// node for every object member, and a separate std::string
+	/// for every key, even if the same key occurs thousands of times.
+	/// A Document instead stores all values in a few flat arrays:
+	///
+	///   * every value is a fixed-size node, with numbers and booleans
+	///     stored inline;
+	///   * all string values are stored in a single character arena;
+	///   * keys are interned, i.e. each distinct key is stored once;
+	///   * object members are kept in a flat array, sorted by key, 
+	///     and are looked up by binary search; array elements are
+	///     kept in a flat array of node indices.
+	///
+	/// A Document is created with a DocumentHandler, or with one
+	/// of the parse() functions:
+	///
+	///    Document::Ptr pDoc = Document::parse(json);
+	///    Document::Value root = pDoc->root();
+	///    std::string name = root.getValue<std::string>("name");
+	///    Document::Value child = root.find("children[0]");
+	///    Object::Ptr pChild = child.toVar().extract<Object::Ptr>();
+	///
+	/// Values are accessed through Document::Value, which provides
+	/// the familiar interface of Object and Array (get(), getValue(),
+	/// optValue(), has(), isObject(), getNames(), etc.). Only values
+	/// that are actually requested are converted to Dynamic::Var;
+	/// objects and arrays are materialized as Object::Ptr and
+	/// Array::Ptr on demand, so existing code working with Object,
+	/// Array and Query can be used for selected parts of a document.
+	/// Query also accepts a Document directly.
+	///
+	/// As with Object, members of an object are ordered by key. If
+	/// a key occurs more than once in an object, the last value wins.
+{
+public:
+	typedef SharedPtr<Document> Ptr;
+
+	class JSON_API Value
+		/// A lightweight reference to a value in a Document.
+		///
+		/// A Value is only valid as long as the Document it
+		/// refers to exists. A default-constructed Value, and
+		/// a Value returned for a non-existing member or element,
+		/// is empty.
+	{
+	public:
+		Value();
+			/// Creates an empty Value.
+
+		bool isEmpty() const;
+			/// Returns true if the Value does not refer to any value.
+
+		bool isNull() const;
+			/// Returns true if the Value is empty or a JSON null.
+
+		bool isObject() const;
+			/// Returns true if the Value is an object.
+
+		bool isArray() const;
+			/// Returns true if the Value is an array.
+
+		bool isString() const;
+			/// Returns true if the Value is a string.
+
+		bool isNumeric() const;
+			/// Returns true if the Value is a number.
+
+		bool isBoolean() const;
+			/// Returns true if the Value is a boolean.
+
+		std::size_t size() const;
+			/// Returns the number of members of an object, the
+			/// number of elements of an array, and 0 otherwise.
+
+		bool has(const std::string& key) const;
+			/// Returns true if the Value is an object with a
+			/// member with the given key.
+
+		Value member(const std::string& key) const;
+			/// Returns the member with the given key, or an empty
+			/// Value if the Value is not an object or no such member
+			/// exists.
+
+		Value element(std::size_t index) const;
+			/// Returns the array element with the given index, or an
+			/// empty Value if the Value is not an array or the index is
+			/// out of range.
+
+		std::string keyAt(std::size_t index) const;
+			/// Returns the key of the object member with the given
+			/// index. Members are ordered by key.
+			///
+			/// Throws a RangeException if the Value is not an object
+			/// or the index is out of range.
+
+		Value valueAt(std::size_t index) const;
+			/// Returns the value of the object member with the given
+			/// index, or an empty Value if the Value is not an object
+			/// or the index is out of range.
+
+		void getNames(std::vector<std::string>& names) const;
+			/// Returns the keys of all members of an object.
+
+		Value find(const std::string& path) const;
+			/// Searches a value, using the same path syntax as Query.
+			/// For example: "person.children[0].name". Returns an empty
+			/// Value if the value can't be found.
+
+		Dynamic::Var get(const std::string& key) const;
+			/// Returns the member with the given key as Dynamic::Var.
+			/// An empty Var is returned if the member doesn't exist.
+			/// Objects and arrays are returned as Object::Ptr and
+			/// Array::Ptr, respectively.
+
+		Dynamic::Var get(unsigned index) const;
+			/// Returns the array element with the given index as
+			/// Dynamic::Var. An empty Var is returned if the element
+			/// doesn't exist.
+
+		Object::Ptr getObject(const std::string& key) const;
+			/// Returns the member with the given key as Object::Ptr,
+			/// or an empty Ptr if the member doesn't exist or is not
+			/// an object.
+
+		Array::Ptr getArray(const std::string& key) const;
+			/// Returns the member with the given key as Array::Ptr,
+			/// or an empty Ptr if the member doesn't exist or is not
+			/// an array.
+
+		bool isObject(const std::string& key) const;
+			/// Returns true if the member with the given key is an object.
+
+		bool isArray(const std::string& key) const;
+			/// Returns true if the member with the given key is an array.
+
+		bool isNull(const std::string& key) const;
+			/// Returns true if the member with the given key does not exist
+			/// or is null.
+
+		template <typename T>
+		T getValue(const std::string& key) const
+			/// Retrieves the member with the given key and converts it
+			/// to the given type, as Object::getValue() does.
+		{
+			Dynamic::Var value = get(key);
+			return value.convert<T>();
+		}
+
+		template <typename T>
+		T optValue(const std::string& key, const T& def) const
+			/// Returns the value of the member with the given key, if it
+			/// exists and can be converted to the given type. Otherwise,
+			/// def is returned.
+		{
+			T value = def;
+			Value v = member(key);
+			if (!v.isNull())
+			{
+				try
+				{
+					value = v.toVar().convert<T>();
+				}
+				catch (...)
+				{
+					// The default value will be returned
+				}
+			}
+			return value;
+		}
+
+		template <typename T>
+		T convert() const
+			/// Converts the value to the given type.
+		{
+			return toVar().convert<T>();
+		}
+
+		Dynamic::Var toVar() const;
+			/// Converts the value to a Dynamic::Var. Objects and arrays
+			/// (including all their members and elements) are converted
+			/// into Object::Ptr and Array::Ptr, respectively.
+
+	private:
+		Value(const Document* pDocument, std::size_t node);
+
+		const Document* _pDocument;
+		std::size_t     _node;
+
+		friend class Document;
+	};
+
+	Document();
+		/// Creates an empty Document.
+
+	~Document();
+		/// Destroys the Document.
+
+	Value root() const;
+		/// Returns the root value of the document, which is
+		/// empty if the document is empty.
+
+	bool empty() const;
+		/// Returns true if the document is empty.
+
+	void clear();
+		/// Removes all values from the document.
+
+	static Ptr parse(const std::string& json);
+		/// Parses the given JSON string into a new Document.
+
+	static Ptr parse(std::istream& in);
+		/// Parses JSON from the given stream into a new Document.
+
+private:
+	Document(const Document&);
+	Document& operator = (const Document&);
+
+	enum NodeType
+	{
+		NODE_NULL,
+		NODE_BOOL,
+		NODE_INT,
+		NODE_UINT,
+		NODE_INT64,
+		NODE_UINT64,
+		NODE_DOUBLE,
+		NODE_STRING,
+		NODE_OBJECT,
+		NODE_ARRAY
+	};
+
+	struct Node
+	{
+		UInt32 type;
+		UInt32 size;
+			/// String length, or number of members or elements.
+		union
+		{
+			bool        b;
+			Int64       i;
+			UInt64      u;
+			double      d;
+			std::size_t offset;
+				/// Offset of a string in the string arena, or index of
+				/// the first member or element of an object or array.
+		};
+	};
+
+	struct Member
+	{
+		UInt32      key;
+		std::size_t node;
+	};
+
+	struct Key
+	{
+		std::size_t offset;
+		std::size_t length;
+	};
+
+	struct MemberLess;
+
+	static const std::size_t NO_NODE = ~std::size_t(0);
+
+	const Node& node(std::size_t index) const;
+	std::size_t findMember(std::size_t node, const std::string& key) const;
+	int compareKey(UInt32 key, const char* name, std::size_t length) const;
+	void sortMembers(std::vector<Member>& members) const;
+	std::string keyString(UInt32 key) const;
+	Dynamic::Var toVar(std::size_t node) const;
+
+	std::vector<Node>        _nodes;
+	std::vector<Member>      _members;
+	std::vector<std::size_t> _elements;
+	std::vector<Key>         _keys;
+	std::string              _keyData;
+	std::string              _strings;
+
+	friend class Value;
+	friend class DocumentHandler;
+};
+
+
+//
+// inlines
+//
+inline Document::Value::Value():
+	_pDocument(0),
+	_node(NO_NODE)
+{
+}
+
+
+inline Document::Value::Value(const Document* pDocument, std::size_t node):
+	_pDocument(pDocument),
+	_node(node)
+{
+}
+
+
+inline bool Document::Value::isEmpty() const
+{
+	return _node == NO_NODE;
+}
+
+
+inline bool Document::Value::isNull() const
+{
+	return _node == NO_NODE || _pDocument->node(_node).type == NODE_NULL;
+}
+
+
+inline bool Document::Value::isObject() const
+{
+	return _node != NO_NODE && _pDocument->node(_node).type == NODE_OBJECT;
+}
+
+
+inline bool Document::Value::isArray() const
+{
+	return _node != NO_NODE && _pDocument->node(_node).type == NODE_ARRAY;
+}
+
+
+inline bool Document::Value::isString() const
+{
+	return _node != NO_NODE && _pDocument->node(_node).type == NODE_STRING;
+}
+
+
+inline bool Document::Value::isBoolean() const
+{
+	return _node != NO_NODE && _pDocument->node(_node).type == NODE_BOOL;
+}
+
+
+inline bool Document::Value::has(const std::string& key) const
+{
+	return !member(key).isEmpty();
+}
+
+
+inline bool Document::Value::isObject(const std::string& key) const
+{
+	return member(key).isObject();
+}
+
+
+inline bool Document::Value::isArray(const std::string& key) const
+{
+	return member(key).isArray();
+}
+
+
+inline bool Document::Value::isNull(const std::string& key) const
+{
+	return member(key).isNull();
+}
+
+
+inline Dynamic::Var Document::Value::get(const std::string& key) const
+{
+	return member(key).toVar();
+}
+
+
+inline Dynamic::Var Document::Value::get(unsigned index) const
+{
+	return element(index).toVar();
+}
+
+
+inline Dynamic::Var Document::Value::toVar() const
+{
+	if (_node == NO_NODE) return Dynamic::Var();
+	return _pDocument->toVar(_node);
+}
+
+
+inline Document::Value Document::root() const
+{
+	return Value(this, _nodes.empty() ? NO_NODE : 0);
+}
+
+
+inline bool Document::empty() const
+{
+	return _nodes.empty();
+}
+
+
+inline const Document::Node& Document::node(std::size_t index) const
+{
+	return _nodes[index];
+}
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_Document_INCLUDED
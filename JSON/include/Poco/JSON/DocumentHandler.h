@@ -0,0 +1,155 @@
+//
+// DocumentHandler.h
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  DocumentHandler
+//
+// Definition of the DocumentHandler class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef JSON_DocumentHandler_INCLUDED
+#define JSON_DocumentHandler_INCLUDED
+
+
+#include "Poco/JSON/Handler.h"
+#include "Poco/JSON/Document.h"
+#include <vector>
+#include <map>
+
+
+namespace Poco {
+namespace JSON {
+
+
+class JSON_API DocumentHandler: public Handler
+	/// A handler for the JSON parser that builds a compact
+	/// Document instead of Object and Array instances.
+	///
+	///    DocumentHandler* pDocumentHandler = new DocumentHandler;
+	///    Parser parser(pDocumentHandler);
+	///    parser.parse(json);
+	///    Document::Ptr pDoc = pDocumentHandler->document();
+	///
+	/// Note that asVar() returns an empty Var, so the
+	/// result of Parser::parse() is empty as well; use
+	/// document() to obtain the result.
+{
+public:
+	DocumentHandler();
+		/// Creates the DocumentHandler.
+
+	virtual ~DocumentHandler();
+		/// Destroys the DocumentHandler.
+
+	virtual void reset();
+		/// Resets the handler state and starts a new Document.
+
+	void startObject();
+		/// Handles a '{'; a new object is started.
+
+	void endObject();
+		/// Handles a '}'; the object is closed.
+
+	void startArray();
+		/// Handles a '['; a new array is started.
+
+	void endArray();
+		/// Handles a ']'; the array is closed.
+
+	void key(const std::string& k);
+		/// A key is read.
+
+	void null();
+		/// A null value is read.
+
+	void value(int v);
+		/// An integer value is read.
+
+	void value(unsigned v);
+		/// An unsigned value is read.
+
+#if defined(POCO_HAVE_INT64)
+	void value(Int64 v);
+		/// A 64-bit integer value is read.
+
+	void value(UInt64 v);
+		/// An unsigned 64-bit integer value is read.
+#endif
+
+	void value(const std::string& s);
+		/// A string value is read.
+
+	void value(double d);
+		/// A double value is read.
+
+	void value(bool b);
+		/// A boolean value is read.
+
+	Document::Ptr document() const;
+		/// Returns the Document built by the handler.
+
+private:
+	struct Frame
+	{
+		std::size_t                      node;
+		bool                             isObject;
+		std::vector<Document::Member>    members;
+		std::vector<std::size_t>         elements;
+	};
+
+	typedef std::map<std::string, UInt32> KeyMap;
+
+	Document::Node& addNode(Document::NodeType type);
+	void startContainer(Document::NodeType type);
+	UInt32 intern(const std::string& key);
+
+	Document::Ptr       _pDocument;
+	std::vector<Frame*> _frames;
+	std::size_t         _depth;
+	UInt32              _key;
+	KeyMap              _keyMap;
+};
+
+
+//
+// inlines
+//
+inline Document::Ptr DocumentHandler::document() const
+{
+	return _pDocument;
+}
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_DocumentHandler_INCLUDED
@@ -255,6 +255,24 @@ public:
 	Dynamic::Var parse(std::istream& in);
 		/// Parses a JSON from the input stream.
 
+	Dynamic::Var parse(const char* json, std::size_t length);
+		/// Parses a JSON document from a contiguous buffer.
+		///
+		/// This is the fastest way to parse a JSON document that
+		/// is already in memory. Runs of ordinary characters inside
+		/// strings are located using SSE2 (or, where SSE2 is not
+		/// available, a machine word at a time) and copied in bulk,
+		/// and numbers are converted without going through
+		/// NumberParser whenever this can be done exactly.
+		///
+		/// To parse a large file without reading it into a
+		/// std::string first, map it into memory using
+		/// Poco::SharedMemory and pass the mapped region:
+		///
+		///     Poco::File file("data.json");
+		///     Poco::SharedMemory mem(file, Poco::SharedMemory::AM_READ);
+		///     Var result = parser.parse(mem.begin(), mem.end() - mem.begin());
+
 	void setHandler(const Handler::Ptr& pHandler);
 		/// Set the handler.
 
@@ -288,6 +306,8 @@ private:
 
 	void parseBufferPopBackChar();
 
+	void parseBufferAppend(const char* chars, std::size_t length);
+
 	void addCharToParseBuffer(CharIntType nextChar, int nextClass);
 
 	void addEscapedCharToParseBuffer(CharIntType nextChar);
@@ -300,6 +320,12 @@ private:
 
 	void parseBuffer();
 
+	static std::size_t scanString(const char* begin, const char* end);
+		/// Returns the length of the run of characters starting at begin
+		/// that can be appended to a string value as they are, i.e.
+		/// that are neither quotes, backslashes, control characters
+		/// nor part of an UTF-8 sequence.
+
 	template <typename IT>
 	class Source
 	{
@@ -320,6 +346,16 @@ private:
 			return true;
 		}
 
+		IT& position()
+		{
+			return _it;
+		}
+
+		const IT& end() const
+		{
+			return _end;
+		}
+
 	private:
 		IT _it;
 		IT _end;
@@ -0,0 +1,273 @@
+//
+// PullParser.h
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  PullParser
+//
+// Definition of the PullParser class.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef JSON_PullParser_INCLUDED
+#define JSON_PullParser_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/Dynamic/Var.h"
+#include "Poco/Buffer.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+
+namespace Poco {
+namespace JSON {
+
+
+class JSON_API PullParser
+	/// A pull parser that reads a JSON document from an
+	/// input stream one token at a time.
+	///
+	/// Unlike Parser, which pushes the complete document into
+	/// a Handler, PullParser lets the caller step through the
+	/// document with next(), skip values it is not interested in
+	/// (including whole objects and arrays) with skip(), and
+	/// turn selected values into Object or Array instances with
+	/// read(). Only a fixed-size input buffer and the current
+	/// token are kept in memory, so documents of any size can be
+	/// processed. For example, a huge top-level array can be
+	/// read record by record:
+	///
+	///    std::ifstream istr("records.json");
+	///    PullParser pp(istr);
+	///    if (pp.next() != PullParser::TOKEN_BEGIN_ARRAY) ...
+	///    while (pp.next() != PullParser::TOKEN_END_ARRAY)
+	///    {
+	///        Object::Ptr pRecord = pp.read().extract<Object::Ptr>();
+	///        ...
+	///    }
+	///
+	/// Syntax errors are reported by throwing a JSONException.
+{
+public:
+	enum Token
+	{
+		TOKEN_NONE,         /// next() has not been called yet
+		TOKEN_BEGIN_OBJECT, /// '{'
+		TOKEN_END_OBJECT,   /// '}'
+		TOKEN_BEGIN_ARRAY,  /// '['
+		TOKEN_END_ARRAY,    /// ']'
+		TOKEN_KEY,          /// an object member name; text() returns the name
+		TOKEN_STRING,       /// a string value; text() returns the decoded string
+		TOKEN_NUMBER,       /// a number; text() returns the number as it appears in the document
+		TOKEN_TRUE,         /// true
+		TOKEN_FALSE,        /// false
+		TOKEN_NULL,         /// null
+		TOKEN_END           /// the end of the document has been reached
+	};
+
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 65536
+	};
+
+	explicit PullParser(std::istream& istr, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the PullParser, reading from the given stream,
+		/// using an input buffer of the given size.
+		///
+		/// The parser only waits for input when its buffer is empty,
+		/// and then takes whatever the stream can deliver without
+		/// waiting, up to the buffer size. Tokens are therefore
+		/// available as soon as they have been received, which
+		/// matters when reading from a socket stream.
+
+	~PullParser();
+		/// Destroys the PullParser.
+
+	Token next();
+		/// Advances to the next token and returns it.
+		///
+		/// Once the end of the document has been reached,
+		/// TOKEN_END is returned. Throws a JSONException if the
+		/// document is malformed, or if anything other than
+		/// whitespace follows the top-level value.
+
+	Token token() const;
+		/// Returns the current token.
+
+	const std::string& text() const;
+		/// Returns the text of the current token.
+		///
+		/// For TOKEN_KEY and TOKEN_STRING, this is the decoded
+		/// string, for TOKEN_NUMBER the number as written, and
+		/// for TOKEN_TRUE, TOKEN_FALSE and TOKEN_NULL the literal.
+		/// For all other tokens, the text is empty.
+
+	Dynamic::Var value() const;
+		/// Returns the value of the current token, which must
+		/// be a string, number, boolean or null. Numbers are converted
+		/// the same way Parser converts them; null is returned
+		/// as an empty Var.
+		///
+		/// Throws an InvalidAccessException if the current token
+		/// is not a scalar value.
+
+	Dynamic::Var read();
+		/// Reads the value starting at the current token and returns it.
+		/// Objects and arrays are returned as Object::Ptr and Array::Ptr,
+		/// all other values as by value().
+		///
+		/// If the current token is TOKEN_KEY, the member's value
+		/// is read. After read() returns, the current token is the last
+		/// token of the value, i.e. TOKEN_END_OBJECT or TOKEN_END_ARRAY
+		/// if an object or array has been read.
+
+	void skip();
+		/// Skips the value starting at the current token.
+		///
+		/// If the current token is TOKEN_KEY, the member's value
+		/// is skipped. Objects and arrays are skipped without decoding
+		/// their contents; only strings and the nesting of brackets
+		/// are taken into account. After skip() returns, the current
+		/// token is the last token of the value, as with read().
+
+	std::size_t depth() const;
+		/// Returns the number of objects and arrays the
+		/// current token is nested in. For TOKEN_BEGIN_OBJECT and
+		/// TOKEN_BEGIN_ARRAY, the new object or array is included.
+
+	std::string path() const;
+		/// Returns the path of the current value, in the format
+		/// used by Query (e.g., "records[3].address.city").
+		/// For TOKEN_KEY, the path of the member's value is returned.
+		/// The path of the top-level value is empty.
+
+private:
+	PullParser(const PullParser&);
+	PullParser& operator = (const PullParser&);
+
+	enum State
+	{
+		STATE_VALUE,
+		STATE_VALUE_OR_CLOSE,
+		STATE_KEY,
+		STATE_KEY_OR_CLOSE,
+		STATE_COLON,
+		STATE_COMMA_OR_CLOSE,
+		STATE_END
+	};
+
+	enum
+	{
+		END_OF_INPUT = -1
+	};
+
+	struct Frame
+	{
+		Frame(bool isArray);
+
+		bool        isArray;
+		int         index;
+		std::string key;
+	};
+
+	typedef std::vector<Frame> FrameVec;
+
+	Token readValue(int c);
+	Token readKey(int c);
+	Token closeContainer(int c);
+	void endValue();
+	void readString();
+	void readEscape();
+	void readUnicodeEscape();
+	unsigned readHex4();
+	void readNumber();
+	std::size_t readDigits();
+	void readLiteral(const char* literal);
+	void skipString();
+	int skipWhitespace();
+	bool fill();
+	int peek();
+	int get();
+	static void syntaxError(const std::string& what);
+
+	std::istream&      _istr;
+	Poco::Buffer<char> _buffer;
+	const char*        _pos;
+	const char*        _end;
+	Token              _token;
+	State              _state;
+	std::string        _text;
+	bool               _isFloat;
+	bool               _hasUTF8;
+	FrameVec           _frames;
+};
+
+
+//
+// inlines
+//
+inline PullParser::Token PullParser::token() const
+{
+	return _token;
+}
+
+
+inline const std::string& PullParser::text() const
+{
+	return _text;
+}
+
+
+inline std::size_t PullParser::depth() const
+{
+	return _frames.size();
+}
+
+
+inline int PullParser::peek()
+{
+	if (_pos == _end && !fill()) return END_OF_INPUT;
+	return static_cast<unsigned char>(*_pos);
+}
+
+
+inline int PullParser::get()
+{
+	if (_pos == _end && !fill()) return END_OF_INPUT;
+	return static_cast<unsigned char>(*_pos++);
+}
+
+
+} } // namespace Poco::JSON
+
+
+#endif // JSON_PullParser_INCLUDED
@@ -42,6 +42,7 @@
 #include "Poco/JSON/JSON.h"
 #include "Poco/JSON/Object.h"
 #include "Poco/JSON/Array.h"
+#include "Poco/JSON/Document.h"
 
 
 namespace Poco {
@@ -59,6 +60,14 @@ public:
 		/// Creating Query holding Ptr will typically result in faster
 		/// performance.
 
+	Query(const Document::Value& source);
+		/// Creates the Query for the given Document value,
+		/// typically Document::root(). The Document must
+		/// exist as long as the Query is used.
+		///
+		/// Only the values found are converted to Dynamic::Var;
+		/// the rest of the document is not materialized.
+
 	virtual ~Query();
 		/// Destructor
 
@@ -122,7 +131,8 @@ public:
 	}
 
 private:
-	Dynamic::Var _source;
+	Dynamic::Var    _source;
+	Document::Value _document;
 };
 
 
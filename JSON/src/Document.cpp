@@ -0,0 +1,341 @@
+//
+// Document.cpp
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  Document
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/JSON/Document.h"
+#include "Poco/JSON/DocumentHandler.h"
+#include "Poco/JSON/Parser.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <cstring>
+
+
+using Poco::Dynamic::Var;
+
+
+namespace Poco {
+namespace JSON {
+
+
+const std::size_t Document::NO_NODE;
+
+
+struct Document::MemberLess
+{
+	MemberLess(const Document& document): _document(document)
+	{
+	}
+
+	bool operator () (const Member& m1, const Member& m2) const
+	{
+		if (m1.key == m2.key) return false;
+		const Key& key2 = _document._keys[m2.key];
+		return _document.compareKey(m1.key, _document._keyData.data() + key2.offset, key2.length) < 0;
+	}
+
+	const Document& _document;
+};
+
+
+//
+// Document::Value
+//
+
+
+bool Document::Value::isNumeric() const
+{
+	if (_node == NO_NODE) return false;
+	UInt32 type = _pDocument->node(_node).type;
+	return type >= NODE_INT && type <= NODE_DOUBLE;
+}
+
+
+std::size_t Document::Value::size() const
+{
+	if (isObject() || isArray())
+		return _pDocument->node(_node).size;
+	else
+		return 0;
+}
+
+
+Document::Value Document::Value::member(const std::string& key) const
+{
+	if (!isObject()) return Value();
+
+	return Value(_pDocument, _pDocument->findMember(_node, key));
+}
+
+
+Document::Value Document::Value::element(std::size_t index) const
+{
+	if (!isArray()) return Value();
+
+	const Node& n = _pDocument->node(_node);
+	if (index >= n.size) return Value();
+	return Value(_pDocument, _pDocument->_elements[n.offset + index]);
+}
+
+
+std::string Document::Value::keyAt(std::size_t index) const
+{
+	if (!isObject() || index >= _pDocument->node(_node).size) throw RangeException("Invalid member index");
+
+	return _pDocument->keyString(_pDocument->_members[_pDocument->node(_node).offset + index].key);
+}
+
+
+Document::Value Document::Value::valueAt(std::size_t index) const
+{
+	if (!isObject()) return Value();
+
+	const Node& n = _pDocument->node(_node);
+	if (index >= n.size) return Value();
+	return Value(_pDocument, _pDocument->_members[n.offset + index].node);
+}
+
+
+void Document::Value::getNames(std::vector<std::string>& names) const
+{
+	names.clear();
+	if (isObject())
+	{
+		const Node& n = _pDocument->node(_node);
+		names.reserve(n.size);
+		for (std::size_t i = 0; i < n.size; ++i)
+		{
+			names.push_back(_pDocument->keyString(_pDocument->_members[n.offset + i].key));
+		}
+	}
+}
+
+
+Document::Value Document::Value::find(const std::string& path) const
+{
+	Value result = *this;
+	std::string::size_type pos = 0;
+	while (!result.isEmpty() && pos < path.size())
+	{
+		std::string::size_type dot = path.find('.', pos);
+		if (dot == std::string::npos) dot = path.size();
+		std::string::size_type bracket = path.find('[', pos);
+		if (bracket == std::string::npos || bracket > dot) bracket = dot;
+		if (bracket > pos)
+			result = result.member(path.substr(pos, bracket - pos));
+		while (!result.isEmpty() && bracket < dot)
+		{
+			std::string::size_type close = path.find(']', bracket);
+			if (close == std::string::npos || close > dot) break;
+			unsigned index;
+			if (!NumberParser::tryParseUnsigned(path.substr(bracket + 1, close - bracket - 1), index)) break;
+			result = result.element(index);
+			bracket = path.find('[', close);
+			if (bracket == std::string::npos || bracket > dot) bracket = dot;
+		}
+		pos = dot + 1;
+	}
+	return result;
+}
+
+
+Object::Ptr Document::Value::getObject(const std::string& key) const
+{
+	Value value = member(key);
+	if (value.isObject())
+		return value.toVar().extract<Object::Ptr>();
+	else
+		return 0;
+}
+
+
+Array::Ptr Document::Value::getArray(const std::string& key) const
+{
+	Value value = member(key);
+	if (value.isArray())
+		return value.toVar().extract<Array::Ptr>();
+	else
+		return 0;
+}
+
+
+//
+// Document
+//
+
+
+Document::Document()
+{
+}
+
+
+Document::~Document()
+{
+}
+
+
+void Document::clear()
+{
+	_nodes.clear();
+	_members.clear();
+	_elements.clear();
+	_keys.clear();
+	_keyData.clear();
+	_strings.clear();
+}
+
+
+Document::Ptr Document::parse(const std::string& json)
+{
+	DocumentHandler* pDocumentHandler = new DocumentHandler;
+	Handler::Ptr pHandler(pDocumentHandler);
+	Parser parser(pHandler);
+	parser.parse(json);
+	return pDocumentHandler->document();
+}
+
+
+Document::Ptr Document::parse(std::istream& in)
+{
+	DocumentHandler* pDocumentHandler = new DocumentHandler;
+	Handler::Ptr pHandler(pDocumentHandler);
+	Parser parser(pHandler);
+	parser.parse(in);
+	return pDocumentHandler->document();
+}
+
+
+std::size_t Document::findMember(std::size_t index, const std::string& key) const
+{
+	const Node& n = _nodes[index];
+	std::size_t lo = n.offset;
+	std::size_t hi = n.offset + n.size;
+	while (lo < hi)
+	{
+		std::size_t mid = lo + (hi - lo)/2;
+		int rc = compareKey(_members[mid].key, key.data(), key.size());
+		if (rc < 0)
+			lo = mid + 1;
+		else if (rc > 0)
+			hi = mid;
+		else
+			return _members[mid].node;
+	}
+	return NO_NODE;
+}
+
+
+int Document::compareKey(UInt32 key, const char* name, std::size_t length) const
+{
+	const Key& k = _keys[key];
+	int rc = k.length > 0 && length > 0 ? std::memcmp(_keyData.data() + k.offset, name, std::min(k.length, length)) : 0;
+	if (rc != 0) return rc;
+	if (k.length < length)
+		return -1;
+	else if (k.length > length)
+		return 1;
+	else
+		return 0;
+}
+
+
+void Document::sortMembers(std::vector<Member>& members) const
+{
+	std::stable_sort(members.begin(), members.end(), MemberLess(*this));
+
+	// If a key occurs more than once, keep the last value, like Object::set().
+	std::vector<Member>::iterator out = members.begin();
+	for (std::vector<Member>::iterator it = members.begin(); it != members.end(); ++it)
+	{
+		if (out != members.begin() && (out - 1)->key == it->key)
+			*(out - 1) = *it;
+		else
+			*out++ = *it;
+	}
+	members.erase(out, members.end());
+}
+
+
+std::string Document::keyString(UInt32 key) const
+{
+	const Key& k = _keys[key];
+	return std::string(_keyData, k.offset, k.length);
+}
+
+
+Var Document::toVar(std::size_t index) const
+{
+	const Node& n = _nodes[index];
+	switch (n.type)
+	{
+	case NODE_BOOL:
+		return n.b;
+	case NODE_INT:
+		return static_cast<int>(n.i);
+	case NODE_UINT:
+		return static_cast<unsigned>(n.u);
+	case NODE_INT64:
+		return n.i;
+	case NODE_UINT64:
+		return n.u;
+	case NODE_DOUBLE:
+		return n.d;
+	case NODE_STRING:
+		return std::string(_strings, n.offset, n.size);
+	case NODE_OBJECT:
+		{
+			Object::Ptr pObject = new Object;
+			for (std::size_t i = n.offset; i < n.offset + n.size; ++i)
+			{
+				pObject->set(keyString(_members[i].key), toVar(_members[i].node));
+			}
+			return pObject;
+		}
+	case NODE_ARRAY:
+		{
+			Array::Ptr pArray = new Array;
+			for (std::size_t i = n.offset; i < n.offset + n.size; ++i)
+			{
+				pArray->add(toVar(_elements[i]));
+			}
+			return pArray;
+		}
+	default:
+		return Var();
+	}
+}
+
+
+} } // namespace Poco::JSON
@@ -0,0 +1,223 @@
+//
+// DocumentHandler.cpp
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  DocumentHandler
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/JSON/DocumentHandler.h"
+
+
+namespace Poco {
+namespace JSON {
+
+
+DocumentHandler::DocumentHandler():
+	_depth(0),
+	_key(0)
+{
+	reset();
+}
+
+
+DocumentHandler::~DocumentHandler()
+{
+	for (std::vector<Frame*>::iterator it = _frames.begin(); it != _frames.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void DocumentHandler::reset()
+{
+	_pDocument = new Document;
+	_depth = 0;
+	_key = 0;
+	_keyMap.clear();
+}
+
+
+void DocumentHandler::startObject()
+{
+	startContainer(Document::NODE_OBJECT);
+}
+
+
+void DocumentHandler::endObject()
+{
+	poco_assert (_depth > 0);
+
+	Frame& frame = *_frames[--_depth];
+	_pDocument->sortMembers(frame.members);
+	Document::Node& node = _pDocument->_nodes[frame.node];
+	node.offset = _pDocument->_members.size();
+	node.size   = static_cast<UInt32>(frame.members.size());
+	_pDocument->_members.insert(_pDocument->_members.end(), frame.members.begin(), frame.members.end());
+}
+
+
+void DocumentHandler::startArray()
+{
+	startContainer(Document::NODE_ARRAY);
+}
+
+
+void DocumentHandler::endArray()
+{
+	poco_assert (_depth > 0);
+
+	Frame& frame = *_frames[--_depth];
+	Document::Node& node = _pDocument->_nodes[frame.node];
+	node.offset = _pDocument->_elements.size();
+	node.size   = static_cast<UInt32>(frame.elements.size());
+	_pDocument->_elements.insert(_pDocument->_elements.end(), frame.elements.begin(), frame.elements.end());
+}
+
+
+void DocumentHandler::key(const std::string& k)
+{
+	_key = intern(k);
+}
+
+
+void DocumentHandler::null()
+{
+	addNode(Document::NODE_NULL);
+}
+
+
+void DocumentHandler::value(int v)
+{
+	addNode(Document::NODE_INT).i = v;
+}
+
+
+void DocumentHandler::value(unsigned v)
+{
+	addNode(Document::NODE_UINT).u = v;
+}
+
+
+#if defined(POCO_HAVE_INT64)
+
+
+void DocumentHandler::value(Int64 v)
+{
+	addNode(Document::NODE_INT64).i = v;
+}
+
+
+void DocumentHandler::value(UInt64 v)
+{
+	addNode(Document::NODE_UINT64).u = v;
+}
+
+
+#endif
+
+
+void DocumentHandler::value(const std::string& s)
+{
+	Document::Node& node = addNode(Document::NODE_STRING);
+	node.offset = _pDocument->_strings.size();
+	node.size   = static_cast<UInt32>(s.size());
+	_pDocument->_strings.append(s);
+}
+
+
+void DocumentHandler::value(double d)
+{
+	addNode(Document::NODE_DOUBLE).d = d;
+}
+
+
+void DocumentHandler::value(bool b)
+{
+	addNode(Document::NODE_BOOL).b = b;
+}
+
+
+Document::Node& DocumentHandler::addNode(Document::NodeType type)
+{
+	std::size_t index = _pDocument->_nodes.size();
+	Document::Node node;
+	node.type   = type;
+	node.size   = 0;
+	node.u      = 0;
+	_pDocument->_nodes.push_back(node);
+	if (_depth > 0)
+	{
+		Frame& parent = *_frames[_depth - 1];
+		if (parent.isObject)
+		{
+			Document::Member member;
+			member.key  = _key;
+			member.node = index;
+			parent.members.push_back(member);
+		}
+		else parent.elements.push_back(index);
+	}
+	return _pDocument->_nodes.back();
+}
+
+
+void DocumentHandler::startContainer(Document::NodeType type)
+{
+	std::size_t index = _pDocument->_nodes.size();
+	addNode(type);
+	if (_depth == _frames.size()) _frames.push_back(new Frame);
+	Frame& frame = *_frames[_depth++];
+	frame.node     = index;
+	frame.isObject = type == Document::NODE_OBJECT;
+	frame.members.clear();
+	frame.elements.clear();
+}
+
+
+UInt32 DocumentHandler::intern(const std::string& key)
+{
+	KeyMap::iterator it = _keyMap.find(key);
+	if (it != _keyMap.end()) return it->second;
+
+	UInt32 id = static_cast<UInt32>(_pDocument->_keys.size());
+	Document::Key k;
+	k.offset = _pDocument->_keyData.size();
+	k.length = key.size();
+	_pDocument->_keys.push_back(k);
+	_pDocument->_keyData.append(key);
+	_keyMap.insert(KeyMap::value_type(key, id));
+	return id;
+}
+
+
+} } // namespace Poco::JSON
@@ -0,0 +1,241 @@
+//
+// NumberConverter.h
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  Parser
+//
+// Conversion of JSON numbers, shared by Parser and PullParser.
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef JSON_NumberConverter_INCLUDED
+#define JSON_NumberConverter_INCLUDED
+
+
+#include "Poco/JSON/JSON.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Ascii.h"
+#include "Poco/Types.h"
+#undef min
+#undef max
+#include <limits>
+#include <string>
+
+
+namespace Poco {
+namespace JSON {
+namespace Impl {
+
+
+#if defined(POCO_HAVE_INT64)
+
+
+inline bool parseDigits(const char*& it, const char* end, UInt64& value)
+	/// Accumulates the decimal digits starting at it into value.
+	/// Returns false if value would overflow.
+{
+	value = 0;
+	for (; it != end && Ascii::isDigit(*it); ++it)
+	{
+		unsigned digit = static_cast<unsigned>(*it - '0');
+		if (value > (std::numeric_limits<UInt64>::max() - digit)/10) return false;
+		value = value*10 + digit;
+	}
+	return true;
+}
+
+
+inline bool parseFloatFast(const char* it, const char* end, double& value)
+	/// Converts a JSON number without calling NumberParser.
+	///
+	/// Only numbers with at most 15 significant digits
+	/// and a decimal exponent of at most 22 are handled
+	/// here. Both the mantissa and the power of ten are then
+	/// exactly representable as doubles, so a single
+	/// multiplication or division yields the correctly
+	/// rounded result. Returns false for all other numbers.
+{
+	static const double powersOf10[] =
+	{
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+		1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	static const int MAX_DIGITS = 15;
+	static const int MAX_EXPONENT = 22;
+
+	bool negative = (it != end && *it == '-');
+	if (negative) ++it;
+
+	UInt64 mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	for (; it != end && Ascii::isDigit(*it); ++it)
+	{
+		if (mantissa != 0 || *it != '0') ++digits;
+		mantissa = mantissa*10 + (*it - '0');
+		if (digits > MAX_DIGITS) return false;
+	}
+	if (it != end && *it == '.')
+	{
+		for (++it; it != end && Ascii::isDigit(*it); ++it)
+		{
+			if (mantissa != 0 || *it != '0') ++digits;
+			mantissa = mantissa*10 + (*it - '0');
+			if (digits > MAX_DIGITS) return false;
+			--exponent;
+		}
+	}
+	if (it != end && (*it == 'e' || *it == 'E'))
+	{
+		++it;
+		bool negativeExponent = (it != end && *it == '-');
+		if (it != end && (*it == '-' || *it == '+')) ++it;
+		int exp = 0;
+		for (; it != end && Ascii::isDigit(*it); ++it)
+		{
+			exp = exp*10 + (*it - '0');
+			if (exp > 2*MAX_EXPONENT) return false;
+		}
+		exponent += negativeExponent ? -exp : exp;
+	}
+	if (it != end || exponent < -MAX_EXPONENT || exponent > MAX_EXPONENT) return false;
+
+	value = static_cast<double>(static_cast<Int64>(mantissa));
+	if (exponent < 0)
+		value /= powersOf10[-exponent];
+	else
+		value *= powersOf10[exponent];
+	if (negative) value = -value;
+	return true;
+}
+
+
+template <class H>
+bool convertIntegerFast(const char* it, const char* end, H& handler)
+	/// Converts the integer in [it, end) and passes it to the handler.
+	/// Returns false, without calling the handler, if the value
+	/// does not fit into 64 bits.
+{
+	bool negative = (it != end && *it == '-');
+	if (negative) ++it;
+
+	UInt64 magnitude;
+	if (it == end || !parseDigits(it, end, magnitude) || it != end) return false;
+
+	if (negative)
+	{
+		if (magnitude > static_cast<UInt64>(std::numeric_limits<Int64>::max()) + 1) return false;
+		Int64 value = static_cast<Int64>(0 - magnitude);
+		if (value < std::numeric_limits<int>::min())
+			handler.value(value);
+		else
+			handler.value(static_cast<int>(value));
+	}
+	else if (magnitude <= static_cast<UInt64>(std::numeric_limits<int>::max()))
+		handler.value(static_cast<int>(magnitude));
+	else if (magnitude <= static_cast<UInt64>(std::numeric_limits<Int64>::max()))
+		handler.value(static_cast<Int64>(magnitude));
+	else
+		handler.value(magnitude);
+	return true;
+}
+
+
+#endif // POCO_HAVE_INT64
+
+
+template <class H>
+void convertInteger(const char* begin, const char* end, H& handler)
+	/// Converts the integer in [begin, end) and passes it to the
+	/// handler as int if it fits, otherwise as the smallest of
+	/// Int64, unsigned or UInt64 that holds it.
+	///
+	/// Throws a SyntaxException if the value cannot be represented.
+{
+#if defined(POCO_HAVE_INT64)
+	if (convertIntegerFast(begin, end, handler)) return;
+
+	std::string text(begin, end);
+	try
+	{
+		Int64 value = NumberParser::parse64(text);
+		// if number is 32-bit, then handle as such
+		if (value > std::numeric_limits<int>::max() || value < std::numeric_limits<int>::min())
+			handler.value(value);
+		else
+			handler.value(static_cast<int>(value));
+	}
+	// try to handle error as unsigned in case of overflow
+	catch (SyntaxException&)
+	{
+		UInt64 value = NumberParser::parseUnsigned64(text);
+		// if number is 32-bit, then handle as such
+		if (value > std::numeric_limits<unsigned>::max())
+			handler.value(value);
+		else
+			handler.value(static_cast<unsigned>(value));
+	}
+#else
+	std::string text(begin, end);
+	try
+	{
+		handler.value(NumberParser::parse(text));
+	}
+	// try to handle error as unsigned in case of overflow
+	catch (SyntaxException&)
+	{
+		handler.value(NumberParser::parseUnsigned(text));
+	}
+#endif
+}
+
+
+template <class H>
+void convertFloat(const char* begin, const char* end, H& handler)
+	/// Converts the floating-point number in [begin, end)
+	/// and passes it to the handler as double.
+	///
+	/// Throws a SyntaxException if the number is invalid.
+{
+	double value;
+#if defined(POCO_HAVE_INT64)
+	if (!parseFloatFast(begin, end, value))
+#endif
+		value = NumberParser::parseFloat(std::string(begin, end));
+	handler.value(value);
+}
+
+
+} } } // namespace Poco::JSON::Impl
+
+
+#endif // JSON_NumberConverter_INCLUDED
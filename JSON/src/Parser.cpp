@@ -36,6 +36,7 @@
 
 #include "Poco/JSON/Parser.h"
 #include "Poco/JSON/JSONException.h"
+#include "NumberConverter.h"
 #include "Poco/Ascii.h"
 #include "Poco/Token.h"
 #include "Poco/UTF8Encoding.h"
@@ -44,6 +45,11 @@
 #include <limits>
 #include <clocale>
 #include <istream>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_JSON_HAVE_SSE2
+#endif
 
 
 namespace Poco {
@@ -173,15 +179,20 @@ void Parser::reset()
 
 Dynamic::Var Parser::parse(const std::string& json)
 {
-	std::string::const_iterator it = json.begin();
-	std::string::const_iterator end = json.end();
-	Source<std::string::const_iterator> source(it, end);
+	return parse(json.data(), json.size());
+}
+
+
+Dynamic::Var Parser::parse(std::istream& in)
+{
+	std::istreambuf_iterator<char> it(in.rdbuf());
+	std::istreambuf_iterator<char> end;
+	Source<std::istreambuf_iterator<char> > source(it, end);
 
 	int c = 0;
 	while(source.nextChar(c))
 	{
-		if (0 == parseChar(c, source))
-			throw SyntaxException("JSON syntax error");
+		if (0 == parseChar(c, source)) throw JSONException("JSON syntax error");
 	}
 
 	if (!done())
@@ -191,16 +202,26 @@ Dynamic::Var Parser::parse(const std::string& json)
 }
 
 
-Dynamic::Var Parser::parse(std::istream& in)
+Dynamic::Var Parser::parse(const char* json, std::size_t length)
 {
-	std::istreambuf_iterator<char> it(in.rdbuf());
-	std::istreambuf_iterator<char> end;
-	Source<std::istreambuf_iterator<char> > source(it, end);
+	Source<const char*> source(json, json + length);
 
 	int c = 0;
 	while(source.nextChar(c))
 	{
-		if (0 == parseChar(c, source)) throw JSONException("JSON syntax error");
+		if (0 == parseChar(c, source))
+			throw SyntaxException("JSON syntax error");
+
+		if (_state == ST && !_escaped)
+		{
+			const char*& pos = source.position();
+			std::size_t n = scanString(pos, source.end());
+			if (n > 0)
+			{
+				parseBufferAppend(pos, n);
+				pos += n;
+			}
+		}
 	}
 
 	if (!done())
@@ -260,6 +281,72 @@ void Parser::parseBufferPushBackChar(char c)
 }
 
 
+void Parser::parseBufferAppend(const char* chars, std::size_t length)
+{
+	std::size_t required = _parseBuffer.size() + length + 1;
+	if (required >= _parseBuffer.capacity())
+	{
+		std::size_t capacity = _parseBuffer.capacity() * 2;
+		_parseBuffer.setCapacity(capacity > required ? capacity : required);
+	}
+
+	_parseBuffer.append(chars, length);
+}
+
+
+std::size_t Parser::scanString(const char* begin, const char* end)
+{
+	const char* it = begin;
+#if defined(POCO_JSON_HAVE_SSE2)
+	// Bytes below 0x20 and bytes of UTF-8 sequences (0x80 and above)
+	// are both less than 0x20 when compared as signed chars.
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i space = _mm_set1_epi8(' ');
+	while (end - it >= 16)
+	{
+		__m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+		__m128i special = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)),
+			_mm_cmplt_epi8(chars, space));
+		int mask = _mm_movemask_epi8(special);
+		if (mask != 0)
+		{
+			while (!(mask & 1))
+			{
+				mask >>= 1;
+				++it;
+			}
+			return it - begin;
+		}
+		it += 16;
+	}
+#else
+	// Scan a machine word at a time; see "Determine if a word
+	// has a byte less than n" in Sean Anderson's Bit Twiddling Hacks.
+	static const UIntPtr ones = ~UIntPtr(0)/255;
+	static const UIntPtr highBits = ones*0x80;
+	while (static_cast<std::size_t>(end - it) >= sizeof(UIntPtr))
+	{
+		UIntPtr word;
+		std::memcpy(&word, it, sizeof(word));
+		UIntPtr quotes = word ^ (ones*'"');
+		UIntPtr backslashes = word ^ (ones*'\\');
+		UIntPtr special = ((word - ones*0x20) | (quotes - ones) | (backslashes - ones) | word) & highBits;
+		if (special) break;
+		it += sizeof(UIntPtr);
+	}
+#endif
+	while (it != end)
+	{
+		unsigned char ch = static_cast<unsigned char>(*it);
+		if (ch < 0x20 || ch >= 0x80 || ch == '"' || ch == '\\') break;
+		++it;
+	}
+	return it - begin;
+}
+
+
 void Parser::addEscapedCharToParseBuffer(CharIntType nextChar)
 {
 	_escaped = 0;
@@ -435,56 +522,14 @@ void Parser::parseBuffer()
 					// Float can't end with a dot
 					if (_parseBuffer[_parseBuffer.size() - 1] == '.' ) throw SyntaxException("JSON syntax error");
 
-					double float_value = NumberParser::parseFloat(std::string(_parseBuffer.begin(), _parseBuffer.size()));
-					_pHandler->value(float_value);
+					Impl::convertFloat(_parseBuffer.begin(), _parseBuffer.end(), *_pHandler);
 					break;
 				}
 			case JSON_T_INTEGER:
 				{
-#if defined(POCO_HAVE_INT64)
-					try
-					{
-						Int64 value = NumberParser::parse64(std::string(_parseBuffer.begin(), _parseBuffer.size()));
-						// if number is 32-bit, then handle as such
-						if (value > std::numeric_limits<int>::max()
-						 || value < std::numeric_limits<int>::min() )
-						{
-							_pHandler->value(value);
-						}
-						else
-						{
-							_pHandler->value(static_cast<int>(value));
-						}
-					}
-					// try to handle error as unsigned in case of overflow
-					catch ( const SyntaxException& )
-					{
-						UInt64 value = NumberParser::parseUnsigned64(std::string(_parseBuffer.begin(), _parseBuffer.size()));
-						// if number is 32-bit, then handle as such
-						if ( value > std::numeric_limits<unsigned>::max() )
-						{
-							_pHandler->value(value);
-						}
-						else
-						{
-							_pHandler->value(static_cast<unsigned>(value));
-						}
-					}
-#else
-					try
-					{
-						int value = NumberParser::parse(std::string(_parseBuffer.begin(), _parseBuffer.size()));
-						_pHandler->value(value);
-					}
-					// try to handle error as unsigned in case of overflow
-					catch ( const SyntaxException& )
-					{
-						unsigned value = NumberParser::parseUnsigned(std::string(_parseBuffer.begin(), _parseBuffer.size()));
-						_pHandler->value(value);
-					}
-#endif
+					Impl::convertInteger(_parseBuffer.begin(), _parseBuffer.end(), *_pHandler);
+					break;
 				}
-				break;
 			case JSON_T_STRING:
 				{
 					_pHandler->value(std::string(_parseBuffer.begin(), _parseBuffer.size()));
@@ -497,6 +542,7 @@ void Parser::parseBuffer()
 	clearBuffer();
 }
 
+
 int Parser::utf8CheckFirst(char byte)
 {
 	unsigned char u = (unsigned char) byte;
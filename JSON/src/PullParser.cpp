@@ -0,0 +1,596 @@
+//
+// PullParser.cpp
+//
+// $Id$
+//
+// Library: JSON
+// Package: JSON
+// Module:  PullParser
+//
+// Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/JSON/PullParser.h"
+#include "Poco/JSON/JSONException.h"
+#include "Poco/JSON/Object.h"
+#include "Poco/JSON/Array.h"
+#include "NumberConverter.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/Ascii.h"
+#include "Poco/Exception.h"
+#undef min
+#undef max
+#include <limits>
+
+
+namespace Poco {
+namespace JSON {
+
+
+namespace
+{
+	class NumberHandler
+		/// Stores the result of a number conversion in a Var.
+	{
+	public:
+		NumberHandler(Dynamic::Var& result): _result(result)
+		{
+		}
+
+		template <class T>
+		void value(T v)
+		{
+			_result = v;
+		}
+
+	private:
+		Dynamic::Var& _result;
+	};
+}
+
+
+PullParser::Frame::Frame(bool array):
+	isArray(array),
+	index(-1)
+{
+}
+
+
+PullParser::PullParser(std::istream& istr, std::size_t bufferSize):
+	_istr(istr),
+	_buffer(bufferSize > 0 ? bufferSize : 1),
+	_pos(0),
+	_end(0),
+	_token(TOKEN_NONE),
+	_state(STATE_VALUE),
+	_isFloat(false),
+	_hasUTF8(false)
+{
+}
+
+
+PullParser::~PullParser()
+{
+}
+
+
+PullParser::Token PullParser::next()
+{
+	int c = skipWhitespace();
+	switch (_state)
+	{
+	case STATE_VALUE:
+		return readValue(c);
+	case STATE_VALUE_OR_CLOSE:
+		if (c == ']') return closeContainer(c);
+		return readValue(c);
+	case STATE_KEY:
+		return readKey(c);
+	case STATE_KEY_OR_CLOSE:
+		if (c == '}') return closeContainer(c);
+		return readKey(c);
+	case STATE_COLON:
+		if (c != ':') syntaxError("':' expected");
+		++_pos;
+		return readValue(skipWhitespace());
+	case STATE_COMMA_OR_CLOSE:
+		if (c == ',')
+		{
+			++_pos;
+			c = skipWhitespace();
+			if (_frames.back().isArray)
+				return readValue(c);
+			else
+				return readKey(c);
+		}
+		return closeContainer(c);
+	case STATE_END:
+		if (c != END_OF_INPUT) syntaxError("unexpected data after end of document");
+		_text.clear();
+		_token = TOKEN_END;
+		break;
+	}
+	return _token;
+}
+
+
+Dynamic::Var PullParser::value() const
+{
+	switch (_token)
+	{
+	case TOKEN_STRING:
+		return _text;
+	case TOKEN_NUMBER:
+		{
+			Dynamic::Var result;
+			NumberHandler handler(result);
+			const char* begin = _text.data();
+			if (_isFloat)
+				Impl::convertFloat(begin, begin + _text.size(), handler);
+			else
+				Impl::convertInteger(begin, begin + _text.size(), handler);
+			return result;
+		}
+	case TOKEN_TRUE:
+		return true;
+	case TOKEN_FALSE:
+		return false;
+	case TOKEN_NULL:
+		return Dynamic::Var();
+	default:
+		throw InvalidAccessException("The current token is not a scalar value");
+	}
+}
+
+
+Dynamic::Var PullParser::read()
+{
+	if (_token == TOKEN_KEY) next();
+
+	if (_token == TOKEN_BEGIN_OBJECT)
+	{
+		Object::Ptr pObject = new Object;
+		while (next() == TOKEN_KEY)
+		{
+			std::string key(_text);
+			next();
+			pObject->set(key, read());
+		}
+		return pObject;
+	}
+	else if (_token == TOKEN_BEGIN_ARRAY)
+	{
+		Array::Ptr pArray = new Array;
+		while (next() != TOKEN_END_ARRAY)
+		{
+			pArray->add(read());
+		}
+		return pArray;
+	}
+	else return value();
+}
+
+
+void PullParser::skip()
+{
+	if (_token == TOKEN_KEY) next();
+
+	if (_token == TOKEN_BEGIN_OBJECT || _token == TOKEN_BEGIN_ARRAY)
+	{
+		int level = 1;
+		int c = 0;
+		while (level > 0)
+		{
+			c = get();
+			switch (c)
+			{
+			case END_OF_INPUT:
+				syntaxError("unexpected end of document");
+				break;
+			case '"':
+				skipString();
+				break;
+			case '{':
+			case '[':
+				++level;
+				break;
+			case '}':
+			case ']':
+				--level;
+				break;
+			default:
+				break;
+			}
+		}
+		bool isArray = _frames.back().isArray;
+		if (c != (isArray ? ']' : '}')) syntaxError("mismatched brackets");
+		_frames.pop_back();
+		endValue();
+		_text.clear();
+		_token = isArray ? TOKEN_END_ARRAY : TOKEN_END_OBJECT;
+	}
+}
+
+
+std::string PullParser::path() const
+{
+	std::string result;
+	std::size_t n = _frames.size();
+	if (n > 0 && (_token == TOKEN_BEGIN_OBJECT || _token == TOKEN_BEGIN_ARRAY)) --n;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		const Frame& frame = _frames[i];
+		if (frame.isArray)
+		{
+			result += '[';
+			NumberFormatter::append(result, frame.index);
+			result += ']';
+		}
+		else
+		{
+			if (!result.empty()) result += '.';
+			result += frame.key;
+		}
+	}
+	return result;
+}
+
+
+PullParser::Token PullParser::readValue(int c)
+{
+	if (!_frames.empty() && _frames.back().isArray) ++_frames.back().index;
+
+	switch (c)
+	{
+	case '{':
+		++_pos;
+		_frames.push_back(Frame(false));
+		_state = STATE_KEY_OR_CLOSE;
+		_text.clear();
+		return _token = TOKEN_BEGIN_OBJECT;
+	case '[':
+		++_pos;
+		_frames.push_back(Frame(true));
+		_state = STATE_VALUE_OR_CLOSE;
+		_text.clear();
+		return _token = TOKEN_BEGIN_ARRAY;
+	case '"':
+		readString();
+		_token = TOKEN_STRING;
+		break;
+	case 't':
+		readLiteral("true");
+		_token = TOKEN_TRUE;
+		break;
+	case 'f':
+		readLiteral("false");
+		_token = TOKEN_FALSE;
+		break;
+	case 'n':
+		readLiteral("null");
+		_token = TOKEN_NULL;
+		break;
+	case END_OF_INPUT:
+		syntaxError("unexpected end of document");
+		break;
+	default:
+		if (c == '-' || Ascii::isDigit(c))
+		{
+			readNumber();
+			_token = TOKEN_NUMBER;
+		}
+		else syntaxError("value expected");
+	}
+	endValue();
+	return _token;
+}
+
+
+PullParser::Token PullParser::readKey(int c)
+{
+	if (c != '"') syntaxError("member name expected");
+	readString();
+	_frames.back().key = _text;
+	_state = STATE_COLON;
+	return _token = TOKEN_KEY;
+}
+
+
+PullParser::Token PullParser::closeContainer(int c)
+{
+	bool isArray = _frames.back().isArray;
+	if (c != (isArray ? ']' : '}')) syntaxError(isArray ? "',' or ']' expected" : "',' or '}' expected");
+	++_pos;
+	_frames.pop_back();
+	endValue();
+	_text.clear();
+	return _token = isArray ? TOKEN_END_ARRAY : TOKEN_END_OBJECT;
+}
+
+
+void PullParser::endValue()
+{
+	_state = _frames.empty() ? STATE_END : STATE_COMMA_OR_CLOSE;
+}
+
+
+void PullParser::readString()
+{
+	++_pos; // opening quote
+	_text.clear();
+	_hasUTF8 = false;
+	for (;;)
+	{
+		if (_pos == _end && !fill()) syntaxError("unterminated string");
+
+		const char* start = _pos;
+		while (_pos != _end)
+		{
+			unsigned char ch = static_cast<unsigned char>(*_pos);
+			if (ch == '"' || ch == '\\' || ch < 0x20) break;
+			if (ch >= 0x80) _hasUTF8 = true;
+			++_pos;
+		}
+		_text.append(start, _pos - start);
+		if (_pos == _end) continue;
+
+		char ch = *_pos++;
+		if (ch == '"')
+			break;
+		else if (ch == '\\')
+			readEscape();
+		else
+			syntaxError("control character in string");
+	}
+
+	if (_hasUTF8)
+	{
+		const unsigned char* it = reinterpret_cast<const unsigned char*>(_text.data());
+		const unsigned char* end = it + _text.size();
+		while (it != end)
+		{
+			int length = 1;
+			if (*it >= 0x80)
+			{
+				if (*it >= 0xC2 && *it <= 0xDF) length = 2;
+				else if (*it >= 0xE0 && *it <= 0xEF) length = 3;
+				else if (*it >= 0xF0 && *it <= 0xF4) length = 4;
+				else syntaxError("invalid UTF-8 sequence in string");
+				if (end - it < length || !UTF8Encoding::isLegal(it, length))
+					syntaxError("invalid UTF-8 sequence in string");
+			}
+			it += length;
+		}
+	}
+}
+
+
+void PullParser::readEscape()
+{
+	switch (get())
+	{
+	case '"':
+		_text += '"';
+		break;
+	case '\\':
+		_text += '\\';
+		break;
+	case '/':
+		_text += '/';
+		break;
+	case 'b':
+		_text += '\b';
+		break;
+	case 'f':
+		_text += '\f';
+		break;
+	case 'n':
+		_text += '\n';
+		break;
+	case 'r':
+		_text += '\r';
+		break;
+	case 't':
+		_text += '\t';
+		break;
+	case 'u':
+		readUnicodeEscape();
+		break;
+	default:
+		syntaxError("invalid escape sequence in string");
+	}
+}
+
+
+void PullParser::readUnicodeEscape()
+{
+	unsigned ch = readHex4();
+	if (ch >= 0xD800 && ch <= 0xDBFF)
+	{
+		if (get() != '\\' || get() != 'u') syntaxError("missing low surrogate in string");
+		unsigned low = readHex4();
+		if (low < 0xDC00 || low > 0xDFFF) syntaxError("invalid low surrogate in string");
+		ch = (((ch & 0x3FF) << 10) | (low & 0x3FF)) + 0x10000;
+	}
+	else if (ch >= 0xDC00 && ch <= 0xDFFF)
+	{
+		syntaxError("unexpected low surrogate in string");
+	}
+
+	UTF8Encoding utf8;
+	unsigned char bytes[4];
+	int length = utf8.convert(static_cast<int>(ch), bytes, sizeof(bytes));
+	_text.append(reinterpret_cast<const char*>(bytes), length);
+}
+
+
+unsigned PullParser::readHex4()
+{
+	unsigned result = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		int c = get();
+		result <<= 4;
+		if (c >= '0' && c <= '9')
+			result += c - '0';
+		else if (c >= 'a' && c <= 'f')
+			result += c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			result += c - 'A' + 10;
+		else
+			syntaxError("invalid unicode escape sequence in string");
+	}
+	return result;
+}
+
+
+void PullParser::readNumber()
+{
+	_text.clear();
+	_isFloat = false;
+	if (peek() == '-')
+	{
+		_text += '-';
+		++_pos;
+	}
+	if (peek() == '0')
+	{
+		_text += '0';
+		++_pos;
+	}
+	else if (readDigits() == 0) syntaxError("invalid number");
+
+	if (peek() == '.')
+	{
+		_isFloat = true;
+		_text += '.';
+		++_pos;
+		if (readDigits() == 0) syntaxError("invalid number");
+	}
+	int c = peek();
+	if (c == 'e' || c == 'E')
+	{
+		_isFloat = true;
+		_text += static_cast<char>(c);
+		++_pos;
+		c = peek();
+		if (c == '+' || c == '-')
+		{
+			_text += static_cast<char>(c);
+			++_pos;
+		}
+		if (readDigits() == 0) syntaxError("invalid number");
+	}
+}
+
+
+std::size_t PullParser::readDigits()
+{
+	std::size_t n = 0;
+	while (Ascii::isDigit(peek()))
+	{
+		_text += *_pos++;
+		++n;
+	}
+	return n;
+}
+
+
+void PullParser::readLiteral(const char* literal)
+{
+	_text.clear();
+	for (const char* p = literal; *p; ++p)
+	{
+		if (get() != *p) syntaxError("invalid literal");
+		_text += *p;
+	}
+}
+
+
+void PullParser::skipString()
+{
+	for (;;)
+	{
+		if (_pos == _end && !fill()) syntaxError("unterminated string");
+		while (_pos != _end)
+		{
+			char ch = *_pos++;
+			if (ch == '"')
+			{
+				return;
+			}
+			else if (ch == '\\')
+			{
+				if (get() == END_OF_INPUT) syntaxError("unterminated string");
+			}
+		}
+	}
+}
+
+
+int PullParser::skipWhitespace()
+{
+	for (;;)
+	{
+		int c = peek();
+		if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return c;
+		++_pos;
+	}
+}
+
+
+bool PullParser::fill()
+{
+	if (!_istr.good()) return false;
+
+	// Only take what the stream buffer can deliver without blocking,
+	// once at least one character is available, so that a document
+	// arriving over a socket can be parsed while it is received.
+	std::streambuf* pBuf = _istr.rdbuf();
+	if (!pBuf || pBuf->sgetc() == std::char_traits<char>::eof())
+	{
+		_istr.setstate(std::ios::eofbit);
+		return false;
+	}
+	std::streamsize n = pBuf->in_avail();
+	if (n <= 0) n = 1;
+	if (n > static_cast<std::streamsize>(_buffer.size())) n = static_cast<std::streamsize>(_buffer.size());
+	n = pBuf->sgetn(_buffer.begin(), n);
+	_pos = _buffer.begin();
+	_end = _pos + n;
+	return n > 0;
+}
+
+
+void PullParser::syntaxError(const std::string& what)
+{
+	throw JSONException("JSON syntax error", what);
+}
+
+
+} } // namespace Poco::JSON
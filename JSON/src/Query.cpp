@@ -59,6 +59,11 @@ Query::Query(const Var& source): _source(source)
 }
 
 
+Query::Query(const Document::Value& source): _document(source)
+{
+}
+
+
 Query::~Query()
 {
 }
@@ -122,6 +127,8 @@ Array& Query::findArray(const std::string& path, Array& arr) const
 
 Var Query::find(const std::string& path) const
 {
+	if (!_document.isEmpty()) return _document.find(path).toVar();
+
 	Var result = _source;
 	StringTokenizer tokenizer(path, ".");
 	for(StringTokenizer::Iterator token = tokenizer.begin(); token != tokenizer.end(); token++)
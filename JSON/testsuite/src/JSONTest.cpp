@@ -42,6 +42,9 @@
 #include "Poco/JSON/ParseHandler.h"
 #include "Poco/JSON/PrintHandler.h"
 #include "Poco/JSON/Template.h"
+#include "Poco/JSON/Document.h"
+#include "Poco/JSON/DocumentHandler.h"
+#include "Poco/JSON/PullParser.h"
 
 #include "Poco/Path.h"
 #include "Poco/Environment.h"
@@ -51,6 +54,8 @@
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Latin1Encoding.h"
 #include "Poco/TextConverter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 
 #include "Poco/Dynamic/Struct.h"
 
@@ -1655,6 +1660,442 @@ void JSONTest::testSmallBuffer()
 }
 
 
+void JSONTest::testParseBuffer()
+{
+	// strings long enough to cross several scan blocks, with special
+	// characters at varying offsets
+	std::string plain(100, 'x');
+	for (std::size_t i = 0; i < 40; ++i)
+	{
+		std::string value(plain, 0, i);
+		value += "\\\"\\n\\u00E1";
+		value.append(plain, 0, 40 - i);
+		value += "\xC3\xA9";
+		std::string json = "{ \"key" + plain.substr(0, i) + "\" : \"" + value + "\" }";
+
+		Parser parser;
+		Var result = parser.parse(json.data(), json.size());
+		assert (result.type() == typeid(Object::Ptr));
+		Object::Ptr object = result.extract<Object::Ptr>();
+		std::string expected(plain, 0, i);
+		expected += "\"\n\xC3\xA1";
+		expected.append(plain, 0, 40 - i);
+		expected += "\xC3\xA9";
+		assert (object->getValue<std::string>("key" + plain.substr(0, i)) == expected);
+	}
+
+	Parser parser;
+	std::string json = "[ \"" + plain + "\", \"\" ]";
+	Var result = parser.parse(json.data(), json.size());
+	Poco::JSON::Array::Ptr array = result.extract<Poco::JSON::Array::Ptr>();
+	assert (array->size() == 2);
+	assert (array->getElement<std::string>(0) == plain);
+	assert (array->getElement<std::string>(1).empty());
+
+	json = "[ \"" + plain + "\t" + plain + "\" ]";
+	parser.reset();
+	try
+	{
+		parser.parse(json.data(), json.size());
+		fail ("control characters in strings must be rejected");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+
+	json = "[ \"" + plain + "\xC3\x28\" ]";
+	parser.reset();
+	try
+	{
+		parser.parse(json.data(), json.size());
+		fail ("invalid UTF-8 must be rejected");
+	}
+	catch (JSONException&)
+	{
+	}
+
+	json = "[ \"" + plain;
+	parser.reset();
+	try
+	{
+		parser.parse(json.data(), json.size());
+		fail ("unterminated string must be rejected");
+	}
+	catch (JSONException&)
+	{
+	}
+}
+
+
+void JSONTest::testParseNumbers()
+{
+	std::string json = "[ 0, -0, 2147483647, -2147483648, 2147483648, -2147483649, "
+		"9223372036854775807, -9223372036854775808, 18446744073709551615 ]";
+	Parser parser;
+	Var result = parser.parse(json);
+	Poco::JSON::Array::Ptr array = result.extract<Poco::JSON::Array::Ptr>();
+	assert (array->get(0).type() == typeid(int) && array->getElement<int>(0) == 0);
+	assert (array->get(1).type() == typeid(int) && array->getElement<int>(1) == 0);
+	assert (array->get(2).type() == typeid(int) && array->getElement<int>(2) == 2147483647);
+	assert (array->get(3).type() == typeid(int) && array->getElement<int>(3) == -2147483647 - 1);
+#if defined(POCO_HAVE_INT64)
+	assert (array->get(4).type() == typeid(Poco::Int64) && array->getElement<Poco::Int64>(4) == 2147483648LL);
+	assert (array->get(5).type() == typeid(Poco::Int64) && array->getElement<Poco::Int64>(5) == -2147483649LL);
+	assert (array->get(6).type() == typeid(Poco::Int64) && array->getElement<Poco::Int64>(6) == 9223372036854775807LL);
+	assert (array->get(7).type() == typeid(Poco::Int64) && array->getElement<Poco::Int64>(7) == -9223372036854775807LL - 1);
+	assert (array->get(8).type() == typeid(Poco::UInt64) && array->getElement<Poco::UInt64>(8) == 18446744073709551615ULL);
+#endif
+
+	const char* floats[] =
+	{
+		"0.5", "-0.5", "0.1", "3.14159", "1e22", "1E-22", "-2.5e+3", "123456789012345.6",
+		"0.000001", "1.7976931348623157e308", "4.9e-324", "1234567890123456789.0", "2.2250738585072014E-308"
+	};
+	for (std::size_t i = 0; i < sizeof(floats)/sizeof(floats[0]); ++i)
+	{
+		parser.reset();
+		json = std::string("[ ") + floats[i] + " ]";
+		result = parser.parse(json);
+		array = result.extract<Poco::JSON::Array::Ptr>();
+		assert (array->get(0).type() == typeid(double));
+		assert (array->getElement<double>(0) == Poco::NumberParser::parseFloat(floats[i]));
+	}
+}
+
+
+void JSONTest::testDocument()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"age\" : 42, \"big\" : 12345678901, \"ratio\" : 0.5, \"married\" : true, \"pet\" : null, "
+		"\"children\" : [ { \"name\" : \"Jonas\", \"age\" : 5 }, { \"name\" : \"Ellen\", \"age\" : 3 } ], "
+		"\"address\": { \"street\": \"A Street\", \"number\": 123, \"city\":\"The City\"} }";
+	Document::Ptr pDoc = Document::parse(json);
+	Document::Value root = pDoc->root();
+	assert (root.isObject());
+	assert (root.size() == 8);
+	assert (root.getValue<std::string>("name") == "Franky");
+	assert (root.getValue<int>("age") == 42);
+	assert (root.get("age").type() == typeid(int));
+#if defined(POCO_HAVE_INT64)
+	assert (root.get("big").type() == typeid(Poco::Int64));
+	assert (root.getValue<Poco::Int64>("big") == 12345678901LL);
+#endif
+	assert (root.getValue<double>("ratio") == 0.5);
+	assert (root.getValue<bool>("married"));
+	assert (root.has("pet"));
+	assert (root.isNull("pet"));
+	assert (root.isNull("dog"));
+	assert (!root.has("dog"));
+	assert (root.member("dog").isEmpty());
+	assert (root.optValue<int>("dog", 7) == 7);
+	assert (root.optValue<std::string>("name", "") == "Franky");
+	assert (root.isArray("children"));
+	assert (root.isObject("address"));
+
+	std::vector<std::string> names;
+	root.getNames(names);
+	assert (names.size() == 8);
+	assert (names[0] == "address");
+	assert (names[7] == "ratio");
+	assert (root.keyAt(1) == "age");
+	assert (root.valueAt(1).convert<int>() == 42);
+
+	Document::Value children = root.member("children");
+	assert (children.size() == 2);
+	assert (children.element(1).getValue<std::string>("name") == "Ellen");
+	assert (children.element(2).isEmpty());
+	assert (root.find("children[0].age").convert<int>() == 5);
+	assert (root.find("address.city").convert<std::string>() == "The City");
+	assert (root.find("address.zip").isEmpty());
+	assert (root.find("children[5].age").isEmpty());
+
+	Object::Ptr pAddress = root.getObject("address");
+	assert (!pAddress.isNull());
+	assert (pAddress->getValue<int>("number") == 123);
+	Poco::JSON::Array::Ptr pChildren = root.getArray("children");
+	assert (pChildren->size() == 2);
+	assert (pChildren->getObject(0)->getValue<std::string>("name") == "Jonas");
+	assert (root.getObject("children").isNull());
+
+	Var result = root.toVar();
+	assert (result.type() == typeid(Object::Ptr));
+	std::ostringstream ostr;
+	Stringifier::stringify(result, ostr);
+	Parser parser;
+	Var expected = parser.parse(json);
+	std::ostringstream expectedStr;
+	Stringifier::stringify(expected, expectedStr);
+	assert (ostr.str() == expectedStr.str());
+
+	Query query(root);
+	assert (query.findValue<int>("children[1].age", 0) == 3);
+	assert (query.findObject("address")->getValue<std::string>("street") == "A Street");
+	assert (query.findArray("children")->size() == 2);
+	assert (query.find("nothing").isEmpty());
+}
+
+
+void JSONTest::testDocumentHandler()
+{
+	std::string json = "[ { \"id\" : 1, \"id\" : 2, \"tag\" : \"x\" }, { \"tag\" : \"y\", \"id\" : 3 }, [], {}, \"end\" ]";
+	DocumentHandler* pDocumentHandler = new DocumentHandler;
+	Parser parser(pDocumentHandler);
+	Var result = parser.parse(json);
+	assert (result.isEmpty());
+	Document::Ptr pDoc = pDocumentHandler->document();
+	Document::Value root = pDoc->root();
+	assert (root.isArray());
+	assert (root.size() == 5);
+	// duplicate keys: last value wins
+	assert (root.element(0).size() == 2);
+	assert (root.element(0).getValue<int>("id") == 2);
+	assert (root.element(1).keyAt(0) == "id");
+	assert (root.element(1).getValue<int>("id") == 3);
+	assert (root.element(2).isArray() && root.element(2).size() == 0);
+	assert (root.element(3).isObject() && root.element(3).size() == 0);
+	assert (root.element(4).isString());
+	assert (root.get(4).convert<std::string>() == "end");
+
+	parser.reset();
+	parser.parse("{ \"a\" : [ 1, 2, 3 ] }");
+	Document::Ptr pDoc2 = pDocumentHandler->document();
+	assert (pDoc2 != pDoc);
+	assert (pDoc2->root().find("a[2]").convert<int>() == 3);
+	assert (root.size() == 5);
+}
+
+
+void JSONTest::testPullParser()
+{
+	std::string json = "{ \"name\" : \"Fr\\u00e4nky \\\"F\\\"\\ud834\\udd1e\", \"age\" : 42, \"ratio\" : -0.5e1, "
+		"\"married\" : true, \"divorced\" : false, \"pet\" : null, \"children\" : [ { \"name\" : \"Jonas\" }, [] ] }";
+
+	// a tiny buffer makes tokens cross buffer boundaries
+	for (std::size_t bufferSize = 1; bufferSize <= 64; bufferSize *= 4)
+	{
+		std::istringstream istr(json);
+		PullParser pp(istr, bufferSize);
+		assert (pp.token() == PullParser::TOKEN_NONE);
+		assert (pp.next() == PullParser::TOKEN_BEGIN_OBJECT);
+		assert (pp.depth() == 1);
+		assert (pp.path().empty());
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.text() == "name");
+		assert (pp.path() == "name");
+		assert (pp.next() == PullParser::TOKEN_STRING);
+		assert (pp.text() == "Fr\xC3\xA4nky \"F\"\xF0\x9D\x84\x9E");
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.next() == PullParser::TOKEN_NUMBER);
+		assert (pp.text() == "42");
+		assert (pp.value().type() == typeid(int));
+		assert (pp.value() == 42);
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.next() == PullParser::TOKEN_NUMBER);
+		assert (pp.value().type() == typeid(double));
+		assert (pp.value() == -5.0);
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.next() == PullParser::TOKEN_TRUE);
+		assert (pp.value() == true);
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.next() == PullParser::TOKEN_FALSE);
+		assert (pp.value() == false);
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.next() == PullParser::TOKEN_NULL);
+		assert (pp.value().isEmpty());
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.text() == "children");
+		assert (pp.next() == PullParser::TOKEN_BEGIN_ARRAY);
+		assert (pp.path() == "children");
+		assert (pp.depth() == 2);
+		assert (pp.next() == PullParser::TOKEN_BEGIN_OBJECT);
+		assert (pp.path() == "children[0]");
+		assert (pp.next() == PullParser::TOKEN_KEY);
+		assert (pp.path() == "children[0].name");
+		assert (pp.next() == PullParser::TOKEN_STRING);
+		assert (pp.text() == "Jonas");
+		assert (pp.next() == PullParser::TOKEN_END_OBJECT);
+		assert (pp.path() == "children[0]");
+		assert (pp.next() == PullParser::TOKEN_BEGIN_ARRAY);
+		assert (pp.path() == "children[1]");
+		assert (pp.next() == PullParser::TOKEN_END_ARRAY);
+		assert (pp.next() == PullParser::TOKEN_END_ARRAY);
+		assert (pp.depth() == 1);
+		assert (pp.next() == PullParser::TOKEN_END_OBJECT);
+		assert (pp.depth() == 0);
+		assert (pp.next() == PullParser::TOKEN_END);
+		assert (pp.next() == PullParser::TOKEN_END);
+
+		try
+		{
+			pp.value();
+			fail ("not a scalar - must throw");
+		}
+		catch (Poco::InvalidAccessException&)
+		{
+		}
+	}
+}
+
+
+void JSONTest::testPullParserSkipRead()
+{
+	std::ostringstream ostr;
+	ostr << "[";
+	for (int i = 0; i < 1000; ++i)
+	{
+		if (i > 0) ostr << ",\n";
+		ostr << "{ \"id\" : " << i << ", \"tags\" : [ \"a]\", \"b\\\"}\" ], \"payload\" : { \"x\" : [ 1, [ 2, { } ] ] }, "
+		     << "\"address\" : { \"city\" : \"City " << i << "\" } }";
+	}
+	ostr << "]";
+
+	std::istringstream istr(ostr.str());
+	PullParser pp(istr, 100);
+	assert (pp.next() == PullParser::TOKEN_BEGIN_ARRAY);
+	int count = 0;
+	while (pp.next() != PullParser::TOKEN_END_ARRAY)
+	{
+		assert (pp.token() == PullParser::TOKEN_BEGIN_OBJECT);
+		while (pp.next() == PullParser::TOKEN_KEY)
+		{
+			if (pp.text() == "id")
+			{
+				pp.next();
+				assert (pp.value() == count);
+			}
+			else if (pp.text() == "address")
+			{
+				Var address = pp.read();
+				assert (pp.token() == PullParser::TOKEN_END_OBJECT);
+				Object::Ptr pAddress = address.extract<Object::Ptr>();
+				assert (pAddress->getValue<std::string>("city") == "City " + Poco::NumberFormatter::format(count));
+			}
+			else
+			{
+				pp.skip();
+				assert (pp.token() == PullParser::TOKEN_END_ARRAY || pp.token() == PullParser::TOKEN_END_OBJECT);
+			}
+		}
+		assert (pp.token() == PullParser::TOKEN_END_OBJECT);
+		++count;
+	}
+	assert (count == 1000);
+	assert (pp.next() == PullParser::TOKEN_END);
+
+	std::istringstream istr2(ostr.str());
+	PullParser pp2(istr2);
+	pp2.next();
+	pp2.next();
+	Var record = pp2.read();
+	Query query(record);
+	assert (query.findValue<int>("payload.x[1][0]", 0) == 2);
+	assert (query.findValue<std::string>("tags[1]", "") == "b\"}");
+	pp2.skip();
+	assert (pp2.next() == PullParser::TOKEN_BEGIN_OBJECT);
+	pp2.skip();
+	assert (pp2.token() == PullParser::TOKEN_END_OBJECT);
+	assert (pp2.depth() == 1);
+}
+
+
+void JSONTest::testPullParserErrors()
+{
+	const char* invalid[] =
+	{
+		"", "{", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "{1:2}", "[01]", "[1.]", "[-]", "[1e]",
+		"[tru]", "[\"abc]", "[\"a\tb\"]", "[\"\\x\"]", "[\"\\ud834\"]", "[\"\xC3\x28\"]", "[1] 2", "[}", "{]"
+	};
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); ++i)
+	{
+		std::istringstream istr(invalid[i]);
+		PullParser pp(istr, 2);
+		try
+		{
+			while (pp.next() != PullParser::TOKEN_END)
+			{
+			}
+			fail (std::string("must throw: ") + invalid[i]);
+		}
+		catch (JSONException&)
+		{
+		}
+	}
+
+	std::istringstream istr("[ [ 1, 2 }, 3 ]");
+	PullParser pp(istr);
+	pp.next();
+	pp.next();
+	try
+	{
+		pp.skip();
+		fail ("mismatched brackets - must throw");
+	}
+	catch (JSONException&)
+	{
+	}
+}
+
+
+namespace
+{
+	class ChunkedStreamBuf: public std::streambuf
+		/// Delivers the given chunks one at a time, like a socket
+		/// stream receiving a document in several packets.
+	{
+	public:
+		ChunkedStreamBuf(const std::vector<std::string>& chunks):
+			_chunks(chunks),
+			_next(0)
+		{
+		}
+
+		std::size_t chunksDelivered() const
+		{
+			return _next;
+		}
+
+	protected:
+		int_type underflow()
+		{
+			if (_next == _chunks.size()) return traits_type::eof();
+			_current = _chunks[_next++];
+			char* p = const_cast<char*>(_current.data());
+			setg(p, p, p + _current.size());
+			return traits_type::to_int_type(*p);
+		}
+
+	private:
+		std::vector<std::string> _chunks;
+		std::size_t _next;
+		std::string _current;
+	};
+}
+
+
+void JSONTest::testPullParserPartialInput()
+{
+	std::vector<std::string> chunks;
+	chunks.push_back("[1, 12345678901");
+	chunks.push_back("2, 1.5");
+	chunks.push_back("e3]");
+	ChunkedStreamBuf buf(chunks);
+	std::istream istr(&buf);
+	PullParser pp(istr);
+
+	// tokens are available as soon as their chunk has arrived
+	assert (pp.next() == PullParser::TOKEN_BEGIN_ARRAY);
+	assert (pp.next() == PullParser::TOKEN_NUMBER);
+	assert (pp.value() == 1);
+	assert (buf.chunksDelivered() == 1);
+	assert (pp.next() == PullParser::TOKEN_NUMBER);
+	assert (pp.value() == Poco::Int64(123456789012LL));
+	assert (buf.chunksDelivered() == 2);
+	assert (pp.next() == PullParser::TOKEN_NUMBER);
+	assert (pp.value() == 1500.0);
+	assert (pp.next() == PullParser::TOKEN_END_ARRAY);
+	assert (pp.next() == PullParser::TOKEN_END);
+}
+
+
 std::string JSONTest::getTestFilesPath(const std::string& type)
 {
 	std::ostringstream ostr;
@@ -1726,6 +2167,14 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testTemplate);
 	CppUnit_addTest(pSuite, JSONTest, testUnicode);
 	CppUnit_addTest(pSuite, JSONTest, testSmallBuffer);
+	CppUnit_addTest(pSuite, JSONTest, testParseBuffer);
+	CppUnit_addTest(pSuite, JSONTest, testParseNumbers);
+	CppUnit_addTest(pSuite, JSONTest, testDocument);
+	CppUnit_addTest(pSuite, JSONTest, testDocumentHandler);
+	CppUnit_addTest(pSuite, JSONTest, testPullParser);
+	CppUnit_addTest(pSuite, JSONTest, testPullParserSkipRead);
+	CppUnit_addTest(pSuite, JSONTest, testPullParserErrors);
+	CppUnit_addTest(pSuite, JSONTest, testPullParserPartialInput);
 
 	return pSuite;
 }
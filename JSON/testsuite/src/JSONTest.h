@@ -87,6 +87,14 @@ public:
 	void testUnicode(); 
 	void testInvalidUnicodeJanssonFiles();
 	void testSmallBuffer();
+	void testParseBuffer();
+	void testParseNumbers();
+	void testDocument();
+	void testDocumentHandler();
+	void testPullParser();
+	void testPullParserSkipRead();
+	void testPullParserErrors();
+	void testPullParserPartialInput();
 
 	void setUp();
 	void tearDown();
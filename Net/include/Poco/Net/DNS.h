@@ -44,12 +44,16 @@
 #include "Poco/Net/SocketDefs.h"
 #include "Poco/Net/IPAddress.h"
 #include "Poco/Net/HostEntry.h"
+#include "Poco/SharedPtr.h"
 
 
 namespace Poco {
 namespace Net {
 
 
+class DNSCache;
+
+
 class Net_API DNS
 	/// This class provides an interface to the
 	/// domain name service.
@@ -69,6 +73,9 @@ public:
 		DNS_HINT_AI_ALL = AI_ALL, // Query both IP6 and IP4 with AI_V4MAPPED
 		DNS_HINT_AI_ADDRCONFIG = AI_ADDRCONFIG, // Resolution only if global address configured
 		DNS_HINT_AI_V4MAPPED = AI_V4MAPPED, // On v6 failure, query v4 and convert to V4MAPPED format	
+		DNS_HINT_DEFAULT = DNS_HINT_AI_CANONNAME | DNS_HINT_AI_ADDRCONFIG // Flags used by hostByName() if none are given
+#else
+		DNS_HINT_DEFAULT = DNS_HINT_NONE
 #endif
 	};
 
@@ -92,6 +99,10 @@ public:
 		/// Throws a DNSException in case of a general DNS error.
 		///
 		/// Throws an IOException in case of any other error.
+		///
+		/// If a DNSCache has been installed with setCache(), and the
+		/// given hintFlags match the ones of the cache, the lookup
+		/// goes through the cache.
 		
 	static HostEntry hostByAddress(const IPAddress& address, unsigned hintFlags =
 #ifdef POCO_HAVE_ADDRINFO
@@ -150,17 +161,30 @@ public:
 		/// has been compiled with -DPOCO_HAVE_LIBRESOLV. Otherwise
 		/// it will do nothing.
 
-	//@ deprecated
+	static void setCache(Poco::SharedPtr<DNSCache> pCache);
+		/// Installs the given DNSCache, which is then used by
+		/// hostByName() (and thus by SocketAddress and all
+		/// classes using it) for looking up host names.
+		///
+		/// Pass a null pointer to remove the cache.
+		
+	static Poco::SharedPtr<DNSCache> getCache();
+		/// Returns the DNSCache installed with setCache(),
+		/// or a null pointer if no cache has been installed.
+
 	static void flushCache();
-		/// Flushes the internal DNS cache.
+		/// Flushes the DNSCache installed with setCache().
 		///
-		/// As of 1.4.2, the DNS cache is no longer used
-		/// and this method does not do anything.
+		/// Does nothing if no cache has been installed.
 		
 	static std::string hostName();
 		/// Returns the host name of this host.
 
 protected:
+	static HostEntry lookup(const std::string& hostname, unsigned hintFlags);
+		/// Looks up the host with the given name, bypassing
+		/// the DNSCache.
+
 	static int lastError();
 		/// Returns the code of the last error.
 		
@@ -169,6 +193,8 @@ protected:
 
 	static void aierror(int code, const std::string& arg);
 		/// Throws an exception according to the getaddrinfo() error code.
+
+	friend class DNSCache;
 };
 
 
@@ -0,0 +1,247 @@
+//
+// DNSCache.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/DNSCache.h#1 $
+//
+// Library: Net
+// Package: NetCore
+// Module:  DNSCache
+//
+// Definition of the DNSCache class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_DNSCache_INCLUDED
+#define Net_DNSCache_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/DNS.h"
+#include "Poco/Net/HostEntry.h"
+#include "Poco/UniqueExpireLRUCache.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Exception.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <set>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API DNSCache
+	/// A caching host name resolver.
+	///
+	/// DNSCache keeps the results of host name lookups for a
+	/// configurable time-to-live (TTL), so that repeated lookups
+	/// of the same host name (e.g., for every new connection to
+	/// the same server) do not have to go to the resolver again.
+	///
+	/// Lookups that fail with a HostNotFoundException or a
+	/// NoAddressFoundException are cached as well (negative caching),
+	/// usually with a shorter TTL. Temporary errors (DNSException)
+	/// are never cached.
+	///
+	/// An entry that is accessed after three quarters of its TTL
+	/// have elapsed is refreshed in the background, while the
+	/// current result is still returned to the caller. Hot entries
+	/// therefore never expire while they are in use.
+	///
+	/// Host names can also be resolved asynchronously with
+	/// resolveAsync(). Background refreshes and asynchronous lookups
+	/// are run in threads obtained from the default thread pool.
+	///
+	/// The actual lookup is done in the virtual query() member function,
+	/// which by default uses the system resolver. Subclasses can
+	/// override it to use a different name service.
+	///
+	/// A DNSCache can be installed with DNS::setCache(). DNS::hostByName()
+	/// then goes through the cache, which makes the cache transparently
+	/// available to SocketAddress and all classes using it.
+{
+public:
+	typedef Poco::ActiveResult<HostEntry> Result;
+
+	enum
+	{
+		DEFAULT_TTL          = 300, /// seconds
+		DEFAULT_NEGATIVE_TTL = 10,  /// seconds
+		DEFAULT_CACHE_SIZE   = 1024
+	};
+
+	DNSCache();
+		/// Creates a DNSCache using the default TTLs and cache size.
+
+	DNSCache(const Poco::Timespan& ttl, const Poco::Timespan& negativeTTL, long cacheSize = DEFAULT_CACHE_SIZE, unsigned hintFlags = DNS::DNS_HINT_DEFAULT);
+		/// Creates a DNSCache.
+		///
+		/// Successful lookups are cached for the given ttl, failed lookups
+		/// for the given negativeTTL. A TTL of zero disables the
+		/// respective kind of caching. At most cacheSize entries are
+		/// kept; if the cache is full, the least recently used
+		/// entry is discarded.
+		///
+		/// The hintFlags are passed to getaddrinfo() by the default
+		/// implementation of query().
+
+	virtual ~DNSCache();
+		/// Destroys the DNSCache, after waiting for all pending
+		/// background operations to complete.
+
+	HostEntry resolve(const std::string& hostname);
+		/// Returns a HostEntry object containing the DNS information
+		/// for the host with the given name, either from the cache
+		/// or by calling query().
+		///
+		/// Throws a HostNotFoundException if a host with the given
+		/// name cannot be found.
+		///
+		/// Throws a NoAddressFoundException if no address can be
+		/// found for the hostname.
+		///
+		/// Throws a DNSException in case of a general DNS error.
+
+	Result resolveAsync(const std::string& hostname);
+		/// Resolves the given host name asynchronously.
+		///
+		/// If a valid entry for the host name is in the cache,
+		/// the returned result is already available. Otherwise,
+		/// the lookup is done in a thread from the default thread
+		/// pool. Lookup errors are reported through the returned result.
+		///
+		/// Throws a NoThreadAvailableException if the default thread
+		/// pool has no thread available for the lookup.
+
+	void remove(const std::string& hostname);
+		/// Removes the entry for the given host name from the cache.
+
+	void clear();
+		/// Removes all entries from the cache.
+
+	std::size_t size();
+		/// Returns the number of entries in the cache,
+		/// including negative entries.
+
+	void waitForCompletion();
+		/// Waits until all pending asynchronous lookups and
+		/// background refreshes have completed.
+		///
+		/// Subclasses overriding query() should call this in their
+		/// destructor.
+
+	const Poco::Timespan& getTTL() const;
+		/// Returns the TTL for successful lookups.
+
+	const Poco::Timespan& getNegativeTTL() const;
+		/// Returns the TTL for failed lookups.
+
+	unsigned hintFlags() const;
+		/// Returns the hint flags used for lookups.
+
+protected:
+	virtual HostEntry query(const std::string& hostname);
+		/// Looks up the given host name, bypassing the cache.
+		///
+		/// The default implementation uses the system resolver,
+		/// like DNS::hostByName().
+
+	HostEntry resolveImpl(const std::string& hostname);
+	void refreshImpl(const std::string& hostname);
+
+private:
+	class Entry
+	{
+	public:
+		Entry(const HostEntry& hostEntry, const Poco::Timespan& ttl);
+		Entry(const Poco::Exception& exc, const Poco::Timespan& ttl);
+		const HostEntry& hostEntry() const;
+		const Poco::Exception* exception() const;
+		bool mustRefresh() const;
+		const Poco::Timestamp& getExpiration() const;
+
+	private:
+		HostEntry _hostEntry;
+		Poco::SharedPtr<Poco::Exception> _pException;
+		Poco::Timestamp _refresh;
+		Poco::Timestamp _expiration;
+	};
+
+	typedef Poco::UniqueExpireLRUCache<std::string, Entry> Cache;
+
+	DNSCache(const DNSCache&);
+	DNSCache& operator = (const DNSCache&);
+
+	HostEntry lookup(const std::string& hostname);
+	void startRefresh(const std::string& hostname);
+	void finishRefresh(const std::string& hostname);
+	void taskStarted();
+	void taskDone();
+
+	Poco::Timespan        _ttl;
+	Poco::Timespan        _negativeTTL;
+	unsigned              _hintFlags;
+	Cache                 _cache;
+	std::set<std::string> _refreshing;
+	int                   _pending;
+	Poco::Mutex           _mutex;
+	Poco::Condition       _idle;
+	Poco::ActiveMethod<HostEntry, std::string, DNSCache> _resolveAsync;
+	Poco::ActiveMethod<void, std::string, DNSCache> _refreshAsync;
+};
+
+
+//
+// inlines
+//
+inline const Poco::Timespan& DNSCache::getTTL() const
+{
+	return _ttl;
+}
+
+
+inline const Poco::Timespan& DNSCache::getNegativeTTL() const
+{
+	return _negativeTTL;
+}
+
+
+inline unsigned DNSCache::hintFlags() const
+{
+	return _hintFlags;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_DNSCache_INCLUDED
@@ -0,0 +1,329 @@
+//
+// HTTPAsyncClient.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/HTTPAsyncClient.h#1 $
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPAsyncClient
+//
+// Definition of the HTTPAsyncClient class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_HTTPAsyncClient_INCLUDED
+#define Net_HTTPAsyncClient_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timespan.h"
+#include "Poco/Mutex.h"
+#include <map>
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPRequest;
+class SocketReactor;
+
+
+class Net_API HTTPAsyncClient
+	/// An asynchronous HTTP client driven by a SocketReactor.
+	///
+	/// Unlike HTTPClientSession, which blocks the calling thread
+	/// until the response has been received, HTTPAsyncClient
+	/// only serializes the request and queues it. All socket I/O
+	/// is done by non-blocking sockets registered with a SocketReactor,
+	/// so a single reactor thread can have a large number of requests
+	/// in progress at the same time.
+	///
+	/// The result of a request is either delivered as an ActiveResult,
+	/// or passed to a Callback object. In both cases, the complete
+	/// response, including its body, is held in memory. Fixed-length,
+	/// chunked and connection-delimited response bodies are supported.
+	///
+	/// Connections are kept alive and reused for further requests to the
+	/// same endpoint (host and port). Up to getMaxConnectionsPerEndpoint()
+	/// connections are opened for each endpoint; requests exceeding this limit
+	/// are queued until a connection becomes available.
+	///
+	/// Idempotent requests (GET, HEAD, PUT, DELETE, OPTIONS and TRACE)
+	/// are pipelined: up to getPipelineDepth() of them are sent on a
+	/// connection without waiting for the preceding responses, once the
+	/// server has answered a first request on that connection without
+	/// closing it. If the server
+	/// closes the connection after a response, requests that have not been
+	/// answered yet are sent again on another connection. Other requests
+	/// are only sent on a connection that has no outstanding requests.
+	///
+	/// Callbacks are invoked, and ActiveResults become available, in
+	/// the reactor's thread (or, if a connection cannot be opened at all,
+	/// in the thread calling sendRequest()). Callbacks must therefore not
+	/// block, and must not wait for an ActiveResult obtained from the
+	/// same client.
+	///
+	/// Requests can be sent from any thread. The SocketReactor must be
+	/// running in its own thread, and the HTTPAsyncClient must only be
+	/// destroyed after the SocketReactor has been stopped, or
+	/// from within the reactor's thread. Any requests that have not been
+	/// completed at that time fail with an exception.
+	///
+	/// Timeouts are checked when the SocketReactor dispatches a
+	/// TimeoutNotification, which it does at least once per reactor
+	/// timeout, even while it is busy. Timeouts are therefore only
+	/// as precise as the reactor's timeout.
+	///
+	/// Usage example:
+	///     SocketReactor reactor;
+	///     Thread thread;
+	///     thread.start(reactor);
+	///
+	///     HTTPAsyncClient client(reactor);
+	///     HTTPRequest request(HTTPRequest::HTTP_GET, "/", HTTPMessage::HTTP_1_1);
+	///     ActiveResult<HTTPAsyncClient::Response> result = client.sendRequest("www.appinf.com", 80, request);
+	///     result.wait();
+	///     if (!result.failed())
+	///         std::cout << result.data().body();
+{
+public:
+	class Net_API Response: public HTTPResponse
+		/// A HTTPResponse, together with its body.
+	{
+	public:
+		Response();
+			/// Creates an empty Response.
+
+		~Response();
+			/// Destroys the Response.
+
+		const std::string& body() const;
+			/// Returns the response body.
+
+		std::string& body();
+			/// Returns the response body.
+
+	private:
+		std::string _body;
+	};
+
+	class Net_API Callback
+		/// Receives the result of a request
+		/// sent with HTTPAsyncClient::sendRequest().
+	{
+	public:
+		virtual ~Callback();
+			/// Destroys the Callback.
+
+		virtual void onResponse(Response& response) = 0;
+			/// Called when the complete response has been received.
+
+		virtual void onError(const Poco::Exception& exc) = 0;
+			/// Called if the request failed.
+	};
+
+	typedef Poco::SharedPtr<Callback> CallbackPtr;
+
+	enum
+	{
+		DEFAULT_MAX_CONNECTIONS_PER_ENDPOINT = 4,
+		DEFAULT_PIPELINE_DEPTH = 4,
+		DEFAULT_TIMEOUT = 60,
+			/// in seconds
+		DEFAULT_KEEP_ALIVE_TIMEOUT = 10,
+			/// in seconds
+		DEFAULT_MAX_RESPONSE_SIZE = 16777216,
+			/// in bytes
+		MAX_HEADER_LENGTH = 65536
+			/// Maximum length of the status line and header
+			/// of a single response.
+	};
+
+	explicit HTTPAsyncClient(SocketReactor& reactor);
+		/// Creates the HTTPAsyncClient, using the given SocketReactor.
+
+	~HTTPAsyncClient();
+		/// Closes all connections and destroys the HTTPAsyncClient.
+		///
+		/// All requests that have not been completed yet fail
+		/// with an exception.
+
+	Poco::ActiveResult<Response> sendRequest(const std::string& host, Poco::UInt16 port, HTTPRequest& request, const std::string& body = "");
+		/// Sends the given request, together with the given body, to the
+		/// server at the given host and port.
+		///
+		/// The Host header is set if the request does not have one. If the
+		/// request uses chunked transfer encoding, the body is sent as a single
+		/// chunk. Otherwise, the Content-Length header is set, unless the body
+		/// is empty and the method is neither POST nor PUT.
+		///
+		/// Returns an ActiveResult that becomes available when the
+		/// response has been received, or the request has failed.
+		///
+		/// The host name is resolved in the calling thread, the first
+		/// time a request is sent to the given host and port.
+		/// Throws an exception if the host name cannot be resolved.
+
+	void sendRequest(const std::string& host, Poco::UInt16 port, HTTPRequest& request, const std::string& body, CallbackPtr pCallback);
+		/// Sends the given request, together with the given body, to the
+		/// server at the given host and port. See above for details.
+		///
+		/// The result is passed to the given Callback, in the reactor's thread.
+
+	void setMaxConnectionsPerEndpoint(int maxConnections);
+		/// Sets the maximum number of connections opened
+		/// to a single endpoint.
+
+	int getMaxConnectionsPerEndpoint() const;
+		/// Returns the maximum number of connections opened
+		/// to a single endpoint.
+
+	void setPipelineDepth(int depth);
+		/// Sets the maximum number of requests sent on a connection
+		/// without waiting for their responses. A depth of 1 disables
+		/// pipelining.
+
+	int getPipelineDepth() const;
+		/// Returns the maximum number of requests sent on a connection
+		/// without waiting for their responses.
+
+	void setTimeout(const Poco::Timespan& timeout);
+		/// Sets the time after which a request fails with a
+		/// TimeoutException if the connection has been inactive.
+
+	const Poco::Timespan& getTimeout() const;
+		/// Returns the request timeout.
+
+	void setKeepAliveTimeout(const Poco::Timespan& timeout);
+		/// Sets the time after which a connection without
+		/// outstanding requests is closed.
+
+	const Poco::Timespan& getKeepAliveTimeout() const;
+		/// Returns the keep-alive timeout.
+
+	void setMaxResponseSize(std::size_t size);
+		/// Sets the maximum size of a response body. A request whose
+		/// response has a larger body fails with a MessageException,
+		/// and the connection is closed.
+		///
+		/// The default is DEFAULT_MAX_RESPONSE_SIZE.
+
+	std::size_t getMaxResponseSize() const;
+		/// Returns the maximum size of a response body.
+
+	std::size_t pending() const;
+		/// Returns the number of requests that have not been completed yet.
+
+	std::size_t connections() const;
+		/// Returns the number of open connections.
+
+private:
+	class Connection;
+	struct Exchange;
+	struct Endpoint;
+
+	typedef std::map<std::string, Endpoint*> EndpointMap;
+	typedef std::vector<Exchange*> ExchangeVec;
+
+	HTTPAsyncClient();
+	HTTPAsyncClient(const HTTPAsyncClient&);
+	HTTPAsyncClient& operator = (const HTTPAsyncClient&);
+
+	void enqueue(const std::string& host, Poco::UInt16 port, HTTPRequest& request, const std::string& body, Exchange* pExchange);
+	void dispatch(Endpoint& endpoint, ExchangeVec& done);
+	void fail(Exchange* pExchange, const Poco::Exception& exc, ExchangeVec& done);
+	static void complete(ExchangeVec& done);
+
+	SocketReactor&  _reactor;
+	EndpointMap     _endpoints;
+	int             _maxConnections;
+	int             _pipelineDepth;
+	Poco::Timespan  _timeout;
+	Poco::Timespan  _keepAliveTimeout;
+	std::size_t     _maxResponseSize;
+	std::size_t     _pending;
+	mutable Poco::FastMutex _mutex;
+
+	friend class Connection;
+};
+
+
+//
+// inlines
+//
+inline const std::string& HTTPAsyncClient::Response::body() const
+{
+	return _body;
+}
+
+
+inline std::string& HTTPAsyncClient::Response::body()
+{
+	return _body;
+}
+
+
+inline int HTTPAsyncClient::getMaxConnectionsPerEndpoint() const
+{
+	return _maxConnections;
+}
+
+
+inline int HTTPAsyncClient::getPipelineDepth() const
+{
+	return _pipelineDepth;
+}
+
+
+inline const Poco::Timespan& HTTPAsyncClient::getTimeout() const
+{
+	return _timeout;
+}
+
+
+inline const Poco::Timespan& HTTPAsyncClient::getKeepAliveTimeout() const
+{
+	return _keepAliveTimeout;
+}
+
+
+inline std::size_t HTTPAsyncClient::getMaxResponseSize() const
+{
+	return _maxResponseSize;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPAsyncClient_INCLUDED
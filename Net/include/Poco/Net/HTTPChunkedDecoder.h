@@ -0,0 +1,83 @@
+//
+// HTTPChunkedDecoder.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/HTTPChunkedDecoder.h#1 $
+//
+// Library: Net
+// Package: HTTP
+// Module:  HTTPChunkedDecoder
+//
+// Definition of the HTTPChunkedDecoder class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_HTTPChunkedDecoder_INCLUDED
+#define Net_HTTPChunkedDecoder_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API HTTPChunkedDecoder
+	/// Decodes a message body in chunked transfer encoding
+	/// that is held in a memory buffer.
+	///
+	/// Unlike HTTPChunkedInputStream, which reads from a
+	/// HTTPSession, HTTPChunkedDecoder works on a buffer that
+	/// is filled by non-blocking reads, and can resume decoding
+	/// once more data has been received. It is used by
+	/// HTTPReactorServerConnection and HTTPAsyncClient.
+{
+public:
+	static bool decode(const std::string& buffer, std::string::size_type& pos, std::string& body);
+		/// Decodes all complete chunks in the buffer, starting
+		/// at pos, and appends them to body.
+		///
+		/// pos is advanced past every decoded chunk, so decoding can
+		/// be resumed at pos once more data has been received.
+		/// Returns true if the last chunk and the trailer have been
+		/// decoded, in which case pos is the position following
+		/// the body. Otherwise, returns false.
+		///
+		/// Throws a MessageException if the chunked
+		/// transfer encoding is invalid.
+
+private:
+	HTTPChunkedDecoder();
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPChunkedDecoder_INCLUDED
@@ -69,12 +69,21 @@ public:
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
 	int writeToDevice(const char* buffer, std::streamsize length);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+		/// Writes data that does not fit into the stream buffer
+		/// as a single chunk, together with any pending buffered
+		/// data, without copying it into the stream buffer first.
+
+	void writeChunk(const char* pending, std::streamsize pendingLength, const char* data, std::streamsize dataLength, bool last);
+		/// Writes a chunk consisting of the pending and data bytes,
+		/// together with the chunk header and trailer, using a
+		/// single gather write. If last is true, the last-chunk is
+		/// appended as well.
 
 private:
 	HTTPSession&    _session;
 	openmode        _mode;
 	std::streamsize _chunk;
-	std::string     _chunkBuffer;
 };
 
 
@@ -230,6 +230,9 @@ protected:
 
 	int write(const char* buffer, std::streamsize length);
 		/// Tries to re-connect if keep-alive is on.
+
+	int write(const SocketBuf* buffers, int count);
+		/// Tries to re-connect if keep-alive is on.
 	
 	virtual std::string proxyRequestPrefix() const;
 		/// Returns the prefix prepended to the URI for proxy requests
@@ -0,0 +1,295 @@
+//
+// HTTPClientSessionPool.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/HTTPClientSessionPool.h#1 $
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Definition of the HTTPClientSessionPool class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_HTTPClientSessionPool_INCLUDED
+#define Net_HTTPClientSessionPool_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/URI.h"
+#include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <map>
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPClientSession;
+class HTTPSessionFactory;
+
+
+class Net_API HTTPClientSessionPool
+	/// A thread-safe pool of persistent HTTPClientSession objects,
+	/// keyed by scheme, host and port.
+	///
+	/// Creating a new session for every request means a DNS lookup,
+	/// a TCP handshake and, for HTTPS, a TLS handshake for every
+	/// request. The pool keeps sessions with an established connection
+	/// after they have been returned, and hands them out again
+	/// for further requests to the same endpoint.
+	///
+	/// The number of sessions per endpoint (idle and borrowed) is
+	/// limited. If all sessions for an endpoint are borrowed, borrowSession()
+	/// waits until one is returned, or until the wait timeout expires.
+	///
+	/// Sessions that have been idle for longer than the idle timeout are
+	/// closed and removed from the pool. Before an idle session is handed out,
+	/// its connection is checked. If the server has closed it in the meantime,
+	/// or has sent unexpected data, the session is reset so that it
+	/// opens a new connection with the next request.
+	///
+	/// Sessions are created with the given HTTPSessionFactory. For http
+	/// URIs, if no instantiator has been registered with the factory,
+	/// a plain HTTPClientSession is created.
+	///
+	/// Typical usage is through a ScopedSession:
+	///
+	///     HTTPClientSessionPool pool;
+	///     ...
+	///     HTTPClientSessionPool::ScopedSession session(pool, uri);
+	///     HTTPRequest request(HTTPRequest::HTTP_GET, uri.getPathAndQuery(), HTTPMessage::HTTP_1_1);
+	///     session->sendRequest(request);
+	///     HTTPResponse response;
+	///     std::istream& rs = session->receiveResponse(response);
+	///     StreamCopier::copyStream(rs, ostr);
+	///
+	/// The response body must be read completely before the session is
+	/// returned to the pool. If a request fails, the session should be
+	/// discarded, or reset() should be called before returning it.
+{
+public:
+	class Net_API ScopedSession
+		/// Borrows a session from a HTTPClientSessionPool on construction
+		/// and returns it on destruction.
+	{
+	public:
+		ScopedSession(HTTPClientSessionPool& pool, const Poco::URI& uri);
+			/// Borrows a session for the given URI from the pool.
+
+		~ScopedSession();
+			/// Returns the session to the pool, unless it has been discarded.
+
+		HTTPClientSession& session();
+			/// Returns the session.
+
+		HTTPClientSession* operator -> ();
+			/// Returns a pointer to the session.
+
+		HTTPClientSession& operator * ();
+			/// Returns the session.
+
+		void discard();
+			/// Deletes the session instead of returning it to the pool.
+			/// Should be called if an error occured while using the session.
+
+	private:
+		ScopedSession(const ScopedSession&);
+		ScopedSession& operator = (const ScopedSession&);
+
+		HTTPClientSessionPool& _pool;
+		HTTPClientSession*     _pSession;
+	};
+
+	enum
+	{
+		DEFAULT_MAX_SESSIONS_PER_ENDPOINT = 8,
+		DEFAULT_IDLE_TIMEOUT = 30,
+		DEFAULT_WAIT_TIMEOUT = 10
+	};
+
+	HTTPClientSessionPool();
+		/// Creates the HTTPClientSessionPool, using the default
+		/// HTTPSessionFactory, with a maximum of 8 sessions per endpoint,
+		/// an idle timeout of 30 seconds and a wait timeout of 10 seconds.
+
+	HTTPClientSessionPool(HTTPSessionFactory& factory, int maxSessionsPerEndpoint, const Poco::Timespan& idleTimeout, const Poco::Timespan& waitTimeout);
+		/// Creates the HTTPClientSessionPool, using the given
+		/// HTTPSessionFactory and parameters.
+
+	~HTTPClientSessionPool();
+		/// Destroys the HTTPClientSessionPool and deletes all idle sessions.
+		///
+		/// All borrowed sessions must have been returned before
+		/// the pool is destroyed.
+
+	HTTPClientSession* borrowSession(const Poco::URI& uri);
+		/// Returns a session for the endpoint (scheme, host and port)
+		/// given by uri, which must be given back with returnSession()
+		/// or discardSession(). The caller must not delete the session
+		/// itself, as its slot for the endpoint would never be freed.
+		///
+		/// If an idle session for the endpoint is available, it is returned.
+		/// Otherwise, if less than the maximum number of sessions exist for
+		/// the endpoint, a new one is created. Otherwise, waits until a session
+		/// is returned, or throws a TimeoutException if none is returned within
+		/// the wait timeout.
+
+	void returnSession(HTTPClientSession* pSession);
+		/// Returns a session borrowed with borrowSession() to the pool.
+		///
+		/// Sessions that are not connected, or that do not have
+		/// persistent connections enabled, are deleted.
+
+	void discardSession(HTTPClientSession* pSession);
+		/// Deletes a session borrowed with borrowSession() and
+		/// frees its slot for the endpoint.
+
+	void evictIdle();
+		/// Closes and deletes all sessions that have been idle for
+		/// longer than the idle timeout.
+		///
+		/// This is done automatically whenever sessions are borrowed
+		/// or returned, but may be called periodically by an application
+		/// that uses the pool only rarely.
+
+	void clear();
+		/// Closes and deletes all idle sessions.
+
+	int maxSessionsPerEndpoint() const;
+		/// Returns the maximum number of sessions per endpoint.
+
+	const Poco::Timespan& idleTimeout() const;
+		/// Returns the idle timeout.
+
+	const Poco::Timespan& waitTimeout() const;
+		/// Returns the wait timeout.
+
+	std::size_t idle() const;
+		/// Returns the number of idle sessions in the pool.
+
+	std::size_t borrowed() const;
+		/// Returns the number of sessions currently borrowed.
+
+protected:
+	HTTPClientSession* createSession(const Poco::URI& uri);
+		/// Creates a new session for the given URI.
+
+	static bool isHealthy(HTTPClientSession& session);
+		/// Returns false if the connection of an idle session
+		/// has been closed by the server, or data has been received
+		/// although no request is pending.
+
+	static std::string endpointKey(const Poco::URI& uri);
+
+private:
+	HTTPClientSessionPool(const HTTPClientSessionPool&);
+	HTTPClientSessionPool& operator = (const HTTPClientSessionPool&);
+
+	struct IdleSession
+	{
+		HTTPClientSession* pSession;
+		Poco::Timestamp    returned;
+	};
+
+	typedef std::vector<IdleSession> IdleVec;
+
+	struct Endpoint
+	{
+		Endpoint();
+
+		IdleVec idle;
+		int     borrowed;
+	};
+
+	typedef std::map<std::string, Endpoint> EndpointMap;
+	typedef std::map<HTTPClientSession*, std::string> SessionMap;
+
+	void evictIdleImpl(std::vector<HTTPClientSession*>& evicted);
+	void release(HTTPClientSession* pSession);
+
+	HTTPSessionFactory&     _factory;
+	int                     _maxSessionsPerEndpoint;
+	Poco::Timespan          _idleTimeout;
+	Poco::Timespan          _waitTimeout;
+	EndpointMap             _endpoints;
+	SessionMap              _borrowed;
+	std::size_t             _idle;
+	Poco::Timestamp         _lastEviction;
+	mutable Poco::FastMutex _mutex;
+	Poco::Condition         _returned;
+};
+
+
+//
+// inlines
+//
+inline HTTPClientSession& HTTPClientSessionPool::ScopedSession::session()
+{
+	return *_pSession;
+}
+
+
+inline HTTPClientSession* HTTPClientSessionPool::ScopedSession::operator -> ()
+{
+	return _pSession;
+}
+
+
+inline HTTPClientSession& HTTPClientSessionPool::ScopedSession::operator * ()
+{
+	return *_pSession;
+}
+
+
+inline int HTTPClientSessionPool::maxSessionsPerEndpoint() const
+{
+	return _maxSessionsPerEndpoint;
+}
+
+
+inline const Poco::Timespan& HTTPClientSessionPool::idleTimeout() const
+{
+	return _idleTimeout;
+}
+
+
+inline const Poco::Timespan& HTTPClientSessionPool::waitTimeout() const
+{
+	return _waitTimeout;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPClientSessionPool_INCLUDED
@@ -75,6 +75,10 @@ public:
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
 	int writeToDevice(const char* buffer, std::streamsize length);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+		/// Writes data that does not fit into the stream buffer
+		/// together with any pending buffered data, using a single
+		/// gather write, without copying it into the stream buffer first.
 
 private:
 	HTTPSession&    _session;
@@ -0,0 +1,182 @@
+//
+// HTTPReactorServer.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/HTTPReactorServer.h#1 $
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorServer
+//
+// Definition of the HTTPReactorServer class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_HTTPReactorServer_INCLUDED
+#define Net_HTTPReactorServer_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/ParallelSocketReactor.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Environment.h"
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API HTTPReactorServer
+	/// An HTTP server that handles its connections on a number
+	/// of event loops (ParallelSocketReactor instances), rather
+	/// than with a thread per connection.
+	///
+	/// Every event loop runs in its own thread and accepts new
+	/// connections by itself. On Linux, every event loop gets
+	/// its own listening socket, bound to the same address
+	/// using the SO_REUSEPORT socket option, so that the kernel
+	/// distributes incoming connections among the event loops.
+	/// There is neither a dedicated acceptor thread, nor a
+	/// shared queue of connections. On other platforms, all event
+	/// loops share a single non-blocking listening socket.
+	///
+	/// A connection stays with the event loop that accepted
+	/// it for its entire lifetime. See HTTPReactorServerConnection
+	/// for details on how requests are handled.
+	///
+	/// Since requests are handled in the threads of the event loops,
+	/// request handlers must not block for a significant amount of
+	/// time. Applications with long running request handlers
+	/// should use HTTPServer instead.
+	///
+	/// The following HTTPServerParams are used:
+	///   - software version
+	///   - timeout (maximum time to receive a complete request,
+	///     and maximum time without progress in sending a response)
+	///   - keep-alive, keep-alive timeout and maximum keep-alive requests
+	///
+	/// The timeouts are checked with a granularity of the
+	/// SocketReactor timeout (250 milliseconds), even while
+	/// an event loop is busy.
+{
+public:
+	HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::UInt16 portNumber = 80, HTTPServerParams::Ptr pParams = new HTTPServerParams, int reactors = Poco::Environment::processorCount());
+		/// Creates HTTPReactorServer listening on the given port
+		/// (default 80) of all interfaces, using the given number
+		/// of event loops.
+		///
+		/// The server takes ownership of the HTTPRequestHandlerFactory
+		/// and the HTTPServerParams object.
+
+	HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, const SocketAddress& address, HTTPServerParams::Ptr pParams, int reactors = Poco::Environment::processorCount());
+		/// Creates HTTPReactorServer listening on the given address,
+		/// using the given number of event loops.
+		///
+		/// If the port number of address is 0, a port number is
+		/// chosen by the operating system, which can be obtained
+		/// by calling port().
+		///
+		/// The server takes ownership of the HTTPRequestHandlerFactory
+		/// and the HTTPServerParams object.
+
+	~HTTPReactorServer();
+		/// Stops the server, if it is still running,
+		/// and destroys it.
+
+	void start();
+		/// Starts the event loops.
+		///
+		/// Before start() is called, connections are
+		/// queued by the listening sockets, but not accepted.
+
+	void stop();
+		/// Stops the server.
+		///
+		/// All event loops are stopped, and all client
+		/// connections are closed.
+
+	Poco::UInt16 port() const;
+		/// Returns the port the server is listening on.
+
+	int reactors() const;
+		/// Returns the number of event loops.
+
+	const HTTPServerParams& params() const;
+		/// Returns a const reference to the HTTPServerParams
+		/// used by the server.
+
+	enum
+	{
+		LISTEN_BACKLOG = 64
+	};
+
+private:
+	class Acceptor;
+
+	typedef ParallelSocketReactor<SocketReactor> Reactor;
+	typedef std::vector<Reactor::Ptr> ReactorVec;
+	typedef std::vector<Acceptor*> AcceptorVec;
+	typedef std::vector<ServerSocket> SocketVec;
+
+	void init(const SocketAddress& address);
+
+	HTTPReactorServer();
+	HTTPReactorServer(const HTTPReactorServer&);
+	HTTPReactorServer& operator = (const HTTPReactorServer&);
+
+	HTTPRequestHandlerFactory::Ptr _pFactory;
+	HTTPServerParams::Ptr          _pParams;
+	int                            _reactorCount;
+	SocketVec                      _sockets;
+	ReactorVec                     _reactors;
+	AcceptorVec                    _acceptors;
+};
+
+
+//
+// inlines
+//
+inline int HTTPReactorServer::reactors() const
+{
+	return _reactorCount;
+}
+
+
+inline const HTTPServerParams& HTTPReactorServer::params() const
+{
+	return *_pParams;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPReactorServer_INCLUDED
@@ -0,0 +1,209 @@
+//
+// HTTPReactorServerConnection.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/HTTPReactorServerConnection.h#1 $
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorServerConnection
+//
+// Definition of the HTTPReactorServerConnection class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_HTTPReactorServerConnection_INCLUDED
+#define Net_HTTPReactorServerConnection_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Timestamp.h"
+#include <string>
+#include <deque>
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPRequest;
+
+
+class Net_API HTTPReactorServerConnection
+	/// This class handles a single HTTP connection
+	/// on behalf of a HTTPReactorServer.
+	///
+	/// Instead of occupying a thread for the lifetime of the
+	/// connection, a HTTPReactorServerConnection is registered
+	/// with a SocketReactor and only does work when data is
+	/// available. The socket is put into non-blocking mode.
+	/// Incoming data is collected in a buffer until a complete
+	/// request (including its body, in either fixed-length or
+	/// chunked encoding) has been received. The request header
+	/// is parsed only once, and a chunked body is decoded as it
+	/// arrives. The request is then passed to a HTTPRequestHandler
+	/// in the reactor's thread.
+	///
+	/// A request without Content-Length or chunked transfer
+	/// encoding has no body. Requests with a body larger than
+	/// MAX_BODY_LENGTH are rejected with a 413 (Request Entity
+	/// Too Large) response. No more data is read from the socket
+	/// than the pending request may still need.
+	///
+	/// The response is buffered as well, and written to the
+	/// socket as it becomes writable. Files sent with
+	/// HTTPServerResponse::sendFile() are not buffered, but
+	/// passed to StreamSocket::sendFile() once the preceding
+	/// output has been written.
+	///
+	/// Pipelined requests are supported; responses are always
+	/// sent in request order.
+	///
+	/// Since request handlers run in the reactor's thread, they
+	/// must not block for a significant amount of time.
+	///
+	/// The connection deletes itself when the socket is closed,
+	/// when the keep-alive timeout expires, when a request is not
+	/// received completely, or a response makes no progress,
+	/// within the timeout, or when the SocketReactor shuts down.
+	/// As the timeout for receiving a request is counted from
+	/// its first byte, a client cannot hold the connection by
+	/// sending a request very slowly.
+	/// Timeouts are checked with the TimeoutNotification, which
+	/// the SocketReactor also dispatches while it is busy.
+{
+public:
+	enum
+	{
+		MAX_HEADER_LENGTH = 65536,
+			/// Maximum length of the request line and header
+			/// of a single request.
+
+		MAX_BODY_LENGTH = 16777216
+			/// Maximum length of the body of a single request.
+	};
+
+	HTTPReactorServerConnection(const StreamSocket& socket, SocketReactor& reactor, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory);
+		/// Creates the HTTPReactorServerConnection and registers
+		/// it with the given SocketReactor.
+
+	~HTTPReactorServerConnection();
+		/// Unregisters the HTTPReactorServerConnection from the
+		/// SocketReactor and destroys it.
+
+	void onReadable(ReadableNotification* pNf);
+	void onWritable(WritableNotification* pNf);
+	void onTimeout(TimeoutNotification* pNf);
+	void onShutdown(ShutdownNotification* pNf);
+
+protected:
+	void processRequests();
+		/// Handles all complete requests in the input buffer.
+
+	bool processRequest();
+		/// Handles the next request in the input buffer.
+		///
+		/// Returns false if the input buffer does not
+		/// contain a complete request.
+
+	bool readHeader();
+		/// Parses the header of the next request in the input
+		/// buffer, if it has been received completely.
+		///
+		/// Returns false if the header is not yet complete,
+		/// or if it is invalid.
+
+	bool readBody(std::string::size_type& end);
+		/// Checks whether the body of the pending request has
+		/// been received completely. If so, stores the length of
+		/// the request (relative to the start of the request) in
+		/// end and returns true.
+
+	std::string::size_type receiveLimit() const;
+		/// Returns the amount of unprocessed data the input
+		/// buffer may hold before reading is suspended.
+
+	void compact();
+		/// Discards consumed data from the input buffer.
+
+	void sendErrorResponse(HTTPResponse::HTTPStatus status);
+		/// Queues an error response and closes the connection
+		/// once it has been sent.
+
+	void flush();
+		/// Writes as much of the output buffer, and of the
+		/// files queued for sending, to the socket as possible
+		/// without blocking.
+
+	void close();
+		/// Closes the connection and deletes the object.
+
+private:
+	HTTPReactorServerConnection();
+	HTTPReactorServerConnection(const HTTPReactorServerConnection&);
+	HTTPReactorServerConnection& operator = (const HTTPReactorServerConnection&);
+
+	class PendingRequest;
+	class OutputFile;
+
+	bool sendFile(OutputFile& file);
+		/// Sends as much of the given file as possible without
+		/// blocking. Returns true if the file has been sent
+		/// completely.
+
+	StreamSocket                   _socket;
+	SocketReactor&                 _reactor;
+	HTTPServerParams::Ptr          _pParams;
+	HTTPRequestHandlerFactory::Ptr _pFactory;
+	std::string                    _inBuffer;
+	std::string::size_type         _inPos;
+	std::string::size_type         _scanPos;
+	PendingRequest*                _pPending;
+	std::string                    _outBuffer;
+	std::string::size_type         _outPos;
+	std::deque<OutputFile*>        _outFiles;
+	Poco::Timestamp                _lastActivity;
+	Poco::Timestamp                _requestStart;
+	Poco::Timestamp                _lastSend;
+	int                            _requests;
+	bool                           _continueSent;
+	bool                           _writable;
+	bool                           _keepAlive;
+	bool                           _readSuspended;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPReactorServerConnection_INCLUDED
@@ -147,6 +147,23 @@ public:
 	void read(std::istream& istr);
 		/// Reads the HTTP request from the
 		/// given input stream.
+
+	std::size_t read(const char* begin, const char* end);
+		/// Reads the HTTP request header from the given
+		/// memory buffer, using a MessageHeaderParser.
+		///
+		/// Compared to read(std::istream&), this saves reading
+		/// the header character by character through a stream.
+		/// The header fields are still copied into the request,
+		/// so that the buffer need not outlive it.
+		///
+		/// Returns the number of bytes consumed (including the
+		/// empty line terminating the header), or 0 if the
+		/// buffer does not yet contain the complete header,
+		/// in which case the request is left unchanged.
+		///
+		/// Throws a MessageException if the request
+		/// header is malformed.
 		
 	static const std::string HTTP_GET;
 	static const std::string HTTP_HEAD;
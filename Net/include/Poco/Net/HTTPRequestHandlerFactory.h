@@ -82,6 +82,7 @@ private:
 	
 	friend class HTTPServer;
 	friend class HTTPServerConnection;
+	friend class HTTPReactorServer;
 };
 
 
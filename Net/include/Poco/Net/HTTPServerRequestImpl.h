@@ -102,8 +102,25 @@ public:
 		/// Returns the underlying socket after detaching
 		/// it from the server session.
 
+	void recycle();
+		/// Discards the current request, together with its
+		/// input stream, and reads the next request from the
+		/// server session into this object.
+		///
+		/// This allows HTTPServerConnection to use a single
+		/// HTTPServerRequestImpl object for all requests
+		/// received over a persistent connection.
+		///
+		/// Throws a NoMessageException if the client has closed
+		/// the connection, or a MessageException if the request
+		/// header is invalid.
+
 protected:
 	static const std::string EXPECT;
+
+	void receive();
+		/// Reads the request header from the server session
+		/// and creates the input stream for the request body.
 	
 private:
 	HTTPServerResponseImpl&         _response;
@@ -97,6 +97,34 @@ public:
 		/// Throws a FileNotFoundException if the file
 		/// cannot be found, or an OpenFileException if
 		/// the file cannot be opened.
+
+	virtual void sendFile(const std::string& path, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType) = 0;
+		/// Sends the response header to the client, followed
+		/// by length bytes of the given file, starting at offset.
+		///
+		/// The Content-Length header of the response is set
+		/// to length. Together with a status of HTTP_PARTIAL_CONTENT
+		/// and a Content-Range header, which must be set by the
+		/// caller, this can be used to answer Range requests.
+		///
+		/// Must not be called after send(), sendBuffer() 
+		/// or redirect() has been called.
+		///
+		/// Throws a FileNotFoundException if the file
+		/// cannot be found, an OpenFileException if
+		/// the file cannot be opened, or a RangeException
+		/// if the range is not within the file.
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	virtual void sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType) = 0;
+		/// Sends the response header to the client, followed
+		/// by length bytes, starting at offset, of the file
+		/// referred to by the open file descriptor fd.
+		///
+		/// The file descriptor is not closed, and its file
+		/// position is not changed. Otherwise, works like the
+		/// sendFile() overload taking a path.
+#endif
 		
 	virtual void sendBuffer(const void* pBuffer, std::size_t length) = 0;
 		/// Sends the response header to the client, followed
@@ -42,6 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Timestamp.h"
 
 
 namespace Poco {
@@ -95,6 +96,36 @@ public:
 		/// Throws a FileNotFoundException if the file
 		/// cannot be found, or an OpenFileException if
 		/// the file cannot be opened.
+		///
+		/// On Unix platforms, the file content is sent
+		/// with StreamSocket::sendFile(), which avoids
+		/// copying it through user space where possible.
+
+	void sendFile(const std::string& path, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType);
+		/// Sends the response header to the client, followed
+		/// by length bytes of the given file, starting at offset.
+		///
+		/// The Content-Length header of the response is set
+		/// to length. Status and Content-Range header for
+		/// a Range request must be set by the caller.
+		///
+		/// Must not be called after send(), sendBuffer() 
+		/// or redirect() has been called.
+		///
+		/// Throws a FileNotFoundException if the file
+		/// cannot be found, an OpenFileException if
+		/// the file cannot be opened, or a RangeException
+		/// if the range is not within the file.
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	void sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType);
+		/// Sends the response header to the client, followed
+		/// by length bytes, starting at offset, of the file
+		/// referred to by the open file descriptor fd.
+		///
+		/// The file descriptor is not closed, and its file
+		/// position is not changed.
+#endif
 		
 	void sendBuffer(const void* pBuffer, std::size_t length);
 		/// Sends the response header to the client, followed
@@ -128,8 +159,18 @@ public:
 	bool sent() const;
 		/// Returns true if the response (header) has been sent.
 
+	void recycle();
+		/// Completes the response by destroying its output stream,
+		/// and returns the response object to its initial state, so
+		/// that it can be reused for the next request received over
+		/// the same connection.
+
 protected:
 	void attachRequest(HTTPServerRequestImpl* pRequest);
+	void prepareFile(const Poco::Timestamp& dateTime, Poco::UInt64 length, const std::string& mediaType);
+#if defined(POCO_OS_FAMILY_UNIX)
+	void sendFileContent(int fd, Poco::UInt64 offset, Poco::UInt64 length);
+#endif
 	
 private:
 	HTTPServerSession& _session;
@@ -162,6 +162,12 @@ protected:
 	virtual int write(const char* buffer, std::streamsize length);
 		/// Writes data to the socket.
 
+	virtual int write(const SocketBuf* buffers, int count);
+		/// Writes the data in the given buffers to the socket,
+		/// using a single gather write if possible.
+		///
+		/// See StreamSocket::sendBytes() for details.
+
 	int receive(char* buffer, int length);
 		/// Reads up to length bytes.
 		
@@ -170,6 +176,19 @@ protected:
 
 	void refill();
 		/// Refills the internal buffer.
+
+	const char* buffer(int& length);
+		/// Returns a pointer to the data in the internal
+		/// buffer, and stores the number of buffered bytes
+		/// in length. If the buffer is empty, it is refilled
+		/// first, so length is only 0 at the end of the stream.
+		///
+		/// The data stays in the buffer until it is consumed
+		/// with skip() or one of the read functions.
+
+	void skip(int length);
+		/// Discards the given number of bytes from the
+		/// internal buffer.
 		
 	virtual void connect(const SocketAddress& address);
 		/// Connects the underlying socket to the given address
@@ -207,6 +226,7 @@ private:
 	friend class HTTPHeaderStreamBuf;
 	friend class HTTPFixedLengthStreamBuf;
 	friend class HTTPChunkedStreamBuf;
+	friend class HTTPServerRequestImpl;
 };
 
 
@@ -70,9 +70,8 @@ public:
 		/// Creates the HostEntry from the data in an addrinfo structure.
 #endif
 
-#if defined(POCO_VXWORKS)
 	HostEntry(const std::string& name, const IPAddress& addr);
-#endif
+		/// Creates the HostEntry from the given name and address.
 
 	HostEntry(const HostEntry& entry);
 		/// Creates the HostEntry by copying another one.
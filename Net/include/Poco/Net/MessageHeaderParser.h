@@ -0,0 +1,209 @@
+//
+// MessageHeaderParser.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/MessageHeaderParser.h#1 $
+//
+// Library: Net
+// Package: Messages
+// Module:  MessageHeaderParser
+//
+// Definition of the MessageHeaderParser class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_MessageHeaderParser_INCLUDED
+#define Net_MessageHeaderParser_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+namespace Net {
+
+
+class MessageHeader;
+
+
+class Net_API MessageHeaderParser
+	/// A parser for RFC 2822 style message header fields that
+	/// works directly on a memory buffer.
+	///
+	/// Unlike MessageHeader::read(), which reads the header
+	/// character by character from a stream and copies every
+	/// name and value into a std::string, MessageHeaderParser
+	/// scans the buffer in bulk (using memchr() to locate line
+	/// ends and colons) and records each field as a pair of
+	/// pointers into the buffer. No memory is allocated for
+	/// the first INLINE_FIELDS fields; additional fields are
+	/// kept in an overflow vector.
+	///
+	/// The field table refers to the parsed buffer, so the
+	/// buffer must stay valid (and unchanged) as long as the
+	/// fields are used. Use copyTo() to transfer the fields
+	/// into a MessageHeader. Note that a MessageHeader stores
+	/// its own copy of every name and value, so copyTo() still
+	/// allocates memory for each field. Only code that works
+	/// with the field table directly avoids these copies.
+	///
+	/// The same sanity checks and limits as in MessageHeader::read()
+	/// are applied, including the field limit (see setFieldLimit()).
+{
+public:
+	struct Field
+		/// A header field, referring to the parsed buffer.
+	{
+		const char* name;
+		std::size_t nameLength;
+		const char* value;
+		std::size_t valueLength;
+		bool        folded;
+			/// True if the value spans multiple lines (see RFC 2822,
+			/// section 2.2.3). In this case, the raw value still
+			/// contains the line breaks, which are removed by value().
+	};
+
+	enum
+	{
+		INLINE_FIELDS = 32
+	};
+
+	MessageHeaderParser();
+		/// Creates the MessageHeaderParser.
+
+	~MessageHeaderParser();
+		/// Destroys the MessageHeaderParser.
+
+	std::size_t parse(const char* begin, const char* end);
+		/// Parses the header fields in the buffer given by begin and end,
+		/// up to and including the empty line terminating the header.
+		///
+		/// Returns the number of bytes consumed, or 0 if the buffer
+		/// does not contain the complete header. In the latter case, the
+		/// field table is cleared and parse() can be called again
+		/// once more data is available.
+		///
+		/// Throws a MessageException if the header is malformed, or if
+		/// it contains more fields than allowed.
+
+	void reset();
+		/// Clears the field table.
+
+	std::size_t count() const;
+		/// Returns the number of fields in the table.
+
+	const Field& operator [] (std::size_t index) const;
+		/// Returns the field with the given index.
+
+	const Field* find(const std::string& name) const;
+		/// Returns the first field with the given name (which
+		/// is case-insensitive), or null if no such field exists.
+
+	bool has(const std::string& name) const;
+		/// Returns true if there is at least one field with
+		/// the given name.
+
+	std::string name(std::size_t index) const;
+		/// Returns a copy of the name of the field with the given index.
+
+	std::string value(std::size_t index) const;
+		/// Returns a copy of the value of the field with the given index,
+		/// with line breaks of folded values removed.
+
+	void copyTo(MessageHeader& header) const;
+		/// Adds all fields to the given MessageHeader.
+		///
+		/// Apart from the storage allocated by the MessageHeader,
+		/// no temporary strings are created.
+
+	int getFieldLimit() const;
+		/// Returns the maximum number of header fields
+		/// allowed.
+
+	void setFieldLimit(int limit);
+		/// Sets the maximum number of header fields
+		/// allowed. Specify 0 for no limit.
+		/// The default limit is the same as for MessageHeader.
+
+private:
+	MessageHeaderParser(const MessageHeaderParser&);
+	MessageHeaderParser& operator = (const MessageHeaderParser&);
+
+	enum Limits
+	{
+		MAX_NAME_LENGTH  = 256,
+		MAX_VALUE_LENGTH = 8192,
+		DFL_FIELD_LIMIT  = 100
+	};
+
+	void append(const Field& field);
+	static void assignValue(const Field& field, std::string& value);
+
+	Field              _fields[INLINE_FIELDS];
+	std::vector<Field> _overflow;
+	std::size_t        _count;
+	int                _fieldLimit;
+};
+
+
+//
+// inlines
+//
+inline std::size_t MessageHeaderParser::count() const
+{
+	return _count;
+}
+
+
+inline const MessageHeaderParser::Field& MessageHeaderParser::operator [] (std::size_t index) const
+{
+	poco_assert (index < _count);
+
+	return index < INLINE_FIELDS ? _fields[index] : _overflow[index - INLINE_FIELDS];
+}
+
+
+inline bool MessageHeaderParser::has(const std::string& name) const
+{
+	return find(name) != 0;
+}
+
+
+inline int MessageHeaderParser::getFieldLimit() const
+{
+	return _fieldLimit;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_MessageHeaderParser_INCLUDED
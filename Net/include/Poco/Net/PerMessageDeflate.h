@@ -0,0 +1,258 @@
+//
+// PerMessageDeflate.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/PerMessageDeflate.h#1 $
+//
+// Library: Net
+// Package: WebSocket
+// Module:  PerMessageDeflate
+//
+// Definition of the PerMessageDeflate class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_PerMessageDeflate_INCLUDED
+#define Net_PerMessageDeflate_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Buffer.h"
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API PerMessageDeflate
+	/// This class implements the permessage-deflate WebSocket
+	/// extension, as specified in RFC 7692.
+	///
+	/// A PerMessageDeflate object passed to the WebSocket constructor
+	/// holds the parameters the application is willing to use. A client
+	/// offers the extension with these parameters in its handshake request,
+	/// and a server accepts an offer within their limits. After a successful
+	/// handshake, the WebSocket holds its own PerMessageDeflate object with
+	/// the negotiated parameters (see WebSocket::perMessageDeflate()).
+	///
+	/// Each direction of a connection uses a single zlib stream for
+	/// all messages. Unless context takeover has been disabled for a
+	/// direction, the stream also keeps its sliding window from one message
+	/// to the next, which considerably improves compression of small
+	/// messages with similar content. Output buffers are reused, so
+	/// compressing and decompressing a message does not allocate memory
+	/// once the buffers have grown to the size of the largest message.
+{
+public:
+	enum
+	{
+		MIN_WINDOW_BITS = 9,
+			/// zlib cannot compress with a 256 byte (8 bit) window.
+		MAX_WINDOW_BITS = 15
+	};
+
+	PerMessageDeflate();
+		/// Creates a PerMessageDeflate with default parameters:
+		/// maximum window size and context takeover in both
+		/// directions, and zlib's default compression level.
+
+	PerMessageDeflate(const PerMessageDeflate& deflate);
+		/// Creates a PerMessageDeflate with the parameters of
+		/// the given one. Compression state is not copied.
+
+	~PerMessageDeflate();
+		/// Destroys the PerMessageDeflate.
+
+	PerMessageDeflate& operator = (const PerMessageDeflate& deflate);
+		/// Assigns the parameters of the given PerMessageDeflate.
+		/// Compression state is not copied.
+
+	void setServerMaxWindowBits(int bits);
+		/// Sets the base-2 logarithm of the maximum
+		/// LZ77 window size used by the server for compression.
+		///
+		/// Must be in range MIN_WINDOW_BITS to MAX_WINDOW_BITS.
+
+	int getServerMaxWindowBits() const;
+		/// Returns the base-2 logarithm of the maximum
+		/// LZ77 window size used by the server for compression.
+
+	void setClientMaxWindowBits(int bits);
+		/// Sets the base-2 logarithm of the maximum
+		/// LZ77 window size used by the client for compression.
+		///
+		/// Must be in range MIN_WINDOW_BITS to MAX_WINDOW_BITS.
+
+	int getClientMaxWindowBits() const;
+		/// Returns the base-2 logarithm of the maximum
+		/// LZ77 window size used by the client for compression.
+
+	void setServerNoContextTakeover(bool flag);
+		/// If true, the server resets its compressor
+		/// after every message.
+
+	bool getServerNoContextTakeover() const;
+		/// Returns true if the server resets its compressor
+		/// after every message.
+
+	void setClientNoContextTakeover(bool flag);
+		/// If true, the client resets its compressor
+		/// after every message.
+
+	bool getClientNoContextTakeover() const;
+		/// Returns true if the client resets its compressor
+		/// after every message.
+
+	void setCompressionLevel(int level);
+		/// Sets the zlib compression level (0 - 9) used
+		/// for sending messages. -1 selects zlib's default.
+
+	int getCompressionLevel() const;
+		/// Returns the zlib compression level.
+
+	std::string offer() const;
+		/// Returns the value of the Sec-WebSocket-Extensions
+		/// header for a client's handshake request.
+
+	bool accept(const std::string& offers, std::string& response);
+		/// Selects the first acceptable permessage-deflate offer from
+		/// the given value of a client's Sec-WebSocket-Extensions header.
+		///
+		/// If there is one, updates the parameters with the
+		/// negotiated values, stores the value for the
+		/// Sec-WebSocket-Extensions header of the handshake
+		/// response in response and returns true.
+		/// Otherwise, returns false.
+
+	void confirm(const std::string& response);
+		/// Updates the parameters with the negotiated values from
+		/// the given value of a server's Sec-WebSocket-Extensions header,
+		/// sent in response to offer().
+		///
+		/// Throws a WebSocketException if the response is not valid
+		/// for the offer, or cannot be complied with.
+
+	void init(bool server);
+		/// Creates the compression and decompression streams for
+		/// a server-side (server == true) or client-side connection,
+		/// according to the negotiated parameters.
+		///
+		/// For internal use by WebSocketImpl.
+
+	std::size_t deflate(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& buffer);
+		/// Compresses the payload of a frame into buffer, replacing
+		/// its content. If fin is true, the frame is the last frame
+		/// of a message.
+		///
+		/// Returns the size of the compressed payload.
+
+	std::size_t inflate(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& buffer, std::size_t maxLength);
+		/// Decompresses the payload of a frame and appends it to buffer.
+		/// If fin is true, the frame is the last frame of a message.
+		///
+		/// Returns the size of the decompressed payload. Throws a
+		/// WebSocketException if it exceeds maxLength.
+
+	std::size_t inflate(const char* data, std::size_t length, bool fin, char* buffer, std::size_t bufferLength);
+		/// Decompresses the payload of a frame into buffer.
+		/// If fin is true, the frame is the last frame of a message.
+		///
+		/// Returns the size of the decompressed payload. Throws a
+		/// WebSocketException if it exceeds bufferLength.
+
+	static const std::string EXTENSION_NAME;
+		/// The name of the extension ("permessage-deflate").
+
+protected:
+	std::size_t inflateSome(char* buffer, std::size_t length, bool& done);
+		/// Decompresses pending input into buffer. Sets done to true
+		/// if all input has been consumed and all output has been
+		/// produced.
+
+	std::size_t inflateAll(Poco::Buffer<char>& buffer, std::size_t produced, std::size_t maxLength);
+		/// Decompresses pending input and appends it to buffer,
+		/// which is grown as necessary.
+
+	void cleanup();
+
+private:
+	int  _serverMaxWindowBits;
+	int  _clientMaxWindowBits;
+	bool _serverNoContextTakeover;
+	bool _clientNoContextTakeover;
+	int  _compressionLevel;
+	bool _server;
+	bool _deflateInit;
+	bool _inflateInit;
+	z_stream _deflateStream;
+	z_stream _inflateStream;
+};
+
+
+//
+// inlines
+//
+inline int PerMessageDeflate::getServerMaxWindowBits() const
+{
+	return _serverMaxWindowBits;
+}
+
+
+inline int PerMessageDeflate::getClientMaxWindowBits() const
+{
+	return _clientMaxWindowBits;
+}
+
+
+inline bool PerMessageDeflate::getServerNoContextTakeover() const
+{
+	return _serverNoContextTakeover;
+}
+
+
+inline bool PerMessageDeflate::getClientNoContextTakeover() const
+{
+	return _clientNoContextTakeover;
+}
+
+
+inline int PerMessageDeflate::getCompressionLevel() const
+{
+	return _compressionLevel;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PerMessageDeflate_INCLUDED
@@ -0,0 +1,155 @@
+//
+// PollSet.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/PollSet.h#1 $
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Definition of the PollSet class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_PollSet_INCLUDED
+#define Net_PollSet_INCLUDED
+
+
+#include "Poco/Net/Socket.h"
+#include <map>
+
+
+namespace Poco {
+namespace Net {
+
+
+class PollSetImpl;
+
+
+class Net_API PollSet
+	/// A set of sockets that can be efficiently polled as a whole.
+	///
+	/// Unlike Socket::select(), which has to pass every socket
+	/// to the operating system on each call, a PollSet keeps its
+	/// sockets registered with the operating system between calls
+	/// to poll(). Registration work is only done in add(), update()
+	/// and remove(), and the cost of poll() is proportional to the
+	/// number of sockets that are actually ready.
+	///
+	/// If POCO_HAVE_FD_EPOLL is defined, a single epoll instance
+	/// is created for the lifetime of the PollSet. On all other platforms,
+	/// PollSet falls back to Socket::select().
+	///
+	/// It is safe to call add(), update() and remove() from another
+	/// thread while poll() is waiting. However, poll() itself must
+	/// only be called from one thread at a time.
+{
+public:
+	enum Mode
+	{
+		POLL_READ  = 0x01,
+		POLL_WRITE = 0x02,
+		POLL_ERROR = 0x04
+	};
+
+	typedef std::map<Poco::Net::Socket, int> SocketModeMap;
+
+	PollSet();
+		/// Creates an empty, level-triggered PollSet.
+
+	explicit PollSet(bool edgeTriggered);
+		/// Creates an empty PollSet.
+		///
+		/// If edgeTriggered is true, and the platform supports it
+		/// (epoll only), sockets are registered in edge-triggered
+		/// mode. A socket is then only reported again after new data
+		/// has arrived (or new buffer space has become available),
+		/// so users must read (or write) until the operation would
+		/// block. Otherwise, sockets are registered in
+		/// level-triggered mode, which corresponds to the
+		/// semantics of Socket::select().
+
+	~PollSet();
+		/// Destroys the PollSet.
+
+	void add(const Poco::Net::Socket& socket, int mode);
+		/// Adds the given socket to the set, for polling with
+		/// the given mode, which is a combination of
+		/// POLL_READ, POLL_WRITE and POLL_ERROR.
+		///
+		/// If the socket is already in the set, its mode is
+		/// replaced with the given one.
+
+	void remove(const Poco::Net::Socket& socket);
+		/// Removes the given socket from the set.
+		///
+		/// Does nothing if the socket is not in the set.
+
+	void update(const Poco::Net::Socket& socket, int mode);
+		/// Updates the mode of the given socket.
+		///
+		/// If the socket is not yet in the set, it is added.
+
+	bool has(const Poco::Net::Socket& socket) const;
+		/// Returns true if the given socket is in the set.
+
+	bool empty() const;
+		/// Returns true if no socket is in the set.
+
+	std::size_t size() const;
+		/// Returns the number of sockets in the set.
+
+	void clear();
+		/// Removes all sockets from the set.
+
+	bool isEdgeTriggered() const;
+		/// Returns true if sockets are registered in
+		/// edge-triggered mode.
+
+	SocketModeMap poll(const Poco::Timespan& timeout);
+		/// Waits until the state of at least one of the sockets
+		/// in the set changes accordingly to its mode, or
+		/// the timeout expires.
+		///
+		/// Returns a map of all sockets that are ready, together
+		/// with their ready mode. The map is empty if the timeout
+		/// has expired or if the set is empty, in which case
+		/// poll() returns immediately.
+
+private:
+	PollSet(const PollSet&);
+	PollSet& operator = (const PollSet&);
+
+	PollSetImpl* _pImpl;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PollSet_INCLUDED
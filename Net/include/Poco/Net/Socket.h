@@ -306,6 +306,17 @@ public:
 	static bool supportsIPv6();
 		/// Returns true if the system supports IPv6.
 
+	static SocketBuf makeBuffer(void* buffer, std::size_t length);
+		/// Returns a SocketBuf referring to the given buffer,
+		/// for use with StreamSocket::sendBytes() and
+		/// StreamSocket::receiveBytes() for multiple buffers.
+
+	static char* bufferBase(const SocketBuf& buf);
+		/// Returns the address of the buffer the SocketBuf refers to.
+
+	static std::size_t bufferLength(const SocketBuf& buf);
+		/// Returns the length of the buffer the SocketBuf refers to.
+
 	void init(int af);
 		/// Creates the underlying system socket for the given
 		/// address family.
@@ -641,6 +652,40 @@ inline bool Socket::supportsIPv6()
 }
 
 
+inline SocketBuf Socket::makeBuffer(void* buffer, std::size_t length)
+{
+	SocketBuf buf;
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	buf.buf = reinterpret_cast<char*>(buffer);
+	buf.len = static_cast<ULONG>(length);
+#else
+	buf.iov_base = buffer;
+	buf.iov_len  = length;
+#endif
+	return buf;
+}
+
+
+inline char* Socket::bufferBase(const SocketBuf& buf)
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	return buf.buf;
+#else
+	return reinterpret_cast<char*>(buf.iov_base);
+#endif
+}
+
+
+inline std::size_t Socket::bufferLength(const SocketBuf& buf)
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	return buf.len;
+#else
+	return buf.iov_len;
+#endif
+}
+
+
 inline void Socket::init(int af)
 {
 	_pImpl->init(af);
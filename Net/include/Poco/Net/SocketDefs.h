@@ -154,6 +154,7 @@
 	#include <errno.h>
 	#include <sys/types.h>
 	#include <sys/socket.h>
+	#include <sys/uio.h>
 	#include <fcntl.h>
 	#if POCO_OS != POCO_OS_HPUX
 		#include <sys/select.h>
@@ -370,4 +371,20 @@
 #endif
 
 
+namespace Poco {
+namespace Net {
+
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	typedef WSABUF SocketBuf;
+#else
+	typedef struct iovec SocketBuf;
+#endif
+	/// A buffer descriptor for scatter/gather I/O.
+	/// Use Socket::makeBuffer() to create one.
+
+
+} } // namespace Poco::Net
+
+
 #endif // Net_SocketDefs_INCLUDED
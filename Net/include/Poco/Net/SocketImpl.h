@@ -164,6 +164,20 @@ public:
 		///
 		/// Certain socket implementations may also return a negative
 		/// value denoting a certain condition.
+
+	virtual int sendBytes(const SocketBuf* buffers, int count, int flags = 0);
+		/// Sends the contents of the given count buffers through
+		/// the socket, in a single system call (gather write).
+		///
+		/// Returns the number of bytes sent, which may be
+		/// less than the total size of the buffers.
+
+	virtual int receiveBytes(SocketBuf* buffers, int count, int flags = 0);
+		/// Receives data from the socket and stores it in the
+		/// given count buffers, filling one buffer after the other,
+		/// in a single system call (scatter read).
+		///
+		/// Returns the number of bytes received.
 	
 	virtual int sendTo(const void* buffer, int length, const SocketAddress& address, int flags = 0);
 		/// Sends the contents of the given buffer through
@@ -449,6 +463,7 @@ private:
 	
 	friend class Socket;
 	friend class SecureSocketImpl;
+	friend class PollSetImpl;
 };
 
 
@@ -42,8 +42,10 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
+#include "Poco/Net/PollSet.h"
 #include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
 #include "Poco/Observer.h"
 #include "Poco/AutoPtr.h"
 #include <map>
@@ -86,7 +88,11 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// as argument.
 	///
 	/// Once started, the SocketReactor waits for events
-	/// on the registered sockets, using Socket::select().
+	/// on the registered sockets, using a PollSet.
+	/// Sockets are registered with the PollSet when event handlers
+	/// are added or removed, so the cost of a single iteration
+	/// of the reactor loop only depends on the number of sockets
+	/// that are actually ready (on platforms supporting epoll).
 	/// If an event is detected, the corresponding event handler
 	/// is invoked. There are five event types (and corresponding
 	/// notification classes) defined: ReadableNotification, WritableNotification,
@@ -102,10 +108,15 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// TimeoutNotification will be dispatched to all event handlers
 	/// registered for it. This is done in the onTimeout() method
 	/// which can be overridden by subclasses to perform custom
-	/// timeout processing.
+	/// timeout processing. If events keep occuring, the
+	/// TimeoutNotification is dispatched after the events, once
+	/// the timeout has expired since it was last dispatched.
+	/// Event handlers can therefore rely on the TimeoutNotification
+	/// to check their deadlines, no matter how busy the
+	/// SocketReactor is.
 	///
-	/// If there are no sockets for the SocketReactor to pass to
-	/// Socket::select(), an IdleNotification will be dispatched to
+	/// If there are no sockets for the SocketReactor to wait
+	/// for, an IdleNotification will be dispatched to
 	/// all event handlers registered for it. This is done in the
 	/// onIdle() method which can be overridden by subclasses
 	/// to perform custom idle processing. Since onIdle() will be
@@ -127,6 +138,15 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// from another thread while the SocketReactor is running. Also,
 	/// it is safe to call addEventHandler() and removeEventHandler()
 	/// from event handlers.
+	///
+	/// Optionally, sockets can be registered in edge-triggered mode
+	/// (see PollSet for details). In this mode, a ReadableNotification
+	/// is only dispatched again after new data has arrived, so the
+	/// event handlers must read all available data from the socket
+	/// (and should use non-blocking sockets to do so). Event handlers
+	/// that read only part of the available data (like SocketAcceptor,
+	/// which accepts one connection per notification) must not be
+	/// used with an edge-triggered SocketReactor.
 {
 public:
 	SocketReactor();
@@ -135,6 +155,12 @@ public:
 	explicit SocketReactor(const Poco::Timespan& timeout);
 		/// Creates the SocketReactor, using the given timeout.
 
+	SocketReactor(const Poco::Timespan& timeout, bool edgeTriggered);
+		/// Creates the SocketReactor, using the given timeout.
+		///
+		/// If edgeTriggered is true, sockets are registered
+		/// in edge-triggered mode, if supported by the platform.
+
 	virtual ~SocketReactor();
 		/// Destroys the SocketReactor.
 
@@ -156,12 +182,16 @@ public:
 		///
 		/// The default timeout is 250 milliseconds;
 		///
-		/// The timeout is passed to the Socket::select()
+		/// The timeout is passed to the PollSet::poll()
 		/// method.
 		
 	const Poco::Timespan& getTimeout() const;
 		/// Returns the timeout.
 
+	bool isEdgeTriggered() const;
+		/// Returns true if sockets are registered in
+		/// edge-triggered mode.
+
 	void addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer);
 		/// Registers an event handler with the SocketReactor.
 		///
@@ -181,14 +211,16 @@ public:
 
 protected:
 	virtual void onTimeout();
-		/// Called if the timeout expires and no other events are available.
+		/// Called if the timeout expires and no other events are available,
+		/// or if the timeout has expired since the last call while the
+		/// SocketReactor was busy.
 		///
 		/// Can be overridden by subclasses. The default implementation
 		/// dispatches the TimeoutNotification and thus should be called by overriding
 		/// implementations.
 		
 	virtual void onIdle();
-		/// Called if no sockets are available to call select() on.
+		/// Called if no sockets are available to wait for.
 		///
 		/// Can be overridden by subclasses. The default implementation
 		/// dispatches the IdleNotification and thus should be called by overriding
@@ -221,6 +253,7 @@ private:
 	typedef std::map<Socket, NotifierPtr>     EventHandlerMap;
 
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
+	void updatePollSet(const Socket& socket, NotifierPtr& pNotifier);
 
 	enum
 	{
@@ -229,7 +262,9 @@ private:
 		
 	bool            _stop;
 	Poco::Timespan  _timeout;
+	Poco::Timestamp _lastTimeout;
 	EventHandlerMap _handlers;
+	PollSet         _pollSet;
 	NotificationPtr _pReadableNotification;
 	NotificationPtr _pWritableNotification;
 	NotificationPtr _pErrorNotification;
@@ -142,6 +142,29 @@ public:
 		/// Certain socket implementations may also return a negative
 		/// value denoting a certain condition.
 
+	int sendBytes(const SocketBuf* buffers, int count, int flags = 0);
+		/// Sends the contents of the given count buffers through
+		/// the socket, using a single gather write where possible.
+		/// Buffers can be created with Socket::makeBuffer().
+		///
+		/// Like sendBytes() for a single buffer, ensures that all
+		/// data is sent if the socket is blocking.
+		///
+		/// Returns the number of bytes sent, which may be
+		/// less than the total size of the buffers.
+
+	int receiveBytes(SocketBuf* buffers, int count, int flags = 0);
+		/// Receives data from the socket and stores it in
+		/// the given count buffers, filling one after the other.
+		///
+		/// Returns the number of bytes received.
+		/// A return value of 0 means a graceful shutdown
+		/// of the connection from the peer.
+		///
+		/// Throws a TimeoutException if a receive timeout has
+		/// been set and nothing is received within that interval.
+		/// Throws a NetException (or a subclass) in case of other errors.
+
 	int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
@@ -169,6 +192,23 @@ public:
 		/// been set and nothing is received within that interval.
 		/// Throws a NetException (or a subclass) in case of other errors.
 
+#if defined(POCO_OS_FAMILY_UNIX)
+	Poco::UInt64 sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends count bytes, starting at offset, from the file
+		/// referred to by the file descriptor fd through the socket.
+		/// The file position of fd is not changed.
+		///
+		/// On Linux, the data is passed from the file to the socket
+		/// by the kernel using sendfile(), without copying it
+		/// to user space. On other platforms, as well as for
+		/// secure sockets, the data is read into a buffer and
+		/// sent with sendBytes().
+		///
+		/// Returns the number of bytes sent, which is less than
+		/// count if the end of the file has been reached, or
+		/// if the socket is non-blocking.
+#endif
+
 	void sendUrgent(unsigned char data);
 		/// Sends one byte of urgent data through
 		/// the socket.
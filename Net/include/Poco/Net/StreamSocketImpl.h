@@ -70,8 +70,46 @@ public:
 		/// Returns the number of bytes sent. The return value may also be
 		/// negative to denote some special condition.
 
+	virtual int sendBytes(const SocketBuf* buffers, int count, int flags = 0);
+		/// Ensures that the contents of all buffers are sent if the
+		/// socket is blocking. In case of a non-blocking socket, sends
+		/// as many bytes as possible.
+		///
+		/// For secure sockets, the buffers are copied into a single
+		/// buffer, which is then passed to sendBytes().
+		///
+		/// Returns the number of bytes sent.
+
+	using SocketImpl::receiveBytes;
+
+	virtual int receiveBytes(SocketBuf* buffers, int count, int flags = 0);
+		/// Receives data from the socket into the given buffers.
+		///
+		/// For secure sockets, only the first non-empty
+		/// buffer is filled, using receiveBytes().
+		///
+		/// Returns the number of bytes received.
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	virtual Poco::UInt64 sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends count bytes, starting at offset, from the file
+		/// referred to by fd. Uses sendfile() where available
+		/// and the socket is not secure. Otherwise, reads the
+		/// file in chunks and passes them to sendBytes().
+		///
+		/// Returns the number of bytes sent, which is less than
+		/// count at the end of the file, or if the socket is
+		/// non-blocking.
+#endif
+
 protected:
 	virtual ~StreamSocketImpl();
+
+private:
+	enum
+	{
+		SENDFILE_BUFFER_SIZE = 65536
+	};
 };
 
 
@@ -45,9 +45,10 @@
 #include "Poco/Net/TCPServerConnectionFactory.h"
 #include "Poco/Net/TCPServerParams.h"
 #include "Poco/Runnable.h"
-#include "Poco/NotificationQueue.h"
+#include "Poco/AbstractNotificationQueue.h"
 #include "Poco/ThreadPool.h"
 #include "Poco/Mutex.h"
+#include "Poco/AtomicCounter.h"
 
 
 namespace Poco {
@@ -121,16 +122,17 @@ private:
 
 	int _rc;
 	TCPServerParams::Ptr _pParams;
-	int  _currentThreads;
-	int  _totalConnections;
-	int  _currentConnections;
-	int  _maxConcurrentConnections;
-	int  _refusedConnections;
-	bool _stopped;
-	Poco::NotificationQueue         _queue;
-	TCPServerConnectionFactory::Ptr _pConnectionFactory;
-	Poco::ThreadPool&               _threadPool;
-	mutable Poco::FastMutex         _mutex;
+	Poco::AtomicCounter _currentThreads;
+	Poco::AtomicCounter _totalConnections;
+	Poco::AtomicCounter _currentConnections;
+	Poco::AtomicCounter _maxConcurrentConnections;
+	Poco::AtomicCounter _refusedConnections;
+	Poco::AtomicCounter _queuedConnections;
+	Poco::AtomicCounter _stopped;
+	Poco::AbstractNotificationQueue* _pQueue;
+	TCPServerConnectionFactory::Ptr  _pConnectionFactory;
+	Poco::ThreadPool&                _threadPool;
+	mutable Poco::FastMutex          _mutex;
 };
 
 
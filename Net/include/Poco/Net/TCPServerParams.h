@@ -67,6 +67,7 @@ public:
 		///   - threadIdleTime:       10 seconds
 		///   - maxThreads:           0
 		///   - maxQueued:            64
+		///   - lockFreeQueue:        false
 
 	void setThreadIdleTime(const Poco::Timespan& idleTime);
 		/// Sets the maximum idle time for a thread before
@@ -114,6 +115,21 @@ public:
 		/// Returns the priority of TCP server threads
 		/// created by TCPServer. 
 
+	void setLockFreeQueue(bool flag);
+		/// If flag is true, the TCPServerDispatcher queues
+		/// connections in a LockFreeNotificationQueue with a
+		/// capacity of maxQueued, instead of a NotificationQueue.
+		/// This reduces lock contention between the thread
+		/// accepting connections and the server connection threads.
+		///
+		/// Must be set before the TCPServer is created.
+		///
+		/// The default is false.
+
+	bool getLockFreeQueue() const;
+		/// Returns true if the TCPServerDispatcher uses
+		/// a LockFreeNotificationQueue.
+
 protected:
 	virtual ~TCPServerParams();
 		/// Destroys the TCPServerParams.
@@ -123,6 +139,7 @@ private:
 	int _maxThreads;
 	int _maxQueued;
 	Poco::Thread::Priority _threadPriority;
+	bool _lockFreeQueue;
 };
 
 
@@ -153,6 +170,12 @@ inline Poco::Thread::Priority TCPServerParams::getThreadPriority() const
 }
 
 
+inline bool TCPServerParams::getLockFreeQueue() const
+{
+	return _lockFreeQueue;
+}
+
+
 } } // namespace Poco::Net
 
 
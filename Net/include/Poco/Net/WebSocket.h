@@ -43,6 +43,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/HTTPCredentials.h"
+#include "Poco/Buffer.h"
 
 
 namespace Poco {
@@ -53,6 +54,7 @@ class WebSocketImpl;
 class HTTPServerRequest;
 class HTTPServerResponse;
 class HTTPClientSession;
+class PerMessageDeflate;
 
 
 class Net_API WebSocket: public StreamSocket
@@ -144,8 +146,12 @@ public:
 			/// The server rejected the username or password for authentication.
 		WS_ERR_PAYLOAD_TOO_BIG                = 10,
 			/// Payload too big for supplied buffer.
-		WS_ERR_INCOMPLETE_FRAME               = 11
+		WS_ERR_INCOMPLETE_FRAME               = 11,
 			/// Incomplete frame received.
+		WS_ERR_HANDSHAKE_EXTENSION            = 12,
+			/// Invalid or unexpected Sec-WebSocket-Extensions header in handshake response.
+		WS_ERR_COMPRESSION                    = 13
+			/// Compressed payload cannot be decompressed.
 	};
 	
 	WebSocket(HTTPServerRequest& request, HTTPServerResponse& response);
@@ -158,6 +164,15 @@ public:
 		///
 		/// Throws an exception if the request is not a proper WebSocket
 		/// upgrade request.
+
+	WebSocket(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate& deflate);
+		/// Creates a server-side WebSocket from within a
+		/// HTTPRequestHandler, like the constructor above.
+		///
+		/// If the client offers the permessage-deflate extension
+		/// with parameters acceptable to deflate, the extension is
+		/// used for the connection. Otherwise, messages are sent
+		/// and received uncompressed.
 		
 	WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response);
 		/// Creates a client-side WebSocket, using the given
@@ -185,6 +200,14 @@ public:
 		///
 		/// The result of the handshake can be obtained from the response
 		/// object.
+
+	WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, const PerMessageDeflate& deflate);
+		/// Creates a client-side WebSocket, like the constructor
+		/// above, and offers the permessage-deflate extension with
+		/// the parameters given in deflate.
+		///
+		/// Whether the server has accepted the extension can be
+		/// checked with perMessageDeflate().
 	
 	WebSocket(const Socket& socket);
 		/// Creates a WebSocket from another Socket, which must be a WebSocket,
@@ -239,6 +262,66 @@ public:
 		///
 		/// The frame flags and opcode (FrameFlags and FrameOpcodes)
 		/// is stored in flags.
+
+	int receiveFrame(Poco::Buffer<char>& buffer, int& flags);
+		/// Receives a frame from the socket and appends its
+		/// payload to buffer. The buffer is grown if necessary.
+		/// To avoid allocating memory for every frame, the same
+		/// buffer should be reused, after calling buffer.resize(0).
+		///
+		/// Returns the number of bytes received, which is the
+		/// size of the payload. A return value of 0 means that
+		/// the peer has shut down or closed the connection, unless
+		/// flags indicate an empty frame.
+		///
+		/// Throws a WebSocketException if the payload is larger
+		/// than the maximum payload size (see setMaxPayloadSize()).
+		/// Throws a TimeoutException if a receive timeout has
+		/// been set and nothing is received within that interval.
+		/// Throws a NetException (or a subclass) in case of other errors.
+		///
+		/// The frame flags and opcode (FrameFlags and FrameOpcodes)
+		/// is stored in flags.
+
+	void setMaxPayloadSize(int maxPayloadSize);
+		/// Sets the maximum payload size accepted by receiveFrame().
+		///
+		/// Frames with a larger payload are rejected with a
+		/// WebSocketException. The default is the largest
+		/// value representable as an int.
+
+	int getMaxPayloadSize() const;
+		/// Returns the maximum payload size accepted by receiveFrame().
+
+	void setReadAheadSize(int size);
+		/// Sets the size of the buffer used for reading ahead.
+		///
+		/// By default (size 0), receiveFrame() only takes the bytes
+		/// belonging to the current frame from the socket, which
+		/// requires two or three receive calls per frame. If size
+		/// is greater than 0, up to size bytes are read from the
+		/// socket at once, and further frames received with the
+		/// same call are returned by subsequent calls to receiveFrame()
+		/// without accessing the socket. This greatly reduces the
+		/// number of system calls for connections carrying many
+		/// small frames.
+		///
+		/// Note that frames already read ahead are not reported by
+		/// Socket::select(), poll() or a SocketReactor. Applications
+		/// using these must call receiveFrame() until available()
+		/// returns 0.
+
+	int getReadAheadSize() const;
+		/// Returns the size of the buffer used for reading ahead.
+
+	const PerMessageDeflate* perMessageDeflate() const;
+		/// Returns the negotiated parameters of the permessage-deflate
+		/// extension, or null if the extension is not used.
+		///
+		/// If the extension is used, the payloads of text and binary
+		/// messages are transparently compressed by sendFrame()
+		/// and decompressed by receiveFrame(). Control frames are
+		/// never compressed.
 		
 	Mode mode() const;
 		/// Returns WS_SERVER if the WebSocket is a server-side
@@ -248,9 +331,9 @@ public:
 		/// The WebSocket protocol version supported (13).
 	
 protected:
-	static WebSocketImpl* accept(HTTPServerRequest& request, HTTPServerResponse& response);
-	static WebSocketImpl* connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials);
-	static WebSocketImpl* completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key);
+	static WebSocketImpl* accept(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate* pDeflate = 0);
+	static WebSocketImpl* connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials, const PerMessageDeflate* pDeflate = 0);
+	static WebSocketImpl* completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key, const PerMessageDeflate* pDeflate = 0);
 	static std::string computeAccept(const std::string& key);
 	static std::string createKey();
 	
@@ -41,6 +41,7 @@
 
 
 #include "Poco/Net/StreamSocketImpl.h"
+#include "Poco/Buffer.h"
 #include "Poco/Random.h"
 
 
@@ -48,6 +49,9 @@ namespace Poco {
 namespace Net {
 
 
+class PerMessageDeflate;
+
+
 class Net_API WebSocketImpl: public StreamSocketImpl
 	/// This class implements a WebSocket, according
 	/// to the WebSocket protocol described in RFC 6455.
@@ -62,7 +66,16 @@ public:
 		
 	virtual int receiveBytes(void* buffer, int length, int flags);
 		/// Receives a WebSocket protocol frame.
+
+	int receiveBytes(Poco::Buffer<char>& buffer, int flags);
+		/// Receives a WebSocket protocol frame and appends
+		/// its payload to buffer, which is grown as necessary.
 		
+	virtual int available();
+		/// Returns the number of bytes available from the
+		/// socket, including data that has already been
+		/// read ahead.
+
 	virtual SocketImpl* acceptConnection(SocketAddress& clientAddr);
 	virtual void connect(const SocketAddress& address);
 	virtual void connect(const SocketAddress& address, const Poco::Timespan& timeout);
@@ -77,6 +90,11 @@ public:
 	virtual int sendTo(const void* buffer, int length, const SocketAddress& address, int flags = 0);
 	virtual int receiveFrom(void* buffer, int length, SocketAddress& address, int flags = 0);
 	virtual void sendUrgent(unsigned char data);
+	virtual int sendBytes(const SocketBuf* buffers, int count, int flags);
+	virtual int receiveBytes(SocketBuf* buffers, int count, int flags);
+#if defined(POCO_OS_FAMILY_UNIX)
+	virtual Poco::UInt64 sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 count);
+#endif
 	virtual bool secure() const;
 	virtual void setSendTimeout(const Poco::Timespan& timeout); 
 	virtual Poco::Timespan getSendTimeout();
@@ -90,6 +108,34 @@ public:
 	bool mustMaskPayload() const;
 		/// Returns true if the payload must be masked.
 
+	void setMaxPayloadSize(int maxPayloadSize);
+		/// Sets the maximum payload size of a received frame.
+
+	int getMaxPayloadSize() const;
+		/// Returns the maximum payload size of a received frame.
+
+	void setReadAheadSize(int size);
+		/// Sets the size of the read-ahead buffer.
+		///
+		/// See WebSocket::setReadAheadSize() for details.
+
+	int getReadAheadSize() const;
+		/// Returns the size of the read-ahead buffer.
+
+	void setPerMessageDeflate(PerMessageDeflate* pDeflate);
+		/// Enables the permessage-deflate extension with
+		/// the given negotiated parameters. Takes ownership
+		/// of pDeflate.
+
+	const PerMessageDeflate* perMessageDeflate() const;
+		/// Returns the permessage-deflate parameters, or null
+		/// if the extension is not used.
+
+	static void maskPayload(char* dest, const char* src, std::size_t length, const char* mask, std::size_t offset = 0);
+		/// XORs length bytes from src with the 4 byte masking key
+		/// mask, starting at the given offset into the key, and
+		/// stores the result in dest. src and dest may be equal.
+
 protected:
 	enum
 	{
@@ -97,7 +143,34 @@ protected:
 		MAX_HEADER_LENGTH = 14
 	};
 	
+	int writeHeader(char* header, int length, int flags, const char* mask);
+		/// Writes the frame header for a payload of the given length
+		/// to header, which must have room for MAX_HEADER_LENGTH bytes.
+		/// Returns the length of the header.
+
+	void sendFrame(const char* header, int headerLength, const char* payload, int length);
+		/// Sends header and payload. If possible, both are passed to the
+		/// operating system in a single gather write, without copying.
+
+	int receiveHeader(char* mask, bool& useMask, int& payloadLength);
+		/// Receives a frame header. Returns the number of bytes received,
+		/// or the return value of receiveNBytes() if it is less than or
+		/// equal to zero.
+
+	int receivePayload(char* buffer, int payloadLength, const char* mask, bool useMask);
+		/// Receives and unmasks the payload of a frame.
+
+	bool mustInflate();
+		/// Returns true if the payload of the most recently received
+		/// frame is compressed, and removes the RSV1 bit from the
+		/// frame flags.
+
+	int receiveCompressedPayload(int payloadLength, const char* mask, bool useMask);
+		/// Receives and unmasks the compressed payload of a frame
+		/// into the inflate buffer.
+
 	int receiveNBytes(void* buffer, int bytes);
+	int receiveSomeBytes(char* buffer, int bytes);
 	virtual ~WebSocketImpl();
 
 private:
@@ -106,6 +179,17 @@ private:
 	StreamSocketImpl* _pStreamSocketImpl;
 	int _frameFlags;
 	bool _mustMaskPayload;
+	int _maxPayloadSize;
+	int _readAheadSize;
+	Poco::Buffer<char> _sendBuffer;
+	Poco::Buffer<char> _recvBuffer;
+	int _recvOffset;
+	int _recvEnd;
+	PerMessageDeflate* _pDeflate;
+	bool _deflating;
+	bool _inflating;
+	Poco::Buffer<char> _deflateBuffer;
+	Poco::Buffer<char> _inflateBuffer;
 	Poco::Random _rnd;
 };
 
@@ -125,6 +209,24 @@ inline bool WebSocketImpl::mustMaskPayload() const
 }
 
 
+inline int WebSocketImpl::getMaxPayloadSize() const
+{
+	return _maxPayloadSize;
+}
+
+
+inline int WebSocketImpl::getReadAheadSize() const
+{
+	return _readAheadSize;
+}
+
+
+inline const PerMessageDeflate* WebSocketImpl::perMessageDeflate() const
+{
+	return _pDeflate;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -35,11 +35,13 @@
 
 
 #include "Poco/Net/DNS.h"
+#include "Poco/Net/DNSCache.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Environment.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/RWLock.h"
+#include "Poco/Mutex.h"
 #include <cstring>
 
 
@@ -62,11 +64,25 @@ static Poco::RWLock resolverLock;
 #endif
 
 
-HostEntry DNS::hostByName(const std::string& hostname, unsigned 
+static Poco::FastMutex cacheMutex;
+static Poco::SharedPtr<DNSCache> pDNSCache;
+
+
+HostEntry DNS::hostByName(const std::string& hostname, unsigned hintFlags)
+{
+	Poco::SharedPtr<DNSCache> pCache = getCache();
+	if (pCache && pCache->hintFlags() == hintFlags)
+		return pCache->resolve(hostname);
+	else
+		return lookup(hostname, hintFlags);
+}
+
+
+HostEntry DNS::lookup(const std::string& hostname, unsigned 
 #ifdef POCO_HAVE_ADDRINFO
-						  hintFlags
+					  hintFlags
 #endif
-						 )
+					 )
 {
 #if defined(POCO_HAVE_LIBRESOLV)
 	Poco::ScopedReadRWLock readLock(resolverLock);
@@ -196,8 +212,26 @@ void DNS::reload()
 }
 
 
+void DNS::setCache(Poco::SharedPtr<DNSCache> pCache)
+{
+	Poco::FastMutex::ScopedLock lock(cacheMutex);
+	
+	pDNSCache = pCache;
+}
+
+
+Poco::SharedPtr<DNSCache> DNS::getCache()
+{
+	Poco::FastMutex::ScopedLock lock(cacheMutex);
+	
+	return pDNSCache;
+}
+
+
 void DNS::flushCache()
 {
+	Poco::SharedPtr<DNSCache> pCache = getCache();
+	if (pCache) pCache->clear();
 }
 
 
@@ -0,0 +1,301 @@
+//
+// DNSCache.cpp
+//
+// $Id: //poco/1.4/Net/src/DNSCache.cpp#1 $
+//
+// Library: Net
+// Package: NetCore
+// Module:  DNSCache
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/DNSCache.h"
+#include "Poco/Net/NetException.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// DNSCache::Entry
+//
+
+
+DNSCache::Entry::Entry(const HostEntry& hostEntry, const Poco::Timespan& ttl):
+	_hostEntry(hostEntry)
+{
+	_refresh += ttl.totalMicroseconds()/4*3;
+	_expiration += ttl.totalMicroseconds();
+}
+
+
+DNSCache::Entry::Entry(const Poco::Exception& exc, const Poco::Timespan& ttl):
+	_pException(exc.clone())
+{
+	_expiration += ttl.totalMicroseconds();
+	_refresh = _expiration;
+}
+
+
+const HostEntry& DNSCache::Entry::hostEntry() const
+{
+	if (_pException) _pException->rethrow();
+	return _hostEntry;
+}
+
+
+const Poco::Exception* DNSCache::Entry::exception() const
+{
+	return _pException.get();
+}
+
+
+bool DNSCache::Entry::mustRefresh() const
+{
+	return !_pException && _refresh.isElapsed(0);
+}
+
+
+const Poco::Timestamp& DNSCache::Entry::getExpiration() const
+{
+	return _expiration;
+}
+
+
+//
+// DNSCache
+//
+
+
+DNSCache::DNSCache():
+	_ttl(DEFAULT_TTL, 0),
+	_negativeTTL(DEFAULT_NEGATIVE_TTL, 0),
+	_hintFlags(DNS::DNS_HINT_DEFAULT),
+	_cache(DEFAULT_CACHE_SIZE),
+	_pending(0),
+	_resolveAsync(this, &DNSCache::resolveImpl),
+	_refreshAsync(this, &DNSCache::refreshImpl)
+{
+}
+
+
+DNSCache::DNSCache(const Poco::Timespan& ttl, const Poco::Timespan& negativeTTL, long cacheSize, unsigned hintFlags):
+	_ttl(ttl),
+	_negativeTTL(negativeTTL),
+	_hintFlags(hintFlags),
+	_cache(cacheSize),
+	_pending(0),
+	_resolveAsync(this, &DNSCache::resolveImpl),
+	_refreshAsync(this, &DNSCache::refreshImpl)
+{
+}
+
+
+DNSCache::~DNSCache()
+{
+	try
+	{
+		waitForCompletion();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+HostEntry DNSCache::resolve(const std::string& hostname)
+{
+	Poco::SharedPtr<Entry> pEntry = _cache.get(hostname);
+	if (pEntry)
+	{
+		if (pEntry->mustRefresh()) startRefresh(hostname);
+		return pEntry->hostEntry();
+	}
+	else return lookup(hostname);
+}
+
+
+DNSCache::Result DNSCache::resolveAsync(const std::string& hostname)
+{
+	Poco::SharedPtr<Entry> pEntry = _cache.get(hostname);
+	if (pEntry)
+	{
+		if (pEntry->mustRefresh()) startRefresh(hostname);
+		Result result(new Poco::ActiveResultHolder<HostEntry>());
+		if (pEntry->exception())
+			result.error(*pEntry->exception());
+		else
+			result.data(new HostEntry(pEntry->hostEntry()));
+		result.notify();
+		return result;
+	}
+	taskStarted();
+	try
+	{
+		return _resolveAsync(hostname);
+	}
+	catch (...)
+	{
+		taskDone();
+		throw;
+	}
+}
+
+
+void DNSCache::remove(const std::string& hostname)
+{
+	_cache.remove(hostname);
+}
+
+
+void DNSCache::clear()
+{
+	_cache.clear();
+}
+
+
+std::size_t DNSCache::size()
+{
+	return _cache.size();
+}
+
+
+void DNSCache::waitForCompletion()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	while (_pending > 0) _idle.wait(_mutex);
+}
+
+
+HostEntry DNSCache::query(const std::string& hostname)
+{
+	return DNS::lookup(hostname, _hintFlags);
+}
+
+
+HostEntry DNSCache::resolveImpl(const std::string& hostname)
+{
+	try
+	{
+		HostEntry result = resolve(hostname);
+		taskDone();
+		return result;
+	}
+	catch (...)
+	{
+		taskDone();
+		throw;
+	}
+}
+
+
+void DNSCache::refreshImpl(const std::string& hostname)
+{
+	try
+	{
+		lookup(hostname);
+	}
+	catch (...)
+	{
+		// A host that no longer exists has been replaced with a negative
+		// entry by lookup(). After a temporary error, the current entry
+		// is kept until it expires.
+	}
+	finishRefresh(hostname);
+}
+
+
+HostEntry DNSCache::lookup(const std::string& hostname)
+{
+	try
+	{
+		HostEntry result = query(hostname);
+		if (_ttl.totalMicroseconds() > 0)
+			_cache.add(hostname, Entry(result, _ttl));
+		return result;
+	}
+	catch (HostNotFoundException& exc)
+	{
+		if (_negativeTTL.totalMicroseconds() > 0)
+			_cache.add(hostname, Entry(exc, _negativeTTL));
+		throw;
+	}
+	catch (NoAddressFoundException& exc)
+	{
+		if (_negativeTTL.totalMicroseconds() > 0)
+			_cache.add(hostname, Entry(exc, _negativeTTL));
+		throw;
+	}
+}
+
+
+void DNSCache::startRefresh(const std::string& hostname)
+{
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		if (!_refreshing.insert(hostname).second) return;
+		++_pending;
+	}
+	try
+	{
+		_refreshAsync(hostname);
+	}
+	catch (Poco::Exception&)
+	{
+		// no thread available - the entry will be refreshed on a later access
+		finishRefresh(hostname);
+	}
+}
+
+
+void DNSCache::finishRefresh(const std::string& hostname)
+{
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+		_refreshing.erase(hostname);
+	}
+	taskDone();
+}
+
+
+void DNSCache::taskStarted()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	++_pending;
+}
+
+
+void DNSCache::taskDone()
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+	if (--_pending == 0) _idle.broadcast();
+}
+
+
+} } // namespace Poco::Net
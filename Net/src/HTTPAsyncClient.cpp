@@ -0,0 +1,852 @@
+//
+// HTTPAsyncClient.cpp
+//
+// $Id: //poco/1.4/Net/src/HTTPAsyncClient.cpp#1 $
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPAsyncClient
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/HTTPAsyncClient.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPChunkedDecoder.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Observer.h"
+#include "Poco/MemoryStream.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Timestamp.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/ErrorHandler.h"
+#include <sstream>
+#include <memory>
+#include <deque>
+#include <algorithm>
+
+
+using Poco::Observer;
+using Poco::FastMutex;
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// HTTPAsyncClient::Response
+//
+
+
+HTTPAsyncClient::Response::Response()
+{
+}
+
+
+HTTPAsyncClient::Response::~Response()
+{
+}
+
+
+//
+// HTTPAsyncClient::Callback
+//
+
+
+HTTPAsyncClient::Callback::~Callback()
+{
+}
+
+
+//
+// HTTPAsyncClient::Exchange
+//
+
+
+struct HTTPAsyncClient::Exchange
+	/// A request, together with the means to deliver its result.
+{
+	Exchange():
+		head(false),
+		idempotent(false),
+		retried(false),
+		pResponse(0),
+		pException(0)
+	{
+	}
+
+	~Exchange()
+	{
+		delete pResponse;
+		delete pException;
+	}
+
+	std::string request;
+	bool head;
+	bool idempotent;
+	bool retried;
+	Poco::AutoPtr<Poco::ActiveResultHolder<Response> > pResult;
+	CallbackPtr pCallback;
+	Response* pResponse;
+	Poco::Exception* pException;
+};
+
+
+//
+// HTTPAsyncClient::Endpoint
+//
+
+
+struct HTTPAsyncClient::Endpoint
+	/// The connections to, and the requests waiting
+	/// for a connection to, a single server.
+{
+	Endpoint(const SocketAddress& addr):
+		address(addr)
+	{
+	}
+
+	SocketAddress address;
+	std::vector<Connection*> connections;
+	std::deque<Exchange*> waiting;
+};
+
+
+//
+// HTTPAsyncClient::Connection
+//
+
+
+class HTTPAsyncClient::Connection
+	/// A non-blocking connection to a server, registered
+	/// with the client's SocketReactor.
+	///
+	/// All methods must be called with the client's mutex locked.
+	/// Connections are deleted in the reactor's thread, or by
+	/// the client's destructor.
+{
+public:
+	Connection(HTTPAsyncClient& client, Endpoint& endpoint):
+		_client(client),
+		_endpoint(endpoint),
+		_outPos(0),
+		_bodyStart(0),
+		_chunkPos(0),
+		_responses(0),
+		_connected(false),
+		_writable(true),
+		_closing(false)
+	{
+		_socket.connectNB(endpoint.address);
+		SocketReactor& reactor = _client._reactor;
+		reactor.addEventHandler(_socket, Observer<Connection, ReadableNotification>(*this, &Connection::onReadable));
+		reactor.addEventHandler(_socket, Observer<Connection, WritableNotification>(*this, &Connection::onWritable));
+		reactor.addEventHandler(_socket, Observer<Connection, ErrorNotification>(*this, &Connection::onError));
+		reactor.addEventHandler(_socket, Observer<Connection, TimeoutNotification>(*this, &Connection::onTimeout));
+		reactor.addEventHandler(_socket, Observer<Connection, ShutdownNotification>(*this, &Connection::onShutdown));
+	}
+
+	~Connection()
+	{
+		try
+		{
+			SocketReactor& reactor = _client._reactor;
+			reactor.removeEventHandler(_socket, Observer<Connection, ReadableNotification>(*this, &Connection::onReadable));
+			reactor.removeEventHandler(_socket, Observer<Connection, WritableNotification>(*this, &Connection::onWritable));
+			reactor.removeEventHandler(_socket, Observer<Connection, ErrorNotification>(*this, &Connection::onError));
+			reactor.removeEventHandler(_socket, Observer<Connection, TimeoutNotification>(*this, &Connection::onTimeout));
+			reactor.removeEventHandler(_socket, Observer<Connection, ShutdownNotification>(*this, &Connection::onShutdown));
+			_socket.close();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	std::size_t load() const
+		/// Returns the number of outstanding requests.
+	{
+		return _inFlight.size();
+	}
+
+	bool canAccept(const Exchange& exchange) const
+		/// Returns true if the given request can be sent
+		/// on this connection.
+		///
+		/// Requests are only pipelined on a connection once the
+		/// server has answered a request on it without closing it.
+	{
+		if (_closing) return false;
+		if (_inFlight.empty()) return true;
+		return _responses > 0 &&
+			exchange.idempotent &&
+			_inFlight.back()->idempotent &&
+			_inFlight.size() < static_cast<std::size_t>(_client._pipelineDepth);
+	}
+
+	void enqueue(Exchange* pExchange)
+		/// Queues the given request for sending. The request
+		/// is actually written by the reactor's thread.
+	{
+		if (_inFlight.empty()) _lastActivity.update();
+		_inFlight.push_back(pExchange);
+		_outBuffer.append(pExchange->request);
+		if (!_writable)
+		{
+			_client._reactor.addEventHandler(_socket, Observer<Connection, WritableNotification>(*this, &Connection::onWritable));
+			_writable = true;
+		}
+	}
+
+	void abort(const Poco::Exception& exc, bool retry, ExchangeVec& done)
+		/// Fails all outstanding requests with the given exception.
+		///
+		/// If retry is true, idempotent requests that have not been
+		/// retried before are queued again instead.
+	{
+		std::deque<Exchange*> requeue;
+		for (std::deque<Exchange*>::iterator it = _inFlight.begin(); it != _inFlight.end(); ++it)
+		{
+			if (retry && (*it)->idempotent && !(*it)->retried)
+			{
+				(*it)->retried = true;
+				requeue.push_back(*it);
+			}
+			else _client.fail(*it, exc, done);
+		}
+		_endpoint.waiting.insert(_endpoint.waiting.begin(), requeue.begin(), requeue.end());
+		_inFlight.clear();
+	}
+
+	void onReadable(ReadableNotification* pNf)
+	{
+		pNf->release();
+		ExchangeVec done;
+		{
+			FastMutex::ScopedLock lock(_client._mutex);
+			try
+			{
+				// Stop reading once the buffer holds more than the
+				// current response may take; parseResponse() rejects it.
+				std::string::size_type limit = receiveLimit();
+				char buffer[8192];
+				int n;
+				do
+				{
+					n = _socket.receiveBytes(buffer, sizeof(buffer));
+					if (n > 0) _inBuffer.append(buffer, n);
+				}
+				while (n > 0 && _inBuffer.size() <= limit);
+				_lastActivity.update();
+				_connected = true;
+				bool eof = n == 0;
+				while (!_inFlight.empty() && parseResponse(eof, done))
+				{
+				}
+				if (_closing)
+				{
+					// The server has not seen, or will not answer,
+					// any of the remaining pipelined requests. As with
+					// any retry, each request is sent again only once.
+					abort(NetException("Connection closed by server"), true, done);
+					close(done);
+				}
+				else if (eof)
+				{
+					// If the connection has been reused, the server may
+					// have closed it before receiving the request.
+					abort(NetException("Connection closed by server"), _responses > 0, done);
+					close(done);
+				}
+				else if (_inFlight.empty() && !_inBuffer.empty())
+				{
+					throw MessageException("Unexpected data received from server");
+				}
+				else if (!done.empty())
+				{
+					// The connection can take further requests.
+					_client.dispatch(_endpoint, done);
+				}
+			}
+			catch (Poco::Exception& exc)
+			{
+				abort(exc, false, done);
+				close(done);
+			}
+		}
+		HTTPAsyncClient::complete(done);
+	}
+
+	void onWritable(WritableNotification* pNf)
+	{
+		pNf->release();
+		ExchangeVec done;
+		{
+			FastMutex::ScopedLock lock(_client._mutex);
+			try
+			{
+				if (!_connected)
+				{
+					checkConnected();
+					_connected = true;
+				}
+				flush();
+			}
+			catch (Poco::Exception& exc)
+			{
+				abort(exc, false, done);
+				close(done);
+			}
+		}
+		HTTPAsyncClient::complete(done);
+	}
+
+	void onError(ErrorNotification* pNf)
+	{
+		pNf->release();
+		ExchangeVec done;
+		{
+			FastMutex::ScopedLock lock(_client._mutex);
+			try
+			{
+				checkConnected();
+				throw NetException("Connection error");
+			}
+			catch (Poco::Exception& exc)
+			{
+				abort(exc, false, done);
+				close(done);
+			}
+		}
+		HTTPAsyncClient::complete(done);
+	}
+
+	void onTimeout(TimeoutNotification* pNf)
+	{
+		pNf->release();
+		ExchangeVec done;
+		{
+			FastMutex::ScopedLock lock(_client._mutex);
+			if (!_inFlight.empty())
+			{
+				if (_lastActivity.isElapsed(_client._timeout.totalMicroseconds()))
+				{
+					abort(TimeoutException("No response received from server"), false, done);
+					close(done);
+				}
+			}
+			else if (_lastActivity.isElapsed(_client._keepAliveTimeout.totalMicroseconds()))
+			{
+				close(done);
+			}
+		}
+		HTTPAsyncClient::complete(done);
+	}
+
+	void onShutdown(ShutdownNotification* pNf)
+	{
+		pNf->release();
+		ExchangeVec done;
+		{
+			FastMutex::ScopedLock lock(_client._mutex);
+			NetException exc("SocketReactor has been shut down");
+			abort(exc, false, done);
+			while (!_endpoint.waiting.empty())
+			{
+				_client.fail(_endpoint.waiting.front(), exc, done);
+				_endpoint.waiting.pop_front();
+			}
+			close(done);
+		}
+		HTTPAsyncClient::complete(done);
+	}
+
+private:
+	Connection();
+	Connection(const Connection&);
+	Connection& operator = (const Connection&);
+
+	std::string::size_type receiveLimit() const
+		/// Returns the number of bytes the input buffer can hold
+		/// without exceeding the header or response size limit.
+	{
+		if (!_pResponse.get())
+			return MAX_HEADER_LENGTH;
+		else if (_pResponse->body().size() >= _client._maxResponseSize)
+			return _chunkPos;
+		else if (_pResponse->getChunkedTransferEncoding())
+			return _chunkPos + (_client._maxResponseSize - _pResponse->body().size());
+		else
+			return _bodyStart + _client._maxResponseSize;
+	}
+
+	bool parseResponse(bool eof, ExchangeVec& done)
+		/// Checks whether the input buffer contains a complete
+		/// response for the first outstanding request, and
+		/// completes the request if so.
+		///
+		/// Returns true if a response (or an interim 1xx
+		/// response) has been consumed, false otherwise.
+	{
+		if (!_pResponse.get())
+		{
+			std::string::size_type pos = _inBuffer.find("\r\n\r\n");
+			if (pos == std::string::npos)
+			{
+				if (_inBuffer.size() > MAX_HEADER_LENGTH)
+					throw MessageException("Response header too long");
+				return false;
+			}
+			_bodyStart = pos + 4;
+			_chunkPos = _bodyStart;
+			std::auto_ptr<Response> pResponse(new Response);
+			Poco::MemoryInputStream istr(_inBuffer.data(), _bodyStart);
+			pResponse->read(istr);
+			if (pResponse->getStatus() < HTTPResponse::HTTP_OK)
+			{
+				_inBuffer.erase(0, _bodyStart);
+				return true;
+			}
+			_pResponse = pResponse;
+		}
+
+		Exchange* pExchange = _inFlight.front();
+		HTTPResponse::HTTPStatus status = _pResponse->getStatus();
+		std::string::size_type end = _bodyStart;
+		if (pExchange->head || status == HTTPResponse::HTTP_NO_CONTENT || status == HTTPResponse::HTTP_NOT_MODIFIED)
+		{
+		}
+		else if (_pResponse->getChunkedTransferEncoding())
+		{
+			// Chunks are decoded as they arrive; _chunkPos is
+			// the position of the next chunk to decode.
+			bool complete = HTTPChunkedDecoder::decode(_inBuffer, _chunkPos, _pResponse->body());
+			if (_pResponse->body().size() + (_inBuffer.size() - _chunkPos) > _client._maxResponseSize)
+				throw MessageException("Response body too large");
+			if (!complete) return false;
+			end = _chunkPos;
+		}
+		else if (_pResponse->hasContentLength())
+		{
+			Poco::UInt64 length64 = static_cast<Poco::UInt64>(_pResponse->getContentLength64());
+			if (length64 > _client._maxResponseSize)
+				throw MessageException("Response body too large");
+			std::string::size_type length = static_cast<std::string::size_type>(length64);
+			if (_inBuffer.size() - _bodyStart < length) return false;
+			_pResponse->body().assign(_inBuffer, _bodyStart, length);
+			end = _bodyStart + length;
+		}
+		else
+		{
+			// The body extends until the server closes the connection.
+			if (_inBuffer.size() - _bodyStart > _client._maxResponseSize)
+				throw MessageException("Response body too large");
+			if (!eof) return false;
+			_pResponse->body().assign(_inBuffer, _bodyStart, std::string::npos);
+			end = _inBuffer.size();
+			_closing = true;
+		}
+		_inBuffer.erase(0, end);
+		_inFlight.pop_front();
+		++_responses;
+		if (!_pResponse->getKeepAlive()) _closing = true;
+		pExchange->pResponse = _pResponse.release();
+		done.push_back(pExchange);
+		--_client._pending;
+		return true;
+	}
+
+	void checkConnected()
+		/// Throws an exception if connecting to the server has failed.
+	{
+		int err = _socket.impl()->socketError();
+		if (err == POCO_ECONNREFUSED)
+			throw ConnectionRefusedException(_endpoint.address.toString());
+		else if (err != 0)
+			throw NetException(_endpoint.address.toString(), err);
+	}
+
+	void flush()
+		/// Writes as much of the output buffer to the socket
+		/// as possible without blocking.
+	{
+		while (_outPos < _outBuffer.size())
+		{
+			int n = 0;
+			try
+			{
+				n = _socket.sendBytes(_outBuffer.data() + _outPos, static_cast<int>(_outBuffer.size() - _outPos));
+			}
+			catch (Poco::IOException& exc)
+			{
+				if (exc.code() != POCO_EWOULDBLOCK && exc.code() != POCO_EAGAIN) throw;
+			}
+			if (n <= 0) break;
+			_outPos += n;
+			_lastActivity.update();
+		}
+		if (_outPos == _outBuffer.size())
+		{
+			_outBuffer.clear();
+			_outPos = 0;
+			if (_writable)
+			{
+				_client._reactor.removeEventHandler(_socket, Observer<Connection, WritableNotification>(*this, &Connection::onWritable));
+				_writable = false;
+			}
+		}
+	}
+
+	void close(ExchangeVec& done)
+		/// Removes the connection from its endpoint, deletes it,
+		/// and hands the endpoint's waiting requests to other
+		/// connections.
+	{
+		poco_assert_dbg (_inFlight.empty());
+
+		HTTPAsyncClient& client = _client;
+		Endpoint& endpoint = _endpoint;
+		std::vector<Connection*>::iterator it = std::find(endpoint.connections.begin(), endpoint.connections.end(), this);
+		if (it != endpoint.connections.end()) endpoint.connections.erase(it);
+		delete this;
+		client.dispatch(endpoint, done);
+	}
+
+	HTTPAsyncClient&        _client;
+	Endpoint&               _endpoint;
+	StreamSocket            _socket;
+	std::deque<Exchange*>   _inFlight;
+	std::string             _inBuffer;
+	std::string             _outBuffer;
+	std::string::size_type  _outPos;
+	std::auto_ptr<Response> _pResponse;
+	std::string::size_type  _bodyStart;
+	std::string::size_type  _chunkPos;
+	Poco::Timestamp         _lastActivity;
+	int                     _responses;
+	bool                    _connected;
+	bool                    _writable;
+	bool                    _closing;
+};
+
+
+//
+// HTTPAsyncClient
+//
+
+
+HTTPAsyncClient::HTTPAsyncClient(SocketReactor& reactor):
+	_reactor(reactor),
+	_maxConnections(DEFAULT_MAX_CONNECTIONS_PER_ENDPOINT),
+	_pipelineDepth(DEFAULT_PIPELINE_DEPTH),
+	_timeout(DEFAULT_TIMEOUT, 0),
+	_keepAliveTimeout(DEFAULT_KEEP_ALIVE_TIMEOUT, 0),
+	_maxResponseSize(DEFAULT_MAX_RESPONSE_SIZE),
+	_pending(0)
+{
+}
+
+
+HTTPAsyncClient::~HTTPAsyncClient()
+{
+	ExchangeVec done;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		NetException exc("HTTPAsyncClient has been destroyed");
+		for (EndpointMap::iterator it = _endpoints.begin(); it != _endpoints.end(); ++it)
+		{
+			Endpoint* pEndpoint = it->second;
+			for (std::vector<Connection*>::iterator itc = pEndpoint->connections.begin(); itc != pEndpoint->connections.end(); ++itc)
+			{
+				(*itc)->abort(exc, false, done);
+				delete *itc;
+			}
+			for (std::deque<Exchange*>::iterator itw = pEndpoint->waiting.begin(); itw != pEndpoint->waiting.end(); ++itw)
+			{
+				fail(*itw, exc, done);
+			}
+			delete pEndpoint;
+		}
+		_endpoints.clear();
+	}
+	try
+	{
+		complete(done);
+	}
+	catch (...)
+	{
+	}
+}
+
+
+Poco::ActiveResult<HTTPAsyncClient::Response> HTTPAsyncClient::sendRequest(const std::string& host, Poco::UInt16 port, HTTPRequest& request, const std::string& body)
+{
+	std::auto_ptr<Exchange> pExchange(new Exchange);
+	pExchange->pResult = new Poco::ActiveResultHolder<Response>;
+	Poco::ActiveResult<Response> result(pExchange->pResult.duplicate());
+	enqueue(host, port, request, body, pExchange.get());
+	pExchange.release();
+	return result;
+}
+
+
+void HTTPAsyncClient::sendRequest(const std::string& host, Poco::UInt16 port, HTTPRequest& request, const std::string& body, CallbackPtr pCallback)
+{
+	poco_check_ptr (pCallback);
+
+	std::auto_ptr<Exchange> pExchange(new Exchange);
+	pExchange->pCallback = pCallback;
+	enqueue(host, port, request, body, pExchange.get());
+	pExchange.release();
+}
+
+
+void HTTPAsyncClient::setMaxConnectionsPerEndpoint(int maxConnections)
+{
+	poco_assert (maxConnections > 0);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_maxConnections = maxConnections;
+}
+
+
+void HTTPAsyncClient::setPipelineDepth(int depth)
+{
+	poco_assert (depth > 0);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_pipelineDepth = depth;
+}
+
+
+void HTTPAsyncClient::setTimeout(const Poco::Timespan& timeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_timeout = timeout;
+}
+
+
+void HTTPAsyncClient::setKeepAliveTimeout(const Poco::Timespan& timeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_keepAliveTimeout = timeout;
+}
+
+
+void HTTPAsyncClient::setMaxResponseSize(std::size_t size)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_maxResponseSize = size;
+}
+
+
+std::size_t HTTPAsyncClient::pending() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _pending;
+}
+
+
+std::size_t HTTPAsyncClient::connections() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	std::size_t n = 0;
+	for (EndpointMap::const_iterator it = _endpoints.begin(); it != _endpoints.end(); ++it)
+	{
+		n += it->second->connections.size();
+	}
+	return n;
+}
+
+
+void HTTPAsyncClient::enqueue(const std::string& host, Poco::UInt16 port, HTTPRequest& request, const std::string& body, Exchange* pExchange)
+{
+	const std::string& method = request.getMethod();
+	if (!request.has(HTTPRequest::HOST))
+		request.setHost(host, port);
+	if (!request.has(HTTPMessage::CONNECTION))
+		request.setKeepAlive(true);
+	bool chunked = request.getChunkedTransferEncoding();
+	if (!chunked && (!body.empty() || method == HTTPRequest::HTTP_POST || method == HTTPRequest::HTTP_PUT))
+		request.setContentLength(static_cast<std::streamsize>(body.size()));
+
+	std::ostringstream ostr;
+	request.write(ostr);
+	pExchange->request = ostr.str();
+	if (chunked)
+	{
+		if (!body.empty())
+		{
+			pExchange->request.append(NumberFormatter::formatHex(static_cast<unsigned>(body.size())));
+			pExchange->request.append("\r\n");
+			pExchange->request.append(body);
+			pExchange->request.append("\r\n");
+		}
+		pExchange->request.append("0\r\n\r\n");
+	}
+	else pExchange->request.append(body);
+	pExchange->head = method == HTTPRequest::HTTP_HEAD;
+	pExchange->idempotent =
+		method == HTTPRequest::HTTP_GET ||
+		method == HTTPRequest::HTTP_HEAD ||
+		method == HTTPRequest::HTTP_PUT ||
+		method == HTTPRequest::HTTP_DELETE ||
+		method == HTTPRequest::HTTP_OPTIONS ||
+		method == HTTPRequest::HTTP_TRACE;
+
+	std::string key(host);
+	key += ':';
+	NumberFormatter::append(key, port);
+	bool known;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		known = _endpoints.find(key) != _endpoints.end();
+	}
+
+	// Endpoints are only removed by the destructor, so a known endpoint
+	// is still there below. A new host name is resolved without holding
+	// the mutex, which would otherwise block the reactor's thread.
+	SocketAddress address;
+	if (!known) address = SocketAddress(host, port);
+
+	ExchangeVec done;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		EndpointMap::iterator it = _endpoints.find(key);
+		if (it == _endpoints.end())
+		{
+			it = _endpoints.insert(EndpointMap::value_type(key, new Endpoint(address))).first;
+		}
+		it->second->waiting.push_back(pExchange);
+		++_pending;
+		dispatch(*it->second, done);
+	}
+	complete(done);
+}
+
+
+void HTTPAsyncClient::dispatch(Endpoint& endpoint, ExchangeVec& done)
+{
+	while (!endpoint.waiting.empty())
+	{
+		Exchange* pExchange = endpoint.waiting.front();
+		Connection* pConnection = 0;
+		for (std::vector<Connection*>::iterator it = endpoint.connections.begin(); it != endpoint.connections.end(); ++it)
+		{
+			if ((*it)->canAccept(*pExchange) && (!pConnection || (*it)->load() < pConnection->load()))
+				pConnection = *it;
+		}
+		if ((!pConnection || pConnection->load() > 0) && endpoint.connections.size() < static_cast<std::size_t>(_maxConnections))
+		{
+			try
+			{
+				pConnection = new Connection(*this, endpoint);
+				endpoint.connections.push_back(pConnection);
+			}
+			catch (Poco::Exception& exc)
+			{
+				endpoint.waiting.pop_front();
+				fail(pExchange, exc, done);
+				continue;
+			}
+		}
+		if (!pConnection) break;
+		endpoint.waiting.pop_front();
+		pConnection->enqueue(pExchange);
+	}
+}
+
+
+void HTTPAsyncClient::fail(Exchange* pExchange, const Poco::Exception& exc, ExchangeVec& done)
+{
+	pExchange->pException = exc.clone();
+	done.push_back(pExchange);
+	--_pending;
+}
+
+
+void HTTPAsyncClient::complete(ExchangeVec& done)
+{
+	for (ExchangeVec::iterator it = done.begin(); it != done.end(); ++it)
+	{
+		std::auto_ptr<Exchange> pExchange(*it);
+		if (pExchange->pCallback)
+		{
+			try
+			{
+				if (pExchange->pException)
+					pExchange->pCallback->onError(*pExchange->pException);
+				else
+					pExchange->pCallback->onResponse(*pExchange->pResponse);
+			}
+			catch (Poco::Exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+		}
+		else
+		{
+			if (pExchange->pException)
+			{
+				pExchange->pResult->error(*pExchange->pException);
+			}
+			else
+			{
+				pExchange->pResult->data(pExchange->pResponse);
+				pExchange->pResponse = 0;
+			}
+			pExchange->pResult->notify();
+		}
+	}
+	done.clear();
+}
+
+
+} } // namespace Poco::Net
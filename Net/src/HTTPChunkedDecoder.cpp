@@ -0,0 +1,80 @@
+//
+// HTTPChunkedDecoder.cpp
+//
+// $Id: //poco/1.4/Net/src/HTTPChunkedDecoder.cpp#1 $
+//
+// Library: Net
+// Package: HTTP
+// Module:  HTTPChunkedDecoder
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/HTTPChunkedDecoder.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Ascii.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+bool HTTPChunkedDecoder::decode(const std::string& buffer, std::string::size_type& pos, std::string& body)
+{
+	for (;;)
+	{
+		std::string::size_type eol = buffer.find("\r\n", pos);
+		if (eol == std::string::npos) return false;
+		std::string::size_type sizeEnd = pos;
+		while (sizeEnd < eol && Poco::Ascii::isHexDigit(buffer[sizeEnd])) ++sizeEnd;
+		unsigned chunkSize;
+		if (sizeEnd == pos || !Poco::NumberParser::tryParseHex(buffer.substr(pos, sizeEnd - pos), chunkSize))
+			throw MessageException("Invalid chunked transfer encoding");
+		std::string::size_type dataPos = eol + 2;
+		if (chunkSize == 0)
+		{
+			// skip optional trailer
+			for (;;)
+			{
+				eol = buffer.find("\r\n", dataPos);
+				if (eol == std::string::npos) return false;
+				bool last = eol == dataPos;
+				dataPos = eol + 2;
+				if (last) break;
+			}
+			pos = dataPos;
+			return true;
+		}
+		if (buffer.size() < dataPos + chunkSize + 2) return false;
+		body.append(buffer, dataPos, chunkSize);
+		pos = dataPos + chunkSize + 2;
+	}
+}
+
+
+} } // namespace Poco::Net
@@ -36,12 +36,10 @@
 
 #include "Poco/Net/HTTPChunkedStream.h"
 #include "Poco/Net/HTTPSession.h"
-#include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/Ascii.h"
 
 
-using Poco::NumberFormatter;
 using Poco::NumberParser;
 
 
@@ -72,8 +70,13 @@ void HTTPChunkedStreamBuf::close()
 {
 	if (_mode & std::ios::out)
 	{
-		sync();
-		_session.write("0\r\n\r\n", 5);
+		std::streamsize pending = static_cast<std::streamsize>(pptr() - pbase());
+		if (pending > 0)
+		{
+			writeChunk(pbase(), pending, 0, 0, true);
+			pbump(static_cast<int>(-pending));
+		}
+		else _session.write("0\r\n\r\n", 5);
 	}
 }
 
@@ -113,16 +116,53 @@ int HTTPChunkedStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 
 int HTTPChunkedStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
 {
-	_chunkBuffer.clear();
-	NumberFormatter::appendHex(_chunkBuffer, length);
-	_chunkBuffer.append("\r\n", 2);
-	_chunkBuffer.append(buffer, static_cast<std::string::size_type>(length));
-	_chunkBuffer.append("\r\n", 2);
-	_session.write(_chunkBuffer.data(), static_cast<std::streamsize>(_chunkBuffer.size()));
+	writeChunk(buffer, length, 0, 0, false);
 	return static_cast<int>(length);
 }
 
 
+std::streamsize HTTPChunkedStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+	if (!(_mode & std::ios::out) || n < epptr() - pptr())
+		return HTTPBasicStreamBuf::xsputn(s, n);
+
+	std::streamsize pending = static_cast<std::streamsize>(pptr() - pbase());
+	writeChunk(pbase(), pending, s, n, false);
+	pbump(static_cast<int>(-pending));
+	return n;
+}
+
+
+void HTTPChunkedStreamBuf::writeChunk(const char* pending, std::streamsize pendingLength, const char* data, std::streamsize dataLength, bool last)
+{
+	static const char hexDigits[] = "0123456789ABCDEF";
+	static const char trailer[] = "\r\n0\r\n\r\n";
+
+	char header[2*sizeof(std::streamsize) + 2];
+	char* end = header + sizeof(header);
+	char* p = end;
+	*--p = '\n';
+	*--p = '\r';
+	std::streamsize length = pendingLength + dataLength;
+	do
+	{
+		*--p = hexDigits[length & 0x0F];
+		length >>= 4;
+	}
+	while (length > 0);
+
+	SocketBuf buffers[4];
+	int count = 0;
+	buffers[count++] = Socket::makeBuffer(p, end - p);
+	if (pendingLength > 0)
+		buffers[count++] = Socket::makeBuffer(const_cast<char*>(pending), static_cast<std::size_t>(pendingLength));
+	if (dataLength > 0)
+		buffers[count++] = Socket::makeBuffer(const_cast<char*>(data), static_cast<std::size_t>(dataLength));
+	buffers[count++] = Socket::makeBuffer(const_cast<char*>(trailer), last ? sizeof(trailer) - 1 : 2);
+	_session.write(buffers, count);
+}
+
+
 //
 // HTTPChunkedIOS
 //
@@ -0,0 +1,381 @@
+//
+// HTTPClientSessionPool.cpp
+//
+// $Id: //poco/1.4/Net/src/HTTPClientSessionPool.cpp#1 $
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
+#include "Poco/Exception.h"
+
+
+using Poco::FastMutex;
+using Poco::Timespan;
+using Poco::Timestamp;
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// HTTPClientSessionPool::ScopedSession
+//
+
+
+HTTPClientSessionPool::ScopedSession::ScopedSession(HTTPClientSessionPool& pool, const Poco::URI& uri):
+	_pool(pool),
+	_pSession(pool.borrowSession(uri))
+{
+}
+
+
+HTTPClientSessionPool::ScopedSession::~ScopedSession()
+{
+	try
+	{
+		if (_pSession) _pool.returnSession(_pSession);
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void HTTPClientSessionPool::ScopedSession::discard()
+{
+	if (_pSession)
+	{
+		_pool.discardSession(_pSession);
+		_pSession = 0;
+	}
+}
+
+
+//
+// HTTPClientSessionPool
+//
+
+
+HTTPClientSessionPool::Endpoint::Endpoint():
+	borrowed(0)
+{
+}
+
+
+HTTPClientSessionPool::HTTPClientSessionPool():
+	_factory(HTTPSessionFactory::defaultFactory()),
+	_maxSessionsPerEndpoint(DEFAULT_MAX_SESSIONS_PER_ENDPOINT),
+	_idleTimeout(DEFAULT_IDLE_TIMEOUT, 0),
+	_waitTimeout(DEFAULT_WAIT_TIMEOUT, 0),
+	_idle(0)
+{
+}
+
+
+HTTPClientSessionPool::HTTPClientSessionPool(HTTPSessionFactory& factory, int maxSessionsPerEndpoint, const Poco::Timespan& idleTimeout, const Poco::Timespan& waitTimeout):
+	_factory(factory),
+	_maxSessionsPerEndpoint(maxSessionsPerEndpoint),
+	_idleTimeout(idleTimeout),
+	_waitTimeout(waitTimeout),
+	_idle(0)
+{
+	poco_assert (maxSessionsPerEndpoint > 0);
+}
+
+
+HTTPClientSessionPool::~HTTPClientSessionPool()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::borrowSession(const Poco::URI& uri)
+{
+	std::string key = endpointKey(uri);
+	std::vector<HTTPClientSession*> evicted;
+	HTTPClientSession* pSession = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_lastEviction.isElapsed(_idleTimeout.totalMicroseconds()/2))
+			evictIdleImpl(evicted);
+
+		Timestamp start;
+		for (;;)
+		{
+			Endpoint& endpoint = _endpoints[key];
+			if (!endpoint.idle.empty())
+			{
+				// Use the most recently returned session, whose
+				// connection is most likely still alive.
+				pSession = endpoint.idle.back().pSession;
+				endpoint.idle.pop_back();
+				--_idle;
+				++endpoint.borrowed;
+				_borrowed[pSession] = key;
+				break;
+			}
+			else if (endpoint.borrowed < _maxSessionsPerEndpoint)
+			{
+				++endpoint.borrowed;
+				break;
+			}
+
+			Timespan remaining = _waitTimeout - Timespan(start.elapsed());
+			if (remaining <= 0 || !_returned.tryWait(_mutex, static_cast<long>(remaining.totalMilliseconds())))
+			{
+				if (_endpoints[key].idle.empty() && _endpoints[key].borrowed >= _maxSessionsPerEndpoint)
+					throw TimeoutException("No HTTP client session available for", key);
+			}
+		}
+	}
+
+	for (std::vector<HTTPClientSession*>::iterator it = evicted.begin(); it != evicted.end(); ++it)
+	{
+		delete *it;
+	}
+
+	if (pSession)
+	{
+		if (!isHealthy(*pSession)) pSession->reset();
+	}
+	else
+	{
+		try
+		{
+			pSession = createSession(uri);
+		}
+		catch (...)
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			--_endpoints[key].borrowed;
+			_returned.broadcast();
+			throw;
+		}
+		FastMutex::ScopedLock lock(_mutex);
+		_borrowed[pSession] = key;
+	}
+	return pSession;
+}
+
+
+void HTTPClientSessionPool::returnSession(HTTPClientSession* pSession)
+{
+	poco_check_ptr (pSession);
+
+	bool keep = pSession->connected() && pSession->getKeepAlive();
+	std::vector<HTTPClientSession*> evicted;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		SessionMap::iterator it = _borrowed.find(pSession);
+		if (it == _borrowed.end()) throw InvalidArgumentException("Session has not been borrowed from this pool");
+		Endpoint& endpoint = _endpoints[it->second];
+		--endpoint.borrowed;
+		_borrowed.erase(it);
+		if (keep)
+		{
+			IdleSession idle;
+			idle.pSession = pSession;
+			endpoint.idle.push_back(idle);
+			++_idle;
+		}
+		if (_lastEviction.isElapsed(_idleTimeout.totalMicroseconds()/2))
+			evictIdleImpl(evicted);
+		_returned.broadcast();
+	}
+
+	if (!keep) delete pSession;
+	for (std::vector<HTTPClientSession*>::iterator it = evicted.begin(); it != evicted.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void HTTPClientSessionPool::discardSession(HTTPClientSession* pSession)
+{
+	poco_check_ptr (pSession);
+
+	release(pSession);
+	delete pSession;
+}
+
+
+void HTTPClientSessionPool::evictIdle()
+{
+	std::vector<HTTPClientSession*> evicted;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		evictIdleImpl(evicted);
+	}
+	for (std::vector<HTTPClientSession*>::iterator it = evicted.begin(); it != evicted.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void HTTPClientSessionPool::clear()
+{
+	std::vector<HTTPClientSession*> sessions;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		for (EndpointMap::iterator it = _endpoints.begin(); it != _endpoints.end(); ++it)
+		{
+			for (IdleVec::iterator itIdle = it->second.idle.begin(); itIdle != it->second.idle.end(); ++itIdle)
+			{
+				sessions.push_back(itIdle->pSession);
+			}
+			it->second.idle.clear();
+		}
+		_idle = 0;
+	}
+	for (std::vector<HTTPClientSession*>::iterator it = sessions.begin(); it != sessions.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+std::size_t HTTPClientSessionPool::idle() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _idle;
+}
+
+
+std::size_t HTTPClientSessionPool::borrowed() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _borrowed.size();
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::createSession(const Poco::URI& uri)
+{
+	HTTPClientSession* pSession = 0;
+	if (_factory.supportsProtocol(uri.getScheme()))
+		pSession = _factory.createClientSession(uri);
+	else if (uri.getScheme() == "http")
+		pSession = new HTTPClientSession(uri.getHost(), uri.getPort());
+	else
+		throw UnknownURISchemeException(uri.getScheme());
+	pSession->setKeepAlive(true);
+	return pSession;
+}
+
+
+bool HTTPClientSessionPool::isHealthy(HTTPClientSession& session)
+{
+	if (!session.connected()) return true;
+
+	try
+	{
+		// An idle connection must not be readable. If it is,
+		// the server has either closed it, or sent garbage.
+		return !session.socket().poll(Timespan(0), Socket::SELECT_READ | Socket::SELECT_ERROR);
+	}
+	catch (Poco::Exception&)
+	{
+		return false;
+	}
+}
+
+
+std::string HTTPClientSessionPool::endpointKey(const Poco::URI& uri)
+{
+	std::string key(uri.getScheme());
+	key += "://";
+	key += Poco::toLower(uri.getHost());
+	key += ':';
+	NumberFormatter::append(key, uri.getPort());
+	return key;
+}
+
+
+void HTTPClientSessionPool::evictIdleImpl(std::vector<HTTPClientSession*>& evicted)
+{
+	Timespan::TimeDiff idleTimeout = _idleTimeout.totalMicroseconds();
+	EndpointMap::iterator it = _endpoints.begin();
+	while (it != _endpoints.end())
+	{
+		IdleVec& idle = it->second.idle;
+		IdleVec::iterator itIdle = idle.begin();
+		while (itIdle != idle.end())
+		{
+			if (itIdle->returned.isElapsed(idleTimeout))
+			{
+				evicted.push_back(itIdle->pSession);
+				itIdle = idle.erase(itIdle);
+				--_idle;
+			}
+			else ++itIdle;
+		}
+		if (idle.empty() && it->second.borrowed == 0)
+			_endpoints.erase(it++);
+		else
+			++it;
+	}
+	_lastEviction.update();
+}
+
+
+void HTTPClientSessionPool::release(HTTPClientSession* pSession)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	SessionMap::iterator it = _borrowed.find(pSession);
+	if (it == _borrowed.end()) throw InvalidArgumentException("Session has not been borrowed from this pool");
+	--_endpoints[it->second].borrowed;
+	_borrowed.erase(it);
+	_returned.broadcast();
+}
+
+
+} } // namespace Poco::Net
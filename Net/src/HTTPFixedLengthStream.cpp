@@ -92,6 +92,24 @@ int HTTPFixedLengthStreamBuf::writeToDevice(const char* buffer, std::streamsize
 }
 
 
+std::streamsize HTTPFixedLengthStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+	std::streamsize pending = static_cast<std::streamsize>(pptr() - pbase());
+	if (!(getMode() & std::ios::out) || n < epptr() - pptr() || _count + pending + n > _length)
+		return HTTPBasicStreamBuf::xsputn(s, n);
+
+	SocketBuf buffers[2];
+	int count = 0;
+	if (pending > 0)
+		buffers[count++] = Socket::makeBuffer(pbase(), static_cast<std::size_t>(pending));
+	buffers[count++] = Socket::makeBuffer(const_cast<char*>(s), static_cast<std::size_t>(n));
+	int sent = _session.write(buffers, count);
+	if (sent > 0) _count += sent;
+	pbump(static_cast<int>(-pending));
+	return n;
+}
+
+
 //
 // HTTPFixedLengthIOS
 //
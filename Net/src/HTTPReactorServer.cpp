@@ -0,0 +1,256 @@
+//
+// HTTPReactorServer.cpp
+//
+// $Id: //poco/1.4/Net/src/HTTPReactorServer.cpp#1 $
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorServer
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/HTTPReactorServer.h"
+#include "Poco/Net/HTTPReactorServerConnection.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Observer.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPReactorServer::Acceptor
+	/// Accepts connections on behalf of a single
+	/// event loop of a HTTPReactorServer.
+{
+public:
+	enum
+	{
+		ACCEPT_BACKOFF = 100000
+			/// Time in microseconds for which accepting connections
+			/// is suspended after an error, e.g. if the process has
+			/// run out of file descriptors.
+	};
+
+	Acceptor(ServerSocket& socket, SocketReactor& reactor, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory):
+		_socket(socket),
+		_reactor(reactor),
+		_pParams(pParams),
+		_pFactory(pFactory),
+		_suspended(false)
+	{
+		_reactor.addEventHandler(_socket, Poco::Observer<Acceptor, ReadableNotification>(*this, &Acceptor::onAccept));
+	}
+
+	~Acceptor()
+		/// The Acceptor is only destroyed after its SocketReactor,
+		/// so there is no need to unregister it.
+	{
+	}
+
+	void onAccept(ReadableNotification* pNf)
+	{
+		pNf->release();
+
+		// The listening socket is non-blocking, so we can
+		// accept all pending connections at once. This also
+		// takes care of the case where several event loops
+		// share a listening socket.
+		for (;;)
+		{
+			StreamSocket socket;
+			try
+			{
+				socket = _socket.acceptConnection();
+			}
+			catch (Poco::IOException& exc)
+			{
+				if (exc.code() == POCO_EWOULDBLOCK || exc.code() == POCO_EAGAIN) break;
+				if (exc.code() == POCO_ECONNABORTED || exc.code() == POCO_EINTR) continue;
+
+				// The pending connection stays in the backlog, so the
+				// listening socket remains readable. Stop watching it
+				// for a while instead of retrying in a busy loop.
+				Poco::ErrorHandler::handle(exc);
+				suspend();
+				break;
+			}
+			new HTTPReactorServerConnection(socket, _reactor, _pParams, _pFactory);
+		}
+	}
+
+	void onTimeout(TimeoutNotification* pNf)
+	{
+		pNf->release();
+		resumeIfDue();
+	}
+
+	void onIdle(IdleNotification* pNf)
+	{
+		pNf->release();
+		resumeIfDue();
+	}
+
+protected:
+	void suspend()
+	{
+		_reactor.removeEventHandler(_socket, Poco::Observer<Acceptor, ReadableNotification>(*this, &Acceptor::onAccept));
+		_reactor.addEventHandler(_socket, Poco::Observer<Acceptor, TimeoutNotification>(*this, &Acceptor::onTimeout));
+		_reactor.addEventHandler(_socket, Poco::Observer<Acceptor, IdleNotification>(*this, &Acceptor::onIdle));
+		_suspendedAt.update();
+		_suspended = true;
+	}
+
+	void resumeIfDue()
+	{
+		if (_suspended && _suspendedAt.isElapsed(ACCEPT_BACKOFF))
+		{
+			_suspended = false;
+			_reactor.removeEventHandler(_socket, Poco::Observer<Acceptor, TimeoutNotification>(*this, &Acceptor::onTimeout));
+			_reactor.removeEventHandler(_socket, Poco::Observer<Acceptor, IdleNotification>(*this, &Acceptor::onIdle));
+			_reactor.addEventHandler(_socket, Poco::Observer<Acceptor, ReadableNotification>(*this, &Acceptor::onAccept));
+		}
+	}
+
+private:
+	ServerSocket                   _socket;
+	SocketReactor&                 _reactor;
+	HTTPServerParams::Ptr          _pParams;
+	HTTPRequestHandlerFactory::Ptr _pFactory;
+	bool                           _suspended;
+	Poco::Timestamp                _suspendedAt;
+};
+
+
+HTTPReactorServer::HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::UInt16 portNumber, HTTPServerParams::Ptr pParams, int reactors):
+	_pFactory(pFactory),
+	_pParams(pParams),
+	_reactorCount(reactors)
+{
+	init(SocketAddress(portNumber));
+}
+
+
+HTTPReactorServer::HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, const SocketAddress& address, HTTPServerParams::Ptr pParams, int reactors):
+	_pFactory(pFactory),
+	_pParams(pParams),
+	_reactorCount(reactors)
+{
+	init(address);
+}
+
+
+HTTPReactorServer::~HTTPReactorServer()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void HTTPReactorServer::init(const SocketAddress& address)
+{
+	poco_check_ptr (_pFactory);
+	poco_check_ptr (_pParams);
+	poco_assert (_reactorCount > 0);
+
+	ServerSocket socket;
+	socket.bind(address, true);
+	socket.listen(LISTEN_BACKLOG);
+	socket.setBlocking(false);
+	_sockets.push_back(socket);
+
+#if POCO_OS == POCO_OS_LINUX && defined(SO_REUSEPORT)
+	SocketAddress boundAddress(address.host(), socket.address().port());
+	try
+	{
+		for (int i = 1; i < _reactorCount; ++i)
+		{
+			ServerSocket reuseSocket;
+			reuseSocket.bind(boundAddress, true);
+			reuseSocket.listen(LISTEN_BACKLOG);
+			reuseSocket.setBlocking(false);
+			_sockets.push_back(reuseSocket);
+		}
+	}
+	catch (Poco::Exception&)
+	{
+		// SO_REUSEPORT is not supported by the kernel;
+		// fall back to a shared listening socket.
+		_sockets.resize(1);
+	}
+#endif
+}
+
+
+void HTTPReactorServer::start()
+{
+	poco_assert (_reactors.empty());
+
+	for (int i = 0; i < _reactorCount; ++i)
+	{
+		Reactor::Ptr pReactor(new Reactor);
+		_reactors.push_back(pReactor);
+		ServerSocket& socket = _sockets[static_cast<std::size_t>(i) < _sockets.size() ? i : 0];
+		_acceptors.push_back(new Acceptor(socket, *pReactor, _pParams, _pFactory));
+	}
+}
+
+
+void HTTPReactorServer::stop()
+{
+	if (_reactors.empty()) return;
+
+	_pFactory->serverStopped(this, true);
+
+	// Destroying the reactors stops the event loops,
+	// which in turn close all client connections.
+	_reactors.clear();
+	for (AcceptorVec::iterator it = _acceptors.begin(); it != _acceptors.end(); ++it)
+	{
+		delete *it;
+	}
+	_acceptors.clear();
+}
+
+
+Poco::UInt16 HTTPReactorServer::port() const
+{
+	return _sockets[0].address().port();
+}
+
+
+} } // namespace Poco::Net
@@ -0,0 +1,909 @@
+//
+// HTTPReactorServerConnection.cpp
+//
+// $Id: //poco/1.4/Net/src/HTTPReactorServerConnection.cpp#1 $
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorServerConnection
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/HTTPReactorServerConnection.h"
+#include "Poco/Net/HTTPChunkedDecoder.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Observer.h"
+#include "Poco/MemoryStream.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/String.h"
+#include "Poco/Buffer.h"
+#include <sstream>
+#include <memory>
+#include <cstring>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+
+using Poco::Observer;
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	class BufferedServerResponse: public HTTPServerResponse
+		/// A HTTPServerResponse that collects the complete
+		/// response in memory.
+	{
+	public:
+		BufferedServerResponse():
+			_pRequest(0),
+			_sent(false),
+			_fd(-1),
+			_fileOffset(0),
+			_fileLength(0)
+		{
+		}
+
+		~BufferedServerResponse()
+		{
+#if defined(POCO_OS_FAMILY_UNIX)
+			if (_fd >= 0) ::close(_fd);
+#endif
+		}
+
+		void attachRequest(HTTPServerRequest* pRequest)
+		{
+			_pRequest = pRequest;
+		}
+
+		void sendContinue()
+		{
+			// The request body has already been received completely,
+			// and a 100 Continue response has been sent if required.
+		}
+
+		std::ostream& send()
+		{
+			poco_assert (!_sent);
+
+			_sent = true;
+			return _body;
+		}
+
+		void sendFile(const std::string& path, const std::string& mediaType)
+		{
+			poco_assert (!_sent);
+
+			Poco::File f(path);
+			sendFile(path, 0, f.getSize(), mediaType);
+		}
+
+		void sendFile(const std::string& path, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType)
+		{
+			poco_assert (!_sent);
+
+			Poco::File f(path);
+			Poco::File::FileSize size = f.getSize();
+			if (offset > size || length > size - offset) throw Poco::RangeException("File range exceeds file size", path);
+			set("Last-Modified", Poco::DateTimeFormatter::format(f.getLastModified(), Poco::DateTimeFormat::HTTP_FORMAT));
+			setContentType(mediaType);
+#if defined(POCO_OS_FAMILY_UNIX)
+			// The file is sent by the connection, once the
+			// output buffer has been written to the socket.
+			int fd = -1;
+			if (!isHead())
+			{
+				fd = ::open(path.c_str(), O_RDONLY);
+				if (fd < 0) throw Poco::OpenFileException(path);
+			}
+			attachFile(fd, offset, length);
+#else
+			Poco::FileInputStream istr(path);
+			if (istr.good())
+			{
+				_sent = true;
+				if (!isHead() && length > 0)
+				{
+					istr.seekg(static_cast<std::streamoff>(offset));
+					Poco::Buffer<char> buffer(8192);
+					while (length > 0 && istr.good())
+					{
+						std::streamsize n = static_cast<std::streamsize>(length < buffer.size() ? length : buffer.size());
+						istr.read(buffer.begin(), n);
+						_body.write(buffer.begin(), istr.gcount());
+						length -= istr.gcount();
+					}
+					if (length > 0) throw Poco::ReadFileException(path);
+				}
+			}
+			else throw Poco::OpenFileException(path);
+#endif
+		}
+
+#if defined(POCO_OS_FAMILY_UNIX)
+		void sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType)
+		{
+			poco_assert (!_sent);
+
+			struct stat st;
+			if (::fstat(fd, &st) != 0) throw Poco::OpenFileException("Invalid file descriptor");
+			if (S_ISREG(st.st_mode))
+			{
+				Poco::UInt64 size = static_cast<Poco::UInt64>(st.st_size);
+				if (offset > size || length > size - offset) throw Poco::RangeException("File range exceeds file size");
+			}
+			set("Last-Modified", Poco::DateTimeFormatter::format(Poco::Timestamp::fromEpochTime(st.st_mtime), Poco::DateTimeFormat::HTTP_FORMAT));
+			setContentType(mediaType);
+			// The caller may close fd as soon as we return,
+			// so the connection sends from a duplicate.
+			int dupFd = -1;
+			if (!isHead())
+			{
+				dupFd = ::dup(fd);
+				if (dupFd < 0) throw Poco::OpenFileException("Cannot duplicate file descriptor");
+			}
+			attachFile(dupFd, offset, length);
+		}
+
+		int releaseFile(Poco::UInt64& offset, Poco::UInt64& length)
+			/// Returns the file descriptor of the file to be sent
+			/// as response body, or -1 if there is none, and
+			/// passes its ownership to the caller.
+		{
+			int fd = hasBody() ? _fd : -1;
+			if (fd >= 0)
+			{
+				offset = _fileOffset;
+				length = _fileLength;
+				_fd = -1;
+			}
+			return fd;
+		}
+#endif
+
+		void sendBuffer(const void* pBuffer, std::size_t length)
+		{
+			poco_assert (!_sent);
+
+			_sent = true;
+			if (!isHead())
+				_body.write(static_cast<const char*>(pBuffer), static_cast<std::streamsize>(length));
+		}
+
+		void redirect(const std::string& uri, HTTPStatus status)
+		{
+			poco_assert (!_sent);
+
+			setStatusAndReason(status);
+			set("Location", uri);
+			_sent = true;
+		}
+
+		void requireAuthentication(const std::string& realm)
+		{
+			poco_assert (!_sent);
+
+			setStatusAndReason(HTTPResponse::HTTP_UNAUTHORIZED);
+			std::string auth("Basic realm=\"");
+			auth.append(realm);
+			auth.append("\"");
+			set("WWW-Authenticate", auth);
+		}
+
+		bool sent() const
+		{
+			return _sent;
+		}
+
+		void writeTo(std::string& buffer)
+			/// Appends the response message to the buffer. The body
+			/// of a file response is not included, see releaseFile().
+		{
+			std::string body;
+			if (hasBody() && _fd < 0)
+			{
+				body = _body.str();
+				setChunkedTransferEncoding(false);
+				setContentLength64(static_cast<Poco::UInt64>(body.size()));
+			}
+			std::ostringstream hstr;
+			write(hstr);
+			buffer.append(hstr.str());
+			buffer.append(body);
+		}
+
+	private:
+		bool isHead() const
+		{
+			return _pRequest && _pRequest->getMethod() == HTTPRequest::HTTP_HEAD;
+		}
+
+		bool hasBody() const
+		{
+			return !isHead() &&
+				getStatus() >= 200 &&
+				getStatus() != HTTPResponse::HTTP_NO_CONTENT &&
+				getStatus() != HTTPResponse::HTTP_NOT_MODIFIED;
+		}
+
+#if defined(POCO_OS_FAMILY_UNIX)
+		void attachFile(int fd, Poco::UInt64 offset, Poco::UInt64 length)
+		{
+			_sent = true;
+			_fd = fd;
+			_fileOffset = offset;
+			_fileLength = length;
+			setChunkedTransferEncoding(false);
+			setContentLength64(length);
+		}
+#endif
+
+		HTTPServerRequest* _pRequest;
+		std::ostringstream _body;
+		bool _sent;
+		int _fd;
+		Poco::UInt64 _fileOffset;
+		Poco::UInt64 _fileLength;
+	};
+
+
+	class BufferedServerRequest: public HTTPServerRequest
+		/// A HTTPServerRequest whose body has been
+		/// received completely.
+	{
+	public:
+		BufferedServerRequest(BufferedServerResponse& response, const StreamSocket& socket, HTTPServerParams* pParams):
+			_response(response),
+			_clientAddress(socket.peerAddress()),
+			_serverAddress(socket.address()),
+			_pParams(pParams, true),
+			_pStream(0)
+		{
+			response.attachRequest(this);
+		}
+
+		~BufferedServerRequest()
+		{
+			delete _pStream;
+		}
+
+		void setBody(std::string& body)
+			/// Takes over the contents of the given string as
+			/// request body.
+		{
+			_body.swap(body);
+			delete _pStream;
+			_pStream = 0;
+			_pStream = new Poco::MemoryInputStream(_body.data(), _body.size());
+		}
+
+		std::istream& stream()
+		{
+			poco_check_ptr (_pStream);
+
+			return *_pStream;
+		}
+
+		bool expectContinue() const
+		{
+			return false;
+		}
+
+		bool wantsContinue() const
+		{
+			const std::string& expect = get("Expect", EMPTY);
+			return !expect.empty() && icompare(expect, "100-continue") == 0;
+		}
+
+		const SocketAddress& clientAddress() const
+		{
+			return _clientAddress;
+		}
+
+		const SocketAddress& serverAddress() const
+		{
+			return _serverAddress;
+		}
+
+		const HTTPServerParams& serverParams() const
+		{
+			return *_pParams;
+		}
+
+		HTTPServerResponse& response() const
+		{
+			return _response;
+		}
+
+	private:
+		BufferedServerResponse& _response;
+		SocketAddress           _clientAddress;
+		SocketAddress           _serverAddress;
+		HTTPServerParams::Ptr   _pParams;
+		std::string             _body;
+		std::istream*           _pStream;
+	};
+}
+
+
+class HTTPReactorServerConnection::PendingRequest
+	/// A request whose header has been parsed, but
+	/// whose body has not been received completely yet.
+{
+public:
+	enum BodyMode
+	{
+		BODY_NONE,
+		BODY_LENGTH,
+		BODY_CHUNKED
+	};
+
+	PendingRequest(const StreamSocket& socket, HTTPServerParams* pParams):
+		request(response, socket, pParams),
+		headerLength(0),
+		bodyMode(BODY_NONE),
+		contentLength(0),
+		bodyPos(0)
+	{
+	}
+
+	BufferedServerResponse response;
+	BufferedServerRequest  request;
+	std::string::size_type headerLength;
+	BodyMode               bodyMode;
+	std::string::size_type contentLength;
+	std::string::size_type bodyPos;
+		/// Position of the next chunk to decode, relative
+		/// to the start of the request.
+	std::string            body;
+};
+
+
+class HTTPReactorServerConnection::OutputFile
+	/// A file to be sent once the output buffer has
+	/// been written up to the given position.
+{
+public:
+	OutputFile(std::string::size_type pos, int fileDescriptor, Poco::UInt64 fileOffset, Poco::UInt64 fileLength):
+		position(pos),
+		fd(fileDescriptor),
+		offset(fileOffset),
+		length(fileLength)
+	{
+	}
+
+	~OutputFile()
+	{
+#if defined(POCO_OS_FAMILY_UNIX)
+		::close(fd);
+#endif
+	}
+
+	std::string::size_type position;
+	int                    fd;
+	Poco::UInt64           offset;
+	Poco::UInt64           length;
+};
+
+
+HTTPReactorServerConnection::HTTPReactorServerConnection(const StreamSocket& socket, SocketReactor& reactor, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory):
+	_socket(socket),
+	_reactor(reactor),
+	_pParams(pParams),
+	_pFactory(pFactory),
+	_inPos(0),
+	_scanPos(0),
+	_pPending(0),
+	_outPos(0),
+	_requests(0),
+	_continueSent(false),
+	_writable(false),
+	_keepAlive(true),
+	_readSuspended(false)
+{
+	poco_check_ptr (pFactory);
+
+	_socket.setBlocking(false);
+	_reactor.addEventHandler(_socket, Observer<HTTPReactorServerConnection, ReadableNotification>(*this, &HTTPReactorServerConnection::onReadable));
+	_reactor.addEventHandler(_socket, Observer<HTTPReactorServerConnection, TimeoutNotification>(*this, &HTTPReactorServerConnection::onTimeout));
+	_reactor.addEventHandler(_socket, Observer<HTTPReactorServerConnection, ShutdownNotification>(*this, &HTTPReactorServerConnection::onShutdown));
+}
+
+
+HTTPReactorServerConnection::~HTTPReactorServerConnection()
+{
+	delete _pPending;
+	for (std::deque<OutputFile*>::iterator it = _outFiles.begin(); it != _outFiles.end(); ++it)
+	{
+		delete *it;
+	}
+	try
+	{
+		_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, ReadableNotification>(*this, &HTTPReactorServerConnection::onReadable));
+		_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, WritableNotification>(*this, &HTTPReactorServerConnection::onWritable));
+		_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, TimeoutNotification>(*this, &HTTPReactorServerConnection::onTimeout));
+		_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, ShutdownNotification>(*this, &HTTPReactorServerConnection::onShutdown));
+		_socket.close();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void HTTPReactorServerConnection::onReadable(ReadableNotification* pNf)
+{
+	pNf->release();
+	try
+	{
+		// No more data is read than the pending request may
+		// still need, so that a client cannot make us buffer
+		// an arbitrary amount of data. Once the connection is
+		// going to be closed, any further data is discarded.
+		char buffer[8192];
+		std::string::size_type limit = receiveLimit();
+		bool receiving = _pPending || _inPos < _inBuffer.size();
+		int n;
+		do
+		{
+			n = _socket.receiveBytes(buffer, sizeof(buffer));
+			if (n > 0 && _keepAlive) _inBuffer.append(buffer, n);
+		}
+		while (n > 0 && _keepAlive && _inBuffer.size() - _inPos <= limit);
+		_lastActivity.update();
+		if (!receiving) _requestStart = _lastActivity;
+		if (n == 0)
+		{
+			// The peer has shut down its end of the connection. Answer
+			// all outstanding requests, then close the connection.
+			_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, ReadableNotification>(*this, &HTTPReactorServerConnection::onReadable));
+			processRequests();
+			_keepAlive = false;
+		}
+		else
+		{
+			processRequests();
+			if (_keepAlive && _inBuffer.size() - _inPos > receiveLimit())
+			{
+				// Complete requests are waiting for the output buffer
+				// to drain. Stop reading until they have been handled.
+				_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, ReadableNotification>(*this, &HTTPReactorServerConnection::onReadable));
+				_readSuspended = true;
+			}
+		}
+		flush();
+	}
+	catch (Poco::Exception&)
+	{
+		close();
+		return;
+	}
+	if (!_keepAlive && _outBuffer.empty() && _outFiles.empty()) close();
+}
+
+
+void HTTPReactorServerConnection::onWritable(WritableNotification* pNf)
+{
+	pNf->release();
+	try
+	{
+		flush();
+		if (_outBuffer.empty() && _outFiles.empty() && _keepAlive)
+		{
+			processRequests();
+			flush();
+		}
+		if (_readSuspended && _keepAlive && _inBuffer.size() - _inPos <= receiveLimit())
+		{
+			_reactor.addEventHandler(_socket, Observer<HTTPReactorServerConnection, ReadableNotification>(*this, &HTTPReactorServerConnection::onReadable));
+			_readSuspended = false;
+		}
+	}
+	catch (Poco::Exception&)
+	{
+		close();
+		return;
+	}
+	if (!_keepAlive && _outBuffer.empty() && _outFiles.empty()) close();
+}
+
+
+void HTTPReactorServerConnection::onTimeout(TimeoutNotification* pNf)
+{
+	pNf->release();
+	Poco::Timespan::TimeDiff timeout = _pParams->getTimeout().totalMicroseconds();
+	bool expired;
+	if (!_outBuffer.empty() || !_outFiles.empty())
+		expired = _lastSend.isElapsed(timeout);
+	else if (_pPending || _inPos < _inBuffer.size())
+		expired = _requestStart.isElapsed(timeout);
+	else if (_requests > 0)
+		expired = _lastActivity.isElapsed(_pParams->getKeepAliveTimeout().totalMicroseconds());
+	else
+		expired = _lastActivity.isElapsed(timeout);
+	if (expired) close();
+}
+
+
+void HTTPReactorServerConnection::onShutdown(ShutdownNotification* pNf)
+{
+	pNf->release();
+	close();
+}
+
+
+void HTTPReactorServerConnection::processRequests()
+{
+	// Stop taking new requests while there is too much
+	// unsent output, to limit memory usage for clients
+	// pipelining requests without reading the responses.
+	while (_keepAlive && _outBuffer.size() - _outPos < MAX_HEADER_LENGTH && _outFiles.empty())
+	{
+		if (!processRequest()) break;
+	}
+	compact();
+}
+
+
+bool HTTPReactorServerConnection::processRequest()
+{
+	if (!_pPending && !readHeader()) return false;
+
+	std::string::size_type end = 0;
+	if (!readBody(end))
+	{
+		if (_keepAlive && _pPending->request.wantsContinue() && !_continueSent)
+		{
+			_outBuffer.append(_pPending->request.getVersion());
+			_outBuffer.append(" 100 Continue\r\n\r\n");
+			_continueSent = true;
+		}
+		return false;
+	}
+
+	std::auto_ptr<PendingRequest> pPending(_pPending);
+	_pPending = 0;
+	_inPos += end;
+	_scanPos = 0;
+	_continueSent = false;
+	_requestStart.update();
+
+	BufferedServerRequest& request = pPending->request;
+	BufferedServerResponse& response = pPending->response;
+	request.setBody(pPending->body);
+
+	++_requests;
+	int maxRequests = _pParams->getMaxKeepAliveRequests();
+	bool canKeepAlive = maxRequests <= 0 || _requests < maxRequests;
+
+	std::string server = _pParams->getSoftwareVersion();
+	Poco::Timestamp now;
+	response.setDate(now);
+	response.setVersion(request.getVersion());
+	response.setKeepAlive(_pParams->getKeepAlive() && request.getKeepAlive() && canKeepAlive);
+	if (!server.empty())
+		response.set("Server", server);
+	try
+	{
+		std::auto_ptr<HTTPRequestHandler> pHandler(_pFactory->createRequestHandler(request));
+		if (pHandler.get())
+		{
+			pHandler->handleRequest(request, response);
+			_keepAlive = _pParams->getKeepAlive() && response.getKeepAlive() && canKeepAlive;
+			response.writeTo(_outBuffer);
+#if defined(POCO_OS_FAMILY_UNIX)
+			Poco::UInt64 offset = 0;
+			Poco::UInt64 length = 0;
+			int fd = response.releaseFile(offset, length);
+			if (fd >= 0)
+			{
+				std::auto_ptr<OutputFile> pFile(new OutputFile(_outBuffer.size(), fd, offset, length));
+				_outFiles.push_back(pFile.get());
+				pFile.release();
+			}
+#endif
+		}
+		else sendErrorResponse(HTTPResponse::HTTP_NOT_IMPLEMENTED);
+	}
+	// Nothing has been written to the socket yet, so
+	// the client always gets a proper error response.
+	catch (Poco::Exception& exc)
+	{
+		sendErrorResponse(HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+		Poco::ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		sendErrorResponse(HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+		Poco::ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		sendErrorResponse(HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+		Poco::ErrorHandler::handle();
+	}
+	return true;
+}
+
+
+bool HTTPReactorServerConnection::readHeader()
+{
+	const char* begin = _inBuffer.data() + _inPos;
+	const char* end = _inBuffer.data() + _inBuffer.size();
+	for (;;)
+	{
+		// Look for the empty line terminating the header, continuing
+		// where the previous search has stopped. _scanPos is relative
+		// to the start of the request.
+		const char* eol = static_cast<const char*>(std::memchr(begin + _scanPos, '\n', end - begin - _scanPos));
+		const char* headerEnd = 0;
+		while (eol && !headerEnd)
+		{
+			const char* p = eol + 1;
+			if (p != end && *p == '\r') ++p;
+			if (p == end) break;
+			if (*p == '\n')
+				headerEnd = p + 1;
+			else
+				eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		}
+		if (!headerEnd)
+		{
+			_scanPos = eol ? eol - begin : end - begin;
+			if (end - begin > MAX_HEADER_LENGTH)
+				sendErrorResponse(HTTPResponse::HTTP_BAD_REQUEST);
+			return false;
+		}
+		_scanPos = headerEnd - begin;
+
+		std::auto_ptr<PendingRequest> pPending(new PendingRequest(_socket, _pParams));
+		HTTPServerRequest& request = pPending->request;
+		try
+		{
+			pPending->headerLength = request.read(begin, headerEnd);
+			if (pPending->headerLength == 0) continue;
+
+			if (request.getChunkedTransferEncoding())
+			{
+				pPending->bodyMode = PendingRequest::BODY_CHUNKED;
+			}
+			else if (request.hasContentLength())
+			{
+				Poco::UInt64 length = static_cast<Poco::UInt64>(request.getContentLength64());
+				if (length > MAX_BODY_LENGTH)
+				{
+					sendErrorResponse(HTTPResponse::HTTP_REQUESTENTITYTOOLARGE);
+					return false;
+				}
+				pPending->bodyMode = PendingRequest::BODY_LENGTH;
+				pPending->contentLength = static_cast<std::string::size_type>(length);
+			}
+		}
+		catch (MessageException&)
+		{
+			sendErrorResponse(HTTPResponse::HTTP_BAD_REQUEST);
+			return false;
+		}
+		catch (SyntaxException&)
+		{
+			sendErrorResponse(HTTPResponse::HTTP_BAD_REQUEST);
+			return false;
+		}
+		pPending->bodyPos = pPending->headerLength;
+		_pPending = pPending.release();
+		return true;
+	}
+}
+
+
+bool HTTPReactorServerConnection::readBody(std::string::size_type& end)
+{
+	std::string::size_type available = _inBuffer.size() - _inPos;
+	std::string::size_type headerLength = _pPending->headerLength;
+	switch (_pPending->bodyMode)
+	{
+	case PendingRequest::BODY_NONE:
+		end = headerLength;
+		return true;
+
+	case PendingRequest::BODY_LENGTH:
+		if (available - headerLength < _pPending->contentLength) return false;
+		_pPending->body.assign(_inBuffer, _inPos + headerLength, _pPending->contentLength);
+		end = headerLength + _pPending->contentLength;
+		return true;
+
+	case PendingRequest::BODY_CHUNKED:
+		{
+			std::string::size_type pos = _inPos + _pPending->bodyPos;
+			bool complete = false;
+			try
+			{
+				complete = HTTPChunkedDecoder::decode(_inBuffer, pos, _pPending->body);
+			}
+			catch (MessageException&)
+			{
+				sendErrorResponse(HTTPResponse::HTTP_BAD_REQUEST);
+				return false;
+			}
+			_pPending->bodyPos = pos - _inPos;
+			if (_pPending->body.size() + (_inBuffer.size() - pos) > MAX_BODY_LENGTH)
+			{
+				sendErrorResponse(HTTPResponse::HTTP_REQUESTENTITYTOOLARGE);
+				return false;
+			}
+			if (complete) end = _pPending->bodyPos;
+			return complete;
+		}
+	}
+	return false;
+}
+
+
+std::string::size_type HTTPReactorServerConnection::receiveLimit() const
+{
+	std::string::size_type limit = MAX_HEADER_LENGTH;
+	if (_pPending)
+	{
+		switch (_pPending->bodyMode)
+		{
+		case PendingRequest::BODY_LENGTH:
+			limit += _pPending->headerLength + _pPending->contentLength;
+			break;
+		case PendingRequest::BODY_CHUNKED:
+			if (_pPending->body.size() < MAX_BODY_LENGTH)
+				limit += _pPending->bodyPos + MAX_BODY_LENGTH - _pPending->body.size();
+			break;
+		default:
+			break;
+		}
+	}
+	return limit;
+}
+
+
+void HTTPReactorServerConnection::compact()
+{
+	// Consumed data is only discarded once it makes up at least
+	// half of the buffer, so that the cost of moving the remaining
+	// data stays proportional to the amount of data received.
+	if (_inPos == _inBuffer.size())
+	{
+		_inBuffer.clear();
+		_inPos = 0;
+	}
+	else if (_inPos > 0 && _inPos >= _inBuffer.size()/2)
+	{
+		_inBuffer.erase(0, _inPos);
+		_inPos = 0;
+	}
+}
+
+
+void HTTPReactorServerConnection::sendErrorResponse(HTTPResponse::HTTPStatus status)
+{
+	HTTPResponse response;
+	response.setVersion(HTTPMessage::HTTP_1_1);
+	response.setStatusAndReason(status);
+	response.setKeepAlive(false);
+	std::ostringstream hstr;
+	response.write(hstr);
+	_outBuffer.append(hstr.str());
+	_keepAlive = false;
+}
+
+
+void HTTPReactorServerConnection::flush()
+{
+	for (;;)
+	{
+		std::string::size_type end = _outFiles.empty() ? _outBuffer.size() : _outFiles.front()->position;
+		while (_outPos < end)
+		{
+			int n = 0;
+			try
+			{
+				n = _socket.sendBytes(_outBuffer.data() + _outPos, static_cast<int>(end - _outPos));
+			}
+			catch (Poco::IOException& exc)
+			{
+				if (exc.code() != POCO_EWOULDBLOCK && exc.code() != POCO_EAGAIN) throw;
+			}
+			if (n <= 0) break;
+			_outPos += n;
+			_lastActivity.update();
+			_lastSend = _lastActivity;
+		}
+		if (_outPos < end || _outFiles.empty() || !sendFile(*_outFiles.front())) break;
+		delete _outFiles.front();
+		_outFiles.pop_front();
+	}
+	if (_outPos == _outBuffer.size() && _outFiles.empty())
+	{
+		_outBuffer.clear();
+		_outPos = 0;
+		if (_writable)
+		{
+			_reactor.removeEventHandler(_socket, Observer<HTTPReactorServerConnection, WritableNotification>(*this, &HTTPReactorServerConnection::onWritable));
+			_writable = false;
+		}
+	}
+	else if (!_writable)
+	{
+		_reactor.addEventHandler(_socket, Observer<HTTPReactorServerConnection, WritableNotification>(*this, &HTTPReactorServerConnection::onWritable));
+		_writable = true;
+		_lastSend.update();
+	}
+}
+
+
+bool HTTPReactorServerConnection::sendFile(OutputFile& file)
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	while (file.length > 0)
+	{
+		Poco::UInt64 n = _socket.sendFile(file.fd, file.offset, file.length);
+		if (n == 0)
+		{
+			// Either the socket is not writable, or the
+			// file has been truncated in the meantime.
+			struct stat st;
+			if (::fstat(file.fd, &st) == 0 && S_ISREG(st.st_mode) && static_cast<Poco::UInt64>(st.st_size) <= file.offset)
+				throw Poco::ReadFileException("Unexpected end of file");
+			return false;
+		}
+		file.offset += n;
+		file.length -= n;
+		_lastActivity.update();
+		_lastSend = _lastActivity;
+	}
+#endif
+	return true;
+}
+
+
+void HTTPReactorServerConnection::close()
+{
+	delete this;
+}
+
+
+} } // namespace Poco::Net
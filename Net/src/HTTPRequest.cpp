@@ -37,9 +37,11 @@
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Net/NameValueCollection.h"
+#include "Poco/Net/MessageHeaderParser.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Ascii.h"
 #include "Poco/String.h"
+#include <cstring>
 
 
 using Poco::NumberFormatter;
@@ -250,6 +252,38 @@ void HTTPRequest::read(std::istream& istr)
 }
 
 
+std::size_t HTTPRequest::read(const char* begin, const char* end)
+{
+	const char* p = begin;
+	while (p != end && Poco::Ascii::isSpace(*p)) ++p;
+	const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+	if (!eol) return 0;
+	const char* method = p;
+	while (p != eol && !Poco::Ascii::isSpace(*p)) ++p;
+	if (p == eol || p - method > MAX_METHOD_LENGTH) throw MessageException("HTTP request method invalid or too long");
+	const char* methodEnd = p;
+	while (p != eol && Poco::Ascii::isSpace(*p)) ++p;
+	const char* uri = p;
+	while (p != eol && !Poco::Ascii::isSpace(*p)) ++p;
+	if (p == eol || p == uri || p - uri > MAX_URI_LENGTH) throw MessageException("HTTP request URI invalid or too long");
+	const char* uriEnd = p;
+	while (p != eol && Poco::Ascii::isSpace(*p)) ++p;
+	const char* version = p;
+	while (p != eol && !Poco::Ascii::isSpace(*p)) ++p;
+	if (p == version || p - version > MAX_VERSION_LENGTH) throw MessageException("Invalid HTTP version string");
+
+	MessageHeaderParser parser;
+	parser.setFieldLimit(getFieldLimit());
+	std::size_t n = parser.parse(eol + 1, end);
+	if (n == 0) return 0;
+	parser.copyTo(*this);
+	setMethod(std::string(method, methodEnd));
+	setURI(std::string(uri, uriEnd));
+	setVersion(std::string(version, p));
+	return (eol + 1 - begin) + n;
+}
+
+
 void HTTPRequest::getCredentials(const std::string& header, std::string& scheme, std::string& authInfo) const
 {
 	scheme.clear();
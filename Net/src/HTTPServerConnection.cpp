@@ -73,6 +73,10 @@ void HTTPServerConnection::run()
 {
 	std::string server = _pParams->getSoftwareVersion();
 	HTTPServerSession session(socket(), _pParams);
+	// The request and response objects are created once and
+	// recycled for all requests received over the connection.
+	HTTPServerResponseImpl response(session);
+	std::auto_ptr<HTTPServerRequestImpl> pRequest;
 	while (!_stopped && session.hasMoreRequests())
 	{
 		try
@@ -80,9 +84,12 @@ void HTTPServerConnection::run()
 			Poco::FastMutex::ScopedLock lock(_mutex);
 			if (!_stopped)
 			{
-				HTTPServerResponseImpl response(session);
-				HTTPServerRequestImpl request(response, session, _pParams);
-			
+				if (pRequest.get())
+					pRequest->recycle();
+				else
+					pRequest.reset(new HTTPServerRequestImpl(response, session, _pParams));
+				HTTPServerRequestImpl& request = *pRequest;
+
 				Poco::Timestamp now;
 				response.setDate(now);
 				response.setVersion(request.getVersion());
@@ -116,6 +123,7 @@ void HTTPServerConnection::run()
 					}
 					throw;
 				}
+				response.recycle();
 			}
 		}
 		catch (NoMessageException&)
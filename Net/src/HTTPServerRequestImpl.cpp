@@ -63,25 +63,11 @@ HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, H
 {
 	response.attachRequest(this);
 
-	HTTPHeaderInputStream hs(session);
-	read(hs);
+	receive();
 	
 	// Now that we know socket is still connected, obtain addresses
 	_clientAddress = session.clientAddress();
 	_serverAddress = session.serverAddress();
-	
-	if (getChunkedTransferEncoding())
-		_pStream = new HTTPChunkedInputStream(session);
-	else if (hasContentLength())
-#if defined(POCO_HAVE_INT64)
-		_pStream = new HTTPFixedLengthInputStream(session, getContentLength64());
-#else
-		_pStream = new HTTPFixedLengthInputStream(session, getContentLength());
-#endif
-	else if (getMethod() == HTTPRequest::HTTP_GET || getMethod() == HTTPRequest::HTTP_HEAD)
-		_pStream = new HTTPFixedLengthInputStream(session, 0);
-	else
-		_pStream = new HTTPInputStream(session);
 }
 
 
@@ -91,6 +77,15 @@ HTTPServerRequestImpl::~HTTPServerRequestImpl()
 }
 
 
+void HTTPServerRequestImpl::recycle()
+{
+	delete _pStream;
+	_pStream = 0;
+	clear();
+	receive();
+}
+
+
 StreamSocket& HTTPServerRequestImpl::socket()
 {
 	return _session.socket();
@@ -103,6 +98,39 @@ StreamSocket HTTPServerRequestImpl::detachSocket()
 }
 
 
+void HTTPServerRequestImpl::receive()
+{
+	// If the complete request header is already in the session
+	// buffer (which is the common case), parse it directly from
+	// there. Otherwise, fall back to reading from a stream.
+	int length = 0;
+	const char* pBuffer = _session.buffer(length);
+	std::size_t n = length > 0 ? read(pBuffer, pBuffer + length) : 0;
+	if (n > 0)
+	{
+		_session.skip(static_cast<int>(n));
+	}
+	else
+	{
+		HTTPHeaderInputStream hs(_session);
+		read(hs);
+	}
+	
+	if (getChunkedTransferEncoding())
+		_pStream = new HTTPChunkedInputStream(_session);
+	else if (hasContentLength())
+#if defined(POCO_HAVE_INT64)
+		_pStream = new HTTPFixedLengthInputStream(_session, getContentLength64());
+#else
+		_pStream = new HTTPFixedLengthInputStream(_session, getContentLength());
+#endif
+	else if (getMethod() == HTTPRequest::HTTP_GET || getMethod() == HTTPRequest::HTTP_HEAD)
+		_pStream = new HTTPFixedLengthInputStream(_session, 0);
+	else
+		_pStream = new HTTPInputStream(_session);
+}
+
+
 bool HTTPServerRequestImpl::expectContinue() const
 {
 	const std::string& expect = get(EXPECT, EMPTY);
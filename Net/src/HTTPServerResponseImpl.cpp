@@ -50,6 +50,15 @@
 #include "Poco/FileStream.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
+#include "Poco/Buffer.h"
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 
 using Poco::File;
@@ -57,6 +66,8 @@ using Poco::Timestamp;
 using Poco::NumberFormatter;
 using Poco::StreamCopier;
 using Poco::OpenFileException;
+using Poco::ReadFileException;
+using Poco::RangeException;
 using Poco::DateTimeFormatter;
 using Poco::DateTimeFormat;
 
@@ -86,6 +97,16 @@ void HTTPServerResponseImpl::sendContinue()
 }
 
 
+void HTTPServerResponseImpl::recycle()
+{
+	delete _pStream;
+	_pStream = 0;
+	clear();
+	setVersion(HTTP_1_0);
+	setStatusAndReason(HTTP_OK);
+}
+
+
 std::ostream& HTTPServerResponseImpl::send()
 {
 	poco_assert (!_pStream);
@@ -131,9 +152,80 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 {
 	poco_assert (!_pStream);
 
+	File f(path);
+	sendFile(path, 0, f.getSize(), mediaType);
+}
+
+
+void HTTPServerResponseImpl::sendFile(const std::string& path, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType)
+{
+	poco_assert (!_pStream);
+
 	File f(path);
 	Timestamp dateTime    = f.getLastModified();
-	File::FileSize length = f.getSize();
+	File::FileSize size   = f.getSize();
+	if (offset > size || length > size - offset) throw RangeException("File range exceeds file size", path);
+	prepareFile(dateTime, length, mediaType);
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw OpenFileException(path);
+	try
+	{
+		sendFileContent(fd, offset, length);
+	}
+	catch (...)
+	{
+		::close(fd);
+		throw;
+	}
+	::close(fd);
+#else
+	Poco::FileInputStream istr(path);
+	if (istr.good())
+	{
+		_pStream = new HTTPHeaderOutputStream(_session);
+		write(*_pStream);
+		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && length > 0)
+		{
+			istr.seekg(static_cast<std::streamoff>(offset));
+			Poco::Buffer<char> buffer(8192);
+			while (length > 0 && istr.good())
+			{
+				std::streamsize n = static_cast<std::streamsize>(length < buffer.size() ? length : buffer.size());
+				istr.read(buffer.begin(), n);
+				n = istr.gcount();
+				_pStream->write(buffer.begin(), n);
+				length -= n;
+			}
+			if (length > 0) throw ReadFileException(path);
+		}
+	}
+	else throw OpenFileException(path);
+#endif
+}
+
+
+#if defined(POCO_OS_FAMILY_UNIX)
+void HTTPServerResponseImpl::sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 length, const std::string& mediaType)
+{
+	poco_assert (!_pStream);
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0) throw OpenFileException("Invalid file descriptor");
+	if (S_ISREG(st.st_mode))
+	{
+		Poco::UInt64 size = static_cast<Poco::UInt64>(st.st_size);
+		if (offset > size || length > size - offset) throw RangeException("File range exceeds file size");
+	}
+	prepareFile(Timestamp::fromEpochTime(st.st_mtime), length, mediaType);
+	sendFileContent(fd, offset, length);
+}
+#endif
+
+
+void HTTPServerResponseImpl::prepareFile(const Timestamp& dateTime, Poco::UInt64 length, const std::string& mediaType)
+{
 	set("Last-Modified", DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT));
 #if defined(POCO_HAVE_INT64)	
 	setContentLength64(length);
@@ -142,19 +234,49 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 #endif
 	setContentType(mediaType);
 	setChunkedTransferEncoding(false);
+}
 
-	Poco::FileInputStream istr(path);
-	if (istr.good())
+
+#if defined(POCO_OS_FAMILY_UNIX)
+void HTTPServerResponseImpl::sendFileContent(int fd, Poco::UInt64 offset, Poco::UInt64 length)
+{
+	_pStream = new HTTPHeaderOutputStream(_session);
+	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && length > 0)
 	{
-		_pStream = new HTTPHeaderOutputStream(_session);
-		write(*_pStream);
-		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+		StreamSocket& socket = _session.socket();
+#if defined(TCP_CORK)
+		// Hold back the header, so that it goes out
+		// together with the beginning of the file.
+		socket.setOption(IPPROTO_TCP, TCP_CORK, 1);
+#endif
+		Poco::UInt64 sent = 0;
+		try
+		{
+			write(*_pStream);
+			_pStream->flush();
+			sent = socket.sendFile(fd, offset, length);
+		}
+		catch (...)
 		{
-			StreamCopier::copyStream(istr, *_pStream);
+#if defined(TCP_CORK)
+			try
+			{
+				socket.setOption(IPPROTO_TCP, TCP_CORK, 0);
+			}
+			catch (...)
+			{
+			}
+#endif
+			throw;
 		}
+#if defined(TCP_CORK)
+		socket.setOption(IPPROTO_TCP, TCP_CORK, 0);
+#endif
+		if (sent < length) throw ReadFileException("Unexpected end of file");
 	}
-	else throw OpenFileException(path);
+	else write(*_pStream);
 }
+#endif
 
 
 void HTTPServerResponseImpl::sendBuffer(const void* pBuffer, std::size_t length)
@@ -160,6 +160,20 @@ int HTTPSession::write(const char* buffer, std::streamsize length)
 }
 
 
+int HTTPSession::write(const SocketBuf* buffers, int count)
+{
+	try
+	{
+		return _socket.sendBytes(buffers, count);
+	}
+	catch (Poco::Exception& exc)
+	{
+		setException(exc);
+		throw;
+	}
+}
+
+
 int HTTPSession::receive(char* buffer, int length)
 {
 	try
@@ -174,6 +188,24 @@ int HTTPSession::receive(char* buffer, int length)
 }
 
 
+const char* HTTPSession::buffer(int& length)
+{
+	if (_pCurrent == _pEnd)
+		refill();
+
+	length = static_cast<int>(_pEnd - _pCurrent);
+	return _pCurrent;
+}
+
+
+void HTTPSession::skip(int length)
+{
+	poco_assert (length >= 0 && length <= _pEnd - _pCurrent);
+
+	_pCurrent += length;
+}
+
+
 void HTTPSession::refill()
 {
 	if (!_pBuffer)
@@ -0,0 +1,233 @@
+//
+// MessageHeaderParser.cpp
+//
+// $Id: //poco/1.4/Net/src/MessageHeaderParser.cpp#1 $
+//
+// Library: Net
+// Package: Messages
+// Module:  MessageHeaderParser
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/MessageHeaderParser.h"
+#include "Poco/Net/MessageHeader.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Ascii.h"
+#include <cstring>
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	const char* contentEnd(const char* p, const char* eol)
+		/// Returns the end of the content of the line starting at p
+		/// and terminated by the linefeed at eol, excluding the
+		/// carriage return, or null if a carriage return is found
+		/// that is not immediately followed by a linefeed.
+	{
+		const char* cr = static_cast<const char*>(std::memchr(p, '\r', eol - p));
+		if (cr && cr + 1 != eol) return 0;
+		return cr ? cr : eol;
+	}
+}
+
+
+MessageHeaderParser::MessageHeaderParser():
+	_count(0),
+	_fieldLimit(DFL_FIELD_LIMIT)
+{
+}
+
+
+MessageHeaderParser::~MessageHeaderParser()
+{
+}
+
+
+std::size_t MessageHeaderParser::parse(const char* begin, const char* end)
+{
+	reset();
+	const char* p = begin;
+	int fields = 0;
+	while (p != end && *p != '\r' && *p != '\n')
+	{
+		if (_fieldLimit > 0 && fields == _fieldLimit)
+			throw MessageException("Too many header fields");
+
+		const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		const char* lineEnd = eol ? eol : end;
+		const char* colon = static_cast<const char*>(std::memchr(p, ':', lineEnd - p));
+		if (!colon || colon - p > MAX_NAME_LENGTH)
+		{
+			if (lineEnd - p > MAX_NAME_LENGTH)
+				throw MessageException("Field name too long/no colon found");
+			if (!eol) break;
+			p = eol + 1; // ignore invalid header lines
+			continue;
+		}
+		if (!eol) break;
+
+		Field field;
+		field.name       = p;
+		field.nameLength = colon - p;
+		field.folded     = false;
+		p = colon + 1;
+		while (p != eol && *p != '\r' && Poco::Ascii::isSpace(*p)) ++p;
+		field.value = p;
+		const char* valueEnd = contentEnd(p, eol);
+		if (!valueEnd || valueEnd - p > MAX_VALUE_LENGTH)
+			throw MessageException("Field value too long/no CRLF found");
+		std::size_t length = valueEnd - p;
+		p = eol + 1;
+		while (p != end && (*p == ' ' || *p == '\t')) // folding
+		{
+			eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (!eol)
+			{
+				p = end;
+				break;
+			}
+			const char* foldEnd = contentEnd(p, eol);
+			if (!foldEnd || length + (foldEnd - p) > MAX_VALUE_LENGTH)
+				throw MessageException("Folded field value too long/no CRLF found");
+			length  += foldEnd - p;
+			valueEnd = foldEnd;
+			field.folded = true;
+			p = eol + 1;
+		}
+		if (p == end) break;
+		while (valueEnd != field.value && Poco::Ascii::isSpace(valueEnd[-1])) --valueEnd;
+		field.valueLength = valueEnd - field.value;
+		append(field);
+		++fields;
+	}
+	if (p != end)
+	{
+		// empty line terminating the header
+		const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		if (eol) return eol + 1 - begin;
+	}
+	reset();
+	return 0;
+}
+
+
+void MessageHeaderParser::reset()
+{
+	_count = 0;
+	_overflow.clear();
+}
+
+
+const MessageHeaderParser::Field* MessageHeaderParser::find(const std::string& name) const
+{
+	for (std::size_t i = 0; i < _count; ++i)
+	{
+		const Field& field = (*this)[i];
+		if (field.nameLength == name.size())
+		{
+			std::size_t k = 0;
+			while (k < field.nameLength && Poco::Ascii::toLower(field.name[k]) == Poco::Ascii::toLower(name[k])) ++k;
+			if (k == field.nameLength) return &field;
+		}
+	}
+	return 0;
+}
+
+
+std::string MessageHeaderParser::name(std::size_t index) const
+{
+	const Field& field = (*this)[index];
+	return std::string(field.name, field.nameLength);
+}
+
+
+std::string MessageHeaderParser::value(std::size_t index) const
+{
+	std::string result;
+	assignValue((*this)[index], result);
+	return result;
+}
+
+
+void MessageHeaderParser::copyTo(MessageHeader& header) const
+{
+	// The name and value strings are reused for all fields, so
+	// that only the MessageHeader allocates storage for them.
+	std::string name;
+	std::string value;
+	for (std::size_t i = 0; i < _count; ++i)
+	{
+		const Field& field = (*this)[i];
+		name.assign(field.name, field.nameLength);
+		assignValue(field, value);
+		header.add(name, value);
+	}
+}
+
+
+void MessageHeaderParser::setFieldLimit(int limit)
+{
+	poco_assert (limit >= 0);
+	
+	_fieldLimit = limit;
+}
+
+
+void MessageHeaderParser::assignValue(const Field& field, std::string& value)
+{
+	if (!field.folded)
+	{
+		value.assign(field.value, field.valueLength);
+		return;
+	}
+
+	value.clear();
+	value.reserve(field.valueLength);
+	const char* end = field.value + field.valueLength;
+	for (const char* p = field.value; p != end; ++p)
+	{
+		if (*p != '\r' && *p != '\n') value += *p;
+	}
+}
+
+
+void MessageHeaderParser::append(const Field& field)
+{
+	if (_count < INLINE_FIELDS)
+		_fields[_count] = field;
+	else
+		_overflow.push_back(field);
+	++_count;
+}
+
+
+} } // namespace Poco::Net
@@ -0,0 +1,523 @@
+//
+// PerMessageDeflate.cpp
+//
+// $Id: //poco/1.4/Net/src/PerMessageDeflate.cpp#1 $
+//
+// Library: Net
+// Package: WebSocket
+// Module:  PerMessageDeflate
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/PerMessageDeflate.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
+#include "Poco/Format.h"
+#include <set>
+#include <limits>
+#include <cstring>
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	typedef std::vector<std::pair<std::string, std::string> > Params;
+
+	bool parseExtension(const std::string& extension, std::string& name, Params& params)
+		/// Splits an extension into its name and parameters.
+		/// Returns false if a parameter is specified more than once.
+	{
+		Poco::StringTokenizer tok(extension, ";", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+		if (tok.count() == 0) return false;
+		name = Poco::toLower(tok[0]);
+		std::set<std::string> seen;
+		for (std::size_t i = 1; i < tok.count(); ++i)
+		{
+			std::string param;
+			std::string value;
+			std::string::size_type pos = tok[i].find('=');
+			if (pos != std::string::npos)
+			{
+				param = Poco::trim(tok[i].substr(0, pos));
+				value = Poco::trim(tok[i].substr(pos + 1));
+				if (value.size() >= 2 && value[0] == '"' && value[value.size() - 1] == '"')
+					value = value.substr(1, value.size() - 2);
+			}
+			else param = tok[i];
+			Poco::toLowerInPlace(param);
+			if (!seen.insert(param).second) return false;
+			params.push_back(Params::value_type(param, value));
+		}
+		return true;
+	}
+
+	bool parseWindowBits(const std::string& value, int& bits)
+	{
+		unsigned v;
+		if (value.empty() || value.size() > 2 || !Poco::NumberParser::tryParseUnsigned(value, v)) return false;
+		if (v < 8 || v > PerMessageDeflate::MAX_WINDOW_BITS) return false;
+		bits = static_cast<int>(v);
+		return true;
+	}
+
+	const char DEFLATE_TAIL[] = { 0x00, 0x00, '\xff', '\xff' };
+}
+
+
+const std::string PerMessageDeflate::EXTENSION_NAME("permessage-deflate");
+
+
+PerMessageDeflate::PerMessageDeflate():
+	_serverMaxWindowBits(MAX_WINDOW_BITS),
+	_clientMaxWindowBits(MAX_WINDOW_BITS),
+	_serverNoContextTakeover(false),
+	_clientNoContextTakeover(false),
+	_compressionLevel(Z_DEFAULT_COMPRESSION),
+	_server(false),
+	_deflateInit(false),
+	_inflateInit(false)
+{
+}
+
+
+PerMessageDeflate::PerMessageDeflate(const PerMessageDeflate& deflate):
+	_serverMaxWindowBits(deflate._serverMaxWindowBits),
+	_clientMaxWindowBits(deflate._clientMaxWindowBits),
+	_serverNoContextTakeover(deflate._serverNoContextTakeover),
+	_clientNoContextTakeover(deflate._clientNoContextTakeover),
+	_compressionLevel(deflate._compressionLevel),
+	_server(false),
+	_deflateInit(false),
+	_inflateInit(false)
+{
+}
+
+
+PerMessageDeflate::~PerMessageDeflate()
+{
+	cleanup();
+}
+
+
+PerMessageDeflate& PerMessageDeflate::operator = (const PerMessageDeflate& deflate)
+{
+	if (&deflate != this)
+	{
+		cleanup();
+		_serverMaxWindowBits     = deflate._serverMaxWindowBits;
+		_clientMaxWindowBits     = deflate._clientMaxWindowBits;
+		_serverNoContextTakeover = deflate._serverNoContextTakeover;
+		_clientNoContextTakeover = deflate._clientNoContextTakeover;
+		_compressionLevel        = deflate._compressionLevel;
+	}
+	return *this;
+}
+
+
+void PerMessageDeflate::setServerMaxWindowBits(int bits)
+{
+	poco_assert (bits >= MIN_WINDOW_BITS && bits <= MAX_WINDOW_BITS);
+
+	_serverMaxWindowBits = bits;
+}
+
+
+void PerMessageDeflate::setClientMaxWindowBits(int bits)
+{
+	poco_assert (bits >= MIN_WINDOW_BITS && bits <= MAX_WINDOW_BITS);
+
+	_clientMaxWindowBits = bits;
+}
+
+
+void PerMessageDeflate::setServerNoContextTakeover(bool flag)
+{
+	_serverNoContextTakeover = flag;
+}
+
+
+void PerMessageDeflate::setClientNoContextTakeover(bool flag)
+{
+	_clientNoContextTakeover = flag;
+}
+
+
+void PerMessageDeflate::setCompressionLevel(int level)
+{
+	poco_assert (level >= Z_DEFAULT_COMPRESSION && level <= Z_BEST_COMPRESSION);
+
+	_compressionLevel = level;
+}
+
+
+std::string PerMessageDeflate::offer() const
+{
+	std::string result(EXTENSION_NAME);
+	if (_serverNoContextTakeover)
+		result.append("; server_no_context_takeover");
+	if (_clientNoContextTakeover)
+		result.append("; client_no_context_takeover");
+	if (_serverMaxWindowBits < MAX_WINDOW_BITS)
+	{
+		result.append("; server_max_window_bits=");
+		Poco::NumberFormatter::append(result, _serverMaxWindowBits);
+	}
+	// Always announce that the server may limit our window.
+	result.append("; client_max_window_bits");
+	if (_clientMaxWindowBits < MAX_WINDOW_BITS)
+	{
+		result.append("=");
+		Poco::NumberFormatter::append(result, _clientMaxWindowBits);
+	}
+	return result;
+}
+
+
+bool PerMessageDeflate::accept(const std::string& offers, std::string& response)
+{
+	Poco::StringTokenizer extensions(offers, ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+	for (Poco::StringTokenizer::Iterator it = extensions.begin(); it != extensions.end(); ++it)
+	{
+		std::string name;
+		Params params;
+		if (!parseExtension(*it, name, params) || name != EXTENSION_NAME) continue;
+
+		bool serverNoContextTakeover = _serverNoContextTakeover;
+		bool clientNoContextTakeover = _clientNoContextTakeover;
+		int serverBits = _serverMaxWindowBits;
+		bool serverBitsOffered = false;
+		int clientBits = MAX_WINDOW_BITS;
+		bool clientBitsOffered = false;
+		bool valid = true;
+		for (Params::const_iterator itp = params.begin(); valid && itp != params.end(); ++itp)
+		{
+			if (itp->first == "server_no_context_takeover")
+			{
+				valid = itp->second.empty();
+				serverNoContextTakeover = true;
+			}
+			else if (itp->first == "client_no_context_takeover")
+			{
+				valid = itp->second.empty();
+				clientNoContextTakeover = true;
+			}
+			else if (itp->first == "server_max_window_bits")
+			{
+				int bits = 0;
+				// zlib cannot compress with a window of 8 bits.
+				valid = parseWindowBits(itp->second, bits) && bits >= MIN_WINDOW_BITS;
+				if (valid && bits < serverBits) serverBits = bits;
+				serverBitsOffered = true;
+			}
+			else if (itp->first == "client_max_window_bits")
+			{
+				clientBits = _clientMaxWindowBits;
+				if (!itp->second.empty())
+				{
+					int bits = 0;
+					valid = parseWindowBits(itp->second, bits);
+					if (valid && bits < clientBits) clientBits = bits;
+				}
+				clientBitsOffered = true;
+			}
+			else valid = false;
+		}
+		if (!valid) continue;
+
+		response = EXTENSION_NAME;
+		if (serverNoContextTakeover)
+			response.append("; server_no_context_takeover");
+		if (clientNoContextTakeover)
+			response.append("; client_no_context_takeover");
+		if (serverBitsOffered || serverBits < MAX_WINDOW_BITS)
+		{
+			response.append("; server_max_window_bits=");
+			Poco::NumberFormatter::append(response, serverBits);
+		}
+		if (clientBitsOffered && clientBits < MAX_WINDOW_BITS)
+		{
+			response.append("; client_max_window_bits=");
+			Poco::NumberFormatter::append(response, clientBits);
+		}
+		_serverNoContextTakeover = serverNoContextTakeover;
+		_clientNoContextTakeover = clientNoContextTakeover;
+		_serverMaxWindowBits     = serverBits;
+		_clientMaxWindowBits     = clientBits;
+		return true;
+	}
+	return false;
+}
+
+
+void PerMessageDeflate::confirm(const std::string& response)
+{
+	std::string name;
+	Params params;
+	if (!parseExtension(response, name, params) || name != EXTENSION_NAME)
+		throw WebSocketException("Invalid permessage-deflate extension response", response, WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+
+	bool serverNoContextTakeover = false;
+	bool clientNoContextTakeover = _clientNoContextTakeover;
+	// The server may use the full window unless it confirms our limit.
+	int serverBits = MAX_WINDOW_BITS;
+	int clientBits = _clientMaxWindowBits;
+	for (Params::const_iterator it = params.begin(); it != params.end(); ++it)
+	{
+		bool valid = true;
+		if (it->first == "server_no_context_takeover")
+		{
+			valid = it->second.empty();
+			serverNoContextTakeover = true;
+		}
+		else if (it->first == "client_no_context_takeover")
+		{
+			valid = it->second.empty();
+			clientNoContextTakeover = true;
+		}
+		else if (it->first == "server_max_window_bits")
+		{
+			valid = parseWindowBits(it->second, serverBits) && serverBits <= _serverMaxWindowBits;
+		}
+		else if (it->first == "client_max_window_bits")
+		{
+			int bits = 0;
+			// zlib cannot compress with a window of 8 bits.
+			valid = parseWindowBits(it->second, bits) && bits >= MIN_WINDOW_BITS;
+			if (valid && bits < clientBits) clientBits = bits;
+		}
+		else valid = false;
+		if (!valid)
+			throw WebSocketException("Unacceptable permessage-deflate extension parameter", it->first, WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+	}
+	_serverNoContextTakeover = serverNoContextTakeover;
+	_clientNoContextTakeover = clientNoContextTakeover;
+	_serverMaxWindowBits     = serverBits;
+	_clientMaxWindowBits     = clientBits;
+}
+
+
+void PerMessageDeflate::init(bool server)
+{
+	cleanup();
+	_server = server;
+
+	int deflateBits = server ? _serverMaxWindowBits : _clientMaxWindowBits;
+	int inflateBits = server ? _clientMaxWindowBits : _serverMaxWindowBits;
+	// A peer compressing with an 8 bit window produces
+	// a stream that can be decompressed with a 9 bit window.
+	if (inflateBits < MIN_WINDOW_BITS) inflateBits = MIN_WINDOW_BITS;
+
+	std::memset(&_deflateStream, 0, sizeof(_deflateStream));
+	std::memset(&_inflateStream, 0, sizeof(_inflateStream));
+	int rc = deflateInit2(&_deflateStream, _compressionLevel, Z_DEFLATED, -deflateBits, 8, Z_DEFAULT_STRATEGY);
+	if (rc != Z_OK) throw IOException(zError(rc));
+	_deflateInit = true;
+	rc = inflateInit2(&_inflateStream, -inflateBits);
+	if (rc != Z_OK)
+	{
+		cleanup();
+		throw IOException(zError(rc));
+	}
+	_inflateInit = true;
+}
+
+
+void PerMessageDeflate::cleanup()
+{
+	if (_deflateInit)
+	{
+		deflateEnd(&_deflateStream);
+		_deflateInit = false;
+	}
+	if (_inflateInit)
+	{
+		inflateEnd(&_inflateStream);
+		_inflateInit = false;
+	}
+}
+
+
+std::size_t PerMessageDeflate::deflate(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& buffer)
+{
+	poco_assert (_deflateInit);
+
+	_deflateStream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	_deflateStream.avail_in = static_cast<uInt>(length);
+	std::size_t size = 0;
+	for (;;)
+	{
+		if (buffer.capacity() < size + 64)
+		{
+			std::size_t capacity = 2*buffer.capacity();
+			std::size_t needed = size + length/2 + 64;
+			buffer.setCapacity(capacity < needed ? needed : capacity, true);
+		}
+		buffer.resize(buffer.capacity(), true);
+		_deflateStream.next_out  = reinterpret_cast<Bytef*>(buffer.begin() + size);
+		_deflateStream.avail_out = static_cast<uInt>(buffer.size() - size);
+		int rc = ::deflate(&_deflateStream, Z_SYNC_FLUSH);
+		size = buffer.size() - _deflateStream.avail_out;
+		if (rc != Z_OK && rc != Z_BUF_ERROR) throw IOException(zError(rc));
+		// If deflate() leaves output space, the flush is complete.
+		if (_deflateStream.avail_in == 0 && _deflateStream.avail_out > 0) break;
+	}
+	if (fin)
+	{
+		// Remove the empty stored block produced by the
+		// flush (RFC 7692, section 7.2.1). An empty message is
+		// sent as a single empty block (section 7.2.3.6).
+		if (size >= 4 && std::memcmp(buffer.begin() + size - 4, DEFLATE_TAIL, 4) == 0)
+			size -= 4;
+		if (size == 0)
+			buffer[size++] = 0;
+		bool noContextTakeover = _server ? _serverNoContextTakeover : _clientNoContextTakeover;
+		if (noContextTakeover) deflateReset(&_deflateStream);
+	}
+	buffer.resize(size, true);
+	return size;
+}
+
+
+std::size_t PerMessageDeflate::inflate(const char* data, std::size_t length, bool fin, Poco::Buffer<char>& buffer, std::size_t maxLength)
+{
+	poco_assert (_inflateInit);
+
+	std::size_t oldSize = buffer.size();
+	const std::size_t maxSize = std::numeric_limits<std::size_t>::max() - 1;
+	std::size_t limit = maxLength < maxSize - oldSize ? oldSize + maxLength : maxSize;
+	_inflateStream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	_inflateStream.avail_in = static_cast<uInt>(length);
+	std::size_t produced = oldSize;
+	try
+	{
+		produced = inflateAll(buffer, produced, limit);
+		if (fin)
+		{
+			_inflateStream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(DEFLATE_TAIL));
+			_inflateStream.avail_in = 4;
+			produced = inflateAll(buffer, produced, limit);
+			bool noContextTakeover = _server ? _clientNoContextTakeover : _serverNoContextTakeover;
+			if (noContextTakeover) inflateReset(&_inflateStream);
+		}
+	}
+	catch (...)
+	{
+		buffer.resize(oldSize, true);
+		throw;
+	}
+	buffer.resize(produced, true);
+	return produced - oldSize;
+}
+
+
+std::size_t PerMessageDeflate::inflate(const char* data, std::size_t length, bool fin, char* buffer, std::size_t bufferLength)
+{
+	poco_assert (_inflateInit);
+
+	_inflateStream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	_inflateStream.avail_in = static_cast<uInt>(length);
+	bool done;
+	char probe;
+	std::size_t produced = inflateSome(buffer, bufferLength, done);
+	// If the buffer is full, check whether there is more.
+	if (!done && inflateSome(&probe, 1, done) > 0)
+		throw WebSocketException("Insufficient buffer for decompressed payload", WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	if (fin)
+	{
+		_inflateStream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(DEFLATE_TAIL));
+		_inflateStream.avail_in = 4;
+		produced += inflateSome(buffer + produced, bufferLength - produced, done);
+		if (!done && inflateSome(&probe, 1, done) > 0)
+			throw WebSocketException("Insufficient buffer for decompressed payload", WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	}
+	if (fin)
+	{
+		bool noContextTakeover = _server ? _clientNoContextTakeover : _serverNoContextTakeover;
+		if (noContextTakeover) inflateReset(&_inflateStream);
+	}
+	return produced;
+}
+
+
+std::size_t PerMessageDeflate::inflateSome(char* buffer, std::size_t length, bool& done)
+{
+	_inflateStream.next_out  = reinterpret_cast<Bytef*>(buffer);
+	_inflateStream.avail_out = static_cast<uInt>(length);
+	for (;;)
+	{
+		int rc = ::inflate(&_inflateStream, Z_SYNC_FLUSH);
+		if (rc == Z_STREAM_END)
+		{
+			// The peer has ended the message with a final block.
+			// Any remaining input starts a new stream.
+			inflateReset(&_inflateStream);
+			if (_inflateStream.avail_in > 0 && _inflateStream.avail_out > 0) continue;
+		}
+		else if (rc != Z_OK && rc != Z_BUF_ERROR)
+		{
+			throw WebSocketException("Cannot decompress payload", zError(rc), WebSocket::WS_ERR_COMPRESSION);
+		}
+		break;
+	}
+	// If inflate() leaves output space, all input has been processed.
+	done = _inflateStream.avail_out > 0;
+	return length - _inflateStream.avail_out;
+}
+
+
+std::size_t PerMessageDeflate::inflateAll(Poco::Buffer<char>& buffer, std::size_t produced, std::size_t maxLength)
+{
+	bool done = false;
+	while (!done)
+	{
+		if (buffer.capacity() == produced)
+		{
+			std::size_t capacity = 2*buffer.capacity();
+			std::size_t needed = produced + 4*_inflateStream.avail_in + 256;
+			buffer.setCapacity(capacity < needed ? needed : capacity, true);
+		}
+		buffer.resize(buffer.capacity(), true);
+		// Do not decompress more than one byte beyond the limit.
+		std::size_t length = buffer.size() - produced;
+		if (produced + length > maxLength + 1) length = maxLength + 1 - produced;
+		produced += inflateSome(buffer.begin() + produced, length, done);
+		if (produced > maxLength)
+			throw WebSocketException("Decompressed payload exceeds maximum payload size", WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	}
+	return produced;
+}
+
+
+} } // namespace Poco::Net
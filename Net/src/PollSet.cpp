@@ -0,0 +1,428 @@
+//
+// PollSet.cpp
+//
+// $Id: //poco/1.4/Net/src/PollSet.cpp#1 $
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/SocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Mutex.h"
+#include "Poco/Timestamp.h"
+#include <string.h>
+#if defined(POCO_HAVE_FD_EPOLL)
+#include <sys/epoll.h>
+#include <vector>
+#endif
+
+
+namespace Poco {
+namespace Net {
+
+
+#if defined(POCO_HAVE_FD_EPOLL)
+
+
+//
+// Linux implementation using a persistent epoll instance
+//
+class PollSetImpl
+{
+public:
+	PollSetImpl(bool edgeTriggered):
+		_epollfd(-1),
+		_edgeTriggered(edgeTriggered)
+	{
+		_epollfd = epoll_create(1024);
+		if (_epollfd < 0)
+		{
+			char buf[1024];
+			strerror_r(errno, buf, sizeof(buf));
+			SocketImpl::error(std::string("Can't create epoll queue: ") + buf);
+		}
+	}
+
+	~PollSetImpl()
+	{
+		::close(_epollfd);
+	}
+
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pImpl = socket.impl();
+		poco_socket_t sockfd = pImpl->sockfd();
+		if (sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+		SocketMap::iterator it = _socketMap.find(pImpl);
+		if (it == _socketMap.end())
+		{
+			control(EPOLL_CTL_ADD, sockfd, mode);
+			_socketMap.insert(SocketMap::value_type(pImpl, Entry(socket, sockfd)));
+			_fdMap[sockfd] = pImpl;
+		}
+		else control(EPOLL_CTL_MOD, sockfd, mode);
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketMap::iterator it = _socketMap.find(socket.impl());
+		if (it != _socketMap.end())
+		{
+			// The socket may already have been closed, in which case
+			// the kernel has removed it from the epoll set anyway.
+			if (it->first->sockfd() != POCO_INVALID_SOCKET)
+				deregister(it->second.fd);
+			FdMap::iterator itFd = _fdMap.find(it->second.fd);
+			if (itFd != _fdMap.end() && itFd->second == it->first)
+				_fdMap.erase(itFd);
+			_socketMap.erase(it);
+		}
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.find(socket.impl()) != _socketMap.end();
+	}
+
+	std::size_t size() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.size();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		// The epoll instance is kept, as poll() may be waiting on it
+		// in another thread. Only the registrations are removed.
+		for (SocketMap::iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+		{
+			if (it->first->sockfd() != POCO_INVALID_SOCKET)
+				deregister(it->second.fd);
+		}
+		_socketMap.clear();
+		_fdMap.clear();
+	}
+
+	bool isEdgeTriggered() const
+	{
+		return _edgeTriggered;
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_socketMap.empty()) return result;
+			if (_events.size() < _socketMap.size())
+				_events.resize(_socketMap.size());
+		}
+
+		Poco::Timespan remainingTime(timeout);
+		int rc;
+		do
+		{
+			Poco::Timestamp start;
+			rc = epoll_wait(_epollfd, &_events[0], static_cast<int>(_events.size()), static_cast<int>(remainingTime.totalMilliseconds()));
+			if (rc < 0 && SocketImpl::lastError() == POCO_EINTR)
+			{
+				Poco::Timestamp end;
+				Poco::Timespan waited = end - start;
+				if (waited < remainingTime)
+					remainingTime -= waited;
+				else
+					remainingTime = 0;
+			}
+		}
+		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
+		if (rc < 0) SocketImpl::error();
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (int i = 0; i < rc; ++i)
+		{
+			// Events are keyed by file descriptor, and sockets removed
+			// while we were waiting are silently dropped.
+			FdMap::iterator itFd = _fdMap.find(_events[i].data.fd);
+			if (itFd != _fdMap.end())
+			{
+				SocketMap::iterator it = _socketMap.find(itFd->second);
+				int mode = 0;
+				if (_events[i].events & (EPOLLIN | EPOLLHUP))
+					mode |= PollSet::POLL_READ;
+				if (_events[i].events & EPOLLOUT)
+					mode |= PollSet::POLL_WRITE;
+				if (_events[i].events & EPOLLERR)
+					mode |= PollSet::POLL_ERROR;
+				result[it->second.socket] |= mode;
+			}
+		}
+		return result;
+	}
+
+private:
+	struct Entry
+	{
+		Entry(const Socket& s, poco_socket_t f): socket(s), fd(f)
+		{
+		}
+
+		Socket        socket;
+		poco_socket_t fd;
+	};
+
+	typedef std::map<SocketImpl*, Entry> SocketMap;
+	typedef std::map<poco_socket_t, SocketImpl*> FdMap;
+
+	void control(int op, poco_socket_t sockfd, int mode)
+	{
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		if (mode & PollSet::POLL_READ)
+			ev.events |= EPOLLIN;
+		if (mode & PollSet::POLL_WRITE)
+			ev.events |= EPOLLOUT;
+		if (mode & PollSet::POLL_ERROR)
+			ev.events |= EPOLLERR;
+		if (_edgeTriggered)
+			ev.events |= EPOLLET;
+		ev.data.fd = sockfd;
+		if (epoll_ctl(_epollfd, op, sockfd, &ev) < 0)
+		{
+			char buf[1024];
+			strerror_r(errno, buf, sizeof(buf));
+			SocketImpl::error(std::string("Can't insert socket to epoll queue: ") + buf);
+		}
+	}
+
+	void deregister(poco_socket_t sockfd)
+	{
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		epoll_ctl(_epollfd, EPOLL_CTL_DEL, sockfd, &ev);
+	}
+
+	int                              _epollfd;
+	bool                             _edgeTriggered;
+	SocketMap                        _socketMap;
+	FdMap                            _fdMap;
+	std::vector<struct epoll_event>  _events;
+	mutable Poco::FastMutex          _mutex;
+};
+
+
+#else
+
+
+//
+// Generic implementation based on Socket::select()
+//
+class PollSetImpl
+{
+public:
+	PollSetImpl(bool /*edgeTriggered*/)
+	{
+	}
+
+	~PollSetImpl()
+	{
+	}
+
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap[socket] = mode;
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap.erase(socket);
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.find(socket) != _socketMap.end();
+	}
+
+	std::size_t size() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.size();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap.clear();
+	}
+
+	bool isEdgeTriggered() const
+	{
+		return false;
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		Socket::SocketList readList;
+		Socket::SocketList writeList;
+		Socket::SocketList exceptList;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			for (PollSet::SocketModeMap::const_iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+			{
+				if (it->second & PollSet::POLL_READ)
+					readList.push_back(it->first);
+				if (it->second & PollSet::POLL_WRITE)
+					writeList.push_back(it->first);
+				if (it->second & PollSet::POLL_ERROR)
+					exceptList.push_back(it->first);
+			}
+		}
+
+		PollSet::SocketModeMap result;
+		if (Socket::select(readList, writeList, exceptList, timeout))
+		{
+			for (Socket::SocketList::const_iterator it = readList.begin(); it != readList.end(); ++it)
+				result[*it] |= PollSet::POLL_READ;
+			for (Socket::SocketList::const_iterator it = writeList.begin(); it != writeList.end(); ++it)
+				result[*it] |= PollSet::POLL_WRITE;
+			for (Socket::SocketList::const_iterator it = exceptList.begin(); it != exceptList.end(); ++it)
+				result[*it] |= PollSet::POLL_ERROR;
+		}
+		return result;
+	}
+
+private:
+	PollSet::SocketModeMap  _socketMap;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+#endif // POCO_HAVE_FD_EPOLL
+
+
+//
+// PollSet
+//
+
+
+PollSet::PollSet():
+	_pImpl(new PollSetImpl(false))
+{
+}
+
+
+PollSet::PollSet(bool edgeTriggered):
+	_pImpl(new PollSetImpl(edgeTriggered))
+{
+}
+
+
+PollSet::~PollSet()
+{
+	delete _pImpl;
+}
+
+
+void PollSet::add(const Socket& socket, int mode)
+{
+	_pImpl->add(socket, mode);
+}
+
+
+void PollSet::remove(const Socket& socket)
+{
+	_pImpl->remove(socket);
+}
+
+
+void PollSet::update(const Socket& socket, int mode)
+{
+	_pImpl->add(socket, mode);
+}
+
+
+bool PollSet::has(const Socket& socket) const
+{
+	return _pImpl->has(socket);
+}
+
+
+bool PollSet::empty() const
+{
+	return _pImpl->size() == 0;
+}
+
+
+std::size_t PollSet::size() const
+{
+	return _pImpl->size();
+}
+
+
+void PollSet::clear()
+{
+	_pImpl->clear();
+}
+
+
+bool PollSet::isEdgeTriggered() const
+{
+	return _pImpl->isEdgeTriggered();
+}
+
+
+PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
+{
+	return _pImpl->poll(timeout);
+}
+
+
+} } // namespace Poco::Net
@@ -332,6 +332,80 @@ int SocketImpl::receiveBytes(void* buffer, int length, int flags)
 }
 
 
+int SocketImpl::sendBytes(const SocketBuf* buffers, int count, int flags)
+{
+#if defined(POCO_BROKEN_TIMEOUTS)
+	if (_sndTimeout.totalMicroseconds() != 0)
+	{
+		if (!poll(_sndTimeout, SELECT_WRITE))
+			throw TimeoutException();
+	}
+#endif
+
+	int rc;
+	do
+	{
+		if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		DWORD sent = 0;
+		rc = WSASend(_sockfd, const_cast<LPWSABUF>(buffers), static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), 0, 0);
+		if (rc == 0) rc = static_cast<int>(sent);
+#else
+		struct msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov    = const_cast<SocketBuf*>(buffers);
+		msg.msg_iovlen = count;
+		rc = static_cast<int>(::sendmsg(_sockfd, &msg, flags));
+#endif
+	}
+	while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+	if (rc < 0) error();
+	return rc;
+}
+
+
+int SocketImpl::receiveBytes(SocketBuf* buffers, int count, int flags)
+{
+#if defined(POCO_BROKEN_TIMEOUTS)
+	if (_recvTimeout.totalMicroseconds() != 0)
+	{
+		if (!poll(_recvTimeout, SELECT_READ))
+			throw TimeoutException();
+	}
+#endif
+
+	int rc;
+	do
+	{
+		if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		DWORD received = 0;
+		DWORD dwFlags = static_cast<DWORD>(flags);
+		rc = WSARecv(_sockfd, buffers, static_cast<DWORD>(count), &received, &dwFlags, 0, 0);
+		if (rc == 0) rc = static_cast<int>(received);
+#else
+		struct msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov    = buffers;
+		msg.msg_iovlen = count;
+		rc = static_cast<int>(::recvmsg(_sockfd, &msg, flags));
+#endif
+	}
+	while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+	if (rc < 0) 
+	{
+		int err = lastError();
+		if (err == POCO_EAGAIN && !_blocking)
+			;
+		else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+			throw TimeoutException();
+		else
+			error(err);
+	}
+	return rc;
+}
+
+
 int SocketImpl::sendTo(const void* buffer, int length, const SocketAddress& address, int flags)
 {
 	int rc;
@@ -77,6 +77,20 @@ SocketReactor::SocketReactor(const Poco::Timespan& timeout):
 }
 
 
+SocketReactor::SocketReactor(const Poco::Timespan& timeout, bool edgeTriggered):
+	_stop(false),
+	_timeout(timeout),
+	_pollSet(edgeTriggered),
+	_pReadableNotification(new ReadableNotification(this)),
+	_pWritableNotification(new WritableNotification(this)),
+	_pErrorNotification(new ErrorNotification(this)),
+	_pTimeoutNotification(new TimeoutNotification(this)),
+	_pIdleNotification(new IdleNotification(this)),
+	_pShutdownNotification(new ShutdownNotification(this))
+{
+}
+
+
 SocketReactor::~SocketReactor()
 {
 }
@@ -84,55 +98,42 @@ SocketReactor::~SocketReactor()
 
 void SocketReactor::run()
 {
-	Socket::SocketList readable;
-	Socket::SocketList writable;
-	Socket::SocketList except;
-	
 	while (!_stop)
 	{
 		try
 		{
-			readable.clear();
-			writable.clear();
-			except.clear();
-			int nSockets = 0;
+			if (_pollSet.empty())
 			{
-				FastMutex::ScopedLock lock(_mutex);
-				for (EventHandlerMap::iterator it = _handlers.begin(); it != _handlers.end(); ++it)
+				onIdle();
+			}
+			else
+			{
+				PollSet::SocketModeMap ready = _pollSet.poll(_timeout);
+				if (!ready.empty())
 				{
-					if (it->second->accepts(_pReadableNotification))
-					{
-						readable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pWritableNotification))
+					onBusy();
+
+					for (PollSet::SocketModeMap::iterator it = ready.begin(); it != ready.end(); ++it)
 					{
-						writable.push_back(it->first);
-						nSockets++;
+						if (it->second & PollSet::POLL_READ)
+							dispatch(it->first, _pReadableNotification);
+						if (it->second & PollSet::POLL_WRITE)
+							dispatch(it->first, _pWritableNotification);
+						if (it->second & PollSet::POLL_ERROR)
+							dispatch(it->first, _pErrorNotification);
 					}
-					if (it->second->accepts(_pErrorNotification))
+					if (_lastTimeout.isElapsed(_timeout.totalMicroseconds()))
 					{
-						except.push_back(it->first);
-						nSockets++;
+						_lastTimeout.update();
+						onTimeout();
 					}
 				}
+				else
+				{
+					_lastTimeout.update();
+					onTimeout();
+				}
 			}
-			if (nSockets == 0)
-			{
-				onIdle();
-			}
-			else if (Socket::select(readable, writable, except, _timeout))
-			{
-				onBusy();
-
-				for (Socket::SocketList::iterator it = readable.begin(); it != readable.end(); ++it)
-					dispatch(*it, _pReadableNotification);
-				for (Socket::SocketList::iterator it = writable.begin(); it != writable.end(); ++it)
-					dispatch(*it, _pWritableNotification);
-				for (Socket::SocketList::iterator it = except.begin(); it != except.end(); ++it)
-					dispatch(*it, _pErrorNotification);
-			}
-			else onTimeout();
 		}
 		catch (Exception& exc)
 		{
@@ -169,22 +170,32 @@ const Poco::Timespan& SocketReactor::getTimeout() const
 }
 
 
+bool SocketReactor::isEdgeTriggered() const
+{
+	return _pollSet.isEdgeTriggered();
+}
+
+
 void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
+	// The poll set is updated while holding the mutex, so that
+	// it always reflects the current contents of _handlers.
+	FastMutex::ScopedLock lock(_mutex);
+
 	NotifierPtr pNotifier;
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it == _handlers.end())
 	{
-		FastMutex::ScopedLock lock(_mutex);
-		
-		EventHandlerMap::iterator it = _handlers.find(socket);
-		if (it == _handlers.end())
-		{
-			pNotifier = new SocketNotifier(socket);
-			_handlers[socket] = pNotifier;
-		}
-		else pNotifier = it->second;
+		pNotifier = new SocketNotifier(socket);
+		_handlers[socket] = pNotifier;
 	}
+	else pNotifier = it->second;
+
 	if (!pNotifier->hasObserver(observer))
+	{
 		pNotifier->addObserver(this, observer);
+		updatePollSet(socket, pNotifier);
+	}
 }
 
 
@@ -208,25 +219,24 @@ bool SocketReactor::hasEventHandler(const Socket& socket, const Poco::AbstractOb
 
 void SocketReactor::removeEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
-	NotifierPtr pNotifier;
+	FastMutex::ScopedLock lock(_mutex);
+
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it != _handlers.end())
 	{
-		FastMutex::ScopedLock lock(_mutex);
-	
-		EventHandlerMap::iterator it = _handlers.find(socket);
-		if (it != _handlers.end())
+		NotifierPtr pNotifier = it->second;
+		if (pNotifier->hasObserver(observer))
 		{
-			pNotifier = it->second;
-			if (pNotifier->hasObserver(observer) && pNotifier->countObservers() == 1)
+			if (pNotifier->countObservers() == 1)
 			{
 				_handlers.erase(it);
+				_pollSet.remove(socket);
 			}
+			pNotifier->removeObserver(this, observer);
+			if (pNotifier->countObservers() > 0)
+				updatePollSet(socket, pNotifier);
 		}
 	}
-	if (pNotifier && pNotifier->hasObserver(observer))
-	{
-		pNotifier->removeObserver(this, observer);
-	}
-
 }
 
 
@@ -305,4 +315,21 @@ void SocketReactor::dispatch(NotifierPtr& pNotifier, SocketNotification* pNotifi
 }
 
 
+void SocketReactor::updatePollSet(const Socket& socket, NotifierPtr& pNotifier)
+{
+	int mode = 0;
+	if (pNotifier->accepts(_pReadableNotification))
+		mode |= PollSet::POLL_READ;
+	if (pNotifier->accepts(_pWritableNotification))
+		mode |= PollSet::POLL_WRITE;
+	if (pNotifier->accepts(_pErrorNotification))
+		mode |= PollSet::POLL_ERROR;
+
+	if (mode)
+		_pollSet.update(socket, mode);
+	else
+		_pollSet.remove(socket);
+}
+
+
 } } // namespace Poco::Net
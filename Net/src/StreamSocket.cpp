@@ -134,6 +134,12 @@ int StreamSocket::sendBytes(const void* buffer, int length, int flags)
 }
 
 
+int StreamSocket::sendBytes(const SocketBuf* buffers, int count, int flags)
+{
+	return impl()->sendBytes(buffers, count, flags);
+}
+
+
 int StreamSocket::sendBytes(FIFOBuffer& fifoBuf)
 {
 	int ret = impl()->sendBytes(&fifoBuf.buffer()[0], (int) fifoBuf.used());
@@ -142,6 +148,12 @@ int StreamSocket::sendBytes(FIFOBuffer& fifoBuf)
 }
 
 
+int StreamSocket::receiveBytes(SocketBuf* buffers, int count, int flags)
+{
+	return impl()->receiveBytes(buffers, count, flags);
+}
+
+
 int StreamSocket::receiveBytes(void* buffer, int length, int flags)
 {
 	return impl()->receiveBytes(buffer, length, flags);
@@ -156,6 +168,14 @@ int StreamSocket::receiveBytes(FIFOBuffer& fifoBuf)
 }
 
 
+#if defined(POCO_OS_FAMILY_UNIX)
+Poco::UInt64 StreamSocket::sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	return static_cast<StreamSocketImpl*>(impl())->sendFile(fd, offset, count);
+}
+#endif
+
+
 void StreamSocket::sendUrgent(unsigned char data)
 {
 	impl()->sendUrgent(data);
@@ -35,8 +35,19 @@
 
 
 #include "Poco/Net/StreamSocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Net/Socket.h"
 #include "Poco/Exception.h"
 #include "Poco/Thread.h"
+#include "Poco/Buffer.h"
+#include <vector>
+#include <cstring>
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/sendfile.h>
+#endif
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <unistd.h>
+#endif
 
 
 namespace Poco {
@@ -92,4 +103,138 @@ int StreamSocketImpl::sendBytes(const void* buffer, int length, int flags)
 }
 
 
+int StreamSocketImpl::sendBytes(const SocketBuf* buffers, int count, int flags)
+{
+	if (secure())
+	{
+		std::size_t total = 0;
+		for (int i = 0; i < count; i++) total += Socket::bufferLength(buffers[i]);
+		Poco::Buffer<char> buffer(total);
+		char* p = buffer.begin();
+		for (int i = 0; i < count; i++)
+		{
+			std::memcpy(p, Socket::bufferBase(buffers[i]), Socket::bufferLength(buffers[i]));
+			p += Socket::bufferLength(buffers[i]);
+		}
+		return sendBytes(buffer.begin(), static_cast<int>(total), flags);
+	}
+
+	bool blocking = getBlocking();
+	const SocketBuf* pBuffers = buffers;
+	std::vector<SocketBuf> remaining;
+	int sent = 0;
+	for (;;)
+	{
+		int n = SocketImpl::sendBytes(pBuffers, count, flags);
+		poco_assert_dbg (n >= 0);
+		sent += n;
+		if (!blocking) break;
+		std::size_t done = n;
+		while (count > 0 && done >= Socket::bufferLength(*pBuffers))
+		{
+			done -= Socket::bufferLength(*pBuffers);
+			++pBuffers;
+			--count;
+		}
+		if (count == 0) break;
+		// Partially sent; continue with a copy of
+		// the buffer list that can be adjusted.
+		if (remaining.empty())
+			remaining.assign(pBuffers, pBuffers + count);
+		else
+			remaining.erase(remaining.begin(), remaining.end() - count);
+		remaining[0] = Socket::makeBuffer(Socket::bufferBase(remaining[0]) + done, Socket::bufferLength(remaining[0]) - done);
+		pBuffers = &remaining[0];
+		Poco::Thread::yield();
+	}
+	return sent;
+}
+
+
+int StreamSocketImpl::receiveBytes(SocketBuf* buffers, int count, int flags)
+{
+	if (secure())
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (Socket::bufferLength(buffers[i]) > 0)
+				return receiveBytes(Socket::bufferBase(buffers[i]), static_cast<int>(Socket::bufferLength(buffers[i])), flags);
+		}
+		return 0;
+	}
+	return SocketImpl::receiveBytes(buffers, count, flags);
+}
+
+
+#if defined(POCO_OS_FAMILY_UNIX)
+Poco::UInt64 StreamSocketImpl::sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	Poco::UInt64 sent = 0;
+	bool blocking = getBlocking();
+#if POCO_OS == POCO_OS_LINUX && !defined(POCO_BROKEN_TIMEOUTS)
+	if (!secure())
+	{
+		off_t off = static_cast<off_t>(offset);
+		while (sent < count)
+		{
+			if (sockfd() == POCO_INVALID_SOCKET) throw InvalidSocketException();
+			// sendfile() transfers at most 0x7ffff000 bytes at once.
+			Poco::UInt64 chunk = count - sent;
+			if (chunk > 0x40000000) chunk = 0x40000000;
+			ssize_t rc;
+			do
+			{
+				rc = ::sendfile(sockfd(), fd, &off, static_cast<std::size_t>(chunk));
+			}
+			while (blocking && rc < 0 && lastError() == POCO_EINTR);
+			if (rc < 0)
+			{
+				int err = lastError();
+				if (err == POCO_EAGAIN || err == POCO_EWOULDBLOCK)
+				{
+					if (!blocking) return sent;
+					// a blocking socket only fails this way if the send timeout expired
+					throw TimeoutException(err);
+				}
+				// Not supported for this kind of file; fall back to copying.
+				if ((err == EINVAL || err == ENOSYS) && sent == 0) break;
+				error(err);
+			}
+			if (rc == 0) return sent;
+			sent += static_cast<Poco::UInt64>(rc);
+		}
+		if (sent == count) return sent;
+	}
+#endif
+	Poco::Buffer<char> buffer(SENDFILE_BUFFER_SIZE);
+	while (sent < count)
+	{
+		std::size_t chunk = SENDFILE_BUFFER_SIZE;
+		if (count - sent < chunk) chunk = static_cast<std::size_t>(count - sent);
+		ssize_t n;
+		do
+		{
+			n = ::pread(fd, buffer.begin(), chunk, static_cast<off_t>(offset + sent));
+		}
+		while (n < 0 && errno == EINTR);
+		if (n < 0) throw Poco::ReadFileException("Cannot read file for sending");
+		if (n == 0) break;
+		int rc = 0;
+		try
+		{
+			rc = sendBytes(buffer.begin(), static_cast<int>(n));
+		}
+		catch (Poco::IOException& exc)
+		{
+			if (exc.code() != POCO_EAGAIN && exc.code() != POCO_EWOULDBLOCK) throw;
+			if (blocking) throw TimeoutException(exc.code());
+		}
+		if (rc > 0) sent += rc;
+		if (rc < n) break;
+	}
+	return sent;
+}
+#endif
+
+
 } } // namespace Poco::Net
@@ -36,6 +36,9 @@
 
 #include "Poco/Net/TCPServerDispatcher.h"
 #include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/NotificationQueueAdapter.h"
+#include "Poco/NotificationQueue.h"
+#include "Poco/LockFreeNotificationQueue.h"
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
 #include <memory>
@@ -80,7 +83,9 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	_currentConnections(0),
 	_maxConcurrentConnections(0),
 	_refusedConnections(0),
-	_stopped(false),
+	_queuedConnections(0),
+	_stopped(0),
+	_pQueue(0),
 	_pConnectionFactory(pFactory),
 	_threadPool(threadPool)
 {
@@ -91,11 +96,21 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	
 	if (_pParams->getMaxThreads() == 0)
 		_pParams->setMaxThreads(threadPool.capacity());
+
+	if (_pParams->getLockFreeQueue())
+	{
+		// TCPServerParams::setMaxQueued() only accepts positive
+		// values, but the queue must never be created empty.
+		int capacity = _pParams->getMaxQueued() > 0 ? _pParams->getMaxQueued() : 1;
+		_pQueue = new Poco::NotificationQueueAdapter<Poco::LockFreeNotificationQueue>(static_cast<std::size_t>(capacity));
+	}
+	else _pQueue = new Poco::NotificationQueueAdapter<Poco::NotificationQueue>;
 }
 
 
 TCPServerDispatcher::~TCPServerDispatcher()
 {
+	delete _pQueue;
 }
 
 
@@ -124,9 +139,10 @@ void TCPServerDispatcher::run()
 
 	for (;;)
 	{
-		AutoPtr<Notification> pNf = _queue.waitDequeueNotification(idleTime);
+		AutoPtr<Notification> pNf = _pQueue->waitDequeueNotification(idleTime);
 		if (pNf)
 		{
+			--_queuedConnections;
 			TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf.get());
 			if (pCNf)
 			{
@@ -137,12 +153,17 @@ void TCPServerDispatcher::run()
 				endConnection();
 			}
 		}
-	
-		FastMutex::ScopedLock lock(_mutex);
-		if (_stopped || (_currentThreads > 1 && _queue.empty()))
+
+		// The counters and the stopped flag are atomic, so the mutex
+		// is only needed when the thread is actually going to exit.
+		if (_stopped.value() || (_currentThreads > 1 && _pQueue->empty()))
 		{
-			--_currentThreads;
-			break;
+			FastMutex::ScopedLock lock(_mutex);
+			if (_stopped.value() || (_currentThreads > 1 && _pQueue->empty()))
+			{
+				--_currentThreads;
+				break;
+			}
 		}
 	}
 }
@@ -156,27 +177,32 @@ namespace
 	
 void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 {
-	FastMutex::ScopedLock lock(_mutex);
-
-	if (_queue.size() < _pParams->getMaxQueued())
+	if (++_queuedConnections <= _pParams->getMaxQueued())
 	{
-		_queue.enqueueNotification(new TCPConnectionNotification(socket));
-		if (!_queue.hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
+		_pQueue->enqueueNotification(new TCPConnectionNotification(socket));
+		if (!_pQueue->hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
 		{
-			try
+			FastMutex::ScopedLock lock(_mutex);
+
+			if (_currentThreads < _pParams->getMaxThreads())
 			{
-				_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, threadName);
 				++_currentThreads;
-			}
-			catch (Poco::Exception&)
-			{
-				// no problem here, connection is already queued
-				// and a new thread might be available later.
+				try
+				{
+					_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, threadName);
+				}
+				catch (Poco::Exception&)
+				{
+					// no problem here, connection is already queued
+					// and a new thread might be available later.
+					--_currentThreads;
+				}
 			}
 		}
 	}
 	else
 	{
+		--_queuedConnections;
 		++_refusedConnections;
 	}
 }
@@ -184,73 +210,75 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 
 void TCPServerDispatcher::stop()
 {
-	_stopped = true;
-	_queue.clear();
-	_queue.wakeUpAll();
+	_stopped = 1;
+	// Connections may still be enqueued concurrently, so the
+	// counter is decremented for each removed connection
+	// instead of being reset.
+	AutoPtr<Notification> pNf = _pQueue->dequeueNotification();
+	while (pNf)
+	{
+		--_queuedConnections;
+		pNf = _pQueue->dequeueNotification();
+	}
+	_pQueue->wakeUpAll();
 }
 
 
 int TCPServerDispatcher::currentThreads() const
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
 	return _currentThreads;
 }
 
 
 int TCPServerDispatcher::totalConnections() const
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
 	return _totalConnections;
 }
 
 
 int TCPServerDispatcher::currentConnections() const
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
 	return _currentConnections;
 }
 
 
 int TCPServerDispatcher::maxConcurrentConnections() const
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
 	return _maxConcurrentConnections;
 }
 
 
 int TCPServerDispatcher::queuedConnections() const
 {
-	return _queue.size();
+	return _queuedConnections;
 }
 
 
 int TCPServerDispatcher::refusedConnections() const
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
 	return _refusedConnections;
 }
 
 
 void TCPServerDispatcher::beginConnection()
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
 	++_totalConnections;
-	++_currentConnections;
-	if (_currentConnections > _maxConcurrentConnections)
-		_maxConcurrentConnections = _currentConnections;
+	int current = ++_currentConnections;
+
+	// The maximum rarely changes, so the mutex
+	// is only taken if it might have to be updated.
+	if (current > _maxConcurrentConnections.value())
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (current > _maxConcurrentConnections.value())
+			_maxConcurrentConnections = current;
+	}
 }
 
 
 void TCPServerDispatcher::endConnection()
 {
-	FastMutex::ScopedLock lock(_mutex);
-
 	--_currentConnections;
 }
 
@@ -36,6 +36,7 @@
 
 #include "Poco/Net/WebSocket.h"
 #include "Poco/Net/WebSocketImpl.h"
+#include "Poco/Net/PerMessageDeflate.h"
 #include "Poco/Net/HTTPServerRequestImpl.h"
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/HTTPClientSession.h"
@@ -50,6 +51,7 @@
 #include "Poco/Random.h"
 #include "Poco/StreamCopier.h"
 #include <sstream>
+#include <memory>
 
 
 namespace Poco {
@@ -67,6 +69,12 @@ WebSocket::WebSocket(HTTPServerRequest& request, HTTPServerResponse& response):
 }
 
 	
+WebSocket::WebSocket(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate& deflate):
+	StreamSocket(accept(request, response, &deflate))
+{
+}
+
+
 WebSocket::WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response):
 	StreamSocket(connect(cs, request, response, _defaultCreds))
 {
@@ -79,6 +87,12 @@ WebSocket::WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse&
 }
 
 
+WebSocket::WebSocket(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, const PerMessageDeflate& deflate):
+	StreamSocket(connect(cs, request, response, _defaultCreds, &deflate))
+{
+}
+
+
 WebSocket::WebSocket(const Socket& socket): 
 	StreamSocket(socket)
 {
@@ -133,13 +147,51 @@ int WebSocket::receiveFrame(void* buffer, int length, int& flags)
 }
 
 	
+int WebSocket::receiveFrame(Poco::Buffer<char>& buffer, int& flags)
+{
+	int n = static_cast<WebSocketImpl*>(impl())->receiveBytes(buffer, 0);
+	flags = static_cast<WebSocketImpl*>(impl())->frameFlags();
+	return n;
+}
+
+
+void WebSocket::setMaxPayloadSize(int maxPayloadSize)
+{
+	static_cast<WebSocketImpl*>(impl())->setMaxPayloadSize(maxPayloadSize);
+}
+
+
+int WebSocket::getMaxPayloadSize() const
+{
+	return static_cast<WebSocketImpl*>(impl())->getMaxPayloadSize();
+}
+
+
+void WebSocket::setReadAheadSize(int size)
+{
+	static_cast<WebSocketImpl*>(impl())->setReadAheadSize(size);
+}
+
+
+int WebSocket::getReadAheadSize() const
+{
+	return static_cast<WebSocketImpl*>(impl())->getReadAheadSize();
+}
+
+
+const PerMessageDeflate* WebSocket::perMessageDeflate() const
+{
+	return static_cast<WebSocketImpl*>(impl())->perMessageDeflate();
+}
+
+
 WebSocket::Mode WebSocket::mode() const
 {
 	return static_cast<WebSocketImpl*>(impl())->mustMaskPayload() ? WS_CLIENT : WS_SERVER;
 }
 
 
-WebSocketImpl* WebSocket::accept(HTTPServerRequest& request, HTTPServerResponse& response)
+WebSocketImpl* WebSocket::accept(HTTPServerRequest& request, HTTPServerResponse& response, const PerMessageDeflate* pDeflate)
 {
 	if (request.hasToken("Connection", "upgrade") && icompare(request.get("Upgrade", ""), "websocket") == 0)
 	{
@@ -154,15 +206,36 @@ WebSocketImpl* WebSocket::accept(HTTPServerRequest& request, HTTPServerResponse&
 		response.set("Upgrade", "websocket");
 		response.set("Connection", "Upgrade");
 		response.set("Sec-WebSocket-Accept", computeAccept(key));
+		std::auto_ptr<PerMessageDeflate> pAccepted;
+		if (pDeflate)
+		{
+			// Offers may be spread over several header fields.
+			std::string offers;
+			NameValueCollection::ConstIterator it = request.find("Sec-WebSocket-Extensions");
+			while (it != request.end() && icompare(it->first, "Sec-WebSocket-Extensions") == 0)
+			{
+				if (!offers.empty()) offers += ',';
+				offers += it->second;
+				++it;
+			}
+			pAccepted.reset(new PerMessageDeflate(*pDeflate));
+			std::string extension;
+			if (pAccepted->accept(offers, extension))
+				response.set("Sec-WebSocket-Extensions", extension);
+			else
+				pAccepted.reset();
+		}
 		response.setContentLength(0);
 		response.send().flush();
-		return new WebSocketImpl(static_cast<StreamSocketImpl*>(static_cast<HTTPServerRequestImpl&>(request).detachSocket().impl()), false);
+		WebSocketImpl* pImpl = new WebSocketImpl(static_cast<StreamSocketImpl*>(static_cast<HTTPServerRequestImpl&>(request).detachSocket().impl()), false);
+		if (pAccepted.get()) pImpl->setPerMessageDeflate(pAccepted.release());
+		return pImpl;
 	}
 	else throw WebSocketException("No WebSocket handshake", WS_ERR_NO_HANDSHAKE);
 }
 
 
-WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials)
+WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, HTTPResponse& response, HTTPCredentials& credentials, const PerMessageDeflate* pDeflate)
 {
 	if (!cs.getProxyHost().empty() && !cs.secure())
 	{
@@ -173,13 +246,15 @@ WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, H
 	request.set("Upgrade", "websocket");
 	request.set("Sec-WebSocket-Version", WEBSOCKET_VERSION);
 	request.set("Sec-WebSocket-Key", key);
+	if (pDeflate)
+		request.set("Sec-WebSocket-Extensions", pDeflate->offer());
 	request.setChunkedTransferEncoding(false);
 	cs.setKeepAlive(true);
 	cs.sendRequest(request);
 	std::istream& istr = cs.receiveResponse(response);
 	if (response.getStatus() == HTTPResponse::HTTP_SWITCHING_PROTOCOLS)
 	{
-		return completeHandshake(cs, response, key);
+		return completeHandshake(cs, response, key, pDeflate);
 	}
 	else if (response.getStatus() == HTTPResponse::HTTP_UNAUTHORIZED)
 	{
@@ -195,7 +270,7 @@ WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, H
 		cs.receiveResponse(response);
 		if (response.getStatus() == HTTPResponse::HTTP_SWITCHING_PROTOCOLS)
 		{
-			return completeHandshake(cs, response, key);
+			return completeHandshake(cs, response, key, pDeflate);
 		}
 		else if (response.getStatus() == HTTPResponse::HTTP_UNAUTHORIZED)
 		{
@@ -213,7 +288,7 @@ WebSocketImpl* WebSocket::connect(HTTPClientSession& cs, HTTPRequest& request, H
 }
 
 
-WebSocketImpl* WebSocket::completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key)
+WebSocketImpl* WebSocket::completeHandshake(HTTPClientSession& cs, HTTPResponse& response, const std::string& key, const PerMessageDeflate* pDeflate)
 {
 	std::string connection = response.get("Connection", "");
 	if (Poco::icompare(connection, "Upgrade") != 0) 
@@ -224,7 +299,19 @@ WebSocketImpl* WebSocket::completeHandshake(HTTPClientSession& cs, HTTPResponse&
 	std::string accept = response.get("Sec-WebSocket-Accept", "");
 	if (accept != computeAccept(key))
 		throw WebSocketException("Invalid or missing Sec-WebSocket-Accept header in handshake response", WS_ERR_NO_HANDSHAKE);
-	return new WebSocketImpl(static_cast<StreamSocketImpl*>(cs.detachSocket().impl()), true);
+	std::auto_ptr<PerMessageDeflate> pAccepted;
+	if (pDeflate)
+	{
+		std::string extension = response.get("Sec-WebSocket-Extensions", "");
+		if (!extension.empty())
+		{
+			pAccepted.reset(new PerMessageDeflate(*pDeflate));
+			pAccepted->confirm(extension);
+		}
+	}
+	WebSocketImpl* pImpl = new WebSocketImpl(static_cast<StreamSocketImpl*>(cs.detachSocket().impl()), true);
+	if (pAccepted.get()) pImpl->setPerMessageDeflate(pAccepted.release());
+	return pImpl;
 }
 
 
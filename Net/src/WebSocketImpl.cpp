@@ -37,12 +37,14 @@
 #include "Poco/Net/WebSocketImpl.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Net/WebSocket.h"
-#include "Poco/Buffer.h"
-#include "Poco/BinaryWriter.h"
-#include "Poco/BinaryReader.h"
-#include "Poco/MemoryStream.h"
+#include "Poco/Net/PerMessageDeflate.h"
 #include "Poco/Format.h"
 #include <cstring>
+#include <limits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POCO_NET_HAVE_SSE2
+#include <emmintrin.h>
+#endif
 
 
 namespace Poco {
@@ -53,7 +55,18 @@ WebSocketImpl::WebSocketImpl(StreamSocketImpl* pStreamSocketImpl, bool mustMaskP
 	StreamSocketImpl(pStreamSocketImpl->sockfd()),
 	_pStreamSocketImpl(pStreamSocketImpl),
 	_frameFlags(0),
-	_mustMaskPayload(mustMaskPayload)
+	_mustMaskPayload(mustMaskPayload),
+	_maxPayloadSize(std::numeric_limits<int>::max()),
+	_readAheadSize(0),
+	_sendBuffer(0),
+	_recvBuffer(MAX_HEADER_LENGTH),
+	_recvOffset(0),
+	_recvEnd(0),
+	_pDeflate(0),
+	_deflating(false),
+	_inflating(false),
+	_deflateBuffer(0),
+	_inflateBuffer(0)
 {
 	poco_check_ptr(pStreamSocketImpl);
 	_pStreamSocketImpl->duplicate();
@@ -63,60 +76,165 @@ WebSocketImpl::WebSocketImpl(StreamSocketImpl* pStreamSocketImpl, bool mustMaskP
 WebSocketImpl::~WebSocketImpl()
 {
 	_pStreamSocketImpl->release();
+	delete _pDeflate;
 	reset();
 }
 
 	
 int WebSocketImpl::sendBytes(const void* buffer, int length, int flags)
 {
-	Poco::Buffer<char> frame(length + MAX_HEADER_LENGTH);
-	Poco::MemoryOutputStream ostr(frame.begin(), frame.size());
-	Poco::BinaryWriter writer(ostr, Poco::BinaryWriter::NETWORK_BYTE_ORDER);
-	
+	char header[MAX_HEADER_LENGTH];
 	if (flags == 0) flags = WebSocket::FRAME_BINARY;
-	writer << static_cast<Poco::UInt8>(flags);
-	Poco::UInt8 lengthByte(0);
+	const char* payload = reinterpret_cast<const char*>(buffer);
+	int payloadLength = length;
+	if (_pDeflate)
+	{
+		int opcode = flags & WebSocket::FRAME_OP_BITMASK;
+		if (opcode == WebSocket::FRAME_OP_TEXT || opcode == WebSocket::FRAME_OP_BINARY || (opcode == WebSocket::FRAME_OP_CONT && _deflating))
+		{
+			// Only the first frame of a compressed message has RSV1 set.
+			bool fin = (flags & WebSocket::FRAME_FLAG_FIN) != 0;
+			if (opcode != WebSocket::FRAME_OP_CONT) flags |= WebSocket::FRAME_FLAG_RSV1;
+			payloadLength = static_cast<int>(_pDeflate->deflate(payload, length, fin, _deflateBuffer));
+			payload = _deflateBuffer.begin();
+			_deflating = !fin;
+		}
+	}
 	if (_mustMaskPayload)
+	{
+		const Poco::UInt32 mask = _rnd.next();
+		const char* m = reinterpret_cast<const char*>(&mask);
+		int headerLength = writeHeader(header, payloadLength, flags, m);
+		std::size_t frameLength = static_cast<std::size_t>(headerLength) + payloadLength;
+		if (_sendBuffer.capacity() < frameLength)
+			_sendBuffer.setCapacity(frameLength, false);
+		_sendBuffer.resize(frameLength, false);
+		std::memcpy(_sendBuffer.begin(), header, headerLength);
+		maskPayload(_sendBuffer.begin() + headerLength, payload, payloadLength, m);
+		_pStreamSocketImpl->sendBytes(_sendBuffer.begin(), static_cast<int>(frameLength));
+	}
+	else
+	{
+		int headerLength = writeHeader(header, payloadLength, flags, 0);
+		sendFrame(header, headerLength, payload, payloadLength);
+	}
+	return length;
+}
+
+
+int WebSocketImpl::writeHeader(char* header, int length, int flags, const char* mask)
+{
+	int n = 0;
+	header[n++] = static_cast<char>(flags);
+	Poco::UInt8 lengthByte(0);
+	if (mask)
 	{
 		lengthByte |= FRAME_FLAG_MASK;
 	}
 	if (length < 126)
 	{
-		lengthByte |= static_cast<Poco::UInt8>(length);
-		writer << lengthByte;
+		header[n++] = static_cast<char>(lengthByte | length);
 	}
 	else if (length < 65536)
 	{
-		lengthByte |= 126;
-		writer << lengthByte << static_cast<Poco::UInt16>(length);
+		header[n++] = static_cast<char>(lengthByte | 126);
+		header[n++] = static_cast<char>((length >> 8) & 0xFF);
+		header[n++] = static_cast<char>(length & 0xFF);
 	}
 	else
 	{
-		lengthByte |= 127;
-		writer << lengthByte << static_cast<Poco::UInt64>(length);
-	}
-	if (_mustMaskPayload)
-	{
-		const Poco::UInt32 mask = _rnd.next();
-		const char* m = reinterpret_cast<const char*>(&mask);
-		const char* b = reinterpret_cast<const char*>(buffer);
-		writer.writeRaw(m, 4);
-		char* p = frame.begin() + ostr.charsWritten();
-		for (int i = 0; i < length; i++)
+		header[n++] = static_cast<char>(lengthByte | 127);
+		Poco::UInt64 l = static_cast<Poco::UInt64>(length);
+		for (int i = 56; i >= 0; i -= 8)
 		{
-			p[i] = b[i] ^ m[i % 4];
+			header[n++] = static_cast<char>((l >> i) & 0xFF);
 		}
 	}
-	else
+	if (mask)
 	{
-		std::memcpy(frame.begin() + ostr.charsWritten(), buffer, length);
+		std::memcpy(header + n, mask, 4);
+		n += 4;
 	}
-	_pStreamSocketImpl->sendBytes(frame.begin(), length + static_cast<int>(ostr.charsWritten()));
-	return length;
+	return n;
+}
+
+
+void WebSocketImpl::sendFrame(const char* header, int headerLength, const char* payload, int length)
+{
+	// Secure sockets need the frame in a single buffer anyway,
+	// which can be reused for all frames.
+	if (!_pStreamSocketImpl->secure())
+	{
+		SocketBuf buffers[2];
+		buffers[0] = Socket::makeBuffer(const_cast<char*>(header), headerLength);
+		buffers[1] = Socket::makeBuffer(const_cast<char*>(payload), length);
+		_pStreamSocketImpl->sendBytes(buffers, length > 0 ? 2 : 1);
+		return;
+	}
+	std::size_t frameLength = static_cast<std::size_t>(headerLength) + length;
+	if (_sendBuffer.capacity() < frameLength)
+		_sendBuffer.setCapacity(frameLength, false);
+	_sendBuffer.resize(frameLength, false);
+	std::memcpy(_sendBuffer.begin(), header, headerLength);
+	std::memcpy(_sendBuffer.begin() + headerLength, payload, length);
+	_pStreamSocketImpl->sendBytes(_sendBuffer.begin(), static_cast<int>(frameLength));
 }
 
 	
 int WebSocketImpl::receiveBytes(void* buffer, int length, int)
+{
+	char mask[4];
+	bool useMask;
+	int payloadLength;
+	int n = receiveHeader(mask, useMask, payloadLength);
+	if (n <= 0) return n;
+	if (mustInflate())
+	{
+		receiveCompressedPayload(payloadLength, mask, useMask);
+		int maxLength = length < _maxPayloadSize ? length : _maxPayloadSize;
+		bool fin = (_frameFlags & WebSocket::FRAME_FLAG_FIN) != 0;
+		return static_cast<int>(_pDeflate->inflate(_inflateBuffer.begin(), payloadLength, fin, reinterpret_cast<char*>(buffer), maxLength));
+	}
+	if (payloadLength > length)
+		throw WebSocketException(Poco::format("Insufficient buffer for payload size %d", payloadLength), WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	return receivePayload(reinterpret_cast<char*>(buffer), payloadLength, mask, useMask);
+}
+
+
+int WebSocketImpl::receiveBytes(Poco::Buffer<char>& buffer, int)
+{
+	char mask[4];
+	bool useMask;
+	int payloadLength;
+	int n = receiveHeader(mask, useMask, payloadLength);
+	if (n <= 0) return n;
+	if (mustInflate())
+	{
+		receiveCompressedPayload(payloadLength, mask, useMask);
+		bool fin = (_frameFlags & WebSocket::FRAME_FLAG_FIN) != 0;
+		return static_cast<int>(_pDeflate->inflate(_inflateBuffer.begin(), payloadLength, fin, buffer, _maxPayloadSize));
+	}
+	std::size_t oldSize = buffer.size();
+	std::size_t newSize = oldSize + payloadLength;
+	if (buffer.capacity() < newSize)
+	{
+		std::size_t capacity = 2*buffer.capacity();
+		buffer.setCapacity(capacity < newSize ? newSize : capacity, true);
+	}
+	buffer.resize(newSize, true);
+	try
+	{
+		return receivePayload(buffer.begin() + oldSize, payloadLength, mask, useMask);
+	}
+	catch (...)
+	{
+		buffer.resize(oldSize, true);
+		throw;
+	}
+}
+
+
+int WebSocketImpl::receiveHeader(char* mask, bool& useMask, int& payloadLength)
 {
 	char header[MAX_HEADER_LENGTH];
 	int n = receiveNBytes(header, 2);
@@ -126,89 +244,103 @@ int WebSocketImpl::receiveBytes(void* buffer, int length, int)
 		return n;
 	}
 	poco_assert (n == 2);
+	_frameFlags = static_cast<Poco::UInt8>(header[0]);
 	Poco::UInt8 lengthByte = static_cast<Poco::UInt8>(header[1]);
-	int maskOffset = 0;
-	if (lengthByte & FRAME_FLAG_MASK) maskOffset += 4;
+	useMask = (lengthByte & FRAME_FLAG_MASK) != 0;
 	lengthByte &= 0x7f;
-	if (lengthByte + 2 + maskOffset < MAX_HEADER_LENGTH)
+	int lengthBytes = lengthByte == 127 ? 8 : (lengthByte == 126 ? 2 : 0);
+	int headerLength = 2 + lengthBytes + (useMask ? 4 : 0);
+	int toRead = headerLength - 2;
+	if (_readAheadSize == 0 && _recvOffset == _recvEnd && headerLength + lengthByte <= MAX_HEADER_LENGTH)
 	{
-		n = receiveNBytes(header + 2, lengthByte + maskOffset);
+		// Receive a small payload together with the header.
+		// It is served from the read-ahead buffer afterwards.
+		toRead += lengthByte;
 	}
-	else
+	if (toRead > 0)
 	{
-		n = receiveNBytes(header + 2, MAX_HEADER_LENGTH - 2);
+		n = receiveNBytes(header + 2, toRead);
+		if (n <= 0) throw WebSocketException("Incomplete frame received", WebSocket::WS_ERR_INCOMPLETE_FRAME);
 	}
-
-	if (n <= 0) throw WebSocketException("Incomplete frame received", WebSocket::WS_ERR_INCOMPLETE_FRAME);
-
-	n += 2;
-	Poco::MemoryInputStream istr(header, n);
-	Poco::BinaryReader reader(istr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
-	Poco::UInt8 flags;
-	char mask[4];
-	reader >> flags >> lengthByte;
-	_frameFlags = flags;
-	int payloadLength = 0;
-	int payloadOffset = 2;
-	if ((lengthByte & 0x7f) == 127)
-	{
-		Poco::UInt64 l;
-		reader >> l;
-		if (l > length) throw WebSocketException(Poco::format("Insufficient buffer for payload size %Lu", l), WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
-		payloadLength = static_cast<int>(l);
-		payloadOffset += 8;
-	}
-	else if ((lengthByte & 0x7f) == 126)
-	{
-		Poco::UInt16 l;
-		reader >> l;
-		if (l > length) throw WebSocketException(Poco::format("Insufficient buffer for payload size %hu", l), WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
-		payloadLength = static_cast<int>(l);
-		payloadOffset += 2;
+	Poco::UInt64 length = lengthByte;
+	if (lengthBytes > 0)
+	{
+		length = 0;
+		for (int i = 0; i < lengthBytes; i++)
+		{
+			length = (length << 8) | static_cast<Poco::UInt8>(header[2 + i]);
+		}
 	}
-	else
+	if (length > static_cast<Poco::UInt64>(_maxPayloadSize))
+		throw WebSocketException(Poco::format("Payload size %Lu exceeds maximum payload size", length), WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	payloadLength = static_cast<int>(length);
+	if (useMask)
 	{
-		Poco::UInt8 l = lengthByte & 0x7f;
-		if (l > length) throw WebSocketException(Poco::format("Insufficient buffer for payload size %u", unsigned(l)), WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
-		payloadLength = static_cast<int>(l);
+		std::memcpy(mask, header + 2 + lengthBytes, 4);
 	}
-	if (lengthByte & FRAME_FLAG_MASK)
+	int extra = 2 + toRead - headerLength;
+	if (extra > 0)
 	{
-		reader.readRaw(mask, 4);
-		payloadOffset += 4;
+		std::memcpy(_recvBuffer.begin(), header + headerLength, extra);
+		_recvOffset = 0;
+		_recvEnd = extra;
 	}
-	int received = 0;
-	if (payloadOffset < n)
+	return headerLength;
+}
+
+
+int WebSocketImpl::receivePayload(char* buffer, int payloadLength, const char* mask, bool useMask)
+{
+	if (payloadLength == 0) return 0;
+	int received = receiveNBytes(buffer, payloadLength);
+	if (received <= 0) throw WebSocketException("Incomplete frame received", WebSocket::WS_ERR_INCOMPLETE_FRAME);
+	if (useMask)
 	{
-		std::memcpy(buffer, header + payloadOffset, n - payloadOffset);
-		received = n - payloadOffset;
+		maskPayload(buffer, buffer, received, mask);
 	}
-	if (received < payloadLength)
+	return received;
+}
+
+
+bool WebSocketImpl::mustInflate()
+{
+	if (!_pDeflate) return false;
+
+	bool compressed = false;
+	int opcode = _frameFlags & WebSocket::FRAME_OP_BITMASK;
+	bool fin = (_frameFlags & WebSocket::FRAME_FLAG_FIN) != 0;
+	if (opcode == WebSocket::FRAME_OP_TEXT || opcode == WebSocket::FRAME_OP_BINARY)
 	{
-		n = receiveNBytes(reinterpret_cast<char*>(buffer) + received, payloadLength - received);
-		if (n <= 0) throw WebSocketException("Incomplete frame received", WebSocket::WS_ERR_INCOMPLETE_FRAME);
-		received += n;
+		compressed = (_frameFlags & WebSocket::FRAME_FLAG_RSV1) != 0;
+		_inflating = compressed && !fin;
 	}
-	if (lengthByte & FRAME_FLAG_MASK)
+	else if (opcode == WebSocket::FRAME_OP_CONT)
 	{
-		char* p = reinterpret_cast<char*>(buffer);
-		for (int i = 0; i < received; i++)
-		{
-			p[i] ^= mask[i % 4];
-		}
+		compressed = _inflating;
+		if (fin) _inflating = false;
 	}
-	return received;
+	if (compressed) _frameFlags &= ~WebSocket::FRAME_FLAG_RSV1;
+	return compressed;
+}
+
+
+int WebSocketImpl::receiveCompressedPayload(int payloadLength, const char* mask, bool useMask)
+{
+	if (_inflateBuffer.capacity() < static_cast<std::size_t>(payloadLength))
+		_inflateBuffer.setCapacity(payloadLength, false);
+	_inflateBuffer.resize(payloadLength, false);
+	return receivePayload(_inflateBuffer.begin(), payloadLength, mask, useMask);
 }
 
 
 int WebSocketImpl::receiveNBytes(void* buffer, int bytes)
 {
-	int received = _pStreamSocketImpl->receiveBytes(reinterpret_cast<char*>(buffer), bytes);
+	int received = receiveSomeBytes(reinterpret_cast<char*>(buffer), bytes);
 	if (received > 0)
 	{
 		while (received < bytes)
 		{
-			int n = _pStreamSocketImpl->receiveBytes(reinterpret_cast<char*>(buffer) + received, bytes - received);
+			int n = receiveSomeBytes(reinterpret_cast<char*>(buffer) + received, bytes - received);
 			if (n > 0)
 				received += n;
 			else
@@ -219,6 +351,115 @@ int WebSocketImpl::receiveNBytes(void* buffer, int bytes)
 }
 
 
+int WebSocketImpl::receiveSomeBytes(char* buffer, int bytes)
+{
+	int n = _recvEnd - _recvOffset;
+	if (n == 0 && _readAheadSize > 0 && bytes < _readAheadSize)
+	{
+		n = _pStreamSocketImpl->receiveBytes(_recvBuffer.begin(), _readAheadSize);
+		if (n <= 0) return n;
+		_recvOffset = 0;
+		_recvEnd = n;
+	}
+	if (n > 0)
+	{
+		if (n > bytes) n = bytes;
+		std::memcpy(buffer, _recvBuffer.begin() + _recvOffset, n);
+		_recvOffset += n;
+		return n;
+	}
+	return _pStreamSocketImpl->receiveBytes(buffer, bytes);
+}
+
+
+int WebSocketImpl::available()
+{
+	return (_recvEnd - _recvOffset) + _pStreamSocketImpl->available();
+}
+
+
+void WebSocketImpl::setMaxPayloadSize(int maxPayloadSize)
+{
+	poco_assert (maxPayloadSize > 0);
+
+	_maxPayloadSize = maxPayloadSize;
+}
+
+
+void WebSocketImpl::setReadAheadSize(int size)
+{
+	poco_assert (size >= 0);
+
+	int pending = _recvEnd - _recvOffset;
+	if (pending > 0 && _recvOffset > 0)
+	{
+		std::memmove(_recvBuffer.begin(), _recvBuffer.begin() + _recvOffset, pending);
+	}
+	_recvOffset = 0;
+	_recvEnd = pending;
+	std::size_t capacity = size;
+	if (capacity < MAX_HEADER_LENGTH) capacity = MAX_HEADER_LENGTH;
+	if (capacity < static_cast<std::size_t>(pending)) capacity = pending;
+	_recvBuffer.setCapacity(capacity, true);
+	_readAheadSize = size;
+}
+
+
+void WebSocketImpl::setPerMessageDeflate(PerMessageDeflate* pDeflate)
+{
+	poco_check_ptr (pDeflate);
+
+	try
+	{
+		pDeflate->init(!_mustMaskPayload);
+	}
+	catch (...)
+	{
+		delete pDeflate;
+		throw;
+	}
+	delete _pDeflate;
+	_pDeflate = pDeflate;
+	_deflating = false;
+	_inflating = false;
+}
+
+
+void WebSocketImpl::maskPayload(char* dest, const char* src, std::size_t length, const char* mask, std::size_t offset)
+{
+	// Replicate the key so that it lines up with
+	// the first byte, then process 16 (SSE2) or
+	// 8 bytes at a time.
+	char key[16];
+	for (int i = 0; i < 16; i++)
+	{
+		key[i] = mask[(offset + i) & 3];
+	}
+	std::size_t i = 0;
+#if defined(POCO_NET_HAVE_SSE2)
+	const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_xor_si128(v, k));
+	}
+#endif
+	Poco::UInt64 k64;
+	std::memcpy(&k64, key, sizeof(k64));
+	for (; i + 8 <= length; i += 8)
+	{
+		Poco::UInt64 v;
+		std::memcpy(&v, src + i, sizeof(v));
+		v ^= k64;
+		std::memcpy(dest + i, &v, sizeof(v));
+	}
+	for (; i < length; i++)
+	{
+		dest[i] = src[i] ^ key[i & 15];
+	}
+}
+
+
 SocketImpl* WebSocketImpl::acceptConnection(SocketAddress& clientAddr)
 {
 	throw Poco::InvalidAccessException("Cannot acceptConnection() on a WebSocketImpl");
@@ -304,6 +545,26 @@ void WebSocketImpl::sendUrgent(unsigned char data)
 }
 
 
+int WebSocketImpl::sendBytes(const SocketBuf* buffers, int count, int flags)
+{
+	throw Poco::InvalidAccessException("Cannot sendBytes() multiple buffers on a WebSocketImpl");
+}
+
+
+int WebSocketImpl::receiveBytes(SocketBuf* buffers, int count, int flags)
+{
+	throw Poco::InvalidAccessException("Cannot receiveBytes() multiple buffers on a WebSocketImpl");
+}
+
+
+#if defined(POCO_OS_FAMILY_UNIX)
+Poco::UInt64 WebSocketImpl::sendFile(int fd, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	throw Poco::InvalidAccessException("Cannot sendFile() on a WebSocketImpl");
+}
+#endif
+
+
 bool WebSocketImpl::secure() const
 {
 	return _pStreamSocketImpl->secure();
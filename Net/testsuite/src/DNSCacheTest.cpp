@@ -0,0 +1,323 @@
+//
+// DNSCacheTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/DNSCacheTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "DNSCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/DNSCache.h"
+#include "Poco/Net/DNS.h"
+#include "Poco/Net/HostEntry.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Thread.h"
+
+
+using Poco::Net::DNSCache;
+using Poco::Net::DNS;
+using Poco::Net::IPAddress;
+using Poco::Net::HostEntry;
+using Poco::Net::SocketAddress;
+using Poco::Net::HostNotFoundException;
+using Poco::Net::DNSException;
+using Poco::SharedPtr;
+using Poco::Timespan;
+using Poco::Thread;
+
+
+namespace
+{
+	class StubDNSCache: public DNSCache
+		/// A DNSCache that answers queries with a fixed
+		/// address, or a fixed error.
+	{
+	public:
+		enum Error
+		{
+			ERR_NONE,
+			ERR_NOT_FOUND,
+			ERR_TEMPORARY
+		};
+
+		StubDNSCache(const Timespan& ttl, const Timespan& negativeTTL):
+			DNSCache(ttl, negativeTTL),
+			_address("10.0.0.1"),
+			_error(ERR_NONE),
+			_queries(0)
+		{
+		}
+
+		~StubDNSCache()
+		{
+			waitForCompletion();
+		}
+
+		void setAddress(const std::string& address)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_address = address;
+		}
+
+		void setError(Error error)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_error = error;
+		}
+
+		int queries()
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _queries;
+		}
+
+	protected:
+		HostEntry query(const std::string& hostname)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			++_queries;
+			switch (_error)
+			{
+			case ERR_NOT_FOUND:
+				throw HostNotFoundException(hostname);
+			case ERR_TEMPORARY:
+				throw DNSException("Temporary DNS error while resolving", hostname);
+			default:
+				return HostEntry(hostname, IPAddress(_address));
+			}
+		}
+
+	private:
+		std::string _address;
+		Error _error;
+		int _queries;
+		Poco::FastMutex _mutex;
+	};
+}
+
+
+DNSCacheTest::DNSCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+DNSCacheTest::~DNSCacheTest()
+{
+}
+
+
+void DNSCacheTest::testResolve()
+{
+	StubDNSCache cache(Timespan(60, 0), Timespan(10, 0));
+	HostEntry he = cache.resolve("www.example.com");
+	assert (he.name() == "www.example.com");
+	assert (he.addresses().size() == 1);
+	assert (he.addresses()[0].toString() == "10.0.0.1");
+	assert (cache.queries() == 1);
+
+	he = cache.resolve("www.example.com");
+	assert (he.addresses()[0].toString() == "10.0.0.1");
+	assert (cache.queries() == 1);
+
+	cache.resolve("mail.example.com");
+	assert (cache.queries() == 2);
+	assert (cache.size() == 2);
+
+	cache.remove("www.example.com");
+	cache.resolve("www.example.com");
+	assert (cache.queries() == 3);
+
+	cache.clear();
+	assert (cache.size() == 0);
+}
+
+
+void DNSCacheTest::testExpire()
+{
+	StubDNSCache cache(Timespan(0, 200000), Timespan(10, 0));
+	cache.resolve("www.example.com");
+	cache.resolve("www.example.com");
+	assert (cache.queries() == 1);
+
+	Thread::sleep(300);
+	cache.setAddress("10.0.0.2");
+	HostEntry he = cache.resolve("www.example.com");
+	assert (he.addresses()[0].toString() == "10.0.0.2");
+	assert (cache.queries() == 2);
+}
+
+
+void DNSCacheTest::testNegative()
+{
+	StubDNSCache cache(Timespan(60, 0), Timespan(0, 200000));
+	cache.setError(StubDNSCache::ERR_NOT_FOUND);
+	try
+	{
+		cache.resolve("nohost.example.com");
+		fail("host not found - must throw");
+	}
+	catch (HostNotFoundException&)
+	{
+	}
+	assert (cache.queries() == 1);
+
+	cache.setError(StubDNSCache::ERR_NONE);
+	try
+	{
+		cache.resolve("nohost.example.com");
+		fail("negative entry - must throw");
+	}
+	catch (HostNotFoundException&)
+	{
+	}
+	assert (cache.queries() == 1);
+
+	Thread::sleep(300);
+	HostEntry he = cache.resolve("nohost.example.com");
+	assert (he.addresses()[0].toString() == "10.0.0.1");
+	assert (cache.queries() == 2);
+}
+
+
+void DNSCacheTest::testTemporaryError()
+{
+	StubDNSCache cache(Timespan(60, 0), Timespan(10, 0));
+	cache.setError(StubDNSCache::ERR_TEMPORARY);
+	try
+	{
+		cache.resolve("www.example.com");
+		fail("temporary error - must throw");
+	}
+	catch (DNSException&)
+	{
+	}
+	assert (cache.size() == 0);
+
+	cache.setError(StubDNSCache::ERR_NONE);
+	HostEntry he = cache.resolve("www.example.com");
+	assert (he.addresses()[0].toString() == "10.0.0.1");
+	assert (cache.queries() == 2);
+}
+
+
+void DNSCacheTest::testRefresh()
+{
+	StubDNSCache cache(Timespan(1, 0), Timespan(10, 0));
+	cache.resolve("www.example.com");
+	assert (cache.queries() == 1);
+
+	Thread::sleep(800);
+	cache.setAddress("10.0.0.2");
+	HostEntry he = cache.resolve("www.example.com");
+	// the current entry is returned while it is refreshed in the background
+	assert (he.addresses()[0].toString() == "10.0.0.1");
+	cache.waitForCompletion();
+	assert (cache.queries() == 2);
+
+	he = cache.resolve("www.example.com");
+	assert (he.addresses()[0].toString() == "10.0.0.2");
+	assert (cache.queries() == 2);
+}
+
+
+void DNSCacheTest::testResolveAsync()
+{
+	StubDNSCache cache(Timespan(60, 0), Timespan(10, 0));
+	DNSCache::Result result = cache.resolveAsync("www.example.com");
+	result.wait();
+	assert (!result.failed());
+	assert (result.data().addresses()[0].toString() == "10.0.0.1");
+	assert (cache.queries() == 1);
+
+	result = cache.resolveAsync("www.example.com");
+	assert (result.available());
+	assert (result.data().addresses()[0].toString() == "10.0.0.1");
+	assert (cache.queries() == 1);
+
+	cache.setError(StubDNSCache::ERR_NOT_FOUND);
+	result = cache.resolveAsync("nohost.example.com");
+	result.wait();
+	assert (result.failed());
+	assert (dynamic_cast<HostNotFoundException*>(result.exception()) != 0);
+
+	result = cache.resolveAsync("nohost.example.com");
+	assert (result.available());
+	assert (result.failed());
+	assert (cache.queries() == 2);
+}
+
+
+void DNSCacheTest::testInstall()
+{
+	SharedPtr<StubDNSCache> pCache = new StubDNSCache(Timespan(60, 0), Timespan(10, 0));
+	DNS::setCache(pCache);
+	assert (DNS::getCache().get() == pCache.get());
+
+	SocketAddress sa1("www.example.com", 80);
+	assert (sa1.host().toString() == "10.0.0.1");
+	SocketAddress sa2("www.example.com", 8080);
+	assert (sa2.host().toString() == "10.0.0.1");
+	assert (pCache->queries() == 1);
+
+	DNS::flushCache();
+	assert (pCache->size() == 0);
+
+	DNS::setCache(0);
+	assert (DNS::getCache().isNull());
+}
+
+
+void DNSCacheTest::setUp()
+{
+}
+
+
+void DNSCacheTest::tearDown()
+{
+	DNS::setCache(0);
+}
+
+
+CppUnit::Test* DNSCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("DNSCacheTest");
+
+	CppUnit_addTest(pSuite, DNSCacheTest, testResolve);
+	CppUnit_addTest(pSuite, DNSCacheTest, testExpire);
+	CppUnit_addTest(pSuite, DNSCacheTest, testNegative);
+	CppUnit_addTest(pSuite, DNSCacheTest, testTemporaryError);
+	CppUnit_addTest(pSuite, DNSCacheTest, testRefresh);
+	CppUnit_addTest(pSuite, DNSCacheTest, testResolveAsync);
+	CppUnit_addTest(pSuite, DNSCacheTest, testInstall);
+
+	return pSuite;
+}
@@ -0,0 +1,567 @@
+//
+// HTTPAsyncClientTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/HTTPAsyncClientTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "HTTPAsyncClientTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "HTTPAsyncClientTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPAsyncClient.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Observer.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include <vector>
+#include <set>
+
+
+using Poco::Net::HTTPAsyncClient;
+using Poco::Net::SocketReactor;
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::WritableNotification;
+using Poco::StreamCopier;
+using Poco::NumberFormatter;
+using Poco::ActiveResult;
+using Poco::Timespan;
+
+
+namespace
+{
+	class TestRequestHandler: public HTTPRequestHandler
+		/// Responds with the client's port number, which
+		/// identifies the connection, or echoes the request body.
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string body;
+			if (request.getURI() == "/echo")
+			{
+				StreamCopier::copyToString(request.stream(), body);
+			}
+			else
+			{
+				body = NumberFormatter::format(request.clientAddress().port());
+			}
+			response.setContentType("text/plain");
+			if (request.getURI() == "/chunked")
+				response.setChunkedTransferEncoding(true);
+			else
+				response.setContentLength(body.length());
+			if (request.getURI() == "/close")
+				response.setKeepAlive(false);
+			if (request.getMethod() == HTTPRequest::HTTP_HEAD)
+				response.send();
+			else
+				response.send() << body;
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			return new TestRequestHandler;
+		}
+	};
+
+	class ReactorThread
+		/// Runs a SocketReactor for the lifetime of the object.
+	{
+	public:
+		ReactorThread(SocketReactor& reactor):
+			_reactor(reactor)
+		{
+			_thread.start(_reactor);
+		}
+
+		~ReactorThread()
+		{
+			_reactor.stop();
+			_thread.join();
+		}
+
+	private:
+		SocketReactor& _reactor;
+		Poco::Thread _thread;
+	};
+
+	class TestCallback: public HTTPAsyncClient::Callback
+	{
+	public:
+		TestCallback(int expected):
+			_expected(expected),
+			_responses(0),
+			_errors(0)
+		{
+		}
+
+		void onResponse(HTTPAsyncClient::Response& response)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_bodies.insert(response.body());
+			++_responses;
+			if (_responses + _errors == _expected) _done.set();
+		}
+
+		void onError(const Poco::Exception& exc)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			++_errors;
+			if (_responses + _errors == _expected) _done.set();
+		}
+
+		void wait()
+		{
+			_done.wait(10000);
+		}
+
+		int responses() const
+		{
+			return _responses;
+		}
+
+		int errors() const
+		{
+			return _errors;
+		}
+
+		const std::set<std::string>& bodies() const
+		{
+			return _bodies;
+		}
+
+	private:
+		int _expected;
+		int _responses;
+		int _errors;
+		std::set<std::string> _bodies;
+		Poco::FastMutex _mutex;
+		Poco::Event _done;
+	};
+
+	class BusyHandler
+		/// Keeps a SocketReactor busy by handling the
+		/// writable events of an idle connection.
+	{
+	public:
+		void onWritable(WritableNotification* pNf)
+		{
+			pNf->release();
+		}
+	};
+
+	ActiveResult<HTTPAsyncClient::Response> get(HTTPAsyncClient& client, Poco::UInt16 port, const std::string& uri)
+	{
+		HTTPRequest request(HTTPRequest::HTTP_GET, uri, HTTPMessage::HTTP_1_1);
+		return client.sendRequest("localhost", port, request);
+	}
+}
+
+
+HTTPAsyncClientTest::HTTPAsyncClientTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPAsyncClientTest::~HTTPAsyncClientTest()
+{
+}
+
+
+void HTTPAsyncClientTest::testGet()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	ActiveResult<HTTPAsyncClient::Response> result = get(client, svs.address().port(), "/");
+	result.wait(10000);
+	assert (!result.failed());
+	assert (result.data().getStatus() == HTTPResponse::HTTP_OK);
+	assert (result.data().getContentType() == "text/plain");
+	std::string connection = result.data().body();
+	assert (!connection.empty());
+
+	ActiveResult<HTTPAsyncClient::Response> result2 = get(client, svs.address().port(), "/");
+	result2.wait(10000);
+	assert (!result2.failed());
+	assert (result2.data().body() == connection);
+	assert (client.connections() == 1);
+	assert (client.pending() == 0);
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testPost()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	std::string body(100000, 'x');
+	HTTPRequest request(HTTPRequest::HTTP_POST, "/echo", HTTPMessage::HTTP_1_1);
+	ActiveResult<HTTPAsyncClient::Response> result = client.sendRequest("localhost", svs.address().port(), request, body);
+	assert (request.getContentLength() == body.size());
+	assert (request.getHost() == "localhost:" + NumberFormatter::format(svs.address().port()));
+	result.wait(10000);
+	assert (!result.failed());
+	assert (result.data().body() == body);
+
+	HTTPRequest emptyRequest(HTTPRequest::HTTP_POST, "/echo", HTTPMessage::HTTP_1_1);
+	ActiveResult<HTTPAsyncClient::Response> result2 = client.sendRequest("localhost", svs.address().port(), emptyRequest);
+	assert (emptyRequest.getContentLength() == 0);
+	result2.wait(10000);
+	assert (!result2.failed());
+	assert (result2.data().body().empty());
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testMaxResponseSize()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+	assert (client.getMaxResponseSize() == HTTPAsyncClient::DEFAULT_MAX_RESPONSE_SIZE);
+	client.setMaxResponseSize(1000);
+	assert (client.getMaxResponseSize() == 1000);
+
+	std::string body(1001, 'x');
+	HTTPRequest request(HTTPRequest::HTTP_POST, "/echo", HTTPMessage::HTTP_1_1);
+	ActiveResult<HTTPAsyncClient::Response> result = client.sendRequest("localhost", svs.address().port(), request, body);
+	result.wait(10000);
+	assert (result.failed());
+	assert (dynamic_cast<Poco::Net::MessageException*>(result.exception()) != 0);
+
+	body.resize(1000);
+	HTTPRequest request2(HTTPRequest::HTTP_POST, "/echo", HTTPMessage::HTTP_1_1);
+	ActiveResult<HTTPAsyncClient::Response> result2 = client.sendRequest("localhost", svs.address().port(), request2, body);
+	result2.wait(10000);
+	assert (!result2.failed());
+	assert (result2.data().body() == body);
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testChunked()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	ActiveResult<HTTPAsyncClient::Response> result = get(client, svs.address().port(), "/chunked");
+	result.wait(10000);
+	assert (!result.failed());
+	assert (result.data().getChunkedTransferEncoding());
+	assert (!result.data().body().empty());
+
+	HTTPRequest request(HTTPRequest::HTTP_POST, "/echo", HTTPMessage::HTTP_1_1);
+	request.setChunkedTransferEncoding(true);
+	ActiveResult<HTTPAsyncClient::Response> result2 = client.sendRequest("localhost", svs.address().port(), request, "chunked request body");
+	result2.wait(10000);
+	assert (!result2.failed());
+	assert (result2.data().body() == "chunked request body");
+	assert (result2.data().body() != result.data().body());
+
+	ActiveResult<HTTPAsyncClient::Response> result3 = get(client, svs.address().port(), "/");
+	result3.wait(10000);
+	assert (!result3.failed());
+	assert (result3.data().body() == result.data().body());
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testHead()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	HTTPRequest request(HTTPRequest::HTTP_HEAD, "/", HTTPMessage::HTTP_1_1);
+	ActiveResult<HTTPAsyncClient::Response> result = client.sendRequest("localhost", svs.address().port(), request);
+	result.wait(10000);
+	assert (!result.failed());
+	assert (result.data().hasContentLength());
+	assert (result.data().body().empty());
+
+	ActiveResult<HTTPAsyncClient::Response> result2 = get(client, svs.address().port(), "/");
+	result2.wait(10000);
+	assert (!result2.failed());
+	assert (result2.data().body().length() == result.data().getContentLength());
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testConcurrent()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	std::vector<ActiveResult<HTTPAsyncClient::Response> > results;
+	for (int i = 0; i < 50; ++i)
+	{
+		results.push_back(get(client, svs.address().port(), "/"));
+	}
+	assert (client.connections() <= HTTPAsyncClient::DEFAULT_MAX_CONNECTIONS_PER_ENDPOINT);
+	std::set<std::string> connections;
+	for (std::vector<ActiveResult<HTTPAsyncClient::Response> >::iterator it = results.begin(); it != results.end(); ++it)
+	{
+		it->wait(10000);
+		assert (!it->failed());
+		connections.insert(it->data().body());
+	}
+	assert (connections.size() <= HTTPAsyncClient::DEFAULT_MAX_CONNECTIONS_PER_ENDPOINT);
+	assert (client.pending() == 0);
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testCallback()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	TestCallback* pCallback = new TestCallback(10);
+	HTTPAsyncClient::CallbackPtr pPtr(pCallback);
+	for (int i = 0; i < 10; ++i)
+	{
+		HTTPRequest request(HTTPRequest::HTTP_POST, "/echo", HTTPMessage::HTTP_1_1);
+		client.sendRequest("localhost", svs.address().port(), request, NumberFormatter::format(i), pPtr);
+	}
+	pCallback->wait();
+	assert (pCallback->responses() == 10);
+	assert (pCallback->errors() == 0);
+	assert (pCallback->bodies().size() == 10);
+	assert (pCallback->bodies().count("9") == 1);
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testPipelining()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	client.setMaxConnectionsPerEndpoint(1);
+	client.setPipelineDepth(8);
+	ReactorThread thread(reactor);
+
+	std::vector<ActiveResult<HTTPAsyncClient::Response> > results;
+	for (int i = 0; i < 20; ++i)
+	{
+		results.push_back(get(client, svs.address().port(), "/"));
+	}
+	assert (client.connections() == 1);
+	std::set<std::string> connections;
+	for (std::vector<ActiveResult<HTTPAsyncClient::Response> >::iterator it = results.begin(); it != results.end(); ++it)
+	{
+		it->wait(10000);
+		assert (!it->failed());
+		connections.insert(it->data().body());
+	}
+	assert (connections.size() == 1);
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testConnectionClose()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	client.setMaxConnectionsPerEndpoint(2);
+	ReactorThread thread(reactor);
+
+	std::vector<ActiveResult<HTTPAsyncClient::Response> > results;
+	for (int i = 0; i < 10; ++i)
+	{
+		results.push_back(get(client, svs.address().port(), "/close"));
+	}
+	std::set<std::string> connections;
+	for (std::vector<ActiveResult<HTTPAsyncClient::Response> >::iterator it = results.begin(); it != results.end(); ++it)
+	{
+		it->wait(10000);
+		assert (!it->failed());
+		assert (!it->data().getKeepAlive());
+		connections.insert(it->data().body());
+	}
+	assert (connections.size() == 10);
+	srv.stop();
+}
+
+
+void HTTPAsyncClientTest::testConnectionRefused()
+{
+	Poco::UInt16 port;
+	{
+		ServerSocket svs(0);
+		port = svs.address().port();
+	}
+
+	SocketReactor reactor(Timespan(0, 50000));
+	HTTPAsyncClient client(reactor);
+	ReactorThread thread(reactor);
+
+	ActiveResult<HTTPAsyncClient::Response> result = get(client, port, "/");
+	result.wait(10000);
+	assert (result.failed());
+	assert (dynamic_cast<Poco::Net::NetException*>(result.exception()) != 0);
+
+	TestCallback* pCallback = new TestCallback(1);
+	HTTPAsyncClient::CallbackPtr pPtr(pCallback);
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/", HTTPMessage::HTTP_1_1);
+	client.sendRequest("localhost", port, request, "", pPtr);
+	pCallback->wait();
+	assert (pCallback->errors() == 1);
+	assert (client.connections() == 0);
+	assert (client.pending() == 0);
+}
+
+
+void HTTPAsyncClientTest::testTimeoutBusyReactor()
+{
+	// The server never accepts the connection, so no
+	// response will ever arrive.
+	ServerSocket svs(0);
+
+	ServerSocket busySvs(0);
+	StreamSocket busy(busySvs.address());
+	StreamSocket busyPeer = busySvs.acceptConnection();
+	BusyHandler busyHandler;
+
+	SocketReactor reactor(Timespan(0, 50000));
+	reactor.addEventHandler(busy, Poco::Observer<BusyHandler, WritableNotification>(busyHandler, &BusyHandler::onWritable));
+	HTTPAsyncClient client(reactor);
+	client.setTimeout(Timespan(1, 0));
+	{
+		ReactorThread thread(reactor);
+		ActiveResult<HTTPAsyncClient::Response> result = get(client, svs.address().port(), "/");
+		result.wait(10000);
+		assert (result.available());
+		assert (result.failed());
+		assert (dynamic_cast<Poco::TimeoutException*>(result.exception()) != 0);
+	}
+	reactor.removeEventHandler(busy, Poco::Observer<BusyHandler, WritableNotification>(busyHandler, &BusyHandler::onWritable));
+}
+
+
+void HTTPAsyncClientTest::setUp()
+{
+}
+
+
+void HTTPAsyncClientTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPAsyncClientTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPAsyncClientTest");
+
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testGet);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testPost);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testMaxResponseSize);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testChunked);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testHead);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testConcurrent);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testCallback);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testPipelining);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testConnectionClose);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testConnectionRefused);
+	CppUnit_addTest(pSuite, HTTPAsyncClientTest, testTimeoutBusyReactor);
+
+	return pSuite;
+}
@@ -0,0 +1,361 @@
+//
+// HTTPClientSessionPoolTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/HTTPClientSessionPoolTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "HTTPClientSessionPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Exception.h"
+#include <sstream>
+
+
+using Poco::Net::HTTPClientSessionPool;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPSessionFactory;
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::StreamCopier;
+using Poco::NumberFormatter;
+using Poco::Timespan;
+using Poco::URI;
+
+
+namespace
+{
+	class ClientPortRequestHandler: public HTTPRequestHandler
+		/// Responds with the client's port number, which
+		/// identifies the connection.
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string port = NumberFormatter::format(request.clientAddress().port());
+			response.setContentType("text/plain");
+			response.setContentLength(port.length());
+			response.send() << port;
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			return new ClientPortRequestHandler;
+		}
+	};
+
+	std::string get(HTTPClientSession& session, bool keepAlive = true)
+	{
+		HTTPRequest request(HTTPRequest::HTTP_GET, "/", HTTPMessage::HTTP_1_1);
+		request.setKeepAlive(keepAlive);
+		session.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = session.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		return ostr.str();
+	}
+
+	class Returner: public Poco::Runnable
+	{
+	public:
+		Returner(HTTPClientSessionPool& pool, HTTPClientSession* pSession):
+			_pool(pool),
+			_pSession(pSession)
+		{
+		}
+
+		void run()
+		{
+			Poco::Thread::sleep(200);
+			_pool.returnSession(_pSession);
+		}
+
+	private:
+		HTTPClientSessionPool& _pool;
+		HTTPClientSession* _pSession;
+	};
+}
+
+
+HTTPClientSessionPoolTest::HTTPClientSessionPoolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPClientSessionPoolTest::~HTTPClientSessionPoolTest()
+{
+}
+
+
+void HTTPClientSessionPoolTest::testReuse()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri("http://localhost:" + NumberFormatter::format(svs.address().port()) + "/");
+	std::string connection;
+	{
+		HTTPClientSessionPool::ScopedSession session(pool, uri);
+		assert (session->getKeepAlive());
+		assert (pool.borrowed() == 1);
+		connection = get(*session);
+	}
+	assert (pool.borrowed() == 0);
+	assert (pool.idle() == 1);
+	{
+		HTTPClientSessionPool::ScopedSession session1(pool, uri);
+		assert (pool.idle() == 0);
+		assert (get(*session1) == connection);
+
+		HTTPClientSessionPool::ScopedSession session2(pool, uri);
+		assert (&session1.session() != &session2.session());
+		assert (get(*session2) != connection);
+		assert (pool.borrowed() == 2);
+	}
+	assert (pool.idle() == 2);
+	pool.clear();
+	assert (pool.idle() == 0);
+	srv.stop();
+}
+
+
+void HTTPClientSessionPoolTest::testEndpoints()
+{
+	ServerSocket svs1(0);
+	HTTPServer srv1(new RequestHandlerFactory, svs1, new HTTPServerParams);
+	srv1.start();
+	ServerSocket svs2(0);
+	HTTPServer srv2(new RequestHandlerFactory, svs2, new HTTPServerParams);
+	srv2.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 1, Timespan(30, 0), Timespan(0, 100000));
+	URI uri1("http://localhost:" + NumberFormatter::format(svs1.address().port()) + "/a");
+	URI uri2("http://LOCALHOST:" + NumberFormatter::format(svs2.address().port()) + "/b");
+	HTTPClientSession* pSession1 = pool.borrowSession(uri1);
+	HTTPClientSession* pSession2 = pool.borrowSession(uri2);
+	assert (pSession1->getPort() == svs1.address().port());
+	assert (pSession2->getPort() == svs2.address().port());
+	get(*pSession1);
+	get(*pSession2);
+	pool.returnSession(pSession1);
+	pool.returnSession(pSession2);
+	assert (pool.borrowSession(URI("http://localhost:" + NumberFormatter::format(svs2.address().port()) + "/c")) == pSession2);
+	pool.returnSession(pSession2);
+
+	try
+	{
+		pool.borrowSession(URI("ftp://localhost/"));
+		fail ("unknown scheme - must throw");
+	}
+	catch (Poco::UnknownURISchemeException&)
+	{
+	}
+	try
+	{
+		HTTPClientSession session;
+		pool.returnSession(&session);
+		fail ("not borrowed - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	srv1.stop();
+	srv2.stop();
+}
+
+
+void HTTPClientSessionPoolTest::testWaitTimeout()
+{
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 2, Timespan(30, 0), Timespan(0, 100000));
+	URI uri("http://localhost:80/");
+	HTTPClientSessionPool::ScopedSession session1(pool, uri);
+	HTTPClientSessionPool::ScopedSession session2(pool, uri);
+	try
+	{
+		HTTPClientSessionPool::ScopedSession session3(pool, uri);
+		fail ("pool exhausted - must throw");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+	session2.discard();
+	assert (pool.borrowed() == 1);
+	HTTPClientSessionPool::ScopedSession session3(pool, uri);
+	assert (pool.borrowed() == 2);
+}
+
+
+void HTTPClientSessionPoolTest::testWaitReturn()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 1, Timespan(30, 0), Timespan(5, 0));
+	URI uri("http://localhost:" + NumberFormatter::format(svs.address().port()) + "/");
+	HTTPClientSession* pSession = pool.borrowSession(uri);
+	get(*pSession);
+
+	Returner returner(pool, pSession);
+	Poco::Thread thread;
+	thread.start(returner);
+	HTTPClientSession* pSession2 = pool.borrowSession(uri);
+	thread.join();
+	assert (pSession2 == pSession);
+	get(*pSession2);
+	pool.returnSession(pSession2);
+	srv.stop();
+}
+
+
+void HTTPClientSessionPoolTest::testHealthCheck()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAliveTimeout(Timespan(0, 100000));
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri("http://localhost:" + NumberFormatter::format(svs.address().port()) + "/");
+	std::string connection;
+	{
+		HTTPClientSessionPool::ScopedSession session(pool, uri);
+		connection = get(*session);
+	}
+	// wait until the server has closed the idle connection
+	Poco::Thread::sleep(500);
+	{
+		HTTPClientSessionPool::ScopedSession session(pool, uri);
+		assert (!session->connected());
+		std::string connection2 = get(*session);
+		assert (!connection2.empty());
+		assert (connection2 != connection);
+	}
+	srv.stop();
+}
+
+
+void HTTPClientSessionPoolTest::testIdleEviction()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(0, 200000), Timespan(1, 0));
+	URI uri("http://localhost:" + NumberFormatter::format(svs.address().port()) + "/");
+	{
+		HTTPClientSessionPool::ScopedSession session1(pool, uri);
+		HTTPClientSessionPool::ScopedSession session2(pool, uri);
+		get(*session1);
+		get(*session2);
+	}
+	assert (pool.idle() == 2);
+	pool.evictIdle();
+	assert (pool.idle() == 2);
+	Poco::Thread::sleep(300);
+	pool.evictIdle();
+	assert (pool.idle() == 0);
+	srv.stop();
+}
+
+
+void HTTPClientSessionPoolTest::testNoKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri("http://localhost:" + NumberFormatter::format(svs.address().port()) + "/");
+	{
+		HTTPClientSessionPool::ScopedSession session(pool, uri);
+		session->setKeepAlive(false);
+		get(*session, false);
+	}
+	assert (pool.idle() == 0);
+	assert (pool.borrowed() == 0);
+	srv.stop();
+}
+
+
+void HTTPClientSessionPoolTest::setUp()
+{
+}
+
+
+void HTTPClientSessionPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPClientSessionPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPClientSessionPoolTest");
+
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testReuse);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testEndpoints);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testWaitTimeout);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testWaitReturn);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testHealthCheck);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testIdleEviction);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testNoKeepAlive);
+
+	return pSuite;
+}
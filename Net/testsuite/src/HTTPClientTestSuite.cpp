@@ -33,6 +33,8 @@
 #include "HTTPClientTestSuite.h"
 #include "HTTPClientSessionTest.h"
 #include "HTTPStreamFactoryTest.h"
+#include "HTTPClientSessionPoolTest.h"
+#include "HTTPAsyncClientTest.h"
 
 
 CppUnit::Test* HTTPClientTestSuite::suite()
@@ -41,6 +43,8 @@ CppUnit::Test* HTTPClientTestSuite::suite()
 
 	pSuite->addTest(HTTPClientSessionTest::suite());
 	pSuite->addTest(HTTPStreamFactoryTest::suite());
+	pSuite->addTest(HTTPClientSessionPoolTest::suite());
+	pSuite->addTest(HTTPAsyncClientTest::suite());
 
 	return pSuite;
 }
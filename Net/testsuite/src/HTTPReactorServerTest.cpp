@@ -0,0 +1,591 @@
+//
+// HTTPReactorServerTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/HTTPReactorServerTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+
+
+#include "HTTPReactorServerTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPReactorServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPReactorServerConnection.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketStream.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include <sstream>
+#include <stdexcept>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+using Poco::Net::HTTPReactorServer;
+using Poco::Net::HTTPReactorServerConnection;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketStream;
+using Poco::Net::SocketAddress;
+using Poco::StreamCopier;
+
+
+namespace
+{
+	class EchoBodyRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			if (request.getChunkedTransferEncoding())
+				response.setChunkedTransferEncoding(true);
+			else if (request.getContentLength() != HTTPMessage::UNKNOWN_CONTENT_LENGTH)
+				response.setContentLength(request.getContentLength());
+			
+			response.setContentType(request.getContentType());
+			
+			std::istream& istr = request.stream();
+			std::ostream& ostr = response.send();
+			StreamCopier::copyStream(istr, ostr);
+		}
+	};
+
+	class EchoURIRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			const std::string& uri = request.getURI();
+			response.sendBuffer(uri.data(), uri.length());
+		}
+	};
+
+	class ThrowRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest&, HTTPServerResponse&)
+		{
+			throw std::runtime_error("handler failed");
+		}
+	};
+
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string path = request.get("X-File");
+#if defined(POCO_OS_FAMILY_UNIX)
+			if (request.getURI() == "/fileFd")
+			{
+				// the descriptor is closed before the file is sent
+				int fd = ::open(path.c_str(), O_RDONLY);
+				try
+				{
+					response.sendFile(fd, 10, 1000, "application/octet-stream");
+				}
+				catch (...)
+				{
+					::close(fd);
+					throw;
+				}
+				::close(fd);
+				return;
+			}
+#endif
+			response.sendFile(path, "application/octet-stream");
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			if (request.getURI() == "/echoBody")
+				return new EchoBodyRequestHandler;
+			else if (request.getURI().compare(0, 5, "/file") == 0)
+				return new FileRequestHandler;
+			else if (request.getURI() == "/throw")
+				return new ThrowRequestHandler;
+			else if (request.getURI().compare(0, 5, "/echo") == 0)
+				return new EchoURIRequestHandler;
+			else
+				return 0;
+		}
+	};
+}
+
+
+HTTPReactorServerTest::HTTPReactorServerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPReactorServerTest::~HTTPReactorServerTest()
+{
+}
+
+
+void HTTPReactorServerTest::testIdentityRequest()
+{
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), pParams, 1);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", srv.port());
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody");
+	request.setContentLength((int) body.length());
+	request.setContentType("text/plain");
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getContentLength() == body.size());
+	assert (response.getContentType() == "text/plain");
+	assert (!response.getKeepAlive());
+	assert (rbody == body);
+}
+
+
+void HTTPReactorServerTest::testChunkedRequest()
+{
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), pParams, 1);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", srv.port());
+	std::string body(50000, 'x');
+	HTTPRequest request("POST", "/echoBody");
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getContentLength() == body.size());
+	assert (response.getContentType() == "text/plain");
+	assert (!response.getChunkedTransferEncoding());
+	assert (rbody == body);
+}
+
+
+void HTTPReactorServerTest::testSplitChunkedRequest()
+{
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), pParams, 1);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", srv.port()));
+	std::string request("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n");
+	// Send the request in small pieces, splitting the header,
+	// the chunk headers and the chunk data.
+	for (std::string::size_type pos = 0; pos < request.size(); pos += 7)
+	{
+		std::string piece(request, pos, 7);
+		ss.sendBytes(piece.data(), (int) piece.size());
+		Poco::Thread::sleep(10);
+	}
+
+	SocketStream str(ss);
+	HTTPResponse response;
+	response.read(str);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == 11);
+	std::string rbody;
+	StreamCopier::copyToString(str, rbody);
+	assert (rbody == "hello world");
+}
+
+
+void HTTPReactorServerTest::testRequestTooLarge()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", srv.port()));
+	std::string header("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Length: ");
+	header.append(Poco::NumberFormatter::format(static_cast<Poco::UInt64>(HTTPReactorServerConnection::MAX_BODY_LENGTH) + 1));
+	header.append("\r\n\r\n");
+	ss.sendBytes(header.data(), (int) header.size());
+
+	SocketStream str(ss);
+	HTTPResponse response;
+	response.read(str);
+	assert (response.getStatus() == HTTPResponse::HTTP_REQUESTENTITYTOOLARGE);
+	assert (!response.getKeepAlive());
+}
+
+
+void HTTPReactorServerTest::testHandlerException()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+
+	HTTPClientSession cs("localhost", srv.port());
+	HTTPRequest request("GET", "/throw", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getStatus() == HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+}
+
+
+void HTTPReactorServerTest::testIdentityRequestKeepAlive()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", srv.port());
+	cs.setKeepAlive(true);
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentLength((int) body.length());
+	request.setContentType("text/plain");
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getContentLength() == body.size());
+	assert (response.getContentType() == "text/plain");
+	assert (response.getKeepAlive());
+	assert (rbody == body);
+	
+	body.assign(1000, 'y');
+	request.setContentLength((int) body.length());
+	request.setKeepAlive(false);
+	cs.sendRequest(request) << body;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getContentLength() == body.size());
+	assert (response.getContentType() == "text/plain");
+	assert (!response.getKeepAlive());
+	assert (rbody == body);
+}
+
+
+void HTTPReactorServerTest::testMaxKeepAlive()
+{
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxKeepAliveRequests(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), pParams, 1);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", srv.port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/echo", HTTPMessage::HTTP_1_1);
+	request.setKeepAlive(true);
+
+	HTTPResponse response;
+	std::string rbody;
+	cs.sendRequest(request);
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getKeepAlive());
+	assert (rbody == "/echo");
+
+	cs.sendRequest(request);
+	cs.receiveResponse(response) >> rbody;
+	assert (!response.getKeepAlive());
+	assert (rbody == "/echo");
+}
+
+
+void HTTPReactorServerTest::testPipelinedRequests()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", srv.port()));
+	std::string requests;
+	requests.append("GET /echo1 HTTP/1.1\r\nHost: localhost\r\n\r\n");
+	requests.append("GET /echo2 HTTP/1.1\r\nHost: localhost\r\n\r\n");
+	requests.append("GET /echo3 HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+	ss.sendBytes(requests.data(), (int) requests.size());
+
+	SocketStream str(ss);
+	for (int i = 1; i <= 3; ++i)
+	{
+		HTTPResponse response;
+		response.read(str);
+		assert (response.getStatus() == HTTPResponse::HTTP_OK);
+		assert (response.getContentLength() == 6);
+		assert (response.getKeepAlive() == (i < 3));
+		std::string rbody(6, '\0');
+		str.read(&rbody[0], 6);
+		std::ostringstream expected;
+		expected << "/echo" << i;
+		assert (rbody == expected.str());
+	}
+	std::string rest;
+	StreamCopier::copyToString(str, rest);
+	assert (rest.empty());
+}
+
+
+void HTTPReactorServerTest::test100Continue()
+{
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), pParams, 1);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", srv.port()));
+	std::string header("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\nExpect: 100-continue\r\n\r\n");
+	ss.sendBytes(header.data(), (int) header.size());
+
+	SocketStream str(ss);
+	HTTPResponse response;
+	response.read(str);
+	assert (response.getStatus() == HTTPResponse::HTTP_CONTINUE);
+
+	ss.sendBytes("hello", 5);
+	response.read(str);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == 5);
+	std::string rbody;
+	StreamCopier::copyToString(str, rbody);
+	assert (rbody == "hello");
+}
+
+
+void HTTPReactorServerTest::testNotImpl()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", srv.port());
+	HTTPRequest request("GET", "/notImpl");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (response.getStatus() == HTTPResponse::HTTP_NOT_IMPLEMENTED);
+	assert (rbody.empty());
+}
+
+
+void HTTPReactorServerTest::testMultipleReactors()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 4);
+	assert (srv.reactors() == 4);
+	srv.start();
+
+	for (int i = 0; i < 20; ++i)
+	{
+		HTTPClientSession cs("localhost", srv.port());
+		HTTPRequest request("GET", "/echo", HTTPMessage::HTTP_1_1);
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assert (response.getStatus() == HTTPResponse::HTTP_OK);
+		assert (rbody == "/echo");
+	}
+
+	srv.stop();
+}
+
+
+void HTTPReactorServerTest::testRequestWithoutBody()
+{
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", srv.port()));
+	ss.setReceiveTimeout(Poco::Timespan(5, 0));
+	SocketStream str(ss);
+	for (int i = 0; i < 2; ++i)
+	{
+		// neither Content-Length nor Transfer-Encoding,
+		// so the request has no body
+		std::string request("DELETE /echo HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		ss.sendBytes(request.data(), (int) request.size());
+		HTTPResponse response;
+		response.read(str);
+		assert (response.getStatus() == HTTPResponse::HTTP_OK);
+		assert (response.getKeepAlive());
+		assert (response.getContentLength() == 5);
+		std::string rbody(5, '\0');
+		str.read(&rbody[0], 5);
+		assert (rbody == "/echo");
+	}
+}
+
+
+void HTTPReactorServerTest::testSendFile()
+{
+	Poco::TemporaryFile tempFile;
+	std::string data(300000, ' ');
+	for (std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<char>(i*13 + i/256);
+	{
+		Poco::FileOutputStream ostr(tempFile.path());
+		ostr.write(data.data(), data.size());
+	}
+
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), new HTTPServerParams, 1);
+	srv.start();
+
+	HTTPClientSession cs("localhost", srv.port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	request.set("X-File", tempFile.path());
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::ostringstream body;
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == data.size());
+	assert (response.has("Last-Modified"));
+	assert (body.str() == data);
+
+	HTTPRequest headRequest("HEAD", "/file", HTTPMessage::HTTP_1_1);
+	headRequest.set("X-File", tempFile.path());
+	cs.sendRequest(headRequest);
+	body.str("");
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == data.size());
+	assert (body.str().empty());
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	HTTPRequest fdRequest("GET", "/fileFd", HTTPMessage::HTTP_1_1);
+	fdRequest.set("X-File", tempFile.path());
+	cs.sendRequest(fdRequest);
+	body.str("");
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (body.str() == data.substr(10, 1000));
+#endif
+
+	// the connection is still usable after the files
+	HTTPRequest echoRequest("GET", "/echo", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(echoRequest);
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assert (rbody == "/echo");
+}
+
+
+void HTTPReactorServerTest::testSlowRequest()
+{
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setTimeout(Poco::Timespan(1, 0));
+	HTTPReactorServer srv(new RequestHandlerFactory, SocketAddress(0), pParams, 1);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", srv.port()));
+	std::string line("GET /echo HTTP/1.1\r\n");
+	ss.sendBytes(line.data(), (int) line.size());
+
+	// Keep the reactor busy with a header that never ends.
+	// The connection must still be closed once the
+	// timeout for receiving the request has expired.
+	Poco::Timestamp start;
+	bool closed = false;
+	while (!closed && !start.isElapsed(5000000))
+	{
+		line = "X-Slow: 1\r\n";
+		ss.sendBytes(line.data(), (int) line.size());
+		if (ss.poll(Poco::Timespan(0, 100000), Poco::Net::Socket::SELECT_READ))
+		{
+			char buffer[64];
+			try
+			{
+				closed = ss.receiveBytes(buffer, sizeof(buffer)) == 0;
+			}
+			catch (Poco::Exception&)
+			{
+				closed = true;
+			}
+		}
+	}
+	assert (closed);
+}
+
+
+void HTTPReactorServerTest::setUp()
+{
+}
+
+
+void HTTPReactorServerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPReactorServerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPReactorServerTest");
+
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testIdentityRequest);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testChunkedRequest);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testSplitChunkedRequest);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testRequestTooLarge);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testHandlerException);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testIdentityRequestKeepAlive);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testMaxKeepAlive);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testPipelinedRequests);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, test100Continue);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testNotImpl);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testMultipleReactors);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testRequestWithoutBody);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testSendFile);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testSlowRequest);
+
+	return pSuite;
+}
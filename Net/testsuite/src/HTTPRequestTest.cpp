@@ -174,6 +174,65 @@ void HTTPRequestTest::testRead4()
 }
 
 
+void HTTPRequestTest::testReadBuffer1()
+{
+	std::string s("\r\nPOST /test.cgi HTTP/1.1\r\nConnection: Close\r\nContent-Length:   100  \r\nHost: localhost:8000\r\n\r\nbody");
+	HTTPRequest request;
+	std::size_t n = request.read(s.data(), s.data() + s.size());
+	assert (n == s.size() - 4);
+	assert (request.getMethod() == HTTPRequest::HTTP_POST);
+	assert (request.getURI() == "/test.cgi");
+	assert (request.getVersion() == HTTPMessage::HTTP_1_1);
+	assert (request.size() == 3);
+	assert (request["Connection"] == "Close");
+	assert (request["Host"] == "localhost:8000");
+	assert (request.getContentLength() == 100);
+}
+
+
+void HTTPRequestTest::testReadBuffer2()
+{
+	std::string s("GET /index.html HTTP/1.1\r\nHost: localhost\r\n\r\n");
+	HTTPRequest request;
+	for (std::size_t i = 0; i < s.size(); ++i)
+	{
+		assert (request.read(s.data(), s.data() + i) == 0);
+		assert (request.empty());
+	}
+	assert (request.read(s.data(), s.data() + s.size()) == s.size());
+	assert (request.getMethod() == HTTPRequest::HTTP_GET);
+	assert (request.getURI() == "/index.html");
+	assert (request["Host"] == "localhost");
+}
+
+
+void HTTPRequestTest::testReadBufferInvalid()
+{
+	std::string s("GET ");
+	s.append(8000, 'x');
+	s.append(" HTTP/1.0\r\n\r\n");
+	HTTPRequest request;
+	try
+	{
+		request.read(s.data(), s.data() + s.size());
+		fail("inavalid request - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+	
+	s = "GET / HTTP/1.10\r\n\r\n";
+	try
+	{
+		request.read(s.data(), s.data() + s.size());
+		fail("inavalid request - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
 void HTTPRequestTest::testInvalid1()
 {
 	std::string s(256, 'x');
@@ -280,6 +339,9 @@ CppUnit::Test* HTTPRequestTest::suite()
 	CppUnit_addTest(pSuite, HTTPRequestTest, testRead2);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testRead3);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testRead4);
+	CppUnit_addTest(pSuite, HTTPRequestTest, testReadBuffer1);
+	CppUnit_addTest(pSuite, HTTPRequestTest, testReadBuffer2);
+	CppUnit_addTest(pSuite, HTTPRequestTest, testReadBufferInvalid);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid1);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid2);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid3);
@@ -54,6 +54,9 @@ public:
 	void testRead2();
 	void testRead3();
 	void testRead4();
+	void testReadBuffer1();
+	void testReadBuffer2();
+	void testReadBufferInvalid();
 	void testInvalid1();
 	void testInvalid2();
 	void testInvalid3();
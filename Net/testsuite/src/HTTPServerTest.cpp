@@ -43,8 +43,18 @@
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketStream.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Format.h"
 #include <sstream>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 
 using Poco::Net::HTTPServer;
@@ -59,6 +69,9 @@ using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::SocketInputStream;
 using Poco::StreamCopier;
 
 
@@ -126,6 +139,46 @@ namespace
 		}
 	};
 	
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string path = request.get("X-File");
+			std::string range = request.get("Range", "");
+			if (range.empty())
+			{
+				response.sendFile(path, "application/octet-stream");
+				return;
+			}
+			// bytes=first-last
+			std::string::size_type pos = range.find('-');
+			Poco::UInt64 first = Poco::NumberParser::parseUnsigned64(range.substr(6, pos - 6));
+			Poco::UInt64 last  = Poco::NumberParser::parseUnsigned64(range.substr(pos + 1));
+			Poco::UInt64 size  = Poco::File(path).getSize();
+			response.setStatusAndReason(HTTPResponse::HTTP_PARTIAL_CONTENT);
+			response.set("Content-Range", Poco::format("bytes %Lu-%Lu/%Lu", first, last, size));
+#if defined(POCO_OS_FAMILY_UNIX)
+			if (request.getURI() == "/fileFd")
+			{
+				int fd = ::open(path.c_str(), O_RDONLY);
+				try
+				{
+					response.sendFile(fd, first, last - first + 1, "application/octet-stream");
+				}
+				catch (...)
+				{
+					::close(fd);
+					throw;
+				}
+				::close(fd);
+				return;
+			}
+#endif
+			response.sendFile(path, first, last - first + 1, "application/octet-stream");
+		}
+	};
+
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
@@ -141,6 +194,8 @@ namespace
 				return new AuthRequestHandler();
 			else if (request.getURI() == "/buffer")
 				return new BufferRequestHandler();
+			else if (request.getURI() == "/file" || request.getURI() == "/fileFd")
+				return new FileRequestHandler();
 			else
 				return 0;
 		}
@@ -538,6 +593,132 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testFile()
+{
+	Poco::TemporaryFile tempFile;
+	std::string data(300000, ' ');
+	for (std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<char>(i*13 + i/256);
+	{
+		Poco::FileOutputStream ostr(tempFile.path());
+		ostr.write(data.data(), data.size());
+	}
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("localhost", svs.address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	request.set("X-File", tempFile.path());
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::ostringstream body;
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == data.size());
+	assert (response.has("Last-Modified"));
+	assert (body.str() == data);
+
+	// the connection is still usable after the file
+	HTTPRequest rangeRequest("GET", "/file", HTTPMessage::HTTP_1_1);
+	rangeRequest.set("X-File", tempFile.path());
+	rangeRequest.set("Range", "bytes=1000-200999");
+	cs.sendRequest(rangeRequest);
+	body.str("");
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assert (response.get("Content-Range") == "bytes 1000-200999/300000");
+	assert (response.getContentLength() == 200000);
+	assert (body.str() == data.substr(1000, 200000));
+
+	HTTPRequest fdRequest("GET", "/fileFd", HTTPMessage::HTTP_1_1);
+	fdRequest.set("X-File", tempFile.path());
+	fdRequest.set("Range", "bytes=299990-299999");
+	cs.sendRequest(fdRequest);
+	body.str("");
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assert (body.str() == data.substr(299990));
+
+	HTTPRequest headRequest("HEAD", "/file", HTTPMessage::HTTP_1_1);
+	headRequest.set("X-File", tempFile.path());
+	cs.sendRequest(headRequest);
+	body.str("");
+	StreamCopier::copyStream(cs.receiveResponse(response), body);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() == data.size());
+	assert (body.str().empty());
+
+	HTTPRequest badRequest("GET", "/file", HTTPMessage::HTTP_1_1);
+	badRequest.set("X-File", tempFile.path());
+	badRequest.set("Range", "bytes=299990-300000");
+	cs.sendRequest(badRequest);
+	cs.receiveResponse(response);
+	assert (response.getStatus() == HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+}
+
+
+void HTTPServerTest::testPipelining()
+{
+	HTTPServer srv(new RequestHandlerFactory, 8020);
+	srv.start();
+
+	// Send all requests at once, without waiting for responses.
+	std::string requests;
+	requests.append("GET /echoHeader HTTP/1.1\r\nHost: localhost\r\nX-Seq: 1\r\n\r\n");
+	requests.append("GET /echoHeader HTTP/1.1\r\nHost: localhost\r\nX-Seq: 2\r\n\r\n");
+	requests.append("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Type: text/plain\r\nContent-Length: 5\r\n\r\nhello");
+	requests.append("HEAD /echoHeader HTTP/1.1\r\nHost: localhost\r\nX-Seq: 4\r\n\r\n");
+	requests.append("GET /echoHeader HTTP/1.1\r\nHost: localhost\r\nX-Seq: 5\r\nConnection: close\r\n\r\n");
+
+	StreamSocket ss(SocketAddress("localhost", srv.socket().address().port()));
+	ss.sendBytes(requests.data(), (int) requests.size());
+	SocketInputStream istr(ss);
+
+	HTTPResponse response;
+	std::string body;
+	
+	response.read(istr);
+	body.assign(response.getContentLength(), 0);
+	istr.read(&body[0], body.size());
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getKeepAlive());
+	assert (body.find("X-Seq: 1") != std::string::npos);
+
+	response.clear();
+	response.read(istr);
+	body.assign(response.getContentLength(), 0);
+	istr.read(&body[0], body.size());
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (body.find("X-Seq: 2") != std::string::npos);
+
+	response.clear();
+	response.read(istr);
+	body.assign(response.getContentLength(), 0);
+	istr.read(&body[0], body.size());
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentType() == "text/plain");
+	assert (body == "hello");
+
+	response.clear();
+	response.read(istr);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentLength() > 0);
+
+	response.clear();
+	response.read(istr);
+	body.assign(response.getContentLength(), 0);
+	istr.read(&body[0], body.size());
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (!response.getKeepAlive());
+	assert (body.find("X-Seq: 5") != std::string::npos);
+	assert (body.find("X-Seq: 2") == std::string::npos);
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -566,6 +747,8 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFile);
+	CppUnit_addTest(pSuite, HTTPServerTest, testPipelining);
 
 	return pSuite;
 }
@@ -60,6 +60,8 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testFile();
+	void testPipelining();
 
 	void setUp();
 	void tearDown();
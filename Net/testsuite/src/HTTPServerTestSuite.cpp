@@ -32,6 +32,7 @@
 
 #include "HTTPServerTestSuite.h"
 #include "HTTPServerTest.h"
+#include "HTTPReactorServerTest.h"
 
 
 CppUnit::Test* HTTPServerTestSuite::suite()
@@ -39,6 +40,7 @@ CppUnit::Test* HTTPServerTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPServerTestSuite");
 
 	pSuite->addTest(HTTPServerTest::suite());
+	pSuite->addTest(HTTPReactorServerTest::suite());
 
 	return pSuite;
 }
@@ -0,0 +1,281 @@
+//
+// MessageHeaderParserTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/MessageHeaderParserTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "MessageHeaderParserTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/MessageHeaderParser.h"
+#include "Poco/Net/MessageHeader.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/NumberFormatter.h"
+
+
+using Poco::Net::MessageHeaderParser;
+using Poco::Net::MessageHeader;
+using Poco::Net::MessageException;
+using Poco::NumberFormatter;
+
+
+MessageHeaderParserTest::MessageHeaderParserTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MessageHeaderParserTest::~MessageHeaderParserTest()
+{
+}
+
+
+void MessageHeaderParserTest::testParse1()
+{
+	std::string s("name1: value1\r\nname2: value2\r\nname3: value3\r\n\r\nbody");
+	MessageHeaderParser parser;
+	std::size_t n = parser.parse(s.data(), s.data() + s.size());
+	assert (n == s.size() - 4);
+	assert (parser.count() == 3);
+	assert (parser.name(0) == "name1");
+	assert (parser.value(0) == "value1");
+	assert (parser.name(1) == "name2");
+	assert (parser.value(1) == "value2");
+	assert (parser.name(2) == "name3");
+	assert (parser.value(2) == "value3");
+	
+	// fields refer to the parsed buffer
+	assert (parser[0].name == s.data());
+	assert (parser[0].nameLength == 5);
+	assert (parser[0].value == s.data() + 7);
+	assert (parser[0].valueLength == 6);
+	assert (!parser[0].folded);
+}
+
+
+void MessageHeaderParserTest::testParse2()
+{
+	std::string s("name1:value1\nname2:   value2   \nname3:\nname4: \n\n");
+	MessageHeaderParser parser;
+	std::size_t n = parser.parse(s.data(), s.data() + s.size());
+	assert (n == s.size());
+	assert (parser.count() == 4);
+	assert (parser.value(0) == "value1");
+	assert (parser.value(1) == "value2");
+	assert (parser.value(2).empty());
+	assert (parser.value(3).empty());
+}
+
+
+void MessageHeaderParserTest::testParseIncomplete()
+{
+	std::string s("name1: value1\r\nname2: value2\r\n\r\n");
+	MessageHeaderParser parser;
+	for (std::size_t i = 0; i < s.size(); ++i)
+	{
+		assert (parser.parse(s.data(), s.data() + i) == 0);
+		assert (parser.count() == 0);
+	}
+	assert (parser.parse(s.data(), s.data() + s.size()) == s.size());
+	assert (parser.count() == 2);
+	
+	std::string empty;
+	assert (parser.parse(empty.data(), empty.data()) == 0);
+	assert (parser.count() == 0);
+}
+
+
+void MessageHeaderParserTest::testParseFolding()
+{
+	std::string s("name1: value1\r\nname2: value21\r\n value22\r\n\tvalue23 \r\nname3: value3\r\n\r\n");
+	MessageHeaderParser parser;
+	std::size_t n = parser.parse(s.data(), s.data() + s.size());
+	assert (n == s.size());
+	assert (parser.count() == 3);
+	assert (!parser[0].folded);
+	assert (parser[1].folded);
+	assert (parser.value(1) == "value21 value22\tvalue23");
+	assert (parser.value(2) == "value3");
+	
+	// a continuation line may still be missing
+	std::string t("name1: value1\r\n");
+	assert (parser.parse(t.data(), t.data() + t.size()) == 0);
+	t.append(" value2\r\n");
+	assert (parser.parse(t.data(), t.data() + t.size()) == 0);
+	t.append("\r\n");
+	assert (parser.parse(t.data(), t.data() + t.size()) == t.size());
+	assert (parser.value(0) == "value1 value2");
+}
+
+
+void MessageHeaderParserTest::testParseInvalid1()
+{
+	std::string s("name1: value1\r\nname2\r\nname3: value3\r\n\r\n");
+	MessageHeaderParser parser;
+	std::size_t n = parser.parse(s.data(), s.data() + s.size());
+	assert (n == s.size());
+	assert (parser.count() == 2);
+	assert (parser.name(0) == "name1");
+	assert (parser.name(1) == "name3");
+}
+
+
+void MessageHeaderParserTest::testParseInvalid2()
+{
+	std::string s(300, 'x');
+	s.append(": value\r\n\r\n");
+	MessageHeaderParser parser;
+	try
+	{
+		parser.parse(s.data(), s.data() + s.size());
+		fail("field name too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+	
+	s = "name1: value1\rname2: value2\r\n\r\n";
+	try
+	{
+		parser.parse(s.data(), s.data() + s.size());
+		fail("no CRLF - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+
+	s = "name1: ";
+	s.append(9000, 'x');
+	s.append("\r\n\r\n");
+	try
+	{
+		parser.parse(s.data(), s.data() + s.size());
+		fail("field value too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void MessageHeaderParserTest::testOverflow()
+{
+	std::string s;
+	for (int i = 0; i < 50; ++i)
+	{
+		s.append("name");
+		s.append(NumberFormatter::format(i));
+		s.append(": value");
+		s.append(NumberFormatter::format(i));
+		s.append("\r\n");
+	}
+	s.append("\r\n");
+	MessageHeaderParser parser;
+	assert (parser.parse(s.data(), s.data() + s.size()) == s.size());
+	assert (parser.count() == 50);
+	for (int i = 0; i < 50; ++i)
+	{
+		assert (parser.name(i) == "name" + NumberFormatter::format(i));
+		assert (parser.value(i) == "value" + NumberFormatter::format(i));
+	}
+}
+
+
+void MessageHeaderParserTest::testFind()
+{
+	std::string s("Host: localhost\r\nContent-Length: 100\r\nAccept: text/html\r\nAccept: text/plain\r\n\r\n");
+	MessageHeaderParser parser;
+	parser.parse(s.data(), s.data() + s.size());
+	assert (parser.has("host"));
+	assert (parser.has("CONTENT-LENGTH"));
+	assert (!parser.has("Content-Type"));
+	assert (!parser.has("Hos"));
+	const MessageHeaderParser::Field* pField = parser.find("accept");
+	assert (pField != 0);
+	assert (std::string(pField->value, pField->valueLength) == "text/html");
+}
+
+
+void MessageHeaderParserTest::testCopyTo()
+{
+	std::string s("name1: value1\r\nname2: value21\r\n value22\r\nname1: value3\r\n\r\n");
+	MessageHeaderParser parser;
+	parser.parse(s.data(), s.data() + s.size());
+	MessageHeader mh;
+	parser.copyTo(mh);
+	assert (mh.size() == 3);
+	assert (mh["name2"] == "value21 value22");
+	assert (mh.has("name1"));
+}
+
+
+void MessageHeaderParserTest::testFieldLimit()
+{
+	std::string s("name1: value1\r\nname2: value2\r\nname3: value3\r\n\r\n");
+	MessageHeaderParser parser;
+	parser.setFieldLimit(2);
+	try
+	{
+		parser.parse(s.data(), s.data() + s.size());
+		fail("Field limit exceeded - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+	parser.setFieldLimit(3);
+	assert (parser.parse(s.data(), s.data() + s.size()) == s.size());
+}
+
+
+void MessageHeaderParserTest::setUp()
+{
+}
+
+
+void MessageHeaderParserTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MessageHeaderParserTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MessageHeaderParserTest");
+
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testParse1);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testParse2);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testParseIncomplete);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testParseFolding);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testParseInvalid1);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testParseInvalid2);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testOverflow);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testFind);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testCopyTo);
+	CppUnit_addTest(pSuite, MessageHeaderParserTest, testFieldLimit);
+
+	return pSuite;
+}
@@ -33,6 +33,7 @@
 #include "MessagesTestSuite.h"
 #include "NameValueCollectionTest.h"
 #include "MessageHeaderTest.h"
+#include "MessageHeaderParserTest.h"
 #include "MediaTypeTest.h"
 #include "MultipartWriterTest.h"
 #include "MultipartReaderTest.h"
@@ -45,6 +46,7 @@ CppUnit::Test* MessagesTestSuite::suite()
 
 	pSuite->addTest(NameValueCollectionTest::suite());
 	pSuite->addTest(MessageHeaderTest::suite());
+	pSuite->addTest(MessageHeaderParserTest::suite());
 	pSuite->addTest(MediaTypeTest::suite());
 	pSuite->addTest(MultipartWriterTest::suite());
 	pSuite->addTest(MultipartReaderTest::suite());
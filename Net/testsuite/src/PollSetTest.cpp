@@ -0,0 +1,211 @@
+//
+// PollSetTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/PollSetTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+
+
+#include "PollSetTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "EchoServer.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Timespan.h"
+
+
+using Poco::Net::Socket;
+using Poco::Net::PollSet;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Timespan;
+
+
+PollSetTest::PollSetTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+PollSetTest::~PollSetTest()
+{
+}
+
+
+void PollSetTest::testPoll()
+{
+	Timespan timeout(250000);
+
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1;
+	StreamSocket ss2;
+	ss1.connect(SocketAddress("localhost", echoServer1.port()));
+	ss2.connect(SocketAddress("localhost", echoServer2.port()));
+
+	PollSet ps;
+	assert (ps.empty());
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ);
+	assert (ps.size() == 2);
+	assert (ps.has(ss1));
+	assert (ps.has(ss2));
+
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ss1.sendBytes("hello", 5);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss1) != sm.end());
+	assert (sm[ss1] == PollSet::POLL_READ);
+
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "hello");
+
+	ss2.sendBytes("HELLO", 5);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss2) != sm.end());
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "HELLO");
+
+	ps.remove(ss1);
+	assert (!ps.has(ss1));
+	ss1.sendBytes("hello", 5);
+	ss1.poll(timeout, Socket::SELECT_READ);
+	sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ps.clear();
+	assert (ps.empty());
+	sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ps.add(ss2, PollSet::POLL_READ);
+	ss2.sendBytes("HELLO", 5);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss2) != sm.end());
+
+	ss1.close();
+	ss2.close();
+}
+
+
+void PollSetTest::testPollUpdate()
+{
+	Timespan timeout(250000);
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_READ);
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ps.update(ss, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	assert (ps.size() == 1);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm[ss] == PollSet::POLL_WRITE);
+
+	ss.sendBytes("hello", 5);
+	ss.poll(timeout, Socket::SELECT_READ);
+	sm = ps.poll(timeout);
+	assert (sm[ss] == (PollSet::POLL_READ | PollSet::POLL_WRITE));
+
+	ps.update(ss, PollSet::POLL_WRITE);
+	sm = ps.poll(timeout);
+	assert (sm[ss] == PollSet::POLL_WRITE);
+
+	ss.close();
+}
+
+
+void PollSetTest::testPollEdgeTriggered()
+{
+	Timespan timeout(250000);
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+
+	PollSet ps(true);
+	ps.add(ss, PollSet::POLL_READ);
+
+	ss.sendBytes("hello", 5);
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+
+	if (ps.isEdgeTriggered())
+	{
+		// No new data has arrived, so the socket must not be reported
+		// again, even though it is still readable.
+		sm = ps.poll(timeout);
+		assert (sm.empty());
+	}
+
+	char buffer[256];
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "hello");
+
+	ss.sendBytes("HELLO", 5);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm[ss] == PollSet::POLL_READ);
+
+	ss.close();
+}
+
+
+void PollSetTest::setUp()
+{
+}
+
+
+void PollSetTest::tearDown()
+{
+}
+
+
+CppUnit::Test* PollSetTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PollSetTest");
+
+	CppUnit_addTest(pSuite, PollSetTest, testPoll);
+	CppUnit_addTest(pSuite, PollSetTest, testPollUpdate);
+	CppUnit_addTest(pSuite, PollSetTest, testPollEdgeTriggered);
+
+	return pSuite;
+}
@@ -43,7 +43,12 @@
 #include "Poco/Buffer.h"
 #include "Poco/FIFOBuffer.h"
 #include "Poco/Delegate.h"
+#include "Poco/TemporaryFile.h"
 #include <iostream>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 
 using Poco::Net::Socket;
@@ -58,6 +63,7 @@ using Poco::InvalidArgumentException;
 using Poco::Buffer;
 using Poco::FIFOBuffer;
 using Poco::delegate;
+using Poco::TemporaryFile;
 
 
 SocketTest::SocketTest(const std::string& name): CppUnit::TestCase(name)
@@ -85,6 +91,34 @@ void SocketTest::testEcho()
 }
 
 
+void SocketTest::testScatterGather()
+{
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+	char hello[] = "hello";
+	char sep[] = ", ";
+	char world[] = "world";
+	Poco::Net::SocketBuf sendBuffers[3];
+	sendBuffers[0] = Socket::makeBuffer(hello, 5);
+	sendBuffers[1] = Socket::makeBuffer(sep, 2);
+	sendBuffers[2] = Socket::makeBuffer(world, 5);
+	int n = ss.sendBytes(sendBuffers, 3);
+	assert (n == 12);
+
+	char first[7];
+	char second[256];
+	Poco::Net::SocketBuf receiveBuffers[2];
+	receiveBuffers[0] = Socket::makeBuffer(first, sizeof(first));
+	receiveBuffers[1] = Socket::makeBuffer(second, sizeof(second));
+	n = ss.receiveBytes(receiveBuffers, 2);
+	assert (n == 12);
+	assert (std::string(first, 7) == "hello, ");
+	assert (std::string(second, 5) == "world");
+	ss.close();
+}
+
+
 void SocketTest::testPoll()
 {
 	EchoServer echoServer;
@@ -363,6 +397,34 @@ void SocketTest::testTimeout()
 }
 
 
+void SocketTest::testSendFileTimeout()
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	ServerSocket svs(SocketAddress("localhost", 0));
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", svs.address().port()));
+	StreamSocket peer = svs.acceptConnection();
+	ss.setSendTimeout(Timespan(250000));
+
+	// the peer never reads, so the file does not fit
+	// into the socket buffers
+	TemporaryFile file;
+	int fd = ::open(file.path().c_str(), O_RDWR | O_CREAT, 0600);
+	assert (fd >= 0);
+	assert (::ftruncate(fd, 64*1024*1024) == 0);
+	try
+	{
+		ss.sendFile(fd, 0, 64*1024*1024);
+		fail("peer does not read - must timeout");
+	}
+	catch (TimeoutException&)
+	{
+	}
+	::close(fd);
+#endif
+}
+
+
 void SocketTest::testBufferSize()
 {
 	EchoServer echoServer;
@@ -554,6 +616,7 @@ CppUnit::Test* SocketTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SocketTest");
 
 	CppUnit_addTest(pSuite, SocketTest, testEcho);
+	CppUnit_addTest(pSuite, SocketTest, testScatterGather);
 	CppUnit_addTest(pSuite, SocketTest, testPoll);
 	CppUnit_addTest(pSuite, SocketTest, testAvailable);
 	CppUnit_addTest(pSuite, SocketTest, testFIFOBuffer);
@@ -564,6 +627,7 @@ CppUnit::Test* SocketTest::suite()
 	CppUnit_addTest(pSuite, SocketTest, testAddress);
 	CppUnit_addTest(pSuite, SocketTest, testAssign);
 	CppUnit_addTest(pSuite, SocketTest, testTimeout);
+	CppUnit_addTest(pSuite, SocketTest, testSendFileTimeout);
 	CppUnit_addTest(pSuite, SocketTest, testBufferSize);
 	CppUnit_addTest(pSuite, SocketTest, testOptions);
 	CppUnit_addTest(pSuite, SocketTest, testSelect);
@@ -47,6 +47,7 @@ public:
 	~SocketTest();
 
 	void testEcho();
+	void testScatterGather();
 	void testPoll();
 	void testAvailable();
 	void testFIFOBuffer();
@@ -57,6 +58,7 @@ public:
 	void testAddress();
 	void testAssign();
 	void testTimeout();
+	void testSendFileTimeout();
 	void testBufferSize();
 	void testOptions();
 	void testSelect();
@@ -253,6 +253,54 @@ void TCPServerTest::testMultiConnections()
 }
 
 
+void TCPServerTest::testLockFreeQueue()
+{
+	ServerSocket svs(0);
+	TCPServerParams* pParams = new TCPServerParams;
+	pParams->setMaxThreads(2);
+	pParams->setMaxQueued(4);
+	pParams->setThreadIdleTime(100);
+	pParams->setLockFreeQueue(true);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), svs, pParams);
+	srv.start();
+	
+	SocketAddress sa("localhost", svs.address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+
+	StreamSocket ss3(sa);
+	Thread::sleep(200);
+	assert (srv.queuedConnections() == 1);
+	
+	ss1.close();
+	Thread::sleep(300);
+	assert (srv.queuedConnections() == 0);
+	assert (srv.totalConnections() == 3);
+
+	ss3.sendBytes(data.data(), (int) data.size());
+	n = ss3.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+	ss2.close();
+	ss3.close();
+
+	Thread::sleep(300);
+	assert (srv.currentConnections() == 0);
+}
+
+
 void TCPServerTest::setUp()
 {
 }
@@ -270,6 +318,7 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testOneConnection);
 	CppUnit_addTest(pSuite, TCPServerTest, testTwoConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
+	CppUnit_addTest(pSuite, TCPServerTest, testLockFreeQueue);
 
 	return pSuite;
 }
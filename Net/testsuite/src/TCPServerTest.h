@@ -49,6 +49,7 @@ public:
 	void testOneConnection();
 	void testTwoConnections();
 	void testMultiConnections();
+	void testLockFreeQueue();
 
 	void setUp();
 	void tearDown();
@@ -34,6 +34,8 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/WebSocket.h"
+#include "Poco/Net/WebSocketImpl.h"
+#include "Poco/Net/PerMessageDeflate.h"
 #include "Poco/Net/SocketStream.h"
 #include "Poco/Net/HTTPClientSession.h"
 #include "Poco/Net/HTTPServer.h"
@@ -45,6 +47,11 @@
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Thread.h"
+#include "Poco/Buffer.h"
+#include "Poco/Random.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/NumberFormatter.h"
+#include <vector>
 
 
 using Poco::Net::HTTPClientSession;
@@ -52,9 +59,11 @@ using Poco::Net::HTTPRequest;
 using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPServerRequest;
 using Poco::Net::HTTPServerResponse;
+using Poco::Net::PerMessageDeflate;
 using Poco::Net::SocketStream;
 using Poco::Net::WebSocket;
 using Poco::Net::WebSocketException;
+using Poco::Net::WebSocketImpl;
 
 
 namespace
@@ -62,7 +71,9 @@ namespace
 	class WebSocketRequestHandler: public Poco::Net::HTTPRequestHandler
 	{
 	public:
-		WebSocketRequestHandler(std::size_t bufSize = 1024): _bufSize(bufSize)
+		WebSocketRequestHandler(std::size_t bufSize = 1024, Poco::SharedPtr<PerMessageDeflate> pDeflate = 0):
+			_bufSize(bufSize),
+			_pDeflate(pDeflate)
 		{
 		}
 
@@ -70,7 +81,7 @@ namespace
 		{
 			try
 			{
-				WebSocket ws(request, response);
+				WebSocket ws = _pDeflate ? WebSocket(request, response, *_pDeflate) : WebSocket(request, response);
 				std::auto_ptr<char> pBuffer(new char[_bufSize]);
 				int flags;
 				int n;
@@ -101,6 +112,7 @@ namespace
 
 	private:
 		std::size_t _bufSize;
+		Poco::SharedPtr<PerMessageDeflate> _pDeflate;
 	};
 	
 	class WebSocketRequestHandlerFactory: public Poco::Net::HTTPRequestHandlerFactory
@@ -110,14 +122,37 @@ namespace
 		{
 		}
 
+		WebSocketRequestHandlerFactory(std::size_t bufSize, const PerMessageDeflate& deflate):
+			_bufSize(bufSize),
+			_pDeflate(new PerMessageDeflate(deflate))
+		{
+		}
+
 		Poco::Net::HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
 		{
-			return new WebSocketRequestHandler(_bufSize);
+			return new WebSocketRequestHandler(_bufSize, _pDeflate);
 		}
 
 	private:
 		std::size_t _bufSize;
+		Poco::SharedPtr<PerMessageDeflate> _pDeflate;
 	};
+
+	std::string jsonPayload(int count, int seed)
+	{
+		std::string payload("[");
+		for (int i = 0; i < count; i++)
+		{
+			if (i > 0) payload += ',';
+			payload += "{\"id\":";
+			Poco::NumberFormatter::append(payload, seed + i);
+			payload += ",\"name\":\"item";
+			Poco::NumberFormatter::append(payload, (seed*31 + i*7) % 1000);
+			payload += "\",\"active\":true}";
+		}
+		payload += "]";
+		return payload;
+	}
 }
 
 
@@ -230,6 +265,399 @@ void WebSocketTest::testWebSocketLarge()
 }
 
 
+void WebSocketTest::testReceiveFrameBuffer()
+{
+	const int msgSize = 70000;
+
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory(msgSize), ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	HTTPClientSession cs("localhost", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws");
+	HTTPResponse response;
+	WebSocket ws(cs, request, response);
+
+	Poco::Buffer<char> buffer(0);
+	int sizes[] = {0, 1, 13, 125, 126, 127, 1000, 65535, 65536, msgSize};
+	for (int i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+	{
+		std::string payload(sizes[i], 'x');
+		for (int k = 0; k < sizes[i]; k++) payload[k] = static_cast<char>(k*7 + i);
+		ws.sendFrame(payload.data(), (int) payload.size(), WebSocket::FRAME_BINARY);
+		buffer.resize(0);
+		int flags;
+		int n = ws.receiveFrame(buffer, flags);
+		assert (n == payload.size());
+		assert (buffer.size() == payload.size());
+		assert (std::string(buffer.begin(), buffer.size()) == payload);
+		assert (flags == WebSocket::FRAME_BINARY);
+	}
+	std::size_t capacity = buffer.capacity();
+	assert (capacity >= msgSize);
+
+	// payloads are appended
+	buffer.resize(0);
+	int flags;
+	ws.sendFrame("Hello, ", 7);
+	ws.sendFrame("world!", 6);
+	assert (ws.receiveFrame(buffer, flags) == 7);
+	assert (ws.receiveFrame(buffer, flags) == 6);
+	assert (std::string(buffer.begin(), buffer.size()) == "Hello, world!");
+	assert (buffer.capacity() == capacity);
+
+	ws.shutdown();
+	buffer.resize(0);
+	int n = ws.receiveFrame(buffer, flags);
+	assert (n == 2);
+	assert ((flags & WebSocket::FRAME_OP_BITMASK) == WebSocket::FRAME_OP_CLOSE);
+
+	server.stop();
+}
+
+
+void WebSocketTest::testReadAhead()
+{
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory, ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	HTTPClientSession cs("localhost", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws");
+	HTTPResponse response;
+	WebSocket ws(cs, request, response);
+	ws.setReadAheadSize(4096);
+	assert (ws.getReadAheadSize() == 4096);
+
+	const int count = 200;
+	for (int i = 0; i < count; i++)
+	{
+		std::string payload(i % 150, static_cast<char>('a' + i % 26));
+		ws.sendFrame(payload.data(), (int) payload.size());
+	}
+	// wait for all echoed frames to arrive, so that
+	// they are read ahead in a few large chunks
+	Poco::Thread::sleep(200);
+
+	char buffer[1024];
+	int flags;
+	for (int i = 0; i < count; i++)
+	{
+		std::string payload(i % 150, static_cast<char>('a' + i % 26));
+		int n = ws.receiveFrame(buffer, sizeof(buffer), flags);
+		assert (n == payload.size());
+		assert (payload.compare(0, payload.size(), buffer, 0, n) == 0);
+		assert (flags == WebSocket::FRAME_TEXT);
+	}
+	assert (ws.available() == 0);
+
+	ws.setReadAheadSize(0);
+	std::string payload(1000, 'y');
+	ws.sendFrame(payload.data(), (int) payload.size());
+	int n = ws.receiveFrame(buffer, sizeof(buffer), flags);
+	assert (n == payload.size());
+	assert (payload.compare(0, payload.size(), buffer, 0, n) == 0);
+
+	ws.shutdown();
+	n = ws.receiveFrame(buffer, sizeof(buffer), flags);
+	assert (n == 2);
+	assert ((flags & WebSocket::FRAME_OP_BITMASK) == WebSocket::FRAME_OP_CLOSE);
+
+	server.stop();
+}
+
+
+void WebSocketTest::testMaxPayloadSize()
+{
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory, ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	HTTPClientSession cs("localhost", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws");
+	HTTPResponse response;
+	WebSocket ws(cs, request, response);
+	ws.setMaxPayloadSize(100);
+	assert (ws.getMaxPayloadSize() == 100);
+
+	std::string payload(101, 'x');
+	ws.sendFrame(payload.data(), (int) payload.size());
+	Poco::Buffer<char> buffer(0);
+	int flags;
+	try
+	{
+		ws.receiveFrame(buffer, flags);
+		fail ("payload too big - must throw");
+	}
+	catch (WebSocketException& exc)
+	{
+		assert (exc.code() == WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	}
+	assert (buffer.size() == 0);
+
+	server.stop();
+}
+
+
+void WebSocketTest::testMaskPayload()
+{
+	const char mask[4] = {'\x12', '\x34', '\x56', '\x78'};
+	Poco::Random rnd;
+	std::vector<char> src(300);
+	for (std::size_t i = 0; i < src.size(); i++) src[i] = rnd.nextChar();
+
+	for (std::size_t length = 0; length < 100; length++)
+	{
+		for (std::size_t start = 0; start < 8; start++)
+		{
+			for (std::size_t offset = 0; offset < 4; offset++)
+			{
+				std::vector<char> dest(src.size());
+				WebSocketImpl::maskPayload(&dest[start], &src[start], length, mask, offset);
+				for (std::size_t i = 0; i < length; i++)
+				{
+					assert (dest[start + i] == (src[start + i] ^ mask[(offset + i) % 4]));
+				}
+				// masking is its own inverse, also in place
+				WebSocketImpl::maskPayload(&dest[start], &dest[start], length, mask, offset);
+				assert (std::equal(dest.begin() + start, dest.begin() + start + length, src.begin() + start));
+			}
+		}
+	}
+}
+
+void WebSocketTest::testPerMessageDeflateNegotiation()
+{
+	PerMessageDeflate client;
+	assert (client.offer() == "permessage-deflate; client_max_window_bits");
+	client.setClientMaxWindowBits(12);
+	client.setServerNoContextTakeover(true);
+	assert (client.offer() == "permessage-deflate; server_no_context_takeover; client_max_window_bits=12");
+
+	PerMessageDeflate server;
+	server.setServerMaxWindowBits(13);
+	std::string response;
+	assert (!server.accept("x-webkit-deflate-frame", response));
+	assert (!server.accept("permessage-deflate; server_max_window_bits=8", response));
+	assert (!server.accept("permessage-deflate; foo=1", response));
+	assert (!server.accept("permessage-deflate; client_no_context_takeover; client_no_context_takeover", response));
+
+	// the first acceptable offer is selected
+	assert (server.accept("permessage-deflate; server_max_window_bits=8, permessage-deflate; server_max_window_bits=\"10\"; client_max_window_bits", response));
+	assert (response == "permessage-deflate; server_max_window_bits=10");
+	assert (server.getServerMaxWindowBits() == 10);
+	assert (server.getClientMaxWindowBits() == 15);
+
+	PerMessageDeflate server2;
+	server2.setServerMaxWindowBits(13);
+	server2.setClientMaxWindowBits(11);
+	server2.setClientNoContextTakeover(true);
+	assert (server2.accept(client.offer(), response));
+	assert (response == "permessage-deflate; server_no_context_takeover; client_no_context_takeover; server_max_window_bits=13; client_max_window_bits=11");
+	assert (server2.getServerNoContextTakeover());
+	assert (server2.getClientMaxWindowBits() == 11);
+
+	PerMessageDeflate confirmed(client);
+	confirmed.confirm(response);
+	assert (confirmed.getServerNoContextTakeover());
+	assert (confirmed.getClientNoContextTakeover());
+	assert (confirmed.getServerMaxWindowBits() == 13);
+	assert (confirmed.getClientMaxWindowBits() == 11);
+
+	// the server must not lift our limit
+	PerMessageDeflate limited;
+	limited.setServerMaxWindowBits(10);
+	try
+	{
+		limited.confirm("permessage-deflate; server_max_window_bits=12");
+		fail ("window too large - must throw");
+	}
+	catch (WebSocketException& exc)
+	{
+		assert (exc.code() == WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+	}
+	try
+	{
+		limited.confirm("permessage-deflate; client_max_window_bits=8");
+		fail ("window not supported - must throw");
+	}
+	catch (WebSocketException& exc)
+	{
+		assert (exc.code() == WebSocket::WS_ERR_HANDSHAKE_EXTENSION);
+	}
+}
+
+
+void WebSocketTest::testPerMessageDeflateContextTakeover()
+{
+	std::string message = jsonPayload(50, 1);
+
+	PerMessageDeflate sender;
+	PerMessageDeflate receiver;
+	sender.init(true);
+	receiver.init(false);
+
+	Poco::Buffer<char> compressed(0);
+	Poco::Buffer<char> decompressed(0);
+	std::size_t first = sender.deflate(message.data(), message.size(), true, compressed);
+	assert (first < message.size()/4);
+	assert (receiver.inflate(compressed.begin(), first, true, decompressed, message.size()) == message.size());
+	assert (std::string(decompressed.begin(), decompressed.size()) == message);
+
+	// the second message refers to the first
+	std::size_t second = sender.deflate(message.data(), message.size(), true, compressed);
+	assert (second < first/4);
+	decompressed.resize(0);
+	assert (receiver.inflate(compressed.begin(), second, true, decompressed, message.size()) == message.size());
+	assert (std::string(decompressed.begin(), decompressed.size()) == message);
+
+	// no more allocations once the buffers are large enough
+	const char* pCompressed = compressed.begin();
+	const char* pDecompressed = decompressed.begin();
+	for (int i = 0; i < 10; i++)
+	{
+		std::size_t n = sender.deflate(message.data(), message.size(), true, compressed);
+		decompressed.resize(0);
+		receiver.inflate(compressed.begin(), n, true, decompressed, message.size());
+		assert (std::string(decompressed.begin(), decompressed.size()) == message);
+	}
+	assert (compressed.begin() == pCompressed);
+	assert (decompressed.begin() == pDecompressed);
+
+	PerMessageDeflate params;
+	params.setServerNoContextTakeover(true);
+	params.setServerMaxWindowBits(9);
+	PerMessageDeflate resetSender(params);
+	PerMessageDeflate resetReceiver(params);
+	resetSender.init(true);
+	resetReceiver.init(false);
+	std::size_t n1 = resetSender.deflate(message.data(), message.size(), true, compressed);
+	std::vector<char> copy(compressed.begin(), compressed.begin() + n1);
+	std::size_t n2 = resetSender.deflate(message.data(), message.size(), true, compressed);
+	assert (n1 == n2);
+	assert (std::equal(copy.begin(), copy.end(), compressed.begin()));
+	std::vector<char> out(message.size());
+	for (int i = 0; i < 2; i++)
+	{
+		assert (resetReceiver.inflate(compressed.begin(), n2, true, &out[0], out.size()) == message.size());
+		assert (std::string(&out[0], out.size()) == message);
+	}
+
+	// an empty message is a single empty block
+	assert (resetSender.deflate("", 0, true, compressed) == 1);
+	assert (compressed[0] == 0);
+	assert (resetReceiver.inflate(compressed.begin(), 1, true, &out[0], out.size()) == 0);
+
+	// output that does not fit is rejected
+	std::size_t n = resetSender.deflate(message.data(), message.size(), true, compressed);
+	try
+	{
+		resetReceiver.inflate(compressed.begin(), n, true, &out[0], out.size() - 1);
+		fail ("buffer too small - must throw");
+	}
+	catch (WebSocketException& exc)
+	{
+		assert (exc.code() == WebSocket::WS_ERR_PAYLOAD_TOO_BIG);
+	}
+}
+
+
+void WebSocketTest::testPerMessageDeflate()
+{
+	const int msgSize = 70000;
+
+	PerMessageDeflate serverDeflate;
+	serverDeflate.setServerMaxWindowBits(10);
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory(msgSize, serverDeflate), ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	HTTPClientSession cs("localhost", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws");
+	HTTPResponse response;
+	PerMessageDeflate clientDeflate;
+	clientDeflate.setClientNoContextTakeover(true);
+	WebSocket ws(cs, request, response, clientDeflate);
+	assert (response.get("Sec-WebSocket-Extensions") == "permessage-deflate; client_no_context_takeover; server_max_window_bits=10");
+	assert (ws.perMessageDeflate() != 0);
+	assert (ws.perMessageDeflate()->getServerMaxWindowBits() == 10);
+	assert (ws.perMessageDeflate()->getClientNoContextTakeover());
+
+	Poco::Buffer<char> buffer(0);
+	int flags;
+	int counts[] = {0, 1, 3, 50, 400, 800};
+	for (int i = 0; i < sizeof(counts)/sizeof(counts[0]); i++)
+	{
+		std::string payload = jsonPayload(counts[i], i);
+		ws.sendFrame(payload.data(), (int) payload.size());
+		buffer.resize(0);
+		int n = ws.receiveFrame(buffer, flags);
+		assert (n == payload.size());
+		assert (std::string(buffer.begin(), buffer.size()) == payload);
+		assert (flags == WebSocket::FRAME_TEXT);
+	}
+
+	// incompressible data
+	Poco::Random rnd;
+	std::string random(msgSize, ' ');
+	for (int i = 0; i < msgSize; i++) random[i] = rnd.nextChar();
+	ws.sendFrame(random.data(), (int) random.size(), WebSocket::FRAME_BINARY);
+	buffer.resize(0);
+	assert (ws.receiveFrame(buffer, flags) == msgSize);
+	assert (std::string(buffer.begin(), buffer.size()) == random);
+	assert (flags == WebSocket::FRAME_BINARY);
+
+	// fragmented message, with a control frame in between
+	std::string part1 = jsonPayload(10, 100);
+	std::string part2 = jsonPayload(20, 200);
+	ws.sendFrame(part1.data(), (int) part1.size(), WebSocket::FRAME_OP_TEXT);
+	ws.sendFrame("ping", 4, WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_PING);
+	ws.sendFrame(part2.data(), (int) part2.size(), WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_CONT);
+	char frame[msgSize];
+	int n = ws.receiveFrame(frame, sizeof(frame), flags);
+	assert (flags == WebSocket::FRAME_OP_TEXT);
+	assert (std::string(frame, n) == part1);
+	n = ws.receiveFrame(frame, sizeof(frame), flags);
+	assert (flags == (WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_PING));
+	assert (std::string(frame, n) == "ping");
+	n = ws.receiveFrame(frame, sizeof(frame), flags);
+	assert (flags == (WebSocket::FRAME_FLAG_FIN | WebSocket::FRAME_OP_CONT));
+	assert (std::string(frame, n) == part2);
+
+	ws.shutdown();
+	n = ws.receiveFrame(frame, sizeof(frame), flags);
+	assert (n == 2);
+	assert ((flags & WebSocket::FRAME_OP_BITMASK) == WebSocket::FRAME_OP_CLOSE);
+
+	server.stop();
+}
+
+
+void WebSocketTest::testPerMessageDeflateNotAccepted()
+{
+	Poco::Net::ServerSocket ss(0);
+	Poco::Net::HTTPServer server(new WebSocketRequestHandlerFactory, ss, new Poco::Net::HTTPServerParams);
+	server.start();
+
+	HTTPClientSession cs("localhost", ss.address().port());
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/ws");
+	HTTPResponse response;
+	WebSocket ws(cs, request, response, PerMessageDeflate());
+	assert (!response.has("Sec-WebSocket-Extensions"));
+	assert (ws.perMessageDeflate() == 0);
+
+	std::string payload = jsonPayload(10, 0);
+	ws.sendFrame(payload.data(), (int) payload.size());
+	char buffer[1024];
+	int flags;
+	int n = ws.receiveFrame(buffer, sizeof(buffer), flags);
+	assert (std::string(buffer, n) == payload);
+	assert (flags == WebSocket::FRAME_TEXT);
+
+	server.stop();
+}
+
+
 void WebSocketTest::setUp()
 {
 }
@@ -246,6 +674,14 @@ CppUnit::Test* WebSocketTest::suite()
 
 	CppUnit_addTest(pSuite, WebSocketTest, testWebSocket);
 	CppUnit_addTest(pSuite, WebSocketTest, testWebSocketLarge);
+	CppUnit_addTest(pSuite, WebSocketTest, testReceiveFrameBuffer);
+	CppUnit_addTest(pSuite, WebSocketTest, testReadAhead);
+	CppUnit_addTest(pSuite, WebSocketTest, testMaxPayloadSize);
+	CppUnit_addTest(pSuite, WebSocketTest, testMaskPayload);
+	CppUnit_addTest(pSuite, WebSocketTest, testPerMessageDeflateNegotiation);
+	CppUnit_addTest(pSuite, WebSocketTest, testPerMessageDeflateContextTakeover);
+	CppUnit_addTest(pSuite, WebSocketTest, testPerMessageDeflate);
+	CppUnit_addTest(pSuite, WebSocketTest, testPerMessageDeflateNotAccepted);
 
 	return pSuite;
 }
@@ -48,6 +48,14 @@ public:
 
 	void testWebSocket();
 	void testWebSocketLarge();
+	void testReceiveFrameBuffer();
+	void testReadAhead();
+	void testMaxPayloadSize();
+	void testMaskPayload();
+	void testPerMessageDeflateNegotiation();
+	void testPerMessageDeflateContextTakeover();
+	void testPerMessageDeflate();
+	void testPerMessageDeflateNotAccepted();
 
 	void setUp();
 	void tearDown();
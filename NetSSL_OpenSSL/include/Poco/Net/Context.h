@@ -42,10 +42,15 @@
 
 #include "Poco/Net/NetSSL.h"
 #include "Poco/Net/SocketDefs.h"
+#include "Poco/Net/Session.h"
 #include "Poco/Crypto/X509Certificate.h"
 #include "Poco/Crypto/RSAKey.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/UniqueExpireLRUCache.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
 #include <openssl/ssl.h>
 #include <cstdlib>
 
@@ -63,9 +68,21 @@ class NetSSL_API Context: public Poco::RefCountedObject
 	///
 	/// The Context class is also used to control
 	/// SSL session caching on the server and client side.
+	///
+	/// On the client side, a Context with session caching enabled
+	/// keeps the most recent session for every server (identified by
+	/// the peer host name and port) in a cache. Subsequent connections
+	/// to the same server made through the Context automatically try
+	/// to resume the cached session, including sessions using
+	/// RFC 5077 session tickets.
 {
 public:
 	typedef Poco::AutoPtr<Context> Ptr;
+
+	enum
+	{
+		DEFAULT_CLIENT_SESSION_CACHE_SIZE = 1024
+	};
 	
 	enum Usage
 	{
@@ -210,6 +227,10 @@ public:
 		///
 		/// The default is disabled session caching.
 		///
+		/// On the client side, sessions are stored in the Context's
+		/// client session cache and automatically reused for
+		/// connections to the same server.
+		///
 		/// To enable session caching on the server side, use the
 		/// two-argument version of this method to specify
 		/// a session ID context.
@@ -240,31 +261,33 @@ public:
 		/// is 1024*20, which may be too large for many applications,
 		/// especially on embedded platforms with limited memory.
 		///
-		/// Specifying a size of 0 will set an unlimited cache size.
+		/// For a client Context, sets the maximum number of servers
+		/// for which a session is kept in the client session cache.
+		/// The default is DEFAULT_CLIENT_SESSION_CACHE_SIZE. When the
+		/// cache is full, the least recently used session is discarded.
+		/// Changing the size flushes the client session cache.
 		///
-		/// This method may only be called on SERVER_USE Context objets.
+		/// Specifying a size of 0 will set an unlimited cache size.
 		
 	std::size_t getSessionCacheSize() const;
-		/// Returns the current maximum size of the server session cache.
-		///
-		/// This method may only be called on SERVER_USE Context objets.
+		/// Returns the current maximum size of the session cache.
 		
 	void setSessionTimeout(long seconds);
-		/// Sets the timeout (in seconds) of cached sessions on the server.
-		/// A cached session will be removed from the cache if it has
-		/// not been used for the given number of seconds.
+		/// Sets the timeout (in seconds) of cached sessions.
+		///
+		/// On the server, a cached session will be removed from the cache
+		/// if it has not been used for the given number of seconds.
 		///
-		/// This method may only be called on SERVER_USE Context objets.
+		/// On the client, a cached session is discarded after the
+		/// given number of seconds, or when the session's own lifetime
+		/// (e.g., the lifetime hint of a session ticket) has expired,
+		/// whichever comes first.
 
 	long getSessionTimeout() const;
-		/// Returns the timeout (in seconds) of cached sessions on the server.
-		///
-		/// This method may only be called on SERVER_USE Context objets.
+		/// Returns the timeout (in seconds) of cached sessions.
 
 	void flushSessionCache();
-		/// Flushes the SSL session cache on the server.
-		///
-		/// This method may only be called on SERVER_USE Context objets.
+		/// Flushes the SSL session cache.
 				
 	void enableExtendedCertificateVerification(bool flag = true);
 		/// Enable or disable the automatic post-connection
@@ -283,13 +306,56 @@ public:
 		/// The feature can be disabled by calling this method.
 
 private:
+	class CachedSession
+		/// An entry in the client session cache.
+	{
+	public:
+		CachedSession(Session::Ptr pSession, const Poco::Timestamp& expiration);
+		Session::Ptr session() const;
+		const Poco::Timestamp& getExpiration() const;
+
+	private:
+		Session::Ptr _pSession;
+		Poco::Timestamp _expiration;
+	};
+
+	typedef Poco::UniqueExpireLRUCache<std::string, CachedSession> ClientSessionCache;
+
 	void createSSLContext();
 		/// Create a SSL_CTX object according to Context configuration.
 
+	void setSessionKey(SSL* pSSL, const std::string* pKey);
+		/// Associates the given session cache key (peer host name
+		/// and port) with the given SSL object. New sessions negotiated
+		/// by the SSL object are stored in the client session
+		/// cache under this key.
+
+	Session::Ptr findSession(const std::string& key);
+		/// Returns the cached client session for the given key,
+		/// or null if there is none.
+
+	void addSession(const std::string& key, Session::Ptr pSession);
+		/// Stores the given session in the client session cache.
+
+	void removeSession(const std::string& key);
+		/// Removes the session for the given key from the
+		/// client session cache.
+
+	Poco::SharedPtr<ClientSessionCache> clientSessionCache();
+
+	static int newSessionCallback(SSL* pSSL, SSL_SESSION* pSession);
+		/// Called by OpenSSL whenever a new session has been
+		/// negotiated, or a new session ticket has been received.
+
 	Usage _usage;
 	VerificationMode _mode;
 	SSL_CTX* _pSSLContext;
 	bool _extendedCertificateVerification;
+	std::size_t _clientSessionCacheSize;
+	Poco::SharedPtr<ClientSessionCache> _pClientSessionCache;
+	Poco::FastMutex _clientSessionCacheMutex;
+	
+	friend class SecureSocketImpl;
 };
 
 
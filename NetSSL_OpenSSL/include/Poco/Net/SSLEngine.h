@@ -0,0 +1,262 @@
+//
+// SSLEngine.h
+//
+// $Id: //poco/1.4/NetSSL_OpenSSL/include/Poco/Net/SSLEngine.h#1 $
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLSockets
+// Module:  SSLEngine
+//
+// Definition of the SSLEngine class.
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef NetSSL_SSLEngine_INCLUDED
+#define NetSSL_SSLEngine_INCLUDED
+
+
+#include "Poco/Net/NetSSL.h"
+#include "Poco/Net/Context.h"
+#include "Poco/Net/X509Certificate.h"
+#include <openssl/bio.h>
+#include <openssl/ssl.h>
+
+
+namespace Poco {
+namespace Net {
+
+
+class NetSSL_API SSLEngine
+	/// SSLEngine implements the SSL/TLS protocol without doing any I/O.
+	///
+	/// Unlike SecureStreamSocket, which reads from and writes to a socket
+	/// itself, an SSLEngine works on memory buffers only. Data received from
+	/// the network is passed to the engine with feed(), and data the engine
+	/// wants to send to the network is taken out with drain(). On the
+	/// application side, handshake(), read(), write() and shutdown()
+	/// perform one incremental step each and never block.
+	///
+	/// This makes SSLEngine suitable for event-driven servers and clients,
+	/// e.g. based on SocketReactor, where many connections are served by
+	/// a single thread. A typical readable handler looks like this:
+	///
+	///     int n = socket.receiveBytes(buffer, sizeof(buffer));
+	///     if (n > 0) engine.feed(buffer, n);
+	///     else engine.feedEOF();
+	///     int rc = engine.read(plain, sizeof(plain));
+	///     if (rc > 0) ... process rc bytes of plain data
+	///     else if (rc == 0) ... peer has closed the connection
+	///     // if the transport was closed without a close_notify alert,
+	///     // read() throws a SSLConnectionUnexpectedlyClosedException
+	///     // rc == ERR_SSL_WANT_READ: wait for more data from the peer
+	///     while (engine.pending() > 0)
+	///     {
+	///         n = engine.drain(buffer, sizeof(buffer));
+	///         socket.sendBytes(buffer, n);
+	///     }
+	///
+	/// After every call to handshake(), read(), write() or shutdown(),
+	/// the application must check pending() and send the data waiting in
+	/// the engine to the peer. Since the engine buffers all outgoing data
+	/// in memory, these operations never fail with ERR_SSL_WANT_WRITE.
+	///
+	/// Whether the engine acts as client or as server is determined
+	/// by the usage of the given Context. An SSLEngine must not be
+	/// used by more than one thread at a time.
+{
+public:
+	enum
+	{
+		ERR_SSL_WANT_READ  = -1,
+			/// More data from the peer is needed to complete the operation.
+		ERR_SSL_WANT_WRITE = -2
+			/// Not returned by SSLEngine; for compatibility with
+			/// SecureStreamSocket only.
+	};
+
+	explicit SSLEngine(Context::Ptr pContext);
+		/// Creates the SSLEngine using the given Context.
+		///
+		/// For a client Context, the server certificate can only be
+		/// verified against a host name, so this constructor throws
+		/// an InvalidArgumentException, unless the Context's verification
+		/// mode is VERIFY_NONE or extended certificate verification
+		/// has been disabled for the Context.
+
+	SSLEngine(Context::Ptr pContext, const std::string& peerHostName);
+		/// Creates the SSLEngine using the given Context.
+		///
+		/// For a client Context, the peerHostName is sent to the server
+		/// using the TLS server name indication extension, and is used
+		/// to verify the server certificate after the handshake.
+		///
+		/// Throws an InvalidArgumentException if peerHostName is empty
+		/// and the server certificate would have to be verified
+		/// (see the other constructor).
+
+	~SSLEngine();
+		/// Destroys the SSLEngine.
+
+	std::size_t feed(const char* data, std::size_t length);
+		/// Passes data received from the peer to the engine.
+		///
+		/// All data is consumed; returns length.
+		///
+		/// Throws an IllegalStateException if feedEOF()
+		/// has been called before.
+
+	void feedEOF();
+		/// Tells the engine that the transport has been closed
+		/// by the peer and no more data will be fed.
+		///
+		/// Once all data fed before has been consumed, read() returns 0
+		/// if the peer's close_notify alert has been received, and
+		/// throws a SSLConnectionUnexpectedlyClosedException otherwise,
+		/// as the data may have been truncated. handshake() throws a
+		/// SSLConnectionUnexpectedlyClosedException as well.
+
+	std::size_t pending() const;
+		/// Returns the number of bytes the engine wants to
+		/// send to the peer.
+
+	std::size_t drain(char* buffer, std::size_t length);
+		/// Copies up to length bytes of the data waiting to be
+		/// sent to the peer into the given buffer, and removes
+		/// them from the engine.
+		///
+		/// Returns the number of bytes copied, which is 0
+		/// if no data is pending.
+
+	int handshake();
+		/// Performs the next step of the SSL handshake.
+		///
+		/// Returns 1 if the handshake is complete, or
+		/// ERR_SSL_WANT_READ if more data from the peer is needed.
+		/// In both cases, data for the peer may be pending.
+		///
+		/// For a client engine, the server certificate is verified
+		/// once the handshake is complete (see
+		/// SecureStreamSocket::verifyPeerCertificate()).
+		///
+		/// Throws a SSLException or a CertificateValidationException
+		/// if the handshake fails.
+
+	bool handshakeComplete() const;
+		/// Returns true iff the handshake has been completed.
+
+	int read(char* buffer, int length);
+		/// Decrypts data received from the peer into the given buffer.
+		///
+		/// If the handshake has not been completed yet, advances
+		/// the handshake first.
+		///
+		/// Returns the number of bytes read, 0 if the peer
+		/// has shut down the connection, or ERR_SSL_WANT_READ
+		/// if more data from the peer is needed.
+
+	int write(const char* buffer, int length);
+		/// Encrypts the given data. The encrypted data can be
+		/// taken out of the engine with drain().
+		///
+		/// If the handshake has not been completed yet, advances
+		/// the handshake first, and returns ERR_SSL_WANT_READ
+		/// if it cannot be completed without more data from the peer.
+		///
+		/// Returns the number of bytes written.
+
+	int shutdown();
+		/// Creates a close_notify alert, to be sent to the peer,
+		/// if not done so before.
+		///
+		/// Returns 1 if the peer's close_notify alert has been received
+		/// as well, or 0 otherwise.
+
+	bool isClosed() const;
+		/// Returns true iff the peer has shut down the connection.
+
+	bool havePeerCertificate() const;
+		/// Returns true iff the peer has presented a certificate.
+
+	X509Certificate peerCertificate() const;
+		/// Returns the peer's X509 certificate.
+		///
+		/// Throws a SSLException if the peer did not present a
+		/// certificate.
+
+	Context::Ptr context() const;
+		/// Returns the SSL context used by the engine.
+
+	SSL* sslHandle() const;
+		/// Returns the underlying OpenSSL SSL object.
+
+protected:
+	void init();
+	int handleError(int rc);
+	void verifyPeerCertificate();
+	static bool isLocalHost(const std::string& hostName);
+
+private:
+	SSLEngine();
+	SSLEngine(const SSLEngine&);
+	SSLEngine& operator = (const SSLEngine&);
+
+	Context::Ptr _pContext;
+	std::string  _peerHostName;
+	SSL*         _pSSL;
+	BIO*         _pNetworkIn;
+	BIO*         _pNetworkOut;
+	bool         _handshakeComplete;
+	bool         _eof;
+};
+
+
+//
+// inlines
+//
+inline bool SSLEngine::handshakeComplete() const
+{
+	return _handshakeComplete;
+}
+
+
+inline Context::Ptr SSLEngine::context() const
+{
+	return _pContext;
+}
+
+
+inline SSL* SSLEngine::sslHandle() const
+{
+	return _pSSL;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // NetSSL_SSLEngine_INCLUDED
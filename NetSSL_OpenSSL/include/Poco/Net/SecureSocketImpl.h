@@ -196,6 +196,10 @@ public:
 		/// To remove the currently set session, a null pointer
 		/// can be given.
 		///
+		/// If the Context's client session cache is enabled, and it
+		/// contains a session for the peer, the cached session
+		/// is used instead.
+		///
 		/// Must be called before connect() to be effective.
 		
 	bool sessionWasReused();
@@ -212,6 +216,11 @@ protected:
 	
 	long verifyPeerCertificateImpl(const std::string& hostName);
 		/// Performs post-connect (or post-accept) peer certificate validation.
+
+	std::string sessionKey();
+		/// Returns the key (peer host name and port) for the
+		/// Context's client session cache, or an empty string
+		/// if the socket is not connected yet.
 		
 	static bool isLocalHost(const std::string& hostName);
 		/// Returns true iff the given host name is the local host 
@@ -239,6 +248,7 @@ private:
 	bool _needHandshake;
 	std::string _peerHostName;
 	Session::Ptr _pSession;
+	std::string _sessionKey;
 	
 	friend class SecureStreamSocketImpl;
 };
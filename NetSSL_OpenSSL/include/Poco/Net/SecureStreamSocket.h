@@ -271,6 +271,10 @@ public:
 		/// To remove the currently set session, a null pointer
 		/// can be given.
 		///
+		/// If the Context's client session cache is enabled, and it
+		/// contains a session for the peer, the cached session
+		/// is used instead.
+		///
 		/// Must be called before connect() to be effective.
 		
 	bool sessionWasReused();
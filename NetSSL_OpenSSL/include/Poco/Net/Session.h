@@ -56,7 +56,9 @@ class NetSSL_API Session: public Poco::RefCountedObject
 	///
 	/// For session caching to work, a client must
 	/// save the session object from an existing connection,
-	/// if it wants to reuse it with a future connection.
+	/// if it wants to reuse it with a future connection,
+	/// unless the Context's client session cache is used
+	/// (see Context::enableSessionCache()).
 {
 public:
 	typedef Poco::AutoPtr<Session> Ptr;
@@ -83,6 +85,7 @@ private:
 	SSL_SESSION* _pSession;
 	
 	friend class SecureSocketImpl;
+	friend class Context;
 };
 
 
@@ -46,12 +46,69 @@
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
+#include <limits>
 
 
 namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	Poco::FastMutex indexMutex;
+	int contextIndex = -1;
+	int sessionKeyIndex = -1;
+
+	void initializeIndexes()
+	{
+		Poco::FastMutex::ScopedLock lock(indexMutex);
+
+		if (contextIndex < 0)
+		{
+			contextIndex = SSL_CTX_get_ex_new_index(0, 0, 0, 0, 0);
+			sessionKeyIndex = SSL_get_ex_new_index(0, 0, 0, 0, 0);
+		}
+	}
+
+	long clientCacheSize(std::size_t size)
+	{
+		if (size == 0 || size > static_cast<std::size_t>(std::numeric_limits<long>::max()))
+			return std::numeric_limits<long>::max();
+		else
+			return static_cast<long>(size);
+	}
+}
+
+
+//
+// Context::CachedSession
+//
+
+
+Context::CachedSession::CachedSession(Session::Ptr pSession, const Poco::Timestamp& expiration):
+	_pSession(pSession),
+	_expiration(expiration)
+{
+}
+
+
+Session::Ptr Context::CachedSession::session() const
+{
+	return _pSession;
+}
+
+
+const Poco::Timestamp& Context::CachedSession::getExpiration() const
+{
+	return _expiration;
+}
+
+
+//
+// Context
+//
+
+
 Context::Context(
 	Usage usage,
 	const std::string& privateKeyFile, 
@@ -64,7 +121,9 @@ Context::Context(
 	_usage(usage),
 	_mode(verificationMode),
 	_pSSLContext(0),
-	_extendedCertificateVerification(true)
+	_extendedCertificateVerification(true),
+	_clientSessionCacheSize(DEFAULT_CLIENT_SESSION_CACHE_SIZE),
+	_pClientSessionCache(new ClientSessionCache(DEFAULT_CLIENT_SESSION_CACHE_SIZE))
 {
 	Poco::Crypto::OpenSSLInitializer::initialize();
 	
@@ -141,7 +200,9 @@ Context::Context(
 	_usage(usage),
 	_mode(verificationMode),
 	_pSSLContext(0),
-	_extendedCertificateVerification(true)
+	_extendedCertificateVerification(true),
+	_clientSessionCacheSize(DEFAULT_CLIENT_SESSION_CACHE_SIZE),
+	_pClientSessionCache(new ClientSessionCache(DEFAULT_CLIENT_SESSION_CACHE_SIZE))
 {
 	Poco::Crypto::OpenSSLInitializer::initialize();
 	
@@ -231,7 +292,8 @@ void Context::enableSessionCache(bool flag)
 {
 	if (flag)
 	{
-		SSL_CTX_set_session_cache_mode(_pSSLContext, isForServerUse() ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_CLIENT);
+		// Client sessions are kept in our own cache, keyed by server.
+		SSL_CTX_set_session_cache_mode(_pSSLContext, isForServerUse() ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
 	}
 	else
 	{
@@ -268,42 +330,52 @@ bool Context::sessionCacheEnabled() const
 
 void Context::setSessionCacheSize(std::size_t size)
 {
-	poco_assert (isForServerUse());
-	
-	SSL_CTX_sess_set_cache_size(_pSSLContext, static_cast<long>(size));
+	if (isForServerUse())
+	{
+		SSL_CTX_sess_set_cache_size(_pSSLContext, static_cast<long>(size));
+	}
+	else
+	{
+		Poco::FastMutex::ScopedLock lock(_clientSessionCacheMutex);
+
+		_clientSessionCacheSize = size;
+		_pClientSessionCache = new ClientSessionCache(clientCacheSize(size));
+	}
 }
 
 	
 std::size_t Context::getSessionCacheSize() const
 {
-	poco_assert (isForServerUse());
-	
-	return static_cast<std::size_t>(SSL_CTX_sess_get_cache_size(_pSSLContext));
+	if (isForServerUse())
+		return static_cast<std::size_t>(SSL_CTX_sess_get_cache_size(_pSSLContext));
+	else
+		return _clientSessionCacheSize;
 }
 
 
 void Context::setSessionTimeout(long seconds)
 {
-	poco_assert (isForServerUse());
-
 	SSL_CTX_set_timeout(_pSSLContext, seconds);
 }
 
 
 long Context::getSessionTimeout() const
 {
-	poco_assert (_usage == SERVER_USE);
-
 	return SSL_CTX_get_timeout(_pSSLContext);
 }
 
 
 void Context::flushSessionCache() 
 {
-	poco_assert (_usage == SERVER_USE);
-
-	Poco::Timestamp now;
-	SSL_CTX_flush_sessions(_pSSLContext, static_cast<long>(now.epochTime()));
+	if (isForServerUse())
+	{
+		Poco::Timestamp now;
+		SSL_CTX_flush_sessions(_pSSLContext, static_cast<long>(now.epochTime()));
+	}
+	else
+	{
+		clientSessionCache()->clear();
+	}
 }
 
 
@@ -356,6 +428,79 @@ void Context::createSSLContext()
 	SSL_CTX_set_default_passwd_cb(_pSSLContext, &SSLManager::privateKeyPassphraseCallback);
 	Utility::clearErrorStack();
 	SSL_CTX_set_options(_pSSLContext, SSL_OP_ALL);
+
+	initializeIndexes();
+	SSL_CTX_set_ex_data(_pSSLContext, contextIndex, this);
+	if (!isForServerUse())
+	{
+		SSL_CTX_sess_set_new_cb(_pSSLContext, &Context::newSessionCallback);
+	}
+}
+
+
+void Context::setSessionKey(SSL* pSSL, const std::string* pKey)
+{
+	SSL_set_ex_data(pSSL, sessionKeyIndex, const_cast<std::string*>(pKey));
+}
+
+
+Session::Ptr Context::findSession(const std::string& key)
+{
+	Poco::SharedPtr<CachedSession> pEntry = clientSessionCache()->get(key);
+	if (pEntry)
+		return pEntry->session();
+	else
+		return 0;
+}
+
+
+void Context::addSession(const std::string& key, Session::Ptr pSession)
+{
+	Poco::Timestamp now;
+	long timeout = SSL_CTX_get_timeout(_pSSLContext);
+	long sessionTimeout = static_cast<long>(SSL_SESSION_get_time(pSession->sslSession()) + SSL_SESSION_get_timeout(pSession->sslSession()) - now.epochTime());
+	if (sessionTimeout < timeout) timeout = sessionTimeout;
+	if (timeout > 0)
+	{
+		Poco::Timestamp expiration(now);
+		expiration += Poco::Timespan(timeout, 0);
+		clientSessionCache()->add(key, CachedSession(pSession, expiration));
+	}
+}
+
+
+void Context::removeSession(const std::string& key)
+{
+	clientSessionCache()->remove(key);
+}
+
+
+Poco::SharedPtr<Context::ClientSessionCache> Context::clientSessionCache()
+{
+	Poco::FastMutex::ScopedLock lock(_clientSessionCacheMutex);
+
+	return _pClientSessionCache;
+}
+
+
+int Context::newSessionCallback(SSL* pSSL, SSL_SESSION* pSession)
+{
+	Context* pContext = reinterpret_cast<Context*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(pSSL), contextIndex));
+	const std::string* pKey = reinterpret_cast<const std::string*>(SSL_get_ex_data(pSSL, sessionKeyIndex));
+	if (pContext && pKey && !pKey->empty())
+	{
+		// The Session object takes over our reference to pSession.
+		Session::Ptr pCachedSession = new Session(pSession);
+		try
+		{
+			pContext->addSession(*pKey, pCachedSession);
+		}
+		catch (...)
+		{
+		}
+		return 1;
+	}
+	return 0;
 }
 
 
@@ -0,0 +1,332 @@
+//
+// SSLEngine.cpp
+//
+// $Id: //poco/1.4/NetSSL_OpenSSL/src/SSLEngine.cpp#1 $
+//
+// Library: NetSSL_OpenSSL
+// Package: SSLSockets
+// Module:  SSLEngine
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/SSLEngine.h"
+#include "Poco/Net/SSLException.h"
+#include "Poco/Net/Utility.h"
+#include "Poco/Net/IPAddress.h"
+#include "Poco/String.h"
+#include "Poco/Format.h"
+#include <openssl/err.h>
+#include <openssl/x509v3.h>
+
+
+namespace Poco {
+namespace Net {
+
+
+SSLEngine::SSLEngine(Context::Ptr pContext):
+	_pContext(pContext),
+	_pSSL(0),
+	_pNetworkIn(0),
+	_pNetworkOut(0),
+	_handshakeComplete(false),
+	_eof(false)
+{
+	init();
+}
+
+
+SSLEngine::SSLEngine(Context::Ptr pContext, const std::string& peerHostName):
+	_pContext(pContext),
+	_peerHostName(peerHostName),
+	_pSSL(0),
+	_pNetworkIn(0),
+	_pNetworkOut(0),
+	_handshakeComplete(false),
+	_eof(false)
+{
+	init();
+}
+
+
+SSLEngine::~SSLEngine()
+{
+	// frees the BIOs as well
+	SSL_free(_pSSL);
+}
+
+
+void SSLEngine::init()
+{
+	poco_check_ptr (_pContext);
+
+	if (!_pContext->isForServerUse() && _peerHostName.empty() &&
+	    _pContext->verificationMode() != Context::VERIFY_NONE && _pContext->extendedCertificateVerificationEnabled())
+	{
+		throw Poco::InvalidArgumentException("A peer host name is required for verifying the server certificate");
+	}
+
+	_pNetworkIn  = BIO_new(BIO_s_mem());
+	_pNetworkOut = BIO_new(BIO_s_mem());
+	if (!_pNetworkIn || !_pNetworkOut)
+	{
+		if (_pNetworkIn) BIO_free(_pNetworkIn);
+		if (_pNetworkOut) BIO_free(_pNetworkOut);
+		throw SSLException("Cannot create SSL BIO object");
+	}
+
+	_pSSL = SSL_new(_pContext->sslContext());
+	if (!_pSSL)
+	{
+		BIO_free(_pNetworkIn);
+		BIO_free(_pNetworkOut);
+		throw SSLException("Cannot create SSL object");
+	}
+	SSL_set_bio(_pSSL, _pNetworkIn, _pNetworkOut);
+
+	if (_pContext->isForServerUse())
+	{
+		SSL_set_accept_state(_pSSL);
+	}
+	else
+	{
+#if OPENSSL_VERSION_NUMBER >= 0x0908060L && !defined(OPENSSL_NO_TLSEXT)
+		if (!_peerHostName.empty())
+		{
+			SSL_set_tlsext_host_name(_pSSL, _peerHostName.c_str());
+		}
+#endif
+		SSL_set_connect_state(_pSSL);
+	}
+}
+
+
+std::size_t SSLEngine::feed(const char* data, std::size_t length)
+{
+	if (_eof) throw Poco::IllegalStateException("SSLEngine has already received EOF");
+
+	std::size_t written = 0;
+	while (written < length)
+	{
+		int n = BIO_write(_pNetworkIn, data + written, static_cast<int>(length - written));
+		if (n <= 0) throw SSLException("Cannot write to SSL BIO object");
+		written += n;
+	}
+	return written;
+}
+
+
+void SSLEngine::feedEOF()
+{
+	if (!_eof)
+	{
+		// make reads from the empty memory BIO report EOF instead of "retry"
+		BIO_set_mem_eof_return(_pNetworkIn, 0);
+		_eof = true;
+	}
+}
+
+
+std::size_t SSLEngine::pending() const
+{
+	return static_cast<std::size_t>(BIO_ctrl_pending(_pNetworkOut));
+}
+
+
+std::size_t SSLEngine::drain(char* buffer, std::size_t length)
+{
+	if (length == 0 || pending() == 0) return 0;
+
+	int n = BIO_read(_pNetworkOut, buffer, static_cast<int>(length));
+	return n > 0 ? static_cast<std::size_t>(n) : 0;
+}
+
+
+int SSLEngine::handshake()
+{
+	if (_handshakeComplete) return 1;
+
+	int rc = handleError(SSL_do_handshake(_pSSL));
+	if (rc == 1)
+	{
+		_handshakeComplete = true;
+		verifyPeerCertificate();
+	}
+	else if (rc == 0)
+	{
+		throw SSLConnectionUnexpectedlyClosedException();
+	}
+	return rc;
+}
+
+
+int SSLEngine::read(char* buffer, int length)
+{
+	if (!_handshakeComplete)
+	{
+		int rc = handshake();
+		if (rc != 1) return rc;
+	}
+	return handleError(SSL_read(_pSSL, buffer, length));
+}
+
+
+int SSLEngine::write(const char* buffer, int length)
+{
+	if (!_handshakeComplete)
+	{
+		int rc = handshake();
+		if (rc != 1) return rc;
+	}
+	int rc = handleError(SSL_write(_pSSL, buffer, length));
+	if (rc == 0) throw SSLConnectionUnexpectedlyClosedException();
+	return rc;
+}
+
+
+int SSLEngine::shutdown()
+{
+	int rc = SSL_shutdown(_pSSL);
+	if (rc < 0) 
+	{
+		rc = handleError(rc);
+		if (rc == ERR_SSL_WANT_READ) rc = 0;
+	}
+	return rc;
+}
+
+
+bool SSLEngine::isClosed() const
+{
+	return (SSL_get_shutdown(_pSSL) & SSL_RECEIVED_SHUTDOWN) != 0;
+}
+
+
+bool SSLEngine::havePeerCertificate() const
+{
+	X509* pCert = SSL_get_peer_certificate(_pSSL);
+	if (pCert)
+	{
+		X509_free(pCert);
+		return true;
+	}
+	else return false;
+}
+
+
+X509Certificate SSLEngine::peerCertificate() const
+{
+	X509* pCert = SSL_get_peer_certificate(_pSSL);
+	if (pCert)
+		return X509Certificate(pCert);
+	else
+		throw SSLException("No certificate available");
+}
+
+
+int SSLEngine::handleError(int rc)
+{
+	if (rc > 0) return rc;
+
+	int sslError = SSL_get_error(_pSSL, rc);
+	switch (sslError)
+	{
+	case SSL_ERROR_ZERO_RETURN:
+		return 0;
+	case SSL_ERROR_WANT_READ:
+		return ERR_SSL_WANT_READ;
+	case SSL_ERROR_WANT_WRITE:
+		// cannot happen with a memory BIO
+		return ERR_SSL_WANT_WRITE;
+	default:
+		if (_eof && BIO_ctrl_pending(_pNetworkIn) == 0)
+		{
+			// Depending on the OpenSSL version, EOF on the transport is
+			// reported either as SSL_ERROR_SYSCALL or as SSL_ERROR_SSL
+			// ("unexpected eof while reading").
+			ERR_clear_error();
+			throw SSLConnectionUnexpectedlyClosedException();
+		}
+		else
+		{
+			long lastError = ERR_get_error();
+			if (lastError == 0)
+			{
+				if (rc == 0)
+					throw SSLConnectionUnexpectedlyClosedException();
+				else
+					throw SSLException(Poco::format("The BIO reported an error: %d", rc));
+			}
+			else
+			{
+				char buffer[256];
+				ERR_error_string_n(lastError, buffer, sizeof(buffer));
+				std::string msg(buffer);
+				throw SSLException(msg);
+			}
+		}
+	}
+}
+
+
+void SSLEngine::verifyPeerCertificate()
+{
+	if (_pContext->isForServerUse()) return;
+
+	Context::VerificationMode mode = _pContext->verificationMode();
+	if (mode == Context::VERIFY_NONE || !_pContext->extendedCertificateVerificationEnabled() ||
+	    (isLocalHost(_peerHostName) && mode != Context::VERIFY_STRICT))
+	{
+		return;
+	}
+
+	X509* pCert = SSL_get_peer_certificate(_pSSL);
+	if (pCert)
+	{
+		X509Certificate cert(pCert);
+		if (!cert.verify(_peerHostName))
+		{
+			std::string msg = Utility::convertCertificateError(X509_V_ERR_APPLICATION_VERIFICATION);
+			throw CertificateValidationException("Unacceptable certificate from " + _peerHostName, msg);
+		}
+	}
+}
+
+
+bool SSLEngine::isLocalHost(const std::string& hostName)
+{
+	// Unlike SecureSocketImpl, don't resolve the host name,
+	// as this would block.
+	IPAddress addr;
+	if (IPAddress::tryParse(hostName, addr))
+		return addr.isLoopback();
+	else
+		return Poco::icompare(hostName, "localhost") == 0;
+}
+
+
+} } // namespace Poco::Net
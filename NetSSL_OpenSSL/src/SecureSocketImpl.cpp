@@ -184,9 +184,21 @@ void SecureSocketImpl::connectSSL(bool performHandshake)
 	}
 #endif
 
-	if (_pSession)
+	Session::Ptr pSession = _pSession;
+	_sessionKey.clear();
+	if (!_pContext->isForServerUse() && _pContext->sessionCacheEnabled())
 	{
-		SSL_set_session(_pSSL, _pSession->sslSession());
+		_sessionKey = sessionKey();
+		if (!_sessionKey.empty())
+		{
+			_pContext->setSessionKey(_pSSL, &_sessionKey);
+			Session::Ptr pCachedSession = _pContext->findSession(_sessionKey);
+			if (pCachedSession) pSession = pCachedSession;
+		}
+	}
+	if (pSession)
+	{
+		SSL_set_session(_pSSL, pSession->sslSession());
 	}
 	
 	try
@@ -205,6 +217,8 @@ void SecureSocketImpl::connectSSL(bool performHandshake)
 	}
 	catch (...)
 	{
+		// don't try to resume a session that may be the cause of the failure
+		if (!_sessionKey.empty()) _pContext->removeSession(_sessionKey);
 		SSL_free(_pSSL);
 		_pSSL = 0;
 		throw;
@@ -446,6 +460,23 @@ int SecureSocketImpl::handleError(int rc)
 }
 
 
+std::string SecureSocketImpl::sessionKey()
+{
+	try
+	{
+		SocketAddress peerAddress = _pSocket->peerAddress();
+		std::string key(_peerHostName.empty() ? peerAddress.host().toString() : _peerHostName);
+		key += ':';
+		NumberFormatter::append(key, peerAddress.port());
+		return key;
+	}
+	catch (Poco::Exception&)
+	{
+		return std::string();
+	}
+}
+
+
 void SecureSocketImpl::setPeerHostName(const std::string& peerHostName)
 {
 	_peerHostName = peerHostName;
@@ -435,6 +435,66 @@ void HTTPSClientSessionTest::testCachedSession()
 }
 
 
+void HTTPSClientSessionTest::testClientSessionCache()
+{
+	Context::Ptr pServerContext = new Context(
+		Context::SERVER_USE, 
+		Application::instance().config().getString("openSSL.server.privateKeyFile"),
+		Application::instance().config().getString("openSSL.server.privateKeyFile"),
+		Application::instance().config().getString("openSSL.server.caConfig"),
+		Context::VERIFY_NONE,
+		9,
+		true,
+		"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");	
+	pServerContext->enableSessionCache(true, "TestSuite");
+
+	HTTPSTestServer srv(pServerContext);
+
+	Context::Ptr pClientContext = new Context(
+		Context::CLIENT_USE, 
+		Application::instance().config().getString("openSSL.client.privateKeyFile"),
+		Application::instance().config().getString("openSSL.client.privateKeyFile"),
+		Application::instance().config().getString("openSSL.client.caConfig"),
+		Context::VERIFY_RELAXED,
+		9,
+		true,
+		"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+	pClientContext->enableSessionCache(true);
+	pClientContext->setSessionCacheSize(10);
+	assert (pClientContext->getSessionCacheSize() == 10);
+
+	// Sessions are neither saved nor passed in explicitly.
+	for (int i = 0; i < 3; ++i)
+	{
+		HTTPSClientSession s("localhost", srv.port(), pClientContext);
+		HTTPRequest request(HTTPRequest::HTTP_GET, "/small");
+		s.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = s.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		assert (ostr.str() == HTTPSTestServer::SMALL_BODY);
+		
+		SecureStreamSocket socket(s.socket());
+		assert (socket.sessionWasReused() == (i > 0));
+	}
+
+	pClientContext->flushSessionCache();
+
+	HTTPSClientSession s("localhost", srv.port(), pClientContext);
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/small");
+	s.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = s.receiveResponse(response);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(rs, ostr);
+	assert (ostr.str() == HTTPSTestServer::SMALL_BODY);
+
+	SecureStreamSocket socket(s.socket());
+	assert (!socket.sessionWasReused());
+}
+
+
 void HTTPSClientSessionTest::testUnknownContentLength()
 {
 	HTTPSTestServer srv;
@@ -495,6 +555,7 @@ CppUnit::Test* HTTPSClientSessionTest::suite()
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testInterop);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testProxy);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testCachedSession);
+	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testClientSessionCache);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testUnknownContentLength);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testServerAbort);
 
@@ -35,6 +35,7 @@
 #include "HTTPSClientTestSuite.h"
 #include "TCPServerTestSuite.h"
 #include "HTTPSServerTestSuite.h"
+#include "SSLEngineTest.h"
 
 
 CppUnit::Test* NetSSLTestSuite::suite()
@@ -45,6 +46,7 @@ CppUnit::Test* NetSSLTestSuite::suite()
 	pSuite->addTest(HTTPSClientTestSuite::suite());
 	pSuite->addTest(TCPServerTestSuite::suite());
 	pSuite->addTest(HTTPSServerTestSuite::suite());
+	pSuite->addTest(SSLEngineTest::suite());
 
 	return pSuite;
 }
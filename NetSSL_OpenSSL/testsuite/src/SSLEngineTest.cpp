@@ -0,0 +1,366 @@
+//
+// SSLEngineTest.cpp
+//
+// $Id: //poco/1.4/NetSSL_OpenSSL/testsuite/src/SSLEngineTest.cpp#1 $
+//
+// Copyright (c) 2005-2013, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+// 
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "SSLEngineTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/SSLEngine.h"
+#include "Poco/Net/SSLManager.h"
+#include "Poco/Net/SSLException.h"
+#include "Poco/Net/Context.h"
+#include "Poco/Net/TCPServer.h"
+#include "Poco/Net/TCPServerConnection.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/SecureServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include <iostream>
+
+
+using Poco::Net::SSLEngine;
+using Poco::Net::SSLManager;
+using Poco::Net::Context;
+using Poco::Net::TCPServer;
+using Poco::Net::TCPServerConnection;
+using Poco::Net::TCPServerConnectionFactoryImpl;
+using Poco::Net::SecureServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+
+
+namespace
+{
+	class EchoConnection: public TCPServerConnection
+	{
+	public:
+		EchoConnection(const StreamSocket& s): TCPServerConnection(s)
+		{
+		}
+		
+		void run()
+		{
+			StreamSocket& ss = socket();
+			try
+			{
+				char buffer[256];
+				int n = ss.receiveBytes(buffer, sizeof(buffer));
+				while (n > 0)
+				{
+					ss.sendBytes(buffer, n);
+					n = ss.receiveBytes(buffer, sizeof(buffer));
+				}
+			}
+			catch (Poco::Exception& exc)
+			{
+				std::cerr << "EchoConnection: " << exc.displayText() << std::endl;
+			}
+		}
+	};
+	
+	void flush(SSLEngine& engine, StreamSocket& socket)
+	{
+		char buffer[1024];
+		while (engine.pending() > 0)
+		{
+			int n = static_cast<int>(engine.drain(buffer, sizeof(buffer)));
+			socket.sendBytes(buffer, n);
+		}
+	}
+	
+	void receive(SSLEngine& engine, StreamSocket& socket)
+	{
+		char buffer[1024];
+		int n = socket.receiveBytes(buffer, sizeof(buffer));
+		if (n <= 0) throw Poco::IOException("connection closed by peer");
+		engine.feed(buffer, n);
+	}
+}
+
+
+SSLEngineTest::SSLEngineTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+SSLEngineTest::~SSLEngineTest()
+{
+}
+
+
+void SSLEngineTest::testHandshake()
+{
+	SSLEngine client(SSLManager::instance().defaultClientContext(), "localhost");
+	SSLEngine server(SSLManager::instance().defaultServerContext());
+	assert (!client.handshakeComplete());
+	assert (!server.handshakeComplete());
+	
+	// nothing received yet
+	assert (server.handshake() == SSLEngine::ERR_SSL_WANT_READ);
+	assert (server.pending() == 0);
+	
+	assert (client.handshake() == SSLEngine::ERR_SSL_WANT_READ);
+	assert (client.pending() > 0);
+	
+	handshake(client, server);
+	assert (client.handshakeComplete());
+	assert (server.handshakeComplete());
+	assert (client.havePeerCertificate());
+	assert (!client.peerCertificate().subjectName().empty());
+}
+
+
+void SSLEngineTest::testReadWrite()
+{
+	SSLEngine client(SSLManager::instance().defaultClientContext(), "localhost");
+	SSLEngine server(SSLManager::instance().defaultServerContext());
+	handshake(client, server);
+	
+	char buffer[256];
+	assert (server.read(buffer, sizeof(buffer)) == SSLEngine::ERR_SSL_WANT_READ);
+	
+	std::string data("hello, world");
+	assert (client.write(data.data(), static_cast<int>(data.size())) == static_cast<int>(data.size()));
+	assert (client.pending() > data.size());
+	transfer(client, server);
+	int n = server.read(buffer, sizeof(buffer));
+	assert (n == static_cast<int>(data.size()));
+	assert (std::string(buffer, n) == data);
+	assert (server.read(buffer, sizeof(buffer)) == SSLEngine::ERR_SSL_WANT_READ);
+
+	assert (server.write(buffer, n) == n);
+	transfer(server, client);
+	n = client.read(buffer, sizeof(buffer));
+	assert (std::string(buffer, n) == data);
+}
+
+
+void SSLEngineTest::testLargeWrite()
+{
+	SSLEngine client(SSLManager::instance().defaultClientContext(), "localhost");
+	SSLEngine server(SSLManager::instance().defaultServerContext());
+	handshake(client, server);
+	
+	std::string data(100000, 'x');
+	for (std::string::size_type i = 0; i < data.size(); ++i) data[i] = 'a' + i % 26;
+	assert (client.write(data.data(), static_cast<int>(data.size())) == static_cast<int>(data.size()));
+	transfer(client, server);
+
+	std::string received;
+	char buffer[4096];
+	int n = server.read(buffer, sizeof(buffer));
+	while (n > 0)
+	{
+		received.append(buffer, n);
+		n = server.read(buffer, sizeof(buffer));
+	}
+	assert (n == SSLEngine::ERR_SSL_WANT_READ);
+	assert (received == data);
+}
+
+
+void SSLEngineTest::testShutdown()
+{
+	SSLEngine client(SSLManager::instance().defaultClientContext(), "localhost");
+	SSLEngine server(SSLManager::instance().defaultServerContext());
+	handshake(client, server);
+
+	assert (client.shutdown() == 0);
+	assert (!client.isClosed());
+	transfer(client, server);
+	
+	char buffer[256];
+	assert (server.read(buffer, sizeof(buffer)) == 0);
+	assert (server.isClosed());
+	assert (server.shutdown() == 1);
+	transfer(server, client);
+	
+	assert (client.read(buffer, sizeof(buffer)) == 0);
+	assert (client.isClosed());
+	assert (client.shutdown() == 1);
+}
+
+
+void SSLEngineTest::testEOF()
+{
+	SSLEngine client(SSLManager::instance().defaultClientContext(), "localhost");
+	SSLEngine server(SSLManager::instance().defaultServerContext());
+	handshake(client, server);
+
+	std::string data("hello, world");
+	server.write(data.data(), static_cast<int>(data.size()));
+	transfer(server, client);
+	client.feedEOF();
+
+	// data received before EOF can still be read
+	char buffer[256];
+	assert (client.read(buffer, sizeof(buffer)) == static_cast<int>(data.size()));
+	try
+	{
+		client.read(buffer, sizeof(buffer));
+		fail("EOF without close_notify - must throw");
+	}
+	catch (Poco::Net::SSLConnectionUnexpectedlyClosedException&)
+	{
+	}
+	try
+	{
+		client.feed(buffer, 1);
+		fail("feed after EOF - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+
+	SSLEngine client2(SSLManager::instance().defaultClientContext(), "localhost");
+	SSLEngine server2(SSLManager::instance().defaultServerContext());
+	handshake(client2, server2);
+	server2.shutdown();
+	transfer(server2, client2);
+	client2.feedEOF();
+	assert (client2.read(buffer, sizeof(buffer)) == 0);
+	assert (client2.isClosed());
+}
+
+
+void SSLEngineTest::testPeerHostName()
+{
+	Context::Ptr pContext = new Context(Context::CLIENT_USE, "", "", "", Context::VERIFY_RELAXED, 9, true);
+	try
+	{
+		SSLEngine engine(pContext);
+		fail("no peer host name - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	pContext->enableExtendedCertificateVerification(false);
+	SSLEngine engine(pContext);
+
+	Context::Ptr pNoVerifyContext = new Context(Context::CLIENT_USE, "", "", "", Context::VERIFY_NONE, 9, true);
+	SSLEngine noVerifyEngine(pNoVerifyContext);
+}
+
+
+void SSLEngineTest::testOverSocket()
+{
+	SecureServerSocket svs(0);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), svs);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", svs.address().port()));
+	SSLEngine engine(SSLManager::instance().defaultClientContext(), "localhost");
+	while (engine.handshake() != 1)
+	{
+		flush(engine, ss);
+		receive(engine, ss);
+	}
+	flush(engine, ss);
+	
+	std::string data("hello, world");
+	assert (engine.write(data.data(), static_cast<int>(data.size())) == static_cast<int>(data.size()));
+	flush(engine, ss);
+	
+	std::string received;
+	char buffer[256];
+	while (received.size() < data.size())
+	{
+		int n = engine.read(buffer, sizeof(buffer));
+		if (n > 0)
+			received.append(buffer, n);
+		else if (n == SSLEngine::ERR_SSL_WANT_READ)
+			receive(engine, ss);
+		else
+			fail("unexpected end of connection");
+		flush(engine, ss);
+	}
+	assert (received == data);
+	
+	engine.shutdown();
+	flush(engine, ss);
+	ss.close();
+}
+
+
+int SSLEngineTest::transfer(SSLEngine& from, SSLEngine& to)
+{
+	int total = 0;
+	char buffer[1024];
+	while (from.pending() > 0)
+	{
+		std::size_t n = from.drain(buffer, sizeof(buffer));
+		to.feed(buffer, n);
+		total += static_cast<int>(n);
+	}
+	return total;
+}
+
+
+void SSLEngineTest::handshake(SSLEngine& client, SSLEngine& server)
+{
+	int rounds = 0;
+	while (!client.handshakeComplete() || !server.handshakeComplete())
+	{
+		client.handshake();
+		transfer(client, server);
+		server.handshake();
+		transfer(server, client);
+		if (++rounds > 10) throw Poco::IllegalStateException("handshake does not complete");
+	}
+}
+
+
+void SSLEngineTest::setUp()
+{
+}
+
+
+void SSLEngineTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SSLEngineTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SSLEngineTest");
+
+	CppUnit_addTest(pSuite, SSLEngineTest, testHandshake);
+	CppUnit_addTest(pSuite, SSLEngineTest, testReadWrite);
+	CppUnit_addTest(pSuite, SSLEngineTest, testLargeWrite);
+	CppUnit_addTest(pSuite, SSLEngineTest, testShutdown);
+	CppUnit_addTest(pSuite, SSLEngineTest, testEOF);
+	CppUnit_addTest(pSuite, SSLEngineTest, testPeerHostName);
+	CppUnit_addTest(pSuite, SSLEngineTest, testOverSocket);
+
+	return pSuite;
+}